@@ -0,0 +1,231 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgBakedDialogue.h"
+
+#include "DlgDialogue.h"
+#include "Nodes/DlgNode.h"
+#include "Nodes/DlgNode_Proxy.h"
+
+namespace DlgBakedDialogue
+{
+	static int32 NextGeneration = 0;
+
+	static FDlgBakedConditionsRange AddConditions(
+		TArray<FDlgCondition>& Pool,
+		const TArray<FDlgCondition>& Conditions,
+		FName DefaultParticipantName
+	)
+	{
+		FDlgBakedConditionsRange Range;
+		Range.StartIndex = Pool.Num();
+		Range.Num = Conditions.Num();
+		for (const FDlgCondition& Condition : Conditions)
+		{
+			FDlgCondition& Baked = Pool.Add_GetRef(Condition);
+			if (Baked.ParticipantName == NAME_None)
+			{
+				Baked.ParticipantName = DefaultParticipantName;
+			}
+		}
+
+		return Range;
+	}
+
+	// Same substitution as AddConditions
+	static bool AreConditionsEqual(
+		const TArray<FDlgCondition>& Pool,
+		const FDlgBakedConditionsRange& Range,
+		const TArray<FDlgCondition>& Conditions,
+		FName DefaultParticipantName
+	)
+	{
+		if (Range.Num != Conditions.Num())
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < Range.Num; Index++)
+		{
+			FDlgCondition Condition = Conditions[Index];
+			if (Condition.ParticipantName == NAME_None)
+			{
+				Condition.ParticipantName = DefaultParticipantName;
+			}
+			if (!(Condition == Pool[Range.StartIndex + Index]))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+void FDlgBakedDialogue::Build(const UDlgDialogue& Dialogue)
+{
+	Empty();
+	Generation = DlgBakedDialogue::NextGeneration++;
+
+	const TArray<UDlgNode*>& Nodes = Dialogue.GetNodes();
+	const int32 NumNodes = Nodes.Num();
+	NodeDescriptors.Reserve(NumNodes);
+	NodeEnterConditions.Reserve(NumNodes);
+	NodeEnterRestrictions.Reserve(NumNodes);
+	NodeGUIDs.Reserve(NumNodes);
+	NodeProxyTargets.Reserve(NumNodes);
+	NodeParticipantNames.Reserve(NumNodes);
+
+	for (const UDlgNode* Node : Nodes)
+	{
+		if (!Node)
+		{
+			NodeDescriptors.AddDefaulted_GetRef().FirstEdgeIndex = Edges.Num();
+			NodeEnterConditions.AddDefaulted();
+			NodeEnterRestrictions.Add(EDlgEntryRestriction::None);
+			NodeGUIDs.AddDefaulted();
+			NodeProxyTargets.Add(INDEX_NONE);
+			NodeParticipantNames.Add(INDEX_NONE);
+			continue;
+		}
+
+		NodeDescriptors.Add(FDlgNodeDescriptor::FromNode(*Node, Edges.Num()));
+		NodeEnterConditions.Add(DlgBakedDialogue::AddConditions(Conditions, Node->GetNodeEnterConditions(), Node->GetEnterConditionsParticipantName()));
+		NodeEnterRestrictions.Add(Node->GetEnterRestriction());
+		NodeGUIDs.Add(Node->GetGUID());
+		NodeParticipantNames.Add(Names.AddUnique(Node->GetNodeParticipantName()));
+
+		const UDlgNode_Proxy* Proxy = Cast<UDlgNode_Proxy>(Node);
+		NodeProxyTargets.Add(Proxy ? Proxy->GetTargetNodeIndex() : INDEX_NONE);
+
+		for (const FDlgEdge& Edge : Node->GetNodeChildren())
+		{
+			FDlgBakedEdge& BakedEdge = Edges.AddDefaulted_GetRef();
+			BakedEdge.TargetIndex = Edge.TargetIndex;
+			BakedEdge.Conditions = DlgBakedDialogue::AddConditions(Conditions, Edge.Conditions, NAME_None);
+		}
+	}
+}
+
+void FDlgBakedDialogue::Empty()
+{
+	NodeDescriptors.Empty();
+	NodeEnterConditions.Empty();
+	NodeEnterRestrictions.Empty();
+	NodeGUIDs.Empty();
+	NodeProxyTargets.Empty();
+	NodeParticipantNames.Empty();
+	Edges.Empty();
+	Conditions.Empty();
+	Names.Empty();
+	Generation = INDEX_NONE;
+	ValidatedGeneration = INDEX_NONE;
+	bConditionsValid = false;
+}
+
+bool FDlgBakedDialogue::IsValidFor(const UDlgDialogue& Dialogue) const
+{
+	const TArray<UDlgNode*>& Nodes = Dialogue.GetNodes();
+	if (Generation == INDEX_NONE || NodeDescriptors.Num() != Nodes.Num())
+	{
+		return false;
+	}
+
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		if (!IsNodeUpToDate(Nodes[NodeIndex], NodeIndex))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FDlgBakedDialogue::ValidateConditions(const UDlgDialogue& Dialogue)
+{
+	if (Generation == INDEX_NONE)
+	{
+		return false;
+	}
+	if (ValidatedGeneration == Generation)
+	{
+		return bConditionsValid;
+	}
+
+	ValidatedGeneration = Generation;
+	bConditionsValid = false;
+	const TArray<UDlgNode*>& Nodes = Dialogue.GetNodes();
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		const UDlgNode* Node = Nodes[NodeIndex];
+		if (!Node)
+		{
+			continue;
+		}
+
+		if (!DlgBakedDialogue::AreConditionsEqual(Conditions, NodeEnterConditions[NodeIndex], Node->GetNodeEnterConditions(), Node->GetEnterConditionsParticipantName()))
+		{
+			return false;
+		}
+
+		const TArray<FDlgEdge>& Children = Node->GetNodeChildren();
+		const int32 FirstEdgeIndex = NodeDescriptors[NodeIndex].FirstEdgeIndex;
+		for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); EdgeIndex++)
+		{
+			if (!DlgBakedDialogue::AreConditionsEqual(Conditions, Edges[FirstEdgeIndex + EdgeIndex].Conditions, Children[EdgeIndex].Conditions, NAME_None))
+			{
+				return false;
+			}
+		}
+	}
+
+	bConditionsValid = true;
+	return true;
+}
+
+bool FDlgBakedDialogue::IsValidForNode(const UDlgDialogue& Dialogue, int32 NodeIndex) const
+{
+	const TArray<UDlgNode*>& Nodes = Dialogue.GetNodes();
+	return Generation != INDEX_NONE
+		&& NodeDescriptors.Num() == Nodes.Num()
+		&& Nodes.IsValidIndex(NodeIndex)
+		&& IsNodeUpToDate(Nodes[NodeIndex], NodeIndex);
+}
+
+bool FDlgBakedDialogue::IsNodeUpToDate(const UDlgNode* Node, int32 NodeIndex) const
+{
+	const FDlgNodeDescriptor& Descriptor = NodeDescriptors[NodeIndex];
+	if (!Node)
+	{
+		return Descriptor.NumEdges == 0 && NodeEnterConditions[NodeIndex].Num == 0;
+	}
+
+	const TArray<FDlgEdge>& Children = Node->GetNodeChildren();
+	if (Descriptor.NumEdges != Children.Num() || NodeEnterConditions[NodeIndex].Num != Node->GetNodeEnterConditions().Num())
+	{
+		return false;
+	}
+
+	for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); EdgeIndex++)
+	{
+		const FDlgBakedEdge& Edge = Edges[Descriptor.FirstEdgeIndex + EdgeIndex];
+		if (Edge.TargetIndex != Children[EdgeIndex].TargetIndex || Edge.Conditions.Num != Children[EdgeIndex].Conditions.Num())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+SIZE_T FDlgBakedDialogue::GetAllocatedSize() const
+{
+	return NodeDescriptors.GetAllocatedSize()
+		+ NodeEnterConditions.GetAllocatedSize()
+		+ NodeEnterRestrictions.GetAllocatedSize()
+		+ NodeGUIDs.GetAllocatedSize()
+		+ NodeProxyTargets.GetAllocatedSize()
+		+ NodeParticipantNames.GetAllocatedSize()
+		+ Edges.GetAllocatedSize()
+		+ Conditions.GetAllocatedSize()
+		+ Names.GetAllocatedSize();
+}
@@ -0,0 +1,114 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "DlgCondition.h"
+#include "DlgNodeDescriptor.h"
+
+class UDlgDialogue;
+class UDlgNode;
+enum class EDlgEntryRestriction : uint8;
+
+// Range inside FDlgBakedDialogue::Conditions
+struct FDlgBakedConditionsRange
+{
+public:
+	int32 StartIndex = 0;
+	int32 Num = 0;
+};
+
+// Child of a node inside FDlgBakedDialogue::Edges
+struct FDlgBakedEdge
+{
+public:
+	// Same as FDlgEdge::TargetIndex
+	int32 TargetIndex = INDEX_NONE;
+
+	// Same as FDlgEdge::Conditions
+	FDlgBakedConditionsRange Conditions;
+
+	bool IsValid() const { return TargetIndex > INDEX_NONE; }
+};
+
+/**
+ * Flattened runtime representation of the Nodes of a Dialogue, built by UDlgDialogue::RebuildBakedDialogue.
+ *
+ * The nodes are stored as a struct of arrays (same indices as UDlgDialogue::GetNodes), the edges of all the nodes
+ * in a single array and all the conditions in a single pool. UDlgContext evaluates the node enter conditions and the
+ * edges from here, without going through the UDlgNode objects.
+ * The UDlgNode objects are still the source of truth, they are used for everything else (texts, events, Blueprint, editor).
+ */
+struct DLGSYSTEM_API FDlgBakedDialogue
+{
+public:
+	void Build(const UDlgDialogue& Dialogue);
+	void Empty();
+
+	// Was it built from the current nodes of the Dialogue? Checks the number of nodes, edges and conditions (and the edge targets),
+	// the contents of the conditions are checked by ValidateConditions.
+	bool IsValidFor(const UDlgDialogue& Dialogue) const;
+
+	// Are the Conditions the same as the conditions of the nodes of the Dialogue (same order and values)? Expects IsValidFor.
+	// Only compared by the first call after each Build, the conditions changed after that are only picked up by the next Build.
+	bool ValidateConditions(const UDlgDialogue& Dialogue);
+
+	// Same as IsValidFor but only for the Node at NodeIndex
+	bool IsValidForNode(const UDlgDialogue& Dialogue, int32 NodeIndex) const;
+
+	int32 GetNumNodes() const { return NodeDescriptors.Num(); }
+	bool IsValidNodeIndex(int32 NodeIndex) const { return NodeDescriptors.IsValidIndex(NodeIndex); }
+
+	// Unique for each Build, used to know if the data bound to this (see UDlgContext::BindConditions) is out of date
+	int32 GetGeneration() const { return Generation; }
+
+	// Approximate memory used by the baked data
+	SIZE_T GetAllocatedSize() const;
+
+public:
+	//
+	// Nodes, struct of arrays
+	//
+
+	// Kind, flags and edges range
+	TArray<FDlgNodeDescriptor> NodeDescriptors;
+
+	// UDlgNode::GetNodeEnterConditions
+	TArray<FDlgBakedConditionsRange> NodeEnterConditions;
+
+	// UDlgNode::GetEnterRestriction
+	TArray<EDlgEntryRestriction> NodeEnterRestrictions;
+
+	// UDlgNode::GetGUID
+	TArray<FGuid> NodeGUIDs;
+
+	// UDlgNode_Proxy::GetTargetNodeIndex, INDEX_NONE for the other nodes
+	TArray<int32> NodeProxyTargets;
+
+	// UDlgNode::GetNodeParticipantName, index inside Names
+	TArray<int32> NodeParticipantNames;
+
+	//
+	// Pools
+	//
+
+	// The children of all the nodes, see FDlgNodeDescriptor::FirstEdgeIndex
+	TArray<FDlgBakedEdge> Edges;
+
+	// All the conditions, the participant name of the enter conditions is already the default one if it was not set
+	TArray<FDlgCondition> Conditions;
+
+	// Unique participant names
+	TArray<FName> Names;
+
+protected:
+	// Expects the number of nodes to be the same
+	bool IsNodeUpToDate(const UDlgNode* Node, int32 NodeIndex) const;
+
+protected:
+	int32 Generation = INDEX_NONE;
+
+	// The Generation ValidateConditions compared the conditions for, and the result of it
+	int32 ValidatedGeneration = INDEX_NONE;
+	bool bConditionsValid = false;
+};
@@ -7,35 +7,317 @@
 #include "Nodes/DlgNode.h"
 #include "NYReflectionHelper.h"
 #include "Kismet/GameplayStatics.h"
-#include "DlgDialogueParticipant.h"
+#include "DlgNativeDialogueParticipant.h"
 #include "DlgHelper.h"
 #include "Logging/DlgLogger.h"
 
-bool FDlgCondition::EvaluateArray(const UDlgContext& Context, const TArray<FDlgCondition>& ConditionsArray, FName DefaultParticipantName)
+namespace DlgCondition
 {
-	bool bHasAnyWeak = false;
-	bool bHasSuccessfulWeak = false;
+	// All strong conditions must be satisfied and at least one of the weak ones (if there is any)
+	template <typename ConditionsArrayType, typename IsSatisfiedFunctionType>
+	static bool EvaluateStrengths(const ConditionsArrayType& ConditionsArray, IsSatisfiedFunctionType IsSatisfied)
+	{
+		bool bHasAnyWeak = false;
+		bool bHasSuccessfulWeak = false;
+
+		for (int32 Index = 0; Index < ConditionsArray.Num(); Index++)
+		{
+			const auto& Condition = ConditionsArray[Index];
+			const bool bSatisfied = IsSatisfied(Condition, Index);
+			if (Condition.GetStrength() == EDlgConditionStrength::Weak)
+			{
+				bHasAnyWeak = true;
+				bHasSuccessfulWeak = bHasSuccessfulWeak || bSatisfied;
+			}
+			else if (!bSatisfied)
+			{
+				// All must be satisfied
+				return false;
+			}
+		}
 
-	for (const FDlgCondition& Condition : ConditionsArray)
+		return bHasSuccessfulWeak || !bHasAnyWeak;
+	}
+
+	// Values of the FDlgCondition::HasDialogueValue conditions of a condition array, fetched with a single
+	// IDlgNativeDialogueParticipant::GetValuesNative call per native participant instead of one call per condition
+	struct FPrefetchedValues
 	{
-		const FName ParticipantName = Condition.ParticipantName == NAME_None ? DefaultParticipantName : Condition.ParticipantName;
-		const bool bSatisfied = Condition.IsConditionMet(Context, Context.GetParticipant(ParticipantName));
-		if (Condition.Strength == EDlgConditionStrength::Weak)
+	public:
+		// GetNative(ConditionIndex, OutParticipant) returns the native interface of the participant of the condition (or nullptr)
+		template <typename ConditionsArrayType, typename GetNativeFunctionType>
+		void Prefetch(const ConditionsArrayType& ConditionsArray, GetNativeFunctionType GetNative)
+		{
+			TArray<const IDlgNativeDialogueParticipant*, TInlineAllocator<4>> Natives;
+			TArray<int32, TInlineAllocator<16>> NativeIndices;
+			NativeIndices.Init(INDEX_NONE, ConditionsArray.Num());
+			int32 NumValues = 0;
+			for (int32 Index = 0; Index < ConditionsArray.Num(); Index++)
+			{
+				if (!FDlgCondition::HasDialogueValue(GetCondition(ConditionsArray[Index]).ConditionType))
+				{
+					continue;
+				}
+
+				if (const IDlgNativeDialogueParticipant* Native = GetNative(Index))
+				{
+					NativeIndices[Index] = Natives.AddUnique(Native);
+					NumValues++;
+				}
+			}
+
+			// A single value is fetched directly by the condition
+			if (NumValues < 2)
+			{
+				return;
+			}
+
+			// Grouped by participant, each one fills its requests with one call
+			RequestIndices.Init(INDEX_NONE, ConditionsArray.Num());
+			for (int32 NativeIndex = 0; NativeIndex < Natives.Num(); NativeIndex++)
+			{
+				const int32 FirstRequest = Requests.Num();
+				for (int32 Index = 0; Index < ConditionsArray.Num(); Index++)
+				{
+					if (NativeIndices[Index] == NativeIndex)
+					{
+						const FDlgCondition& Condition = GetCondition(ConditionsArray[Index]);
+						RequestIndices[Index] = Requests.Emplace(Condition.ConditionType, Condition.CallbackName);
+					}
+				}
+
+				Natives[NativeIndex]->GetValuesNative(MakeArrayView(Requests.GetData() + FirstRequest, Requests.Num() - FirstRequest));
+			}
+		}
+
+		const FDlgParticipantValueRequest* Find(int32 ConditionIndex) const
 		{
-			bHasAnyWeak = true;
-			bHasSuccessfulWeak = bHasSuccessfulWeak || bSatisfied;
+			if (!RequestIndices.IsValidIndex(ConditionIndex) || RequestIndices[ConditionIndex] == INDEX_NONE)
+			{
+				return nullptr;
+			}
+
+			return &Requests[RequestIndices[ConditionIndex]];
 		}
-		else if (!bSatisfied)
+
+	protected:
+		static const FDlgCondition& GetCondition(const FDlgCondition& Condition) { return Condition; }
+		static const FDlgCondition& GetCondition(const FDlgBoundCondition& Condition) { return Condition.GetCondition(); }
+
+	protected:
+		TArray<FDlgParticipantValueRequest, TInlineAllocator<16>> Requests;
+
+		// Index in Requests of each condition, empty if nothing was prefetched
+		TArray<int32, TInlineAllocator<16>> RequestIndices;
+	};
+
+	// Uses the resolved Property if there is one, otherwise looks it up by name
+	template <typename PropertyType, typename VariableType>
+	static VariableType GetClassVariable(const UObject* Participant, const FProperty* Property, FName VariableName)
+	{
+		if (Property != nullptr)
 		{
-			// All must be satisfied
-			return false;
+			return static_cast<const PropertyType*>(Property)->GetPropertyValue_InContainer(Participant, 0);
+		}
+
+		return FNYReflectionHelper::GetVariable<PropertyType, VariableType>(Participant, VariableName);
+	}
+
+	// Resolves the property of type PropertyType only for class variables
+	template <typename PropertyType>
+	static const FProperty* FindClassVariable(const UObject* Participant, FName VariableName)
+	{
+		return IsValid(Participant) ? FNYReflectionHelper::FindProperty<PropertyType>(Participant->GetClass(), VariableName) : nullptr;
+	}
+
+	static const FProperty* FindClassVariable(EDlgConditionType ConditionType, const UObject* Participant, FName VariableName)
+	{
+		switch (ConditionType)
+		{
+			case EDlgConditionType::BoolCall:
+			case EDlgConditionType::ClassBoolVariable:
+				return FindClassVariable<FBoolProperty>(Participant, VariableName);
+
+			case EDlgConditionType::FloatCall:
+			case EDlgConditionType::ClassFloatVariable:
+				return FindClassVariable<FFloatProperty>(Participant, VariableName);
+
+			case EDlgConditionType::IntCall:
+			case EDlgConditionType::ClassIntVariable:
+				return FindClassVariable<FIntProperty>(Participant, VariableName);
+
+			case EDlgConditionType::NameCall:
+			case EDlgConditionType::ClassNameVariable:
+				return FindClassVariable<FNameProperty>(Participant, VariableName);
+
+			default:
+				return nullptr;
+		}
+	}
+}
+
+FDlgBoundCondition::FDlgBoundCondition(const UDlgContext& Context, const FDlgCondition& InCondition, FName DefaultParticipantName)
+	: Condition(InCondition)
+{
+	if (Condition.ParticipantName == NAME_None)
+	{
+		Condition.ParticipantName = DefaultParticipantName;
+	}
+
+	if (Condition.IsParticipantInvolved())
+	{
+		Participant = Context.GetParticipant(Condition.ParticipantName);
+		if (FDlgCondition::HasClassVariable(Condition.ConditionType))
+		{
+			Property = DlgCondition::FindClassVariable(Condition.ConditionType, Participant.Get(), Condition.CallbackName);
 		}
 	}
 
-	return bHasSuccessfulWeak || !bHasAnyWeak;
+	if (Condition.IsSecondParticipantInvolved())
+	{
+		OtherParticipant = Context.GetParticipant(Condition.OtherParticipantName);
+		if (Condition.CompareType == EDlgCompare::ToClassVariable)
+		{
+			OtherProperty = DlgCondition::FindClassVariable(Condition.ConditionType, OtherParticipant.Get(), Condition.OtherVariableName);
+		}
+	}
+
+	// Resolved once, used to fetch the values of all the conditions of an array at once (see EvaluateBoundArray)
+	if (FDlgCondition::HasDialogueValue(Condition.ConditionType) && IsValid(Participant.Get()))
+	{
+		NativeParticipant = FDlgParticipantCalls::GetNative(Participant.Get());
+	}
+
+	// Looking up the class variables by name goes through the shared property cache
+	bThreadSafe = Condition.IsThreadSafe()
+		&& (!FDlgCondition::HasClassVariable(Condition.ConditionType) || Property != nullptr)
+		&& (Condition.CompareType != EDlgCompare::ToClassVariable || !Condition.IsSecondParticipantInvolved() || OtherProperty != nullptr);
+}
+
+bool FDlgBoundCondition::TryIsConditionMetThreadSafe(const UDlgContext& Context, bool& bOutIsMet) const
+{
+	if (!bThreadSafe)
+	{
+		return false;
+	}
+
+	// The invalid participants are logged, only from the game thread
+	const UObject* ParticipantObject = Participant.Get();
+	const UObject* OtherParticipantObject = OtherParticipant.Get();
+	if ((Condition.IsParticipantInvolved() && !IsValid(ParticipantObject))
+		|| (Condition.IsSecondParticipantInvolved() && !IsValid(OtherParticipantObject)))
+	{
+		return false;
+	}
+
+	bOutIsMet = Condition.IsConditionMet(Context, ParticipantObject, Property, OtherParticipantObject, OtherProperty);
+	return true;
+}
+
+bool FDlgCondition::EvaluateArray(const UDlgContext& Context, const TArray<FDlgCondition>& ConditionsArray, FName DefaultParticipantName)
+{
+	if (ConditionsArray.Num() == 0)
+	{
+		return true;
+	}
+
+	// Fast path, resolved when the participants were set
+	TArrayView<const FDlgBoundCondition> BoundConditions;
+	if (Context.GetBoundConditions(ConditionsArray, DefaultParticipantName, BoundConditions))
+	{
+		return EvaluateBoundArray(Context, BoundConditions);
+	}
+
+	auto GetConditionParticipant = [&Context, DefaultParticipantName](const FDlgCondition& Condition)
+	{
+		return Context.GetParticipant(Condition.ParticipantName == NAME_None ? DefaultParticipantName : Condition.ParticipantName);
+	};
+
+	DlgCondition::FPrefetchedValues PrefetchedValues;
+	PrefetchedValues.Prefetch(ConditionsArray, [&ConditionsArray, &GetConditionParticipant](int32 Index)
+	{
+		const UObject* Participant = GetConditionParticipant(ConditionsArray[Index]);
+		return IsValid(Participant) ? FDlgParticipantCalls::GetNative(Participant) : nullptr;
+	});
+
+	return DlgCondition::EvaluateStrengths(ConditionsArray, [&Context, &GetConditionParticipant, &PrefetchedValues](const FDlgCondition& Condition, int32 Index)
+	{
+		if (const FDlgParticipantValueRequest* Value = PrefetchedValues.Find(Index))
+		{
+			const UObject* OtherParticipant = Condition.IsSecondParticipantInvolved() ? Context.GetParticipant(Condition.OtherParticipantName) : nullptr;
+			return Condition.IsDialogueValueConditionMet(Context, *Value, OtherParticipant, nullptr);
+		}
+
+		return Condition.IsConditionMet(Context, GetConditionParticipant(Condition));
+	});
+}
+
+bool FDlgCondition::EvaluateBoundArray(const UDlgContext& Context, TArrayView<const FDlgBoundCondition> BoundConditionsArray)
+{
+	DlgCondition::FPrefetchedValues PrefetchedValues;
+	PrefetchedValues.Prefetch(BoundConditionsArray, [&BoundConditionsArray](int32 Index)
+	{
+		return BoundConditionsArray[Index].GetNativeParticipant();
+	});
+
+	return DlgCondition::EvaluateStrengths(BoundConditionsArray, [&Context, &PrefetchedValues](const FDlgBoundCondition& Condition, int32 Index)
+	{
+		// Already evaluated on the worker threads, see UDlgContext::EvaluateThreadSafeConditions
+		bool bIsMet = false;
+		if (Context.GetThreadSafeConditionResult(Condition, bIsMet))
+		{
+			return bIsMet;
+		}
+
+		if (const FDlgParticipantValueRequest* Value = PrefetchedValues.Find(Index))
+		{
+			return Condition.IsDialogueValueConditionMet(Context, *Value);
+		}
+
+		return Condition.IsConditionMet(Context);
+	});
+}
+
+bool FDlgCondition::IsDialogueValueConditionMet(
+	const UDlgContext& Context,
+	const FDlgParticipantValueRequest& Value,
+	const UObject* OtherParticipant,
+	const FProperty* OtherProperty
+) const
+{
+	switch (ConditionType)
+	{
+		case EDlgConditionType::BoolCall:
+			return CheckBool(Context, Value.bBoolValue, OtherParticipant, OtherProperty);
+
+		case EDlgConditionType::FloatCall:
+			return CheckFloat(Context, Value.FloatValue, OtherParticipant, OtherProperty);
+
+		case EDlgConditionType::IntCall:
+			return CheckInt(Context, Value.IntValue, OtherParticipant, OtherProperty);
+
+		case EDlgConditionType::NameCall:
+			return CheckName(Context, Value.NameValue, OtherParticipant, OtherProperty);
+
+		default:
+			checkNoEntry();
+			return false;
+	}
 }
 
 bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Participant) const
+{
+	const UObject* OtherParticipant = IsSecondParticipantInvolved() ? Context.GetParticipant(OtherParticipantName) : nullptr;
+	return IsConditionMet(Context, Participant, nullptr, OtherParticipant, nullptr);
+}
+
+bool FDlgCondition::IsConditionMet(
+	const UDlgContext& Context,
+	const UObject* Participant,
+	const FProperty* Property,
+	const UObject* OtherParticipant,
+	const FProperty* OtherProperty
+) const
 {
 	bool bHasParticipant = true;
 	if (IsParticipantInvolved())
@@ -66,32 +348,32 @@ bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Pa
 	switch (ConditionType)
 	{
 		case EDlgConditionType::EventCall:
-			return IDlgDialogueParticipant::Execute_CheckCondition(Participant, &Context, CallbackName) == bBoolValue;
+			return FDlgParticipantCalls::CheckCondition(Participant, &Context, CallbackName) == bBoolValue;
 
 		case EDlgConditionType::BoolCall:
-			return CheckBool(Context, IDlgDialogueParticipant::Execute_GetBoolValue(Participant, CallbackName));
+			return CheckBool(Context, FDlgParticipantCalls::GetBoolValue(Participant, CallbackName), OtherParticipant, OtherProperty);
 
 		case EDlgConditionType::FloatCall:
-			return CheckFloat(Context, IDlgDialogueParticipant::Execute_GetFloatValue(Participant, CallbackName));
+			return CheckFloat(Context, FDlgParticipantCalls::GetFloatValue(Participant, CallbackName), OtherParticipant, OtherProperty);
 
 		case EDlgConditionType::IntCall:
-			return CheckInt(Context, IDlgDialogueParticipant::Execute_GetIntValue(Participant, CallbackName));
+			return CheckInt(Context, FDlgParticipantCalls::GetIntValue(Participant, CallbackName), OtherParticipant, OtherProperty);
 
 		case EDlgConditionType::NameCall:
-			return CheckName(Context, IDlgDialogueParticipant::Execute_GetNameValue(Participant, CallbackName));
+			return CheckName(Context, FDlgParticipantCalls::GetNameValue(Participant, CallbackName), OtherParticipant, OtherProperty);
 
 
 		case EDlgConditionType::ClassBoolVariable:
-			return CheckBool(Context, FNYReflectionHelper::GetVariable<FBoolProperty, bool>(Participant, CallbackName));
+			return CheckBool(Context, DlgCondition::GetClassVariable<FBoolProperty, bool>(Participant, Property, CallbackName), OtherParticipant, OtherProperty);
 
 		case EDlgConditionType::ClassFloatVariable:
-			return CheckFloat(Context, FNYReflectionHelper::GetVariable<FFloatProperty, float>(Participant, CallbackName));
+			return CheckFloat(Context, DlgCondition::GetClassVariable<FFloatProperty, float>(Participant, Property, CallbackName), OtherParticipant, OtherProperty);
 
 		case EDlgConditionType::ClassIntVariable:
-			return CheckInt(Context, FNYReflectionHelper::GetVariable<FIntProperty, int32>(Participant, CallbackName));
+			return CheckInt(Context, DlgCondition::GetClassVariable<FIntProperty, int32>(Participant, Property, CallbackName), OtherParticipant, OtherProperty);
 
 		case EDlgConditionType::ClassNameVariable:
-			return CheckName(Context, FNYReflectionHelper::GetVariable<FNameProperty, FName>(Participant, CallbackName));
+			return CheckName(Context, DlgCondition::GetClassVariable<FNameProperty, FName>(Participant, Property, CallbackName), OtherParticipant, OtherProperty);
 
 
 		case EDlgConditionType::WasNodeVisited:
@@ -101,7 +383,13 @@ bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Pa
 			{
 				// Use the GUID if it is valid as it is more reliable
 				const UDlgNode* Node = GUID.IsValid() ? Context.GetNodeFromGUID(GUID) : Context.GetNodeFromIndex(IntValue);
-				return Node != nullptr ? Node->HasAnySatisfiedChild(Context, {}) == bBoolValue : false;
+				if (Node == nullptr)
+				{
+					return false;
+				}
+
+				FDlgTraversalState AlreadyVisitedNodes;
+				return Node->HasAnySatisfiedChild(Context, AlreadyVisitedNodes) == bBoolValue;
 			}
 
 		default:
@@ -110,12 +398,11 @@ bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Pa
 	}
 }
 
-bool FDlgCondition::CheckFloat(const UDlgContext& Context, float Value) const
+bool FDlgCondition::CheckFloat(const UDlgContext& Context, float Value, const UObject* OtherParticipant, const FProperty* OtherProperty) const
 {
 	float ValueToCheckAgainst = FloatValue;
 	if (CompareType == EDlgCompare::ToVariable || CompareType == EDlgCompare::ToClassVariable)
 	{
-		const UObject* OtherParticipant = Context.GetParticipant(OtherParticipantName);
 		if (!ValidateIsParticipantValid(Context, TEXT("CheckFloat"), OtherParticipant))
 		{
 			return false;
@@ -123,11 +410,11 @@ bool FDlgCondition::CheckFloat(const UDlgContext& Context, float Value) const
 
 		if (CompareType == EDlgCompare::ToVariable)
 		{
-			ValueToCheckAgainst = IDlgDialogueParticipant::Execute_GetFloatValue(OtherParticipant, OtherVariableName);
+			ValueToCheckAgainst = FDlgParticipantCalls::GetFloatValue(OtherParticipant, OtherVariableName);
 		}
 		else
 		{
-			ValueToCheckAgainst = FNYReflectionHelper::GetVariable<FFloatProperty, float>(OtherParticipant, OtherVariableName);
+			ValueToCheckAgainst = DlgCondition::GetClassVariable<FFloatProperty, float>(OtherParticipant, OtherProperty, OtherVariableName);
 		}
 	}
 
@@ -160,12 +447,11 @@ bool FDlgCondition::CheckFloat(const UDlgContext& Context, float Value) const
 	}
 }
 
-bool FDlgCondition::CheckInt(const UDlgContext& Context, int32 Value) const
+bool FDlgCondition::CheckInt(const UDlgContext& Context, int32 Value, const UObject* OtherParticipant, const FProperty* OtherProperty) const
 {
 	int32 ValueToCheckAgainst = IntValue;
 	if (CompareType == EDlgCompare::ToVariable || CompareType == EDlgCompare::ToClassVariable)
 	{
-		const UObject* OtherParticipant = Context.GetParticipant(OtherParticipantName);
 		if (!ValidateIsParticipantValid(Context, TEXT("CheckInt"), OtherParticipant))
 		{
 			return false;
@@ -173,11 +459,11 @@ bool FDlgCondition::CheckInt(const UDlgContext& Context, int32 Value) const
 
 		if (CompareType == EDlgCompare::ToVariable)
 		{
-			ValueToCheckAgainst = IDlgDialogueParticipant::Execute_GetIntValue(OtherParticipant, OtherVariableName);
+			ValueToCheckAgainst = FDlgParticipantCalls::GetIntValue(OtherParticipant, OtherVariableName);
 		}
 		else
 		{
-			ValueToCheckAgainst = FNYReflectionHelper::GetVariable<FIntProperty, int32>(OtherParticipant, OtherVariableName);
+			ValueToCheckAgainst = DlgCondition::GetClassVariable<FIntProperty, int32>(OtherParticipant, OtherProperty, OtherVariableName);
 		}
 	}
 
@@ -210,12 +496,11 @@ bool FDlgCondition::CheckInt(const UDlgContext& Context, int32 Value) const
 	}
 }
 
-bool FDlgCondition::CheckBool(const UDlgContext& Context, bool bValue) const
+bool FDlgCondition::CheckBool(const UDlgContext& Context, bool bValue, const UObject* OtherParticipant, const FProperty* OtherProperty) const
 {
 	bool bResult = bValue;
 	if (CompareType == EDlgCompare::ToVariable || CompareType == EDlgCompare::ToClassVariable)
 	{
-		const UObject* OtherParticipant = Context.GetParticipant(OtherParticipantName);
 		if (!ValidateIsParticipantValid(Context, TEXT("CheckBool"), OtherParticipant))
 		{
 			return false;
@@ -224,11 +509,11 @@ bool FDlgCondition::CheckBool(const UDlgContext& Context, bool bValue) const
 		bool bValueToCheckAgainst;
 		if (CompareType == EDlgCompare::ToVariable)
 		{
-			bValueToCheckAgainst = IDlgDialogueParticipant::Execute_GetBoolValue(OtherParticipant, OtherVariableName);
+			bValueToCheckAgainst = FDlgParticipantCalls::GetBoolValue(OtherParticipant, OtherVariableName);
 		}
 		else
 		{
-			bValueToCheckAgainst = FNYReflectionHelper::GetVariable<FBoolProperty, bool>(OtherParticipant, OtherVariableName);
+			bValueToCheckAgainst = DlgCondition::GetClassVariable<FBoolProperty, bool>(OtherParticipant, OtherProperty, OtherVariableName);
 		}
 
 		// Check if value matches other variable
@@ -238,12 +523,11 @@ bool FDlgCondition::CheckBool(const UDlgContext& Context, bool bValue) const
 	return bResult == bBoolValue;
 }
 
-bool FDlgCondition::CheckName(const UDlgContext& Context, FName Value) const
+bool FDlgCondition::CheckName(const UDlgContext& Context, FName Value, const UObject* OtherParticipant, const FProperty* OtherProperty) const
 {
 	FName ValueToCheckAgainst = NameValue;
 	if (CompareType == EDlgCompare::ToVariable || CompareType == EDlgCompare::ToClassVariable)
 	{
-		const UObject* OtherParticipant = Context.GetParticipant(OtherParticipantName);
 		if (!ValidateIsParticipantValid(Context, TEXT("CheckName"), OtherParticipant))
 		{
 			return false;
@@ -251,11 +535,11 @@ bool FDlgCondition::CheckName(const UDlgContext& Context, FName Value) const
 
 		if (CompareType == EDlgCompare::ToVariable)
 		{
-			ValueToCheckAgainst = IDlgDialogueParticipant::Execute_GetNameValue(OtherParticipant, OtherVariableName);
+			ValueToCheckAgainst = FDlgParticipantCalls::GetNameValue(OtherParticipant, OtherVariableName);
 		}
 		else
 		{
-			ValueToCheckAgainst = FNYReflectionHelper::GetVariable<FNameProperty, FName>(OtherParticipant, OtherVariableName);
+			ValueToCheckAgainst = DlgCondition::GetClassVariable<FNameProperty, FName>(OtherParticipant, OtherProperty, OtherVariableName);
 		}
 	}
 
@@ -283,6 +567,26 @@ bool FDlgCondition::IsParticipantInvolved() const
 		&& ConditionType != EDlgConditionType::WasNodeVisited;
 }
 
+bool FDlgCondition::IsThreadSafe() const
+{
+	switch (ConditionType)
+	{
+		case EDlgConditionType::ClassBoolVariable:
+		case EDlgConditionType::ClassFloatVariable:
+		case EDlgConditionType::ClassIntVariable:
+		case EDlgConditionType::ClassNameVariable:
+			// EDlgCompare::ToVariable calls the other participant
+			return CompareType != EDlgCompare::ToVariable;
+
+		case EDlgConditionType::WasNodeVisited:
+			// The global memory caches its lookups, only the history of the context is read only
+			return !bLongTermMemory;
+
+		default:
+			return false;
+	}
+}
+
 bool FDlgCondition::IsSecondParticipantInvolved() const
 {
 	// Second participant requires first participant
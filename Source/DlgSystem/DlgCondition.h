@@ -2,14 +2,20 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+#include "UObject/WeakObjectPtrTemplates.h"
 #include "DlgConditionCustom.h"
+#include "NYEngineVersionHelpers.h"
 
 
 #include "DlgCondition.generated.h"
 
 class IDlgDialogueParticipant;
+class IDlgNativeDialogueParticipant;
 class UDlgContext;
 class UDlgDialogue;
+struct FDlgBoundCondition;
+struct FDlgParticipantValueRequest;
 
 // Defines the way the condition is interpreted inside a condition array
 UENUM(BlueprintType)
@@ -132,11 +138,40 @@ public:
 	// Own methods
 	//
 
+	EDlgConditionStrength GetStrength() const { return Strength; }
+
+	// Uses the conditions bound by the Context if there are any (see UDlgContext::BindConditions), otherwise looks everything up by name
 	static bool EvaluateArray(const UDlgContext& Context, const TArray<FDlgCondition>& ConditionsArray, FName DefaultParticipantName = NAME_None);
+
+	// Same as EvaluateArray for conditions already bound by the Context
+	static bool EvaluateBoundArray(const UDlgContext& Context, TArrayView<const FDlgBoundCondition> BoundConditionsArray);
 	bool IsConditionMet(const UDlgContext& Context, const UObject* Participant) const;
 
+	// Same as above but the other participant and the class variables are already resolved.
+	// Property/OtherProperty can be nullptr, in that case they are looked up by name.
+	bool IsConditionMet(
+		const UDlgContext& Context,
+		const UObject* Participant,
+		const FProperty* Property,
+		const UObject* OtherParticipant,
+		const FProperty* OtherProperty
+	) const;
+
+	// Same as above for the HasDialogueValue condition types, with the Value of the participant already fetched
+	// (see IDlgNativeDialogueParticipant::GetValuesNative)
+	bool IsDialogueValueConditionMet(
+		const UDlgContext& Context,
+		const FDlgParticipantValueRequest& Value,
+		const UObject* OtherParticipant,
+		const FProperty* OtherProperty
+	) const;
+
 	// returns true if ParticipantName has to belong to match with a valid Participant in order for the condition type to work */
 	bool IsParticipantInvolved() const;
+
+	// Can this condition be evaluated outside of the game thread? (see UDlgSystemSettings::bParallelConditionsEvaluation)
+	// Only if it reads class variables or the history of the context, without calling the participants
+	bool IsThreadSafe() const;
 	bool IsSecondParticipantInvolved() const;
 
 	// Does this Condition have a IntValue which is in fact a NodeIndex
@@ -209,10 +244,10 @@ protected:
 	// Helper functions doing the check on the primary value based on EDlgCompare
 	//
 
-	bool CheckFloat(const UDlgContext& Context, float Value) const;
-	bool CheckInt(const UDlgContext& Context, int32 Value) const;
-	bool CheckBool(const UDlgContext& Context, bool bValue) const;
-	bool CheckName(const UDlgContext& Context, FName Value) const;
+	bool CheckFloat(const UDlgContext& Context, float Value, const UObject* OtherParticipant, const FProperty* OtherProperty) const;
+	bool CheckInt(const UDlgContext& Context, int32 Value, const UObject* OtherParticipant, const FProperty* OtherProperty) const;
+	bool CheckBool(const UDlgContext& Context, bool bValue, const UObject* OtherParticipant, const FProperty* OtherProperty) const;
+	bool CheckName(const UDlgContext& Context, FName Value, const UObject* OtherParticipant, const FProperty* OtherProperty) const;
 
 	// Checks Participant, prints warning if it is nullptr
 	bool ValidateIsParticipantValid(const UDlgContext& Context, const FString& ContextString, const UObject* Participant) const;
@@ -292,3 +327,52 @@ struct TStructOpsTypeTraits<FDlgCondition> : public TStructOpsTypeTraitsBase2<FD
 		WithIdenticalViaEquality = true
 	};
 };
+
+
+// A condition bound to the participants of a context, created by UDlgContext::BindConditions.
+// The participant, the other participant and the class variables are resolved once, evaluating it does not look up anything by name.
+struct DLGSYSTEM_API FDlgBoundCondition
+{
+public:
+	FDlgBoundCondition() {}
+	FDlgBoundCondition(const UDlgContext& Context, const FDlgCondition& InCondition, FName DefaultParticipantName);
+
+	bool IsConditionMet(const UDlgContext& Context) const
+	{
+		return Condition.IsConditionMet(Context, Participant.Get(), Property, OtherParticipant.Get(), OtherProperty);
+	}
+
+	bool IsDialogueValueConditionMet(const UDlgContext& Context, const FDlgParticipantValueRequest& Value) const
+	{
+		return Condition.IsDialogueValueConditionMet(Context, Value, OtherParticipant.Get(), OtherProperty);
+	}
+
+	EDlgConditionStrength GetStrength() const { return Condition.Strength; }
+	const FDlgCondition& GetCondition() const { return Condition; }
+
+	// Only for the FDlgCondition::HasDialogueValue types, nullptr if the participant does not implement IDlgNativeDialogueParticipant
+	const IDlgNativeDialogueParticipant* GetNativeParticipant() const { return Participant.IsValid() ? NativeParticipant : nullptr; }
+
+	// See FDlgCondition::IsThreadSafe, the class variables must be resolved as well
+	bool IsThreadSafe() const { return bThreadSafe; }
+
+	// Evaluates a thread safe condition from any thread
+	// @return false if it must be evaluated on the game thread (not thread safe or the participant is gone, which is logged)
+	bool TryIsConditionMetThreadSafe(const UDlgContext& Context, bool& bOutIsMet) const;
+
+protected:
+	// Copy of the original condition
+	FDlgCondition Condition;
+
+	TWeakObjectPtr<const UObject> Participant;
+	TWeakObjectPtr<const UObject> OtherParticipant;
+
+	// Only for the Class*Variable condition types and for EDlgCompare::ToClassVariable
+	const FProperty* Property = nullptr;
+	const FProperty* OtherProperty = nullptr;
+
+	// Interface of the Participant, see GetNativeParticipant
+	const IDlgNativeDialogueParticipant* NativeParticipant = nullptr;
+
+	bool bThreadSafe = false;
+};
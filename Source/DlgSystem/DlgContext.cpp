@@ -2,16 +2,21 @@
 #include "DlgContext.h"
 
 #include "Net/UnrealNetwork.h"
+#include "Async/ParallelFor.h"
 #include "Engine/Texture2D.h"
 #include "Engine/Blueprint.h"
 
 #include "DlgConstants.h"
 #include "Nodes/DlgNode.h"
 #include "Nodes/DlgNode_End.h"
+#include "Nodes/DlgNode_Proxy.h"
 #include "Nodes/DlgNode_SpeechSequence.h"
 #include "DlgDialogueParticipant.h"
 #include "DlgMemory.h"
+#include "DlgManager.h"
+#include "DlgSystemSettings.h"
 #include "Logging/DlgLogger.h"
+#include "NYReflectionHelper.h"
 
 
 UDlgContext::UDlgContext(const FObjectInitializer& ObjectInitializer)
@@ -20,193 +25,900 @@ UDlgContext::UDlgContext(const FObjectInitializer& ObjectInitializer)
 	//UObject.bReplicates = true;
 }
 
+void UDlgContext::BeginDestroy()
+{
+	UnbindParticipantVariableChanged();
+	Super::BeginDestroy();
+}
+
 void UDlgContext::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(ThisClass, Dialogue);
-	DOREPLIFETIME(ThisClass, SerializedParticipants);
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(ThisClass, Dialogue);
+	DOREPLIFETIME(ThisClass, SerializedParticipants);
+}
+
+void UDlgContext::SerializeParticipants()
+{
+	SerializedParticipants.Empty(Participants.Num());
+	for (const auto& KeyValue : Participants)
+	{
+		SerializedParticipants.Add(KeyValue.Value);
+	}
+}
+
+void UDlgContext::OnRep_SerializedParticipants()
+{
+	Participants.Empty(SerializedParticipants.Num());
+	for (UObject* Participant : SerializedParticipants)
+	{
+		if (IsValid(Participant))
+		{
+			Participants.Add(IDlgDialogueParticipant::Execute_GetParticipantName(Participant), Participant);
+		}
+	}
+	BindConditions();
+}
+
+void UDlgContext::BindConditions()
+{
+	BoundConditions.Reset();
+	BoundConditionsRanges.Reset();
+	BoundConditionsDialogue = Dialogue;
+	BoundConditionsPropertyCacheGeneration = FNYReflectionHelper::GetPropertyCacheGeneration();
+	bConditionsBoundToBakedDialogue = false;
+	BoundConditionsBakedGeneration = INDEX_NONE;
+	ClearThreadSafeConditionResults();
+	ResetIncrementalOptions(INDEX_NONE);
+	if (!Dialogue)
+	{
+		return;
+	}
+
+	auto BindNode = [this](const UDlgNode* Node)
+	{
+		if (!Node)
+		{
+			return;
+		}
+
+		BindConditionsArray(Node->GetNodeEnterConditions(), Node->GetEnterConditionsParticipantName());
+		for (const FDlgEdge& Edge : Node->GetNodeChildren())
+		{
+			BindConditionsArray(Edge.Conditions, NAME_None);
+		}
+	};
+
+	BoundConditionsBakedGeneration = Dialogue->GetBakedDialogue().GetGeneration();
+	if (Dialogue->HasValidBakedDialogue() && BindBakedConditions())
+	{
+		bConditionsBoundToBakedDialogue = true;
+	}
+	else
+	{
+		// Baked data is out of date (nodes edited without a rebuild), bind from the nodes
+		BoundConditions.Reset();
+		BoundConditionsRanges.Reset();
+		for (const UDlgNode* Node : Dialogue->GetNodes())
+		{
+			BindNode(Node);
+		}
+	}
+
+	for (const UDlgNode* Node : Dialogue->GetStartNodes())
+	{
+		BindNode(Node);
+	}
+}
+
+bool UDlgContext::BindBakedConditions()
+{
+	// Compared once per bake, not by every context
+	if (!Dialogue->ValidateBakedConditions())
+	{
+		return false;
+	}
+
+	// Bind the condition pool as it is, the nodes arrays point inside it
+	const FDlgBakedDialogue& Baked = Dialogue->GetBakedDialogue();
+	BoundConditions.Reserve(Baked.Conditions.Num());
+	for (const FDlgCondition& Condition : Baked.Conditions)
+	{
+		BoundConditions.Emplace(*this, Condition, NAME_None);
+	}
+
+	const TArray<UDlgNode*>& Nodes = Dialogue->GetNodes();
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		const UDlgNode* Node = Nodes[NodeIndex];
+		if (!Node)
+		{
+			continue;
+		}
+
+		const FDlgBakedConditionsRange& EnterConditions = Baked.NodeEnterConditions[NodeIndex];
+		AddBoundConditionsRange(Node->GetNodeEnterConditions(), Node->GetEnterConditionsParticipantName(), EnterConditions.StartIndex, EnterConditions.Num);
+
+		const TArray<FDlgEdge>& Children = Node->GetNodeChildren();
+		const int32 FirstEdgeIndex = Baked.NodeDescriptors[NodeIndex].FirstEdgeIndex;
+		for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); EdgeIndex++)
+		{
+			const FDlgBakedConditionsRange& EdgeConditions = Baked.Edges[FirstEdgeIndex + EdgeIndex].Conditions;
+			AddBoundConditionsRange(Children[EdgeIndex].Conditions, NAME_None, EdgeConditions.StartIndex, EdgeConditions.Num);
+		}
+	}
+
+	return true;
+}
+
+void UDlgContext::BindConditionsArray(const TArray<FDlgCondition>& Conditions, FName DefaultParticipantName)
+{
+	if (Conditions.Num() == 0)
+	{
+		return;
+	}
+
+	AddBoundConditionsRange(Conditions, DefaultParticipantName, BoundConditions.Num(), Conditions.Num());
+	for (const FDlgCondition& Condition : Conditions)
+	{
+		BoundConditions.Emplace(*this, Condition, DefaultParticipantName);
+	}
+}
+
+void UDlgContext::AddBoundConditionsRange(const TArray<FDlgCondition>& Conditions, FName DefaultParticipantName, int32 StartIndex, int32 Num)
+{
+	if (Num == 0)
+	{
+		return;
+	}
+
+	FDlgBoundConditionsRange Range;
+	Range.StartIndex = StartIndex;
+	Range.Num = Num;
+	Range.SourceData = Conditions.GetData();
+	Range.DefaultParticipantName = DefaultParticipantName;
+	BoundConditionsRanges.Add(&Conditions, Range);
+}
+
+bool UDlgContext::AreConditionsBound() const
+{
+	return BoundConditionsDialogue == Dialogue
+		&& BoundConditionsPropertyCacheGeneration == FNYReflectionHelper::GetPropertyCacheGeneration()
+		&& (!Dialogue || BoundConditionsBakedGeneration == Dialogue->GetBakedDialogue().GetGeneration());
+}
+
+bool UDlgContext::GetBoundConditions(
+	const TArray<FDlgCondition>& Conditions,
+	FName DefaultParticipantName,
+	TArrayView<const FDlgBoundCondition>& OutBoundConditions
+) const
+{
+	if (!AreConditionsBound())
+	{
+		return false;
+	}
+
+	const FDlgBoundConditionsRange* Range = BoundConditionsRanges.Find(&Conditions);
+	if (!Range
+		|| Range->SourceData != Conditions.GetData()
+		|| Range->Num != Conditions.Num()
+		|| Range->DefaultParticipantName != DefaultParticipantName)
+	{
+		return false;
+	}
+
+	OutBoundConditions = TArrayView<const FDlgBoundCondition>(BoundConditions.GetData() + Range->StartIndex, Range->Num);
+	return true;
+}
+
+bool UDlgContext::EvaluateThreadSafeConditions(int32 NodeIndex, const TArray<FDlgEdge>& Edges)
+{
+	ClearThreadSafeConditionResults();
+	const UDlgSystemSettings* Settings = GetDefault<UDlgSystemSettings>();
+	if (!Settings->bParallelConditionsEvaluation
+		|| Edges.Num() < Settings->ParallelConditionsMinEdges
+		|| !AreConditionsBound()
+		|| !IsInGameThread())
+	{
+		return false;
+	}
+
+	ThreadSafeConditionResults.Init(INDEX_NONE, BoundConditions.Num());
+	ThreadSafeConditionIndices.Reset();
+	auto GatherRange = [this](int32 StartIndex, int32 Num)
+	{
+		for (int32 Index = StartIndex; Index < StartIndex + Num; Index++)
+		{
+			// Marked as gathered, the target nodes can be shared between the edges
+			if (ThreadSafeConditionResults[Index] == INDEX_NONE && BoundConditions[Index].IsThreadSafe())
+			{
+				ThreadSafeConditionResults[Index] = 0;
+				ThreadSafeConditionIndices.Add(Index);
+			}
+		}
+	};
+	auto GatherConditions = [this, &GatherRange](const TArray<FDlgCondition>& Conditions, FName DefaultParticipantName)
+	{
+		TArrayView<const FDlgBoundCondition> View;
+		if (Conditions.Num() > 0 && GetBoundConditions(Conditions, DefaultParticipantName, View))
+		{
+			GatherRange(static_cast<int32>(View.GetData() - BoundConditions.GetData()), View.Num());
+		}
+	};
+
+	// Same conditions as IsEdgeSatisfied, without the ones of the nodes further away
+	const FDlgBakedDialogue* Baked = CanUseBakedDialogue() ? &Dialogue->GetBakedDialogue() : nullptr;
+	if (Baked && Baked->IsValidNodeIndex(NodeIndex) && Baked->NodeDescriptors[NodeIndex].NumEdges == Edges.Num())
+	{
+		const int32 FirstEdgeIndex = Baked->NodeDescriptors[NodeIndex].FirstEdgeIndex;
+		for (int32 EdgeIndex = 0; EdgeIndex < Edges.Num(); EdgeIndex++)
+		{
+			const FDlgBakedEdge& Edge = Baked->Edges[FirstEdgeIndex + EdgeIndex];
+			GatherRange(Edge.Conditions.StartIndex, Edge.Conditions.Num);
+			if (Baked->IsValidNodeIndex(Edge.TargetIndex))
+			{
+				GatherRange(Baked->NodeEnterConditions[Edge.TargetIndex].StartIndex, Baked->NodeEnterConditions[Edge.TargetIndex].Num);
+			}
+		}
+	}
+	else
+	{
+		for (const FDlgEdge& Edge : Edges)
+		{
+			GatherConditions(Edge.Conditions, NAME_None);
+			if (const UDlgNode* TargetNode = GetNodeFromIndex(Edge.TargetIndex))
+			{
+				GatherConditions(TargetNode->GetNodeEnterConditions(), TargetNode->GetEnterConditionsParticipantName());
+			}
+		}
+	}
+
+	if (ThreadSafeConditionIndices.Num() == 0)
+	{
+		ClearThreadSafeConditionResults();
+		return false;
+	}
+
+	// A single condition is too cheap to be worth a task
+	static constexpr int32 BatchSize = 16;
+	const int32 NumBatches = FMath::DivideAndRoundUp(ThreadSafeConditionIndices.Num(), BatchSize);
+	ParallelFor(NumBatches, [this](int32 BatchIndex)
+	{
+		const int32 EndIndex = FMath::Min((BatchIndex + 1) * BatchSize, ThreadSafeConditionIndices.Num());
+		for (int32 Index = BatchIndex * BatchSize; Index < EndIndex; Index++)
+		{
+			const int32 ConditionIndex = ThreadSafeConditionIndices[Index];
+			bool bIsMet = false;
+			ThreadSafeConditionResults[ConditionIndex] = BoundConditions[ConditionIndex].TryIsConditionMetThreadSafe(*this, bIsMet)
+				? (bIsMet ? 1 : 0)
+				: INDEX_NONE;
+		}
+	});
+
+	return true;
+}
+
+bool UDlgContext::GetThreadSafeConditionResult(const FDlgBoundCondition& Condition, bool& bOutIsMet) const
+{
+	if (ThreadSafeConditionResults.Num() == 0)
+	{
+		return false;
+	}
+
+	const int32 Index = static_cast<int32>(&Condition - BoundConditions.GetData());
+	if (!ThreadSafeConditionResults.IsValidIndex(Index) || ThreadSafeConditionResults[Index] == INDEX_NONE)
+	{
+		return false;
+	}
+
+	bOutIsMet = ThreadSafeConditionResults[Index] != 0;
+	return true;
+}
+
+void UDlgContext::SetIncrementalReevaluation(bool bEnabled)
+{
+	if (bIncrementalReevaluation == bEnabled)
+	{
+		return;
+	}
+
+	bIncrementalReevaluation = bEnabled;
+	ResetIncrementalOptions(INDEX_NONE);
+
+	// Stays bound when disabled, the formatted texts might need it, see ResetForReuse
+	if (bEnabled)
+	{
+		BindParticipantVariableChanged();
+	}
+}
+
+void UDlgContext::BindParticipantVariableChanged()
+{
+	if (!OnParticipantVariableChangedHandle.IsValid())
+	{
+		OnParticipantVariableChangedHandle = UDlgManager::OnParticipantVariableChanged.AddUObject(this, &ThisClass::HandleParticipantVariableChanged);
+	}
+}
+
+void UDlgContext::UnbindParticipantVariableChanged()
+{
+	if (OnParticipantVariableChangedHandle.IsValid())
+	{
+		UDlgManager::OnParticipantVariableChanged.Remove(OnParticipantVariableChangedHandle);
+		OnParticipantVariableChangedHandle.Reset();
+	}
+}
+
+void UDlgContext::MarkParticipantVariableDirty(FName ParticipantName, FName VariableName)
+{
+	if (FormattedTextsDependencies.Contains(FDlgConditionDependency(ParticipantName, VariableName)))
+	{
+		InvalidateFormattedTexts();
+	}
+
+	if (!bIncrementalReevaluation)
+	{
+		return;
+	}
+
+	// Not read by any condition of the Dialogue, nothing to reevaluate
+	if (Dialogue)
+	{
+		const FDlgParticipantData* ParticipantData = Dialogue->GetParticipantsData().Find(ParticipantName);
+		if (ParticipantData && !ParticipantData->IsReadByConditions(VariableName))
+		{
+			return;
+		}
+	}
+
+	DirtyDependencies.Add(FDlgConditionDependency(ParticipantName, VariableName));
+}
+
+void UDlgContext::HandleParticipantVariableChanged(const UObject* Participant, FName VariableName)
+{
+	for (const auto& KeyValue : Participants)
+	{
+		if (KeyValue.Value == Participant)
+		{
+			MarkParticipantVariableDirty(KeyValue.Key, VariableName);
+		}
+	}
+}
+
+void UDlgContext::ResetIncrementalOptions(int32 NodeIndex)
+{
+	IncrementalOptionsNodeIndex = NodeIndex;
+	IncrementalOptions.Reset();
+	DirtyDependencies.Reset();
+	bAllOptionsDirty = NodeIndex == INDEX_NONE;
+}
+
+void UDlgContext::AddIncrementalOption(const FDlgEdge& Edge, bool bSatisfied)
+{
+	FDlgIncrementalOption& Option = IncrementalOptions.AddDefaulted_GetRef();
+	Option.bSatisfied = bSatisfied;
+
+	FDlgTraversalState AlreadyVisitedNodes(IncrementalOptionsNodeIndex);
+	GatherEdgeDependencies(Edge, Option, AlreadyVisitedNodes);
+}
+
+void UDlgContext::GatherEdgeDependencies(const FDlgEdge& Edge, FDlgIncrementalOption& Option, FDlgTraversalState& AlreadyVisitedNodes) const
+{
+	GatherConditionsDependencies(Edge.Conditions, NAME_None, Option);
+
+	// Same traversal as IsNodeEnterable, a node already visited is considered enterable
+	const UDlgNode* Node = GetNodeFromIndex(Edge.TargetIndex);
+	if (!Node || AlreadyVisitedNodes.Contains(Edge.TargetIndex))
+	{
+		return;
+	}
+	AlreadyVisitedNodes.Add(Edge.TargetIndex);
+
+	GatherConditionsDependencies(Node->GetNodeEnterConditions(), Node->GetEnterConditionsParticipantName(), Option);
+	if (Node->GetEnterRestriction() != EDlgEntryRestriction::None)
+	{
+		Option.bVolatile = true;
+	}
+
+	if (const UDlgNode_Proxy* Proxy = Cast<UDlgNode_Proxy>(Node))
+	{
+		GatherEdgeDependencies(FDlgEdge(Proxy->GetTargetNodeIndex()), Option, AlreadyVisitedNodes);
+	}
+	if (Node->GetCheckChildrenOnEvaluation())
+	{
+		for (const FDlgEdge& ChildEdge : Node->GetNodeChildren())
+		{
+			GatherEdgeDependencies(ChildEdge, Option, AlreadyVisitedNodes);
+		}
+	}
+}
+
+void UDlgContext::GatherConditionsDependencies(
+	const TArray<FDlgCondition>& Conditions,
+	FName DefaultParticipantName,
+	FDlgIncrementalOption& Option
+) const
+{
+	for (const FDlgCondition& Condition : Conditions)
+	{
+		switch (Condition.ConditionType)
+		{
+			case EDlgConditionType::WasNodeVisited:
+			case EDlgConditionType::HasSatisfiedChild:
+			case EDlgConditionType::Custom:
+				Option.bVolatile = true;
+				break;
+
+			default:
+			{
+				const FName ParticipantName = Condition.ParticipantName == NAME_None ? DefaultParticipantName : Condition.ParticipantName;
+				Option.Dependencies.AddUnique(FDlgConditionDependency(ParticipantName, Condition.CallbackName));
+				if (Condition.IsSecondParticipantInvolved())
+				{
+					Option.Dependencies.AddUnique(FDlgConditionDependency(Condition.OtherParticipantName, Condition.OtherVariableName));
+				}
+				break;
+			}
+		}
+	}
+}
+
+bool UDlgContext::IsAnyDependencyDirty(const FDlgIncrementalOption& Option) const
+{
+	for (const FDlgConditionDependency& Dependency : Option.Dependencies)
+	{
+		if (DirtyDependencies.Contains(Dependency))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UDlgContext::ReevaluateOptionsIncremental()
+{
+	if (bAllOptionsDirty || IncrementalOptionsNodeIndex == INDEX_NONE || IncrementalOptionsNodeIndex != ActiveNodeIndex)
+	{
+		return false;
+	}
+
+	const UDlgNode* Node = GetActiveNode();
+	if (!IsValid(Node))
+	{
+		return false;
+	}
+
+	const TArray<FDlgEdge>& Children = Node->GetNodeChildren();
+	if (Children.Num() != IncrementalOptions.Num())
+	{
+		return false;
+	}
+
+	bool bChanged = false;
+	FDlgTraversalState AlreadyVisitedNodes(ActiveNodeIndex);
+	for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); EdgeIndex++)
+	{
+		FDlgIncrementalOption& Option = IncrementalOptions[EdgeIndex];
+		if (!Option.bVolatile && !IsAnyDependencyDirty(Option))
+		{
+			continue;
+		}
+
+		const bool bSatisfied = IsEdgeSatisfied(ActiveNodeIndex, EdgeIndex, Children[EdgeIndex], AlreadyVisitedNodes);
+		bChanged |= bSatisfied != Option.bSatisfied;
+		Option.bSatisfied = bSatisfied;
+	}
+	DirtyDependencies.Reset();
+
+	// Same as UDlgNode::ReevaluateChildren, in place
+	if (bChanged)
+	{
+		ResetOptions();
+		for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); EdgeIndex++)
+		{
+			AddOption(ActiveNodeIndex, EdgeIndex, Children[EdgeIndex], IncrementalOptions[EdgeIndex].bSatisfied);
+		}
+	}
+
+	// No option left, let the node handle it
+	return AvailableOptionRecords.Num() > 0;
+}
+
+bool UDlgContext::ChooseOption(int32 OptionIndex)
+{
+	check(Dialogue);
+	if (UDlgNode* Node = GetMutableActiveNode())
+	{
+		if (Node->OptionSelected(OptionIndex, false, *this))
+		{
+			return true;
+		}
+	}
+
+	bDialogueEnded = true;
+	return false;
+}
+
+bool UDlgContext::ChooseSpeechSequenceOptionFromReplicated(int32 OptionIndex)
+{
+	check(Dialogue);
+	if (UDlgNode_SpeechSequence* Node = GetMutableActiveNodeAsSpeechSequence())
+	{
+		if (Node->OptionSelectedFromReplicated(OptionIndex, false, *this))
+		{
+			return true;
+		}
+	}
+
+	bDialogueEnded = true;
+	return false;
+}
+
+bool UDlgContext::ChooseOptionFromAll(int32 Index)
+{
+	if (!OptionRecords.IsValidIndex(Index))
+	{
+		LogErrorWithContext(FString::Printf(TEXT("ChooseOptionFromAll - INVALID given Index = %d"), Index));
+		bDialogueEnded = true;
+		return false;
+	}
+
+	if (UDlgNode* Node = GetMutableActiveNode())
+	{
+		if (Node->OptionSelected(Index, true, *this))
+		{
+			return true;
+		}
+	}
+
+	bDialogueEnded = true;
+	return false;
+}
+
+bool UDlgContext::ReevaluateOptions()
+{
+	check(Dialogue);
+	if (!AreConditionsBound())
+	{
+		BindConditions();
+	}
+	if (bIncrementalReevaluation && ReevaluateOptionsIncremental())
+	{
+		return true;
+	}
+
+	UDlgNode* Node = GetMutableActiveNode();
+	if (!IsValid(Node))
+	{
+		LogErrorWithContext(TEXT("ReevaluateOptions - Failed to update dialogue options"));
+		return false;
+	}
+
+	DirtyDependencies.Reset();
+	bAllOptionsDirty = false;
+	FDlgTraversalState AlreadyEvaluated;
+	return Node->ReevaluateChildren(*this, AlreadyEvaluated);
+}
+
+void UDlgContext::ResetOptions()
+{
+	// Keep the memory around, this is called every frame by some users
+	OptionRecords.Reset();
+	AvailableOptionRecords.Reset();
+	ResetOptionCopies();
+}
+
+void UDlgContext::AddOption(int32 NodeIndex, int32 EdgeIndex, const FDlgEdge& Edge, bool bSatisfied, bool bInnerEdge)
+{
+	if (!bSatisfied && !Edge.bIncludeInAllOptionListIfUnsatisfied)
+	{
+		return;
+	}
+
+	FDlgOptionRecord& Record = OptionRecords.AddDefaulted_GetRef();
+	Record.NodeIndex = NodeIndex;
+	Record.EdgeIndex = EdgeIndex;
+	Record.TargetIndex = Edge.TargetIndex;
+	Record.bInnerEdge = bInnerEdge;
+	Record.bSatisfied = bSatisfied;
+
+	// Formatted on first access, the cached text is kept between reevaluations of the same node
+	if (Edge.GetTextArguments().Num() > 0)
+	{
+		FormattedOptionTexts.FindOrAdd(GetFormattedOptionTextKey(NodeIndex, EdgeIndex, bInnerEdge));
+		BindParticipantVariableChanged();
+	}
+
+	if (bSatisfied)
+	{
+		AvailableOptionRecords.Add(OptionRecords.Num() - 1);
+	}
+	ResetOptionCopies();
+}
+
+const FDlgEdge& UDlgContext::GetOptionRecordEdge(const FDlgOptionRecord& Record) const
+{
+	const UDlgNode* Node = GetNodeFromIndex(Record.NodeIndex);
+	if (!Node)
+	{
+		return FDlgEdge::GetInvalidEdge();
+	}
+
+	if (Record.bInnerEdge)
+	{
+		const UDlgNode_SpeechSequence* SpeechSequence = Cast<UDlgNode_SpeechSequence>(Node);
+		if (SpeechSequence && SpeechSequence->GetInnerEdges().IsValidIndex(Record.EdgeIndex))
+		{
+			return SpeechSequence->GetInnerEdges()[Record.EdgeIndex];
+		}
+		return FDlgEdge::GetInvalidEdge();
+	}
+
+	const TArray<FDlgEdge>& Children = Node->GetNodeChildren();
+	return Children.IsValidIndex(Record.EdgeIndex) ? Children[Record.EdgeIndex] : FDlgEdge::GetInvalidEdge();
+}
+
+FText UDlgContext::GetOptionRecordText(const FDlgOptionRecord& Record) const
+{
+	const FDlgEdge& Edge = GetOptionRecordEdge(Record);
+	FDlgFormattedText* FormattedText = Edge.GetTextArguments().Num() > 0
+		? FormattedOptionTexts.Find(GetFormattedOptionTextKey(Record.NodeIndex, Record.EdgeIndex, Record.bInnerEdge))
+		: nullptr;
+	if (!FormattedText)
+	{
+		return Edge.GetUnformattedText();
+	}
+
+	if (!FormattedText->bValid)
+	{
+		const UDlgNode* Node = GetNodeFromIndex(Record.NodeIndex);
+		const FName NodeOwner = Node ? Node->GetNodeParticipantName() : NAME_None;
+		AddFormattedTextDependencies(Edge.GetTextArguments(), NodeOwner);
+		FormattedText->Text = Edge.FormatText(*this, NodeOwner);
+		FormattedText->bValid = true;
+	}
+
+	return FormattedText->Text;
+}
+
+void UDlgContext::ResetFormattedTexts()
+{
+	FormattedActiveNodeText = FDlgFormattedText();
+	FormattedOptionTexts.Reset();
+	FormattedTextsDependencies.Reset();
+	ResetOptionCopies();
 }
 
-void UDlgContext::SerializeParticipants()
+void UDlgContext::InvalidateFormattedTexts()
 {
-	SerializedParticipants.Empty(Participants.Num());
-	for (const auto& KeyValue : Participants)
+	// Keep the entries of the options, see AddOption
+	FormattedActiveNodeText.bValid = false;
+	for (auto& KeyValue : FormattedOptionTexts)
 	{
-		SerializedParticipants.Add(KeyValue.Value);
+		KeyValue.Value.bValid = false;
 	}
+	FormattedTextsDependencies.Reset();
+	ResetOptionCopies();
 }
 
-void UDlgContext::OnRep_SerializedParticipants()
+void UDlgContext::PrepareFormattedTexts()
 {
-	Participants.Empty(SerializedParticipants.Num());
-	for (UObject* Participant : SerializedParticipants)
+	// Same as EnterNode and AddOption, for the options that were copied or moved here
+	const UDlgNode* Node = GetActiveNode();
+	bool bHasTextArguments = Node && Node->GetTextArguments().Num() > 0;
+	for (const FDlgOptionRecord& Record : OptionRecords)
 	{
-		if (IsValid(Participant))
+		if (GetOptionRecordEdge(Record).GetTextArguments().Num() > 0)
 		{
-			Participants.Add(IDlgDialogueParticipant::Execute_GetParticipantName(Participant), Participant);
+			FormattedOptionTexts.FindOrAdd(GetFormattedOptionTextKey(Record.NodeIndex, Record.EdgeIndex, Record.bInnerEdge));
+			bHasTextArguments = true;
 		}
 	}
+
+	if (bHasTextArguments)
+	{
+		BindParticipantVariableChanged();
+	}
 }
 
-bool UDlgContext::ChooseOption(int32 OptionIndex)
+void UDlgContext::AddFormattedTextDependencies(const TArray<FDlgTextArgument>& Arguments, FName NodeOwner) const
 {
-	check(Dialogue);
-	if (UDlgNode* Node = GetMutableActiveNode())
+	for (const FDlgTextArgument& Argument : Arguments)
 	{
-		if (Node->OptionSelected(OptionIndex, false, *this))
+		FName ParticipantName;
+		FName VariableName;
+		if (Argument.GetReadVariable(NodeOwner, ParticipantName, VariableName))
 		{
-			return true;
+			FormattedTextsDependencies.Add(FDlgConditionDependency(ParticipantName, VariableName));
 		}
 	}
+}
 
-	bDialogueEnded = true;
-	return false;
+void UDlgContext::ResetOptionCopies() const
+{
+	AvailableChildren.Reset();
+	AllChildren.Reset();
+	bAvailableChildrenBuilt = false;
+	bAllChildrenBuilt = false;
 }
 
-bool UDlgContext::ChooseSpeechSequenceOptionFromReplicated(int32 OptionIndex)
+const FDlgEdge& UDlgContext::GetOptionCopy(int32 OptionIndex) const
 {
-	check(Dialogue);
-	if (UDlgNode_SpeechSequence* Node = GetMutableActiveNodeAsSpeechSequence())
+	if (AvailableChildren.Num() != AvailableOptionRecords.Num())
 	{
-		if (Node->OptionSelectedFromReplicated(OptionIndex, false, *this))
+		AvailableChildren.SetNum(AvailableOptionRecords.Num());
+	}
+
+	FDlgEdge& Edge = AvailableChildren[OptionIndex];
+	if (!Edge.IsValid())
+	{
+		const FDlgOptionRecord& Record = OptionRecords[AvailableOptionRecords[OptionIndex]];
+		Edge = GetOptionRecordEdge(Record);
+		if (Edge.GetTextArguments().Num() > 0)
 		{
-			return true;
+			Edge.SetConstructedText(GetOptionRecordText(Record));
 		}
 	}
 
-	bDialogueEnded = true;
-	return false;
+	return Edge;
 }
 
-bool UDlgContext::ChooseOptionFromAll(int32 Index)
+const FDlgEdgeData& UDlgContext::GetOptionCopyFromAll(int32 Index) const
 {
-	if (!AllChildren.IsValidIndex(Index))
+	if (AllChildren.Num() != OptionRecords.Num())
 	{
-		LogErrorWithContext(FString::Printf(TEXT("ChooseOptionFromAll - INVALID given Index = %d"), Index));
-		bDialogueEnded = true;
-		return false;
+		AllChildren.SetNum(OptionRecords.Num());
 	}
 
-	if (UDlgNode* Node = GetMutableActiveNode())
+	FDlgEdgeData& EdgeData = AllChildren[Index];
+	if (!EdgeData.IsValid())
 	{
-		if (Node->OptionSelected(Index, true, *this))
+		const FDlgOptionRecord& Record = OptionRecords[Index];
+		FDlgEdge Edge = GetOptionRecordEdge(Record);
+		if (Edge.GetTextArguments().Num() > 0)
 		{
-			return true;
+			Edge.SetConstructedText(GetOptionRecordText(Record));
 		}
+		EdgeData = FDlgEdgeData{ Record.bSatisfied, Edge };
 	}
 
-	bDialogueEnded = true;
-	return false;
+	return EdgeData;
 }
 
-bool UDlgContext::ReevaluateOptions()
+const TArray<FDlgEdge>& UDlgContext::GetOptionsArray() const
 {
-	check(Dialogue);
-	UDlgNode* Node = GetMutableActiveNode();
-	if (!IsValid(Node))
+	if (!bAvailableChildrenBuilt)
 	{
-		LogErrorWithContext(TEXT("ReevaluateOptions - Failed to update dialogue options"));
-		return false;
+		for (int32 OptionIndex = 0; OptionIndex < AvailableOptionRecords.Num(); OptionIndex++)
+		{
+			GetOptionCopy(OptionIndex);
+		}
+		bAvailableChildrenBuilt = true;
+	}
+
+	return AvailableChildren;
+}
+
+const TArray<FDlgEdgeData>& UDlgContext::GetAllOptionsArray() const
+{
+	if (!bAllChildrenBuilt)
+	{
+		for (int32 Index = 0; Index < OptionRecords.Num(); Index++)
+		{
+			GetOptionCopyFromAll(Index);
+		}
+		bAllChildrenBuilt = true;
 	}
 
-	return Node->ReevaluateChildren(*this, {});
+	return AllChildren;
 }
 
-const FText& UDlgContext::GetOptionText(int32 OptionIndex) const
+FText UDlgContext::GetOptionText(int32 OptionIndex) const
 {
 	check(Dialogue);
-	if (!AvailableChildren.IsValidIndex(OptionIndex))
+	const FDlgOptionRecord* Record = FindOptionRecord(OptionIndex);
+	if (!Record)
 	{
 		LogErrorWithContext(FString::Printf(TEXT("GetOptionText - INVALID given OptionIndex = %d"), OptionIndex));
 		return FText::GetEmpty();
 	}
 
-	return AvailableChildren[OptionIndex].GetText();
+	return GetOptionRecordText(*Record);
 }
 
 FName UDlgContext::GetOptionSpeakerState(int32 OptionIndex) const
 {
 	check(Dialogue);
-	if (!AvailableChildren.IsValidIndex(OptionIndex))
+	const FDlgOptionRecord* Record = FindOptionRecord(OptionIndex);
+	if (!Record)
 	{
 		LogErrorWithContext(FString::Printf(TEXT("GetOptionSpeakerState - INVALID given OptionIndex = %d"), OptionIndex));
 		return NAME_None;
 	}
 
-	return AvailableChildren[OptionIndex].SpeakerState;
+	return GetOptionRecordEdge(*Record).SpeakerState;
 }
 
 const TArray<FDlgCondition>& UDlgContext::GetOptionEnterConditions(int32 OptionIndex) const
 {
 	check(Dialogue);
-	if (!AvailableChildren.IsValidIndex(OptionIndex))
+	const FDlgOptionRecord* Record = FindOptionRecord(OptionIndex);
+	if (!Record)
 	{
 		LogErrorWithContext(FString::Printf(TEXT("GetOptionEnterConditions - INVALID given OptionIndex = %d"), OptionIndex));
 		static TArray<FDlgCondition> EmptyArray;
 		return EmptyArray;
 	}
 
-	return AvailableChildren[OptionIndex].Conditions;
+	return GetOptionRecordEdge(*Record).Conditions;
 }
 
 const FDlgEdge& UDlgContext::GetOption(int32 OptionIndex) const
 {
 	check(Dialogue);
-	if (!AvailableChildren.IsValidIndex(OptionIndex))
+	const FDlgOptionRecord* Record = FindOptionRecord(OptionIndex);
+	if (!Record)
 	{
 		LogErrorWithContext(FString::Printf(TEXT("GetOption - INVALID given OptionIndex = %d"), OptionIndex));
 		return FDlgEdge::GetInvalidEdge();
 	}
 
-	return AvailableChildren[OptionIndex];
+	// Only the edges with text arguments are copied, for the text formatted for this context
+	const FDlgEdge& Edge = GetOptionRecordEdge(*Record);
+	return Edge.GetTextArguments().Num() > 0 ? GetOptionCopy(OptionIndex) : Edge;
 }
 
-const FText& UDlgContext::GetOptionTextFromAll(int32 Index) const
+FText UDlgContext::GetOptionTextFromAll(int32 Index) const
 {
 	check(Dialogue);
-	if (!AllChildren.IsValidIndex(Index))
+	const FDlgOptionRecord* Record = FindOptionRecordFromAll(Index);
+	if (!Record)
 	{
 		LogErrorWithContext(FString::Printf(TEXT("GetOptionTextFromAll - INVALID given Index = %d"), Index));
 		return FText::GetEmpty();
 	}
 
-	return AllChildren[Index].GetEdge().GetText();
+	return GetOptionRecordText(*Record);
 }
 
 bool UDlgContext::IsOptionSatisfied(int32 Index) const
 {
 	check(Dialogue);
-	if (!AllChildren.IsValidIndex(Index))
+	const FDlgOptionRecord* Record = FindOptionRecordFromAll(Index);
+	if (!Record)
 	{
 		LogErrorWithContext(FString::Printf(TEXT("IsOptionSatisfied - INVALID given Index = %d"), Index));
 		return false;
 	}
 
-	return AllChildren[Index].IsSatisfied();
+	return Record->bSatisfied;
 }
 
 FName UDlgContext::GetOptionSpeakerStateFromAll(int32 Index) const
 {
 	check(Dialogue);
-	if (!AllChildren.IsValidIndex(Index))
+	const FDlgOptionRecord* Record = FindOptionRecordFromAll(Index);
+	if (!Record)
 	{
 		LogErrorWithContext(FString::Printf(TEXT("GetOptionSpeakerStateFromAll - INVALID given Index = %d"), Index));
 		return NAME_None;
 	}
 
-	return AllChildren[Index].GetEdge().SpeakerState;
+	return GetOptionRecordEdge(*Record).SpeakerState;
 }
 
 const FDlgEdgeData& UDlgContext::GetOptionFromAll(int32 Index) const
 {
 	check(Dialogue);
-	if (!AllChildren.IsValidIndex(Index))
+	if (!IsValidAllOptionIndex(Index))
 	{
 		LogErrorWithContext(FString::Printf(TEXT("GetOptionFromAll - INVALID given Index = %d"), Index));
 		return FDlgEdgeData::GetInvalidEdge();
 	}
 
-	return AllChildren[Index];
+	// Only this option is copied, FDlgEdgeData has its own copy of the edge
+	return GetOptionCopyFromAll(Index);
 }
 
 const FText& UDlgContext::GetActiveNodeText() const
@@ -218,7 +930,25 @@ const FText& UDlgContext::GetActiveNodeText() const
 		return FText::GetEmpty();
 	}
 
-	return Node->GetNodeText();
+	if (const FDlgSpeechSequenceEntry* Entry = GetActiveSpeechSequenceEntry())
+	{
+		return Entry->Text;
+	}
+
+	const TArray<FDlgTextArgument>& TextArguments = Node->GetTextArguments();
+	if (TextArguments.Num() == 0)
+	{
+		return Node->GetNodeText();
+	}
+
+	if (!FormattedActiveNodeText.bValid)
+	{
+		AddFormattedTextDependencies(TextArguments, Node->GetNodeParticipantName());
+		FormattedActiveNodeText.Text = Node->FormatNodeText(*this);
+		FormattedActiveNodeText.bValid = true;
+	}
+
+	return FormattedActiveNodeText.Text;
 }
 
 FName UDlgContext::GetActiveNodeSpeakerState() const
@@ -230,6 +960,11 @@ FName UDlgContext::GetActiveNodeSpeakerState() const
 		return NAME_None;
 	}
 
+	if (const FDlgSpeechSequenceEntry* Entry = GetActiveSpeechSequenceEntry())
+	{
+		return Entry->SpeakerState;
+	}
+
 	return Node->GetSpeakerState();
 }
 
@@ -242,7 +977,7 @@ USoundWave* UDlgContext::GetActiveNodeVoiceSoundWave() const
 		return nullptr;
 	}
 
-	return Node->GetNodeVoiceSoundWave();
+	return Cast<USoundWave>(GetActiveNodeVoiceSoundBase());
 }
 
 USoundBase* UDlgContext::GetActiveNodeVoiceSoundBase() const
@@ -254,6 +989,11 @@ USoundBase* UDlgContext::GetActiveNodeVoiceSoundBase() const
 		return nullptr;
 	}
 
+	if (const FDlgSpeechSequenceEntry* Entry = GetActiveSpeechSequenceEntry())
+	{
+		return Entry->VoiceSoundWave;
+	}
+
 	return Node->GetNodeVoiceSoundBase();
 }
 
@@ -266,6 +1006,11 @@ UDialogueWave* UDlgContext::GetActiveNodeVoiceDialogueWave() const
 		return nullptr;
 	}
 
+	if (const FDlgSpeechSequenceEntry* Entry = GetActiveSpeechSequenceEntry())
+	{
+		return Entry->VoiceDialogueWave;
+	}
+
 	return Node->GetNodeVoiceDialogueWave();
 }
 
@@ -278,6 +1023,11 @@ UObject* UDlgContext::GetActiveNodeGenericData() const
 		return nullptr;
 	}
 
+	if (const FDlgSpeechSequenceEntry* Entry = GetActiveSpeechSequenceEntry())
+	{
+		return Entry->GenericData;
+	}
+
 	return Node->GetNodeGenericData();
 }
 
@@ -290,6 +1040,11 @@ UDlgNodeData* UDlgContext::GetActiveNodeData() const
 		return nullptr;
 	}
 
+	if (const FDlgSpeechSequenceEntry* Entry = GetActiveSpeechSequenceEntry())
+	{
+		return Entry->NodeData;
+	}
+
 	return Node->GetNodeData();
 }
 
@@ -302,7 +1057,7 @@ UTexture2D* UDlgContext::GetActiveNodeParticipantIcon() const
 		return nullptr;
 	}
 
-	const FName SpeakerName = Node->GetNodeParticipantName();
+	const FName SpeakerName = GetActiveNodeParticipantName();
 	auto* ObjectPtr = Participants.Find(SpeakerName);
 	if (ObjectPtr == nullptr || !IsValid(*ObjectPtr))
 	{
@@ -313,7 +1068,7 @@ UTexture2D* UDlgContext::GetActiveNodeParticipantIcon() const
 		return nullptr;
 	}
 
-	return IDlgDialogueParticipant::Execute_GetParticipantIcon(*ObjectPtr, SpeakerName, Node->GetSpeakerState());
+	return IDlgDialogueParticipant::Execute_GetParticipantIcon(*ObjectPtr, SpeakerName, GetActiveNodeSpeakerState());
 }
 
 UObject* UDlgContext::GetActiveNodeParticipant() const
@@ -325,8 +1080,8 @@ UObject* UDlgContext::GetActiveNodeParticipant() const
 		return nullptr;
 	}
 
-	const FName SpeakerName = Node->GetNodeParticipantName();
-	auto* ObjectPtr = Participants.Find(Node->GetNodeParticipantName());
+	const FName SpeakerName = GetActiveNodeParticipantName();
+	auto* ObjectPtr = Participants.Find(SpeakerName);
 	if (ObjectPtr == nullptr || !IsValid(*ObjectPtr))
 	{
 		LogErrorWithContext(FString::Printf(
@@ -348,6 +1103,11 @@ FName UDlgContext::GetActiveNodeParticipantName() const
 		return NAME_None;
 	}
 
+	if (const FDlgSpeechSequenceEntry* Entry = GetActiveSpeechSequenceEntry())
+	{
+		return Entry->Speaker;
+	}
+
 	return Node->GetNodeParticipantName();
 }
 
@@ -360,7 +1120,7 @@ FText UDlgContext::GetActiveNodeParticipantDisplayName() const
 		return FText::GetEmpty();
 	}
 
-	const FName SpeakerName = Node->GetNodeParticipantName();
+	const FName SpeakerName = GetActiveNodeParticipantName();
 	auto* ObjectPtr = Participants.Find(SpeakerName);
 	if (ObjectPtr == nullptr || !IsValid(*ObjectPtr))
 	{
@@ -432,21 +1192,23 @@ bool UDlgContext::IsOptionConnectedToVisitedNode(int32 Index, bool bLocalHistory
 
 	if (bIndexSkipsUnsatisfiedEdges)
 	{
-		if (!AvailableChildren.IsValidIndex(Index))
+		const FDlgOptionRecord* Record = FindOptionRecord(Index);
+		if (!Record)
 		{
-			LogErrorWithContext(FString::Printf(TEXT("IsOptionConnectedToVisitedNode - INVALID Index = %d for AvailableChildren"), Index));
+			LogErrorWithContext(FString::Printf(TEXT("IsOptionConnectedToVisitedNode - INVALID Index = %d for the satisfied options"), Index));
 			return false;
 		}
-		TargetIndex = AvailableChildren[Index].TargetIndex;
+		TargetIndex = Record->TargetIndex;
 	}
 	else
 	{
-		if (!AllChildren.IsValidIndex(Index))
+		const FDlgOptionRecord* Record = FindOptionRecordFromAll(Index);
+		if (!Record)
 		{
-			LogErrorWithContext(FString::Printf(TEXT("IsOptionConnectedToVisitedNode - INVALID Index = %d for AllChildren"), Index));
+			LogErrorWithContext(FString::Printf(TEXT("IsOptionConnectedToVisitedNode - INVALID Index = %d for all the options"), Index));
 			return false;
 		}
-		TargetIndex = AllChildren[Index].GetEdge().TargetIndex;
+		TargetIndex = Record->TargetIndex;
 	}
 
 	const FGuid TargetGUID = GetNodeGUIDForIndex(TargetIndex);
@@ -465,21 +1227,23 @@ bool UDlgContext::IsOptionConnectedToEndNode(int32 Index, bool bIndexSkipsUnsati
 
 	if (bIndexSkipsUnsatisfiedEdges)
 	{
-		if (!AvailableChildren.IsValidIndex(Index))
+		const FDlgOptionRecord* Record = FindOptionRecord(Index);
+		if (!Record)
 		{
-			LogErrorWithContext(FString::Printf(TEXT("IsOptionConnectedToEndNode - INVALID Index = %d for AvailableChildren"), Index));
+			LogErrorWithContext(FString::Printf(TEXT("IsOptionConnectedToEndNode - INVALID Index = %d for the satisfied options"), Index));
 			return false;
 		}
-		TargetIndex = AvailableChildren[Index].TargetIndex;
+		TargetIndex = Record->TargetIndex;
 	}
 	else
 	{
-		if (!AllChildren.IsValidIndex(Index))
+		const FDlgOptionRecord* Record = FindOptionRecordFromAll(Index);
+		if (!Record)
 		{
-			LogErrorWithContext(FString::Printf(TEXT("IsOptionConnectedToEndNode - INVALID Index = %d for AllChildren"), Index));
+			LogErrorWithContext(FString::Printf(TEXT("IsOptionConnectedToEndNode - INVALID Index = %d for all the options"), Index));
 			return false;
 		}
-		TargetIndex = AllChildren[Index].GetEdge().TargetIndex;
+		TargetIndex = Record->TargetIndex;
 	}
 
 	if (Dialogue == nullptr)
@@ -488,17 +1252,16 @@ bool UDlgContext::IsOptionConnectedToEndNode(int32 Index, bool bIndexSkipsUnsati
 		return false;
 	}
 
-	const TArray<UDlgNode*>& Nodes = Dialogue->GetNodes();
-	if (Nodes.IsValidIndex(TargetIndex))
+	if (Dialogue->IsValidNodeIndex(TargetIndex))
 	{
-		return Nodes[TargetIndex]->IsA<UDlgNode_End>();
+		return Dialogue->IsEndNode(TargetIndex);
 	}
 
 	LogErrorWithContext(FString::Printf(TEXT("IsOptionConnectedToEndNode - The examined Edge/Option at Index = %d does not point to a valid node"), Index));
 	return false;
 }
 
-bool UDlgContext::EnterNode(int32 NodeIndex, TSet<const UDlgNode*> NodesEnteredWithThisStep)
+bool UDlgContext::EnterNode(int32 NodeIndex, FDlgTraversalState& NodesEnteredWithThisStep)
 {
 	check(Dialogue);
 	UDlgNode* Node = GetMutableNodeFromIndex(NodeIndex);
@@ -507,9 +1270,19 @@ bool UDlgContext::EnterNode(int32 NodeIndex, TSet<const UDlgNode*> NodesEnteredW
 		LogErrorWithContext(FString::Printf(TEXT("EnterNode - FAILED because of INVALID NodeIndex = %d"), NodeIndex));
 		return false;
 	}
+	if (!AreConditionsBound())
+	{
+		BindConditions();
+	}
 
 	ActiveNodeIndex = NodeIndex;
 	SetNodeVisited(NodeIndex, Node->GetGUID());
+	ResetIncrementalOptions(INDEX_NONE);
+	ResetFormattedTexts();
+	if (Node->GetTextArguments().Num() > 0)
+	{
+		BindParticipantVariableChanged();
+	}
 
 	return Node->HandleNodeEnter(*this, NodesEnteredWithThisStep);
 }
@@ -534,17 +1307,140 @@ UDlgContext* UDlgContext::CreateCopy() const
 	Context->Dialogue = Dialogue;
 	Context->SetParticipants(Participants);
 	Context->ActiveNodeIndex = ActiveNodeIndex;
-	Context->AvailableChildren = AvailableChildren;
-	Context->AllChildren = AllChildren;
+	Context->OptionRecords = OptionRecords;
+	Context->AvailableOptionRecords = AvailableOptionRecords;
 	Context->History = History;
 	Context->bDialogueEnded = bDialogueEnded;
+	Context->NodeStates = NodeStates;
+	Context->Memory = Memory;
+	Context->PrepareFormattedTexts();
 
 	return Context;
 }
 
+void UDlgContext::ResetForReuse()
+{
+	SetIncrementalReevaluation(false);
+	UnbindParticipantVariableChanged();
+	DirtyDependencies.Reset();
+	bAllOptionsDirty = true;
+	ResetFormattedTexts();
+
+	Dialogue = nullptr;
+	Participants.Reset();
+	SerializedParticipants.Reset();
+	ActiveNodeIndex = INDEX_NONE;
+	ResetOptions();
+	History = FDlgHistory();
+	bDialogueEnded = false;
+	NodeStates.Reset();
+	Memory.Reset();
+
+	// Bound again by the next SetParticipants, keep the allocations
+	ClearThreadSafeConditionResults();
+	BoundConditions.Reset();
+	BoundConditionsRanges.Reset();
+	BoundConditionsDialogue = nullptr;
+	BoundConditionsPropertyCacheGeneration = INDEX_NONE;
+	bConditionsBoundToBakedDialogue = false;
+	BoundConditionsBakedGeneration = INDEX_NONE;
+	ResetIncrementalOptions(INDEX_NONE);
+	MovedStateRevision = 0;
+}
+
+void UDlgContext::MoveStateTo(FDlgContextState& OutState)
+{
+	OutState.Dialogue = Dialogue;
+	OutState.Participants.Reset();
+	for (const auto& KeyValue : Participants)
+	{
+		OutState.Participants.Add(KeyValue.Key, KeyValue.Value);
+	}
+
+	OutState.ActiveNodeIndex = ActiveNodeIndex;
+	OutState.OptionRecords = MoveTemp(OptionRecords);
+	OutState.AvailableOptionRecords = MoveTemp(AvailableOptionRecords);
+	OutState.History = MoveTemp(History);
+	OutState.NodeStates = MoveTemp(NodeStates);
+	OutState.Memory = MoveTemp(Memory);
+	OutState.bDialogueEnded = bDialogueEnded;
+
+	static uint64 NextStateRevision = 0;
+	MovedStateRevision = ++NextStateRevision;
+	OutState.Revision = MovedStateRevision;
+
+	// Only the runtime data, the Dialogue, the Participants, the bound conditions and the caches are kept for MoveStateFrom
+	ActiveNodeIndex = INDEX_NONE;
+	ResetOptions();
+	History = FDlgHistory();
+	bDialogueEnded = false;
+	NodeStates.Reset();
+	Memory.Reset();
+}
+
+bool UDlgContext::MoveStateFrom(FDlgContextState& State)
+{
+	UDlgDialogue* StateDialogue = State.Dialogue.Get();
+	if (!IsValid(StateDialogue))
+	{
+		return false;
+	}
+
+	TMap<FName, UObject*> StateParticipants;
+	StateParticipants.Reserve(State.Participants.Num());
+	for (const auto& KeyValue : State.Participants)
+	{
+		UObject* Participant = KeyValue.Value.Get();
+		if (!IsValid(Participant))
+		{
+			return false;
+		}
+		StateParticipants.Add(KeyValue.Key, Participant);
+	}
+
+	if (Dialogue == StateDialogue && Participants.OrderIndependentCompareEqual(StateParticipants))
+	{
+		// Same bindings, the incremental options and the formatted texts are only valid for the state moved out last
+		if (MovedStateRevision == 0 || MovedStateRevision != State.Revision)
+		{
+			UnbindParticipantVariableChanged();
+			ResetIncrementalOptions(INDEX_NONE);
+			ResetFormattedTexts();
+		}
+		if (!AreConditionsBound())
+		{
+			BindConditions();
+		}
+	}
+	else
+	{
+		ResetForReuse();
+		Dialogue = StateDialogue;
+		SetParticipants(StateParticipants);
+	}
+
+	MovedStateRevision = 0;
+	ActiveNodeIndex = State.ActiveNodeIndex;
+	OptionRecords = MoveTemp(State.OptionRecords);
+	AvailableOptionRecords = MoveTemp(State.AvailableOptionRecords);
+	History = MoveTemp(State.History);
+	NodeStates = MoveTemp(State.NodeStates);
+	Memory = MoveTemp(State.Memory);
+	bDialogueEnded = State.bDialogueEnded;
+
+	// The nodes might have changed since the state was saved
+	if (NodeStates.Num() != Dialogue->GetNodes().Num())
+	{
+		NodeStates.SetNum(Dialogue->GetNodes().Num());
+	}
+	PrepareFormattedTexts();
+
+	return true;
+}
+
 void UDlgContext::SetNodeVisited(int32 NodeIndex, const FGuid& NodeGUID)
 {
-	FDlgMemory::Get().SetNodeVisited(Dialogue->GetGUID(), NodeIndex, NodeGUID);
+	GetMemory().SetNodeVisited(*Dialogue, NodeIndex, NodeGUID);
 	History.Add(NodeIndex, NodeGUID);
 }
 
@@ -555,12 +1451,12 @@ bool UDlgContext::IsNodeVisited(int32 NodeIndex, const FGuid& NodeGUID, bool bLo
 		return History.Contains(NodeIndex, NodeGUID);
 	}
 
-	return FDlgMemory::Get().IsNodeVisited(Dialogue->GetGUID(), NodeIndex, NodeGUID);
+	return GetMemory().IsNodeVisited(*Dialogue, NodeIndex, NodeGUID);
 }
 
 FDlgNodeSavedData& UDlgContext::GetNodeSavedData(const FGuid& NodeGUID)
 {
-	return FDlgMemory::Get().FindOrAddEntry(Dialogue->GetGUID()).GetNodeData(NodeGUID);
+	return GetMemory().GetNodeData(Dialogue->GetGUID(), NodeGUID);
 }
 
 UDlgNode_SpeechSequence* UDlgContext::GetMutableActiveNodeAsSpeechSequence() const
@@ -573,6 +1469,27 @@ const UDlgNode_SpeechSequence* UDlgContext::GetActiveNodeAsSpeechSequence() cons
 	return Cast<UDlgNode_SpeechSequence>(GetNodeFromIndex(ActiveNodeIndex));
 }
 
+const FDlgSpeechSequenceEntry* UDlgContext::GetActiveSpeechSequenceEntry() const
+{
+	if (const UDlgNode_SpeechSequence* Node = GetActiveNodeAsSpeechSequence())
+	{
+		return Node->GetActiveSpeechSequenceEntry(*this);
+	}
+
+	return nullptr;
+}
+
+FDlgNodeState& UDlgContext::GetMutableNodeState(int32 NodeIndex)
+{
+	check(NodeIndex >= 0);
+	if (!NodeStates.IsValidIndex(NodeIndex))
+	{
+		NodeStates.SetNum(NodeIndex + 1);
+	}
+
+	return NodeStates[NodeIndex];
+}
+
 UDlgNode* UDlgContext::GetMutableNodeFromIndex(int32 NodeIndex) const
 {
 	check(Dialogue);
@@ -617,9 +1534,13 @@ const UDlgNode* UDlgContext::GetNodeFromGUID(const FGuid& NodeGUID) const
 	return Dialogue->GetMutableNodeFromGUID(NodeGUID);
 }
 
-bool UDlgContext::IsNodeEnterable(int32 NodeIndex, TSet<const UDlgNode*> AlreadyVisitedNodes) const
+bool UDlgContext::IsNodeEnterable(int32 NodeIndex, FDlgTraversalState& AlreadyVisitedNodes) const
 {
 	check(Dialogue);
+	if (CanUseBakedDialogue())
+	{
+		return IsBakedNodeEnterable(NodeIndex, AlreadyVisitedNodes);
+	}
 	if (const UDlgNode* Node = GetNodeFromIndex(NodeIndex))
 	{
 		return Node->CheckNodeEnterConditions(*this, AlreadyVisitedNodes);
@@ -628,6 +1549,112 @@ bool UDlgContext::IsNodeEnterable(int32 NodeIndex, TSet<const UDlgNode*> Already
 	return false;
 }
 
+bool UDlgContext::IsBakedNodeEnterable(int32 NodeIndex, FDlgTraversalState& AlreadyVisitedNodes) const
+{
+	const FDlgBakedDialogue& Baked = Dialogue->GetBakedDialogue();
+	if (!Baked.IsValidNodeIndex(NodeIndex))
+	{
+		return false;
+	}
+
+	const FDlgNodeDescriptor& Descriptor = Baked.NodeDescriptors[NodeIndex];
+	switch (Descriptor.Kind)
+	{
+		case EDlgNodeKind::Custom:
+		case EDlgNodeKind::Unknown:
+		{
+			// Custom classes and the children of the plugin nodes can have their own CheckNodeEnterConditions
+			const UDlgNode* Node = GetNodeFromIndex(NodeIndex);
+			return Node && Node->CheckNodeEnterConditions(*this, AlreadyVisitedNodes);
+		}
+
+		default:
+			break;
+	}
+
+	// Same as UDlgNode::CheckNodeEnterConditions
+	if (!AlreadyVisitedNodes.Contains(NodeIndex))
+	{
+		// Only visited on this path, the sibling edges must not see it
+		const FDlgTraversalState::FScopedVisit ScopedVisit(AlreadyVisitedNodes, NodeIndex);
+		if (!AreBakedConditionsSatisfied(Baked.NodeEnterConditions[NodeIndex]))
+		{
+			return false;
+		}
+
+		switch (Baked.NodeEnterRestrictions[NodeIndex])
+		{
+			case EDlgEntryRestriction::OncePerContext:
+				if (IsNodeVisited(NodeIndex, Baked.NodeGUIDs[NodeIndex], true))
+				{
+					return false;
+				}
+				break;
+
+			case EDlgEntryRestriction::Once:
+				if (IsNodeVisited(NodeIndex, Baked.NodeGUIDs[NodeIndex], false))
+				{
+					return false;
+				}
+				break;
+
+			default:
+				break;
+		}
+
+		if (Descriptor.bCheckChildrenOnEvaluation)
+		{
+			bool bHasAnySatisfiedChild = false;
+			for (int32 EdgeIndex = Descriptor.FirstEdgeIndex; EdgeIndex < Descriptor.FirstEdgeIndex + Descriptor.NumEdges; EdgeIndex++)
+			{
+				if (IsBakedEdgeSatisfied(EdgeIndex, AlreadyVisitedNodes))
+				{
+					bHasAnySatisfiedChild = true;
+					break;
+				}
+			}
+			if (!bHasAnySatisfiedChild)
+			{
+				return false;
+			}
+		}
+	}
+
+	// Same as UDlgNode_Proxy::CheckNodeEnterConditions
+	if (Descriptor.Kind == EDlgNodeKind::Proxy)
+	{
+		return IsBakedNodeEnterable(Baked.NodeProxyTargets[NodeIndex], AlreadyVisitedNodes);
+	}
+
+	return true;
+}
+
+bool UDlgContext::IsBakedEdgeSatisfied(int32 EdgeIndex, FDlgTraversalState& AlreadyVisitedNodes) const
+{
+	const FDlgBakedEdge& Edge = Dialogue->GetBakedDialogue().Edges[EdgeIndex];
+	return Edge.IsValid()
+		&& IsBakedNodeEnterable(Edge.TargetIndex, AlreadyVisitedNodes)
+		&& AreBakedConditionsSatisfied(Edge.Conditions);
+}
+
+bool UDlgContext::IsEdgeSatisfied(int32 NodeIndex, int32 ChildIndex, const FDlgEdge& Edge, FDlgTraversalState& AlreadyVisitedNodes) const
+{
+	if (CanUseBakedDialogue())
+	{
+		const FDlgBakedDialogue& Baked = Dialogue->GetBakedDialogue();
+		if (Baked.IsValidNodeIndex(NodeIndex))
+		{
+			const FDlgNodeDescriptor& Descriptor = Baked.NodeDescriptors[NodeIndex];
+			if (ChildIndex >= 0 && ChildIndex < Descriptor.NumEdges)
+			{
+				return IsBakedEdgeSatisfied(Descriptor.FirstEdgeIndex + ChildIndex, AlreadyVisitedNodes);
+			}
+		}
+	}
+
+	return Edge.Evaluate(*this, AlreadyVisitedNodes);
+}
+
 bool UDlgContext::CanBeStarted(UDlgDialogue* InDialogue, const TMap<FName, UObject*>& InParticipants)
 {
 	if (!ValidateParticipantsMapForDialogue(TEXT("CanBeStarted"), InDialogue, InParticipants, false))
@@ -653,15 +1680,16 @@ bool UDlgContext::CanBeStarted(UDlgDialogue* InDialogue, const TMap<FName, UObje
 	Context->SetParticipants(InParticipants);
 
 	// Evaluate edges/children of the start node
+	FDlgTraversalState AlreadyVisitedNodes;
 	for (const UDlgNode* StartNode : InDialogue->GetStartNodes())
 	{
 		for (const FDlgEdge& ChildLink : StartNode->GetNodeChildren())
 		{
-			if (ChildLink.Evaluate(*Context, {}))
+			if (ChildLink.Evaluate(*Context, AlreadyVisitedNodes))
 			{
 				// Simulate EnterNode
 				UDlgNode* Node = Context->GetMutableNodeFromIndex(ChildLink.TargetIndex);
-				if (Node && Node->HasAnySatisfiedChild(*Context, {}))
+				if (Node && Node->HasAnySatisfiedChild(*Context, AlreadyVisitedNodes))
 				{
 					return true;
 				}
@@ -674,26 +1702,37 @@ bool UDlgContext::CanBeStarted(UDlgDialogue* InDialogue, const TMap<FName, UObje
 
 bool UDlgContext::StartWithContext(const FString& ContextString, UDlgDialogue* InDialogue, const TMap<FName, UObject*>& InParticipants)
 {
-	const FString ContextMessage = ContextString.IsEmpty()
-		? TEXT("Start")
-		: FString::Printf(TEXT("%s - Start"), *ContextString);
-
 	Dialogue = InDialogue;
 	SetParticipants(InParticipants);
-	if (!ValidateParticipantsMapForDialogue(ContextMessage, Dialogue, Participants))
+	ResetNodeStates();
+	if (!ValidateParticipantsMapForDialogueWithContext(ContextString, TEXT("Start"), Dialogue, Participants))
 	{
 		return false;
 	}
 
+	return EnterFirstStartNodeChild(ContextString);
+}
+
+bool UDlgContext::StartWithValidatedParticipants(const FString& ContextString, UDlgDialogue* InDialogue, const TMap<FName, UObject*>& InParticipants)
+{
+	Dialogue = InDialogue;
+	SetParticipants(InParticipants);
+	ResetNodeStates();
+	return EnterFirstStartNodeChild(ContextString);
+}
+
+bool UDlgContext::EnterFirstStartNodeChild(const FString& ContextString)
+{
 	// Evaluate edges/children of the start node
-	
+	FDlgTraversalState AlreadyVisitedNodes;
 	for (const UDlgNode* StartNode : Dialogue->GetStartNodes())
 	{
 		for (const FDlgEdge& ChildLink : StartNode->GetNodeChildren())
 		{
-			if (ChildLink.Evaluate(*this, {}))
+			if (ChildLink.Evaluate(*this, AlreadyVisitedNodes))
 			{
-				if (EnterNode(ChildLink.TargetIndex, {}))
+				FDlgTraversalState NodesEnteredWithThisStep;
+				if (EnterNode(ChildLink.TargetIndex, NodesEnteredWithThisStep))
 				{
 					return true;
 				}
@@ -703,7 +1742,7 @@ bool UDlgContext::StartWithContext(const FString& ContextString, UDlgDialogue* I
 
 	LogErrorWithContext(FString::Printf(
 		TEXT("%s - FAILED because all possible start node condition failed. Edge conditions and children enter conditions from the start nodes are not satisfied"),
-		*ContextMessage
+		*FormatContextMessage(ContextString, TEXT("Start"))
 	));
 	return false;
 }
@@ -718,14 +1757,11 @@ bool UDlgContext::StartWithContextFromNode(
 	bool bFireEnterEvents
 )
 {
-	const FString ContextMessage = ContextString.IsEmpty()
-		? TEXT("StartFromNode")
-		: FString::Printf(TEXT("%s - StartFromNode"), *ContextString);
-
 	Dialogue = InDialogue;
 	SetParticipants(InParticipants);
+	ResetNodeStates();
 	History = StartHistory;
-	if (!ValidateParticipantsMapForDialogue(ContextMessage, Dialogue, Participants))
+	if (!ValidateParticipantsMapForDialogueWithContext(ContextString, TEXT("StartFromNode"), Dialogue, Participants))
 	{
 		return false;
 	}
@@ -741,20 +1777,21 @@ bool UDlgContext::StartWithContextFromNode(
 	{
 		LogErrorWithContext(FString::Printf(
 			TEXT("%s - FAILED because StartNodeIndex = %d  is INVALID. For StartNodeGUID = %s"),
-			*ContextMessage, StartNodeIndex, *StartNodeGUID.ToString()
+			*FormatContextMessage(ContextString, TEXT("StartFromNode")), StartNodeIndex, *StartNodeGUID.ToString()
 		));
 		return false;
 	}
 
 	if (bFireEnterEvents)
 	{
-		return EnterNode(StartNodeIndex, {});
+		return EnterNode(StartNodeIndex);
 	}
 
 	ActiveNodeIndex = StartNodeIndex;
 	SetNodeVisited(StartNodeIndex, Node->GetGUID());
 
-	return Node->ReevaluateChildren(*this, {});
+	FDlgTraversalState AlreadyEvaluated;
+	return Node->ReevaluateChildren(*this, AlreadyEvaluated);
 }
 
 FString UDlgContext::GetContextString() const
@@ -887,15 +1924,40 @@ bool UDlgContext::ValidateParticipantsMapForDialogue(
 	bool bLog
 )
 {
-	const FString ContextMessage = ContextString.IsEmpty()
-		? FString::Printf(TEXT("ValidateParticipantsMapForDialogue"))
-		: FString::Printf(TEXT("%s - ValidateParticipantsMapForDialogue"), *ContextString);
+	return ValidateParticipantsMapForDialogueWithContext(ContextString, nullptr, Dialogue, ParticipantsMap, bLog);
+}
+
+FString UDlgContext::FormatContextMessage(const FString& ContextString, const TCHAR* ContextName)
+{
+	if (ContextName == nullptr)
+	{
+		return ContextString;
+	}
+
+	return ContextString.IsEmpty()
+		? FString(ContextName)
+		: FString::Printf(TEXT("%s - %s"), *ContextString, ContextName);
+}
+
+bool UDlgContext::ValidateParticipantsMapForDialogueWithContext(
+	const FString& ContextString,
+	const TCHAR* ContextName,
+	const UDlgDialogue* Dialogue,
+	const TMap<FName, UObject*>& ParticipantsMap,
+	bool bLog
+)
+{
+	// Only formatted if something is wrong
+	auto GetContextMessage = [&ContextString, ContextName]() -> FString
+	{
+		return UDlgContext::FormatContextMessage(UDlgContext::FormatContextMessage(ContextString, ContextName), TEXT("ValidateParticipantsMapForDialogue"));
+	};
 
 	if (!IsValid(Dialogue))
 	{
 		if (bLog)
 		{
-			FDlgLogger::Get().Errorf(TEXT("%s - FAILED because the supplied Dialogue Asset is INVALID (nullptr)"), *ContextMessage);
+			FDlgLogger::Get().Errorf(TEXT("%s - FAILED because the supplied Dialogue Asset is INVALID (nullptr)"), *GetContextMessage());
 		}
 		return false;
 	}
@@ -903,16 +1965,13 @@ bool UDlgContext::ValidateParticipantsMapForDialogue(
 	{
 		if (bLog)
 		{
-			FDlgLogger::Get().Errorf(TEXT("%s - Dialogue = `%s` does not have any participants"), *ContextMessage, *Dialogue->GetPathName());
+			FDlgLogger::Get().Errorf(TEXT("%s - Dialogue = `%s` does not have any participants"), *GetContextMessage(), *Dialogue->GetPathName());
 		}
 		return false;
 	}
 
 	// Check if at least these participants are required
 	const TMap<FName, FDlgParticipantData>& DialogueParticipants = Dialogue->GetParticipantsData();
-	TArray<FName> ParticipantsRequiredArray;
-	const int32 ParticipantsNum = DialogueParticipants.GetKeys(ParticipantsRequiredArray);
-	TSet<FName> ParticipantsRequiredSet{ParticipantsRequiredArray};
 
 	// Iterate over Map
 	for (const auto& KeyValue : ParticipantsMap)
@@ -921,8 +1980,12 @@ bool UDlgContext::ValidateParticipantsMapForDialogue(
 		const UObject* Participant = KeyValue.Value;
 
 		// We must check this otherwise we can't get the name
-		if (!ValidateParticipantForDialogue(ContextMessage, Dialogue, Participant, bLog))
+		if (IsValidParticipantForDialogue(Dialogue, Participant) != EDlgValidateStatus::Valid)
 		{
+			if (bLog)
+			{
+				ValidateParticipantForDialogue(GetContextMessage(), Dialogue, Participant, bLog);
+			}
 			return false;
 		}
 
@@ -937,46 +2000,52 @@ bool UDlgContext::ValidateParticipantsMapForDialogue(
 				{
 					FDlgLogger::Get().Errorf(
 						TEXT("%s - The Map has a KEY Participant Name = `%s` DIFFERENT to the VALUE of the Participant Path = `%s` with the Name = `%s` (KEY Participant Name != VALUE Participant Name)"),
-						*ContextMessage, *ParticipantName.ToString(), *Participant->GetPathName(), *ObjectParticipantName.ToString()
+						*GetContextMessage(), *ParticipantName.ToString(), *Participant->GetPathName(), *ObjectParticipantName.ToString()
 					);
 				}
 				return false;
 			}
 		}
 
-		// We found one participant from our set
-		if (ParticipantsRequiredSet.Contains(ParticipantName))
+		// Participant does note exist, just warn about it, we are relaxed about this
+		if (!DialogueParticipants.Contains(ParticipantName) && bLog)
 		{
-			ParticipantsRequiredSet.Remove(ParticipantName);
+			FDlgLogger::Get().Warningf(
+				TEXT("%s - Participant Path = `%s` with Participant Name = `%s` is NOT referenced (DOES) not exist inside the Dialogue. It is going to be IGNORED.\nContext:\n\tDialogue = `%s`"),
+				*GetContextMessage(), *Participant->GetPathName(), *ParticipantName.ToString(), *Dialogue->GetPathName()
+			);
 		}
-		else
+	}
+
+	// Some participants are missing
+	// NOTE: the keys of the map are unique and match the participant names (checked above)
+	bool bAnyParticipantMissing = false;
+	for (const auto& KeyValue : DialogueParticipants)
+	{
+		if (!ParticipantsMap.Contains(KeyValue.Key))
 		{
-			// Participant does note exist, just warn about it, we are relaxed about this
-			if (bLog)
-			{
-				FDlgLogger::Get().Warningf(
-					TEXT("%s - Participant Path = `%s` with Participant Name = `%s` is NOT referenced (DOES) not exist inside the Dialogue. It is going to be IGNORED.\nContext:\n\tDialogue = `%s`"),
-					*ContextMessage, *Participant->GetPathName(), *ParticipantName.ToString(), *Dialogue->GetPathName()
-				);
-			}
+			bAnyParticipantMissing = true;
+			break;
 		}
 	}
 
-	// Some participants are missing
-	if (ParticipantsRequiredSet.Num() > 0)
+	if (bAnyParticipantMissing)
 	{
 		if (bLog)
 		{
 			TArray<FString> ParticipantsMissing;
-			for (const auto Name : ParticipantsRequiredSet)
+			for (const auto& KeyValue : DialogueParticipants)
 			{
-				ParticipantsMissing.Add(Name.ToString());
+				if (!ParticipantsMap.Contains(KeyValue.Key))
+				{
+					ParticipantsMissing.Add(KeyValue.Key.ToString());
+				}
 			}
 
 			const FString NameList = FString::Join(ParticipantsMissing, TEXT(", "));
 			FDlgLogger::Get().Errorf(
 				TEXT("%s - FAILED for Dialogue = `%s` because the following Participant Names are MISSING: `%s"),
-				*ContextMessage,  *Dialogue->GetPathName(), *NameList
+				*GetContextMessage(),  *Dialogue->GetPathName(), *NameList
 			);
 		}
 		return false;
@@ -993,19 +2062,24 @@ bool UDlgContext::ConvertArrayOfParticipantsToMap(
 	bool bLog
 )
 {
-	const FString ContextMessage = ContextString.IsEmpty()
-		? FString::Printf(TEXT("ConvertArrayOfParticipantsToMap"))
-		: FString::Printf(TEXT("%s - ConvertArrayOfParticipantsToMap"), *ContextString);
+	// Only formatted if something is wrong
+	auto GetContextMessage = [&ContextString]() -> FString
+	{
+		return ContextString.IsEmpty()
+			? FString(TEXT("ConvertArrayOfParticipantsToMap"))
+			: FString::Printf(TEXT("%s - ConvertArrayOfParticipantsToMap"), *ContextString);
+	};
 
 	// We don't allow to convert empty arrays
-	OutParticipantsMap.Empty();
+	// NOTE: Reset so that the callers can reuse the same map
+	OutParticipantsMap.Reset();
 	if (ParticipantsArray.Num() == 0)
 	{
 		if (bLog)
 		{
 			FDlgLogger::Get().Errorf(
 				TEXT("%s - Participants Array is EMPTY, can't convert anything. Dialogue = `%s`"),
-				*ContextMessage, Dialogue ? *Dialogue->GetPathName() : TEXT("INVALID")
+				*GetContextMessage(), Dialogue ? *Dialogue->GetPathName() : TEXT("INVALID")
 			);
 		}
 		return false;
@@ -1014,11 +2088,18 @@ bool UDlgContext::ConvertArrayOfParticipantsToMap(
 	for (int32 Index = 0; Index < ParticipantsArray.Num(); Index++)
 	{
 		UObject* Participant = ParticipantsArray[Index];
-		const FString ContextMessageWithIndex = FString::Printf(TEXT("%s - Participant at Index = %d"), *ContextMessage,  Index);
+		auto GetContextMessageWithIndex = [&GetContextMessage, Index]() -> FString
+		{
+			return FString::Printf(TEXT("%s - Participant at Index = %d"), *GetContextMessage(), Index);
+		};
 
 		// We must check this otherwise we can't get the name
-		if (!ValidateParticipantForDialogue(ContextMessageWithIndex, Dialogue, Participant, bLog))
+		if (IsValidParticipantForDialogue(Dialogue, Participant) != EDlgValidateStatus::Valid)
 		{
+			if (bLog)
+			{
+				ValidateParticipantForDialogue(GetContextMessageWithIndex(), Dialogue, Participant, bLog);
+			}
 			return false;
 		}
 
@@ -1031,7 +2112,7 @@ bool UDlgContext::ConvertArrayOfParticipantsToMap(
 			{
 				FDlgLogger::Get().Warningf(
 					TEXT("%s - Participant Path = `%s`, Participant Name = `%s` already exists in the Array. Ignoring it!"),
-					*ContextMessageWithIndex, *Participant->GetPathName(), *ParticipantName.ToString()
+					*GetContextMessageWithIndex(), *Participant->GetPathName(), *ParticipantName.ToString()
 				);
 			}
 			continue;
@@ -16,6 +16,7 @@ class UTexture2D;
 class UDlgNodeData;
 class UDlgNode;
 class UDlgNode_SpeechSequence;
+struct FDlgSpeechSequenceEntry;
 
 // Used to store temporary state of edges
 // This represents a const version of an Edge
@@ -48,6 +49,121 @@ protected:
 };
 
 
+// Where the bound version of a conditions array is inside UDlgContext::BoundConditions
+struct FDlgBoundConditionsRange
+{
+	int32 StartIndex = 0;
+	int32 Num = 0;
+
+	// Only a guard for the arrays resized without a RebuildBakedDialogue, the content changes are detected by UDlgContext::AreConditionsBound
+	const FDlgCondition* SourceData = nullptr;
+	FName DefaultParticipantName;
+};
+
+
+// Variable (or condition name) of a participant read by the conditions of an option, see UDlgContext::SetIncrementalReevaluation
+// Also used for the variables read by the text arguments of the formatted texts
+struct FDlgConditionDependency
+{
+	FDlgConditionDependency() {}
+	FDlgConditionDependency(FName InParticipantName, FName InVariableName)
+		: ParticipantName(InParticipantName), VariableName(InVariableName) {}
+
+	bool operator==(const FDlgConditionDependency& Other) const
+	{
+		return ParticipantName == Other.ParticipantName && VariableName == Other.VariableName;
+	}
+
+	friend uint32 GetTypeHash(const FDlgConditionDependency& Dependency)
+	{
+		return HashCombine(GetTypeHash(Dependency.ParticipantName), GetTypeHash(Dependency.VariableName));
+	}
+
+	FName ParticipantName;
+	FName VariableName;
+};
+
+
+// An option of the active node as last evaluated by UDlgContext::ReevaluateOptions in incremental mode
+struct FDlgIncrementalOption
+{
+	// Read by the conditions of the edge, by the enter conditions of the target node
+	// and by the children of the target node if it checks them on evaluation
+	TArray<FDlgConditionDependency> Dependencies;
+
+	// Depends on something that can not be tracked by name (custom conditions, node history, enter restrictions)
+	// so it is always reevaluated
+	bool bVolatile = false;
+
+	bool bSatisfied = false;
+};
+
+
+// Runtime state of a node for one context, see UDlgContext::GetNodeState.
+// The nodes of the Dialogue are shared between all the contexts running it and are never written at runtime.
+struct FDlgNodeState
+{
+	// UDlgNode_SpeechSequence: the active entry of the SpeechSequence array
+	int32 SpeechSequenceIndex = INDEX_NONE;
+
+	// UDlgNode_Speech virtual parent: the direct child that provided the options (its enter events are fired)
+	int32 VirtualParentFirstSatisfiedDirectChildIndex = INDEX_NONE;
+};
+
+// Option of the active node, see UDlgContext::AddOption.
+// Only references the edge inside the Dialogue, the edge itself is copied only if someone asks for the edges arrays (GetOptionsArray/GetAllOptionsArray).
+struct FDlgOptionRecord
+{
+	// The node that has the edge, the active node or one of its direct children if it is a virtual parent
+	int32 NodeIndex = INDEX_NONE;
+
+	// Index of the edge in the Children of the node (or in the inner edges of a UDlgNode_SpeechSequence)
+	int32 EdgeIndex = INDEX_NONE;
+
+	// Same as the TargetIndex of the edge
+	int32 TargetIndex = INDEX_NONE;
+
+	// Is the edge one of the inner edges of a UDlgNode_SpeechSequence?
+	bool bInnerEdge = false;
+
+	bool bSatisfied = false;
+};
+
+// Text of the active node or of an option formatted for a context on first access, see UDlgContext::GetActiveNodeText
+struct FDlgFormattedText
+{
+	FText Text;
+	bool bValid = false;
+};
+
+// Runtime state of a context without the UObject, so that many short dialogues (e.g. barks) can be kept without any UObject/GC cost.
+// Advanced by borrowing a pooled context, see UDlgContextPool::UpdateState and UDlgContext::MoveStateFrom/MoveStateTo.
+// NOTE: The Dialogue and the Participants are weak references, the state can not be advanced anymore if any of them is destroyed.
+struct DLGSYSTEM_API FDlgContextState
+{
+public:
+	bool HasDialogueEnded() const { return bDialogueEnded; }
+	int32 GetActiveNodeIndex() const { return ActiveNodeIndex; }
+	UDlgDialogue* GetDialogue() const { return Dialogue.Get(); }
+
+public:
+	TWeakObjectPtr<UDlgDialogue> Dialogue;
+	TMap<FName, TWeakObjectPtr<UObject>> Participants;
+
+	// Same as the members of UDlgContext
+	int32 ActiveNodeIndex = INDEX_NONE;
+	TArray<FDlgOptionRecord> OptionRecords;
+	TArray<int32> AvailableOptionRecords;
+	FDlgHistory History;
+	TArray<FDlgNodeState> NodeStates;
+	TSharedPtr<FDlgMemory> Memory;
+	bool bDialogueEnded = false;
+
+	// Unique for each MoveStateTo, the context keeps its caches only for the state it moved out last
+	uint64 Revision = 0;
+};
+
+
 UENUM()
 enum class EDlgValidateStatus : uint8
 {
@@ -87,6 +203,7 @@ public:
 	//
 
 	void PostInitProperties() override { Super::PostInitProperties(); }
+	void BeginDestroy() override;
 
 	UDlgContext(const FObjectInitializer& ObjectInitializer);
 
@@ -152,16 +269,16 @@ public:
 
 	// Gets the number of options with satisfied conditions (number of options)
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Options|Satisfied")
-	int32 GetOptionsNum() const { return AvailableChildren.Num(); }
+	int32 GetOptionsNum() const { return AvailableOptionRecords.Num(); }
 
 	// Is the OptionIndex valid index for the satisfied conditions?
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Options|Satisfied")
-	bool IsValidOptionIndex(int32 OptionIndex) const { return AvailableChildren.IsValidIndex(OptionIndex);  }
+	bool IsValidOptionIndex(int32 OptionIndex) const { return AvailableOptionRecords.IsValidIndex(OptionIndex);  }
 
 	// Gets the Text of the (satisfied) option with index OptionIndex
 	// NOTE: This is just a helper method, you could have called GetOption
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Options|Satisfied")
-	const FText& GetOptionText(int32 OptionIndex) const;
+	FText GetOptionText(int32 OptionIndex) const;
 
 	// Gets the SpeakerState of the (satisfied) edge with index OptionIndex
 	// NOTE: This is just a helper method, you could have called GetOption
@@ -178,9 +295,12 @@ public:
 	const FDlgEdge& GetOption(int32 OptionIndex) const;
 
 	// Gets all satisfied edges
+	// NOTE: the edges are copied from the Dialogue on the first call after each reevaluation, prefer the functions above
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Options|Satisfied")
-	const TArray<FDlgEdge>& GetOptionsArray() const { return AvailableChildren; }
-	TArray<FDlgEdge>& GetMutableOptionsArray() { return AvailableChildren; }
+	const TArray<FDlgEdge>& GetOptionsArray() const;
+
+	UE_DEPRECATED(5.4, "GetMutableOptionsArray has been deprecated, the options are records now and changing the copies does not change them, use ResetOptions/AddOption")
+	TArray<FDlgEdge>& GetMutableOptionsArray() { GetOptionsArray(); return AvailableChildren; }
 
 	//
 	//  Use these functions bellow if you don't care about unsatisfied player options:
@@ -189,15 +309,15 @@ public:
 
 	// Gets the number of options (both satisfied and unsatisfied ones are counted)
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Options|All")
-	int32 GetAllOptionsNum() const { return AllChildren.Num(); }
+	int32 GetAllOptionsNum() const { return OptionRecords.Num(); }
 
 	// Is the Index valid index for both satisfied and unsatisfied conditions
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Options|All")
-	bool IsValidAllOptionIndex(int32 Index) const { return AllChildren.IsValidIndex(Index);  }
+	bool IsValidAllOptionIndex(int32 Index) const { return OptionRecords.IsValidIndex(Index);  }
 
 	// Gets the Text of an option from the all list, which includes the unsatisfied ones as well
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Options|All")
-	const FText& GetOptionTextFromAll(int32 Index) const;
+	FText GetOptionTextFromAll(int32 Index) const;
 
 	// Is the option at Index satisfied? (Does it meet all the conditions)
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Options|All")
@@ -212,9 +332,41 @@ public:
 	const FDlgEdgeData& GetOptionFromAll(int32 Index) const;
 
 	// Gets all edges (both satisfied and unsatisfied)
+	// NOTE: the edges are copied from the Dialogue on the first call after each reevaluation, prefer the functions above
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Options|All")
-	const TArray<FDlgEdgeData>& GetAllOptionsArray() const { return AllChildren; }
-	TArray<FDlgEdgeData>& GetAllMutableOptionsArray() { return AllChildren; }
+	const TArray<FDlgEdgeData>& GetAllOptionsArray() const;
+
+	UE_DEPRECATED(5.4, "GetAllMutableOptionsArray has been deprecated, the options are records now and changing the copies does not change them, use ResetOptions/AddOption")
+	TArray<FDlgEdgeData>& GetAllMutableOptionsArray() { GetAllOptionsArray(); return AllChildren; }
+
+	//
+	// Options without copying the edges, the indices are the same as above
+	//
+
+	// All the options (both satisfied and unsatisfied ones), same order as GetAllOptionsArray
+	const TArray<FDlgOptionRecord>& GetAllOptionRecords() const { return OptionRecords; }
+
+	// Gets the satisfied option with index OptionIndex, nullptr if the index is invalid
+	const FDlgOptionRecord* FindOptionRecord(int32 OptionIndex) const
+	{
+		return AvailableOptionRecords.IsValidIndex(OptionIndex) ? &OptionRecords[AvailableOptionRecords[OptionIndex]] : nullptr;
+	}
+
+	// Gets the option with index Index from all the options, nullptr if the index is invalid
+	const FDlgOptionRecord* FindOptionRecordFromAll(int32 Index) const
+	{
+		return OptionRecords.IsValidIndex(Index) ? &OptionRecords[Index] : nullptr;
+	}
+
+	// Gets the edge of the option from the Dialogue, the invalid edge if it does not exist anymore
+	const FDlgEdge& GetOptionRecordEdge(const FDlgOptionRecord& Record) const;
+
+	// Gets the text of the option, formatted for this context on first access if the edge has text arguments
+	FText GetOptionRecordText(const FDlgOptionRecord& Record) const;
+
+	// Used by the nodes (UDlgNode::ReevaluateChildren) to fill the options of the active node
+	void ResetOptions();
+	void AddOption(int32 NodeIndex, int32 EdgeIndex, const FDlgEdge& Edge, bool bSatisfied, bool bInnerEdge = false);
 
 	/**
 	*  Checks if the node connected directly to one of the active player choices was already visited or not
@@ -247,6 +399,7 @@ public:
 	//
 
 	// Gets the Text of the active node index
+	// NOTE: the text arguments are formatted on the first call and cached until the node changes or one of their variables is marked dirty
 	UFUNCTION(BlueprintPure, Category = "Dialogue|ActiveNode")
 	const FText& GetActiveNodeText() const;
 
@@ -315,6 +468,9 @@ public:
 	UDlgNode_SpeechSequence* GetMutableActiveNodeAsSpeechSequence() const;
 	const UDlgNode_SpeechSequence* GetActiveNodeAsSpeechSequence() const;
 
+	// The active entry of the active node if it is a speech sequence, nullptr otherwise
+	const FDlgSpeechSequenceEntry* GetActiveSpeechSequenceEntry() const;
+
 	//
 	// Data
 	//
@@ -365,7 +521,12 @@ public:
 	// Depending on the node the EnterNode() call can lead to other EnterNode() calls - having NodeIndex as active node after the call
 	// is not granted
 	// Conditions are not checked here - they are expected to be satisfied
-	bool EnterNode(int32 NodeIndex, TSet<const UDlgNode*> NodesEnteredWithThisStep);
+	bool EnterNode(int32 NodeIndex, FDlgTraversalState& NodesEnteredWithThisStep);
+	bool EnterNode(int32 NodeIndex)
+	{
+		FDlgTraversalState NodesEnteredWithThisStep;
+		return EnterNode(NodeIndex, NodesEnteredWithThisStep);
+	}
 
 	// Adds the node as visited in the current dialogue memory
 	virtual void SetNodeVisited(int32 NodeIndex, const FGuid& NodeGUID);
@@ -375,6 +536,11 @@ public:
 
 	virtual FDlgNodeSavedData& GetNodeSavedData(const FGuid& NodeGUID);
 
+	// The dialogue memory this context reads/writes, the global FDlgMemory if none was set (see UDlgMemorySubsystem)
+	FDlgMemory& GetMemory() const { return Memory.IsValid() ? *Memory : FDlgMemory::Get(); }
+	const TSharedPtr<FDlgMemory>& GetMemoryPtr() const { return Memory; }
+	void SetMemory(const TSharedPtr<FDlgMemory>& InMemory) { Memory = InMemory; }
+
 	// Gets the Node at the NodeIndex index
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Data", DisplayName = "Get Node From Index")
 	UDlgNode* GetMutableNodeFromIndex(int32 NodeIndex) const;
@@ -404,13 +570,91 @@ public:
 
 	// Checks the enter conditions of the node.
 	// return false if they are not satisfied or if the index is invalid
-	bool IsNodeEnterable(int32 NodeIndex, TSet<const UDlgNode*> AlreadyVisitedNodes) const;
+	bool IsNodeEnterable(int32 NodeIndex, FDlgTraversalState& AlreadyVisitedNodes) const;
+	bool IsNodeEnterable(int32 NodeIndex) const
+	{
+		FDlgTraversalState AlreadyVisitedNodes;
+		return IsNodeEnterable(NodeIndex, AlreadyVisitedNodes);
+	}
+
+	// Runtime state of the node at NodeIndex in this context, the default state if it was never written
+	const FDlgNodeState& GetNodeState(int32 NodeIndex) const
+	{
+		static const FDlgNodeState DefaultState;
+		return NodeStates.IsValidIndex(NodeIndex) ? NodeStates[NodeIndex] : DefaultState;
+	}
+	FDlgNodeState& GetMutableNodeState(int32 NodeIndex);
+
+	// Resolves the participants (and their class variables) of every condition from the Dialogue, see FDlgBoundCondition.
+	// Called every time the participants change, ReevaluateOptions and EnterNode call it again if the bound conditions are outdated.
+	void BindConditions();
+
+	// Are the bound conditions up to date with the Dialogue and with the properties of the participants?
+	bool AreConditionsBound() const;
+
+	// Are the nodes and edges evaluated from the baked Dialogue (see UDlgDialogue::GetBakedDialogue)?
+	// True if the conditions were bound to the baked Dialogue and they are still up to date.
+	bool CanUseBakedDialogue() const { return bConditionsBoundToBakedDialogue && AreConditionsBound(); }
+
+	// Same as FDlgEdge::Evaluate for the edge at EdgeIndex of FDlgBakedDialogue::Edges, only call it if CanUseBakedDialogue
+	bool IsBakedEdgeSatisfied(int32 EdgeIndex, FDlgTraversalState& AlreadyVisitedNodes) const;
+
+	// Same as Edge.Evaluate, Edge is the child at ChildIndex of the node at NodeIndex. Uses the baked Dialogue if possible.
+	bool IsEdgeSatisfied(int32 NodeIndex, int32 ChildIndex, const FDlgEdge& Edge, FDlgTraversalState& AlreadyVisitedNodes) const;
+
+	// Gets the bound version of the Conditions array (from a node or an edge of the Dialogue)
+	// @return false if the array was not bound (or it changed since), FDlgCondition::EvaluateArray then looks everything up by name
+	bool GetBoundConditions(
+		const TArray<FDlgCondition>& Conditions,
+		FName DefaultParticipantName,
+		TArrayView<const FDlgBoundCondition>& OutBoundConditions
+	) const;
+
+	// Evaluates the thread safe conditions (see FDlgCondition::IsThreadSafe) of the Edges of the node at NodeIndex and the enter
+	// conditions of their target nodes on worker threads, if enabled (see UDlgSystemSettings::bParallelConditionsEvaluation).
+	// The next evaluations use the results instead, until ClearThreadSafeConditionResults.
+	// @return false if nothing was evaluated
+	bool EvaluateThreadSafeConditions(int32 NodeIndex, const TArray<FDlgEdge>& Edges);
+	void ClearThreadSafeConditionResults() { ThreadSafeConditionResults.Reset(); }
+
+	// Gets the result of the bound Condition from EvaluateThreadSafeConditions
+	// @return false if it was not evaluated
+	bool GetThreadSafeConditionResult(const FDlgBoundCondition& Condition, bool& bOutIsMet) const;
+
+	/**
+	 * Opt-in: ReevaluateOptions only reevaluates the options that read a participant variable marked dirty since the last call
+	 * (with MarkParticipantVariableDirty or UDlgManager::NotifyParticipantVariableChanged), plus the ones depending on
+	 * something that can not be tracked by name (custom conditions, node history, enter restrictions).
+	 * NOTE: every change of a value read by the conditions must be notified, the Modify events of the Dialogue do it automatically.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Control")
+	void SetIncrementalReevaluation(bool bEnabled);
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Control")
+	bool IsIncrementalReevaluationEnabled() const { return bIncrementalReevaluation; }
+
+	// The next ReevaluateOptions reevaluates the options reading VariableName (or the condition named VariableName) of ParticipantName
+	// The texts with text arguments reading it are formatted again on their next access (even without incremental reevaluation)
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Control")
+	void MarkParticipantVariableDirty(FName ParticipantName, FName VariableName);
+
+	// The next ReevaluateOptions reevaluates all the options
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Control")
+	void MarkAllOptionsDirty() { bAllOptionsDirty = true; }
+
+	// Used by UDlgNode::ReevaluateChildren to record the options of the node for the incremental ReevaluateOptions
+	void ResetIncrementalOptions(int32 NodeIndex);
+	void AddIncrementalOption(const FDlgEdge& Edge, bool bSatisfied);
 
 	// Initializes/Starts the context, the first (start) node is selected and the first valid child node is entered.
 	// Called by the UDlgManager which creates the context
 	bool Start(UDlgDialogue* InDialogue, const TMap<FName, UObject*>& InParticipants) { return StartWithContext(TEXT(""), InDialogue, InParticipants); }
 	bool StartWithContext(const FString& ContextString, UDlgDialogue* InDialogue, const TMap<FName, UObject*>& InParticipants);
 
+	// Same as StartWithContext but the participants are NOT validated again, they must be valid (see ValidateParticipantsMapForDialogue)
+	// Used by UDlgManager::StartDialoguesBatch which validates them itself
+	bool StartWithValidatedParticipants(const FString& ContextString, UDlgDialogue* InDialogue, const TMap<FName, UObject*>& InParticipants);
+
 	//
 	// Initializes/Start the context using the given node as entry point
 	// This is useful to resume a dialogue
@@ -536,6 +780,22 @@ public:
 	// Create a copy of the current Context
 	UDlgContext* CreateCopy() const;
 
+	// Forgets the Dialogue, the Participants and all the runtime data so that the context can be started again, see UDlgContextPool
+	// The allocations are kept for the next use
+	void ResetForReuse();
+
+	// Moves the runtime data of this context into OutState
+	// The Dialogue, the Participants and the bound conditions are kept for the next MoveStateFrom, call ResetForReuse to forget them
+	void MoveStateTo(FDlgContextState& OutState);
+
+	// Replaces the runtime data of this context with the one of the State, the State is left empty until MoveStateTo
+	// The conditions are only bound again if the Dialogue or the Participants differ from the ones of this context
+	// Return false if the Dialogue or any Participant of the State was destroyed
+	bool MoveStateFrom(FDlgContextState& State);
+
+	// FDlgContextState::Revision of the last state moved out of this context, 0 if the context was used since then
+	uint64 GetMovedStateRevision() const { return MovedStateRevision; }
+
 	// Checks if the context could be started, used to check if there is any reachable node from the start node
 	static bool CanBeStarted(UDlgDialogue* InDialogue, const TMap<FName, UObject*>& InParticipants);
 
@@ -573,6 +833,21 @@ public:
 	);
 
 protected:
+	// Enters the first child of the start nodes that can be entered, the Dialogue and the Participants must be set
+	bool EnterFirstStartNodeChild(const FString& ContextString);
+
+	// ContextName appended to ContextString (if any), only called when something has to be logged
+	static FString FormatContextMessage(const FString& ContextString, const TCHAR* ContextName);
+
+	// Same as ValidateParticipantsMapForDialogue, the context message is only formatted from ContextString and ContextName if something is wrong
+	static bool ValidateParticipantsMapForDialogueWithContext(
+		const FString& ContextString,
+		const TCHAR* ContextName,
+		const UDlgDialogue* Dialogue,
+		const TMap<FName, UObject*>& ParticipantsMap,
+		bool bLog = true
+	);
+
 	// bool StartInternal(UDlgDialogue* InDialogue, const TMap<FName, UObject*>& InParticipants, bool bLog, FString& OutErrorMessage);
 	void LogErrorWithContext(const FString& ErrorMessage) const;
 	FString GetErrorMessageWithContext(const FString& ErrorMessage) const;
@@ -581,6 +856,58 @@ protected:
 	{
 		Participants = InParticipants;
 		SerializeParticipants();
+		BindConditions();
+	}
+
+	void BindConditionsArray(const TArray<FDlgCondition>& Conditions, FName DefaultParticipantName);
+
+	// Binds the condition pool of the baked Dialogue, false if it does not match the conditions of the nodes (see UDlgDialogue::ValidateBakedConditions)
+	bool BindBakedConditions();
+
+	// The conditions array is already bound at StartIndex (same order), only registers it
+	void AddBoundConditionsRange(const TArray<FDlgCondition>& Conditions, FName DefaultParticipantName, int32 StartIndex, int32 Num);
+
+	// Same as UDlgNode::CheckNodeEnterConditions (and the overrides of the plugin nodes) from the baked Dialogue
+	bool IsBakedNodeEnterable(int32 NodeIndex, FDlgTraversalState& AlreadyVisitedNodes) const;
+
+	bool AreBakedConditionsSatisfied(const FDlgBakedConditionsRange& Range) const
+	{
+		return Range.Num == 0
+			|| FDlgCondition::EvaluateBoundArray(*this, TArrayView<const FDlgBoundCondition>(BoundConditions.GetData() + Range.StartIndex, Range.Num));
+	}
+
+	// Every node goes back to its default state, called when the Dialogue is (re)started
+	void ResetNodeStates()
+	{
+		NodeStates.Reset();
+		NodeStates.SetNum(Dialogue ? Dialogue->GetNodes().Num() : 0);
+	}
+
+	// Only reevaluates the volatile and dirty options of the active node
+	// @return false if the records are outdated or no option is available, the caller has to do a full reevaluation
+	bool ReevaluateOptionsIncremental();
+	bool IsAnyDependencyDirty(const FDlgIncrementalOption& Option) const;
+	void GatherEdgeDependencies(const FDlgEdge& Edge, FDlgIncrementalOption& Option, FDlgTraversalState& AlreadyVisitedNodes) const;
+	void GatherConditionsDependencies(const TArray<FDlgCondition>& Conditions, FName DefaultParticipantName, FDlgIncrementalOption& Option) const;
+	void HandleParticipantVariableChanged(const UObject* Participant, FName VariableName);
+	void BindParticipantVariableChanged();
+	void UnbindParticipantVariableChanged();
+
+	// The formatted texts are kept until the active node changes or until a variable read by their text arguments is marked dirty
+	void ResetFormattedTexts();
+	void InvalidateFormattedTexts();
+
+	// Forgets the copies of the edges of the options (AvailableChildren, AllChildren), keeps the memory
+	void ResetOptionCopies() const;
+
+	// The copy of the edge of a single option, the arrays are sized on first use so that the references to the other copies stay valid
+	const FDlgEdge& GetOptionCopy(int32 OptionIndex) const;
+	const FDlgEdgeData& GetOptionCopyFromAll(int32 Index) const;
+	void PrepareFormattedTexts();
+	void AddFormattedTextDependencies(const TArray<FDlgTextArgument>& Arguments, FName NodeOwner) const;
+	static uint64 GetFormattedOptionTextKey(int32 NodeIndex, int32 EdgeIndex, bool bInnerEdge)
+	{
+		return (static_cast<uint64>(static_cast<uint32>(NodeIndex)) << 32) | (static_cast<uint32>(EdgeIndex) << 1) | (bInnerEdge ? 1 : 0);
 	}
 
 protected:
@@ -600,15 +927,22 @@ protected:
 	// The index of the active node in the dialogues Nodes array
 	int32 ActiveNodeIndex = INDEX_NONE;
 
-	// Options of the active node with satisfied conditions - the options the player can choose from
-	TArray<FDlgEdge> AvailableChildren;
-
 	/**
 	 *  List of options which is possible, or would be with satisfied conditions
 	 *  (e.g. in case of virtual parent it isn't necessary the node's child, that's why we have this array here
 	 *  instead of simply returning something from active node
 	 */
-	TArray<FDlgEdgeData> AllChildren;
+	TArray<FDlgOptionRecord> OptionRecords;
+
+	// Indices in OptionRecords of the options with satisfied conditions - the options the player can choose from
+	TArray<int32> AvailableOptionRecords;
+
+	// Copies of the edges of the options, built on demand by GetOptionsArray/GetAllOptionsArray (or one by one by GetOption/GetOptionFromAll)
+	// An entry with an invalid edge was not copied yet
+	mutable TArray<FDlgEdge> AvailableChildren;
+	mutable TArray<FDlgEdgeData> AllChildren;
+	mutable bool bAvailableChildrenBuilt = false;
+	mutable bool bAllChildrenBuilt = false;
 
 	// Node indices visited in this specific Dialogue instance (isn't serialized)
 	// History for this Context only
@@ -616,4 +950,57 @@ protected:
 
 	// cache the result of the last ChooseOption call
 	bool bDialogueEnded = false;
+
+	// Runtime state of the nodes in this context, indexed by the node index
+	TArray<FDlgNodeState> NodeStates;
+
+	// See GetMemory
+	TSharedPtr<FDlgMemory> Memory;
+
+	// All the conditions of the Dialogue bound to the Participants, contiguous per conditions array
+	TArray<FDlgBoundCondition> BoundConditions;
+
+	// Conditions array from the Dialogue => where its bound version is inside BoundConditions
+	TMap<const TArray<FDlgCondition>*, FDlgBoundConditionsRange> BoundConditionsRanges;
+
+	// Result of each of the BoundConditions evaluated by EvaluateThreadSafeConditions (1 or 0), INDEX_NONE if it was not evaluated
+	TArray<int8> ThreadSafeConditionResults;
+
+	// The BoundConditions evaluated by EvaluateThreadSafeConditions, kept to reuse the memory
+	TArray<int32> ThreadSafeConditionIndices;
+
+	// The Dialogue and FNYReflectionHelper::GetPropertyCacheGeneration() the conditions were bound for
+	const UDlgDialogue* BoundConditionsDialogue = nullptr;
+	int32 BoundConditionsPropertyCacheGeneration = INDEX_NONE;
+
+	// FDlgBakedDialogue::GetGeneration of the Dialogue when the conditions were bound, it changes with every edit of the nodes
+	// (UDlgDialogue::RebuildBakedDialogue), so the bindings from the nodes are out of date as well once it changes
+	int32 BoundConditionsBakedGeneration = INDEX_NONE;
+
+	// The start of BoundConditions is FDlgBakedDialogue::Conditions of BoundConditionsBakedGeneration, see CanUseBakedDialogue
+	bool bConditionsBoundToBakedDialogue = false;
+
+	// See GetMovedStateRevision
+	uint64 MovedStateRevision = 0;
+
+	// See SetIncrementalReevaluation
+	bool bIncrementalReevaluation = false;
+	bool bAllOptionsDirty = true;
+
+	// The node and the Children of it the IncrementalOptions were recorded for
+	int32 IncrementalOptionsNodeIndex = INDEX_NONE;
+	TArray<FDlgIncrementalOption> IncrementalOptions;
+
+	// Marked since the last ReevaluateOptions
+	TSet<FDlgConditionDependency> DirtyDependencies;
+
+	// Texts formatted with their text arguments, see ResetFormattedTexts
+	// The options are added by AddOption so that the getters never change the map, the returned references stay valid
+	mutable FDlgFormattedText FormattedActiveNodeText;
+	mutable TMap<uint64, FDlgFormattedText> FormattedOptionTexts;
+
+	// Participant variables read by the text arguments of the formatted texts
+	mutable TSet<FDlgConditionDependency> FormattedTextsDependencies;
+
+	FDelegateHandle OnParticipantVariableChangedHandle;
 };
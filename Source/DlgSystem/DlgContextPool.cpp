@@ -0,0 +1,214 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgContextPool.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "DlgContext.h"
+#include "DlgSystemSettings.h"
+#include "Logging/DlgLogger.h"
+
+
+void UDlgContextPool::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	OnPreGarbageCollectHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &ThisClass::HandlePreGarbageCollect);
+}
+
+void UDlgContextPool::Deinitialize()
+{
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(OnPreGarbageCollectHandle);
+	FreeContexts.Empty();
+	StateContexts.Empty();
+	ParticipantBinding.Empty();
+	Super::Deinitialize();
+}
+
+UDlgContextPool* UDlgContextPool::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject || !GEngine)
+	{
+		return nullptr;
+	}
+
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+	{
+		return World->GetSubsystem<UDlgContextPool>();
+	}
+
+	return nullptr;
+}
+
+UDlgContext* UDlgContextPool::AcquireContext()
+{
+	while (FreeContexts.Num() > 0)
+	{
+		UDlgContext* Context = FreeContexts.Pop();
+		if (IsValid(Context))
+		{
+			return Context;
+		}
+	}
+
+	return NewObject<UDlgContext>(this, UDlgContext::StaticClass());
+}
+
+void UDlgContextPool::ReleaseContext(UDlgContext* Context)
+{
+	if (!IsValid(Context))
+	{
+		return;
+	}
+
+	if (Context->GetOuter() != this)
+	{
+		FDlgLogger::Get().Warningf(
+			TEXT("DlgContextPool - ReleaseContext - Context = `%s` was not created by this pool, ignoring it"),
+			*Context->GetPathName()
+		);
+		return;
+	}
+
+	if (FreeContexts.Contains(Context))
+	{
+		return;
+	}
+
+	// Forget the participants even if it is not kept, so that it does not keep them alive
+	Context->ResetForReuse();
+	if (FreeContexts.Num() < GetDefault<UDlgSystemSettings>()->MaxPooledContexts)
+	{
+		FreeContexts.Add(Context);
+	}
+}
+
+UDlgContext* UDlgContextPool::AcquireStateContext(const FDlgContextState& State)
+{
+	int32 FoundIndex = INDEX_NONE;
+	for (int32 Index = StateContexts.Num() - 1; Index >= 0; Index--)
+	{
+		const UDlgContext* Context = StateContexts[Index];
+		if (!IsValid(Context))
+		{
+			StateContexts.RemoveAtSwap(Index);
+			continue;
+		}
+
+		// Keeps its caches as well
+		if (Context->GetMovedStateRevision() == State.Revision)
+		{
+			FoundIndex = Index;
+			break;
+		}
+		if (FoundIndex == INDEX_NONE && Context->GetDialogue() == State.GetDialogue())
+		{
+			FoundIndex = Index;
+		}
+	}
+
+	if (FoundIndex != INDEX_NONE)
+	{
+		UDlgContext* Context = StateContexts[FoundIndex];
+		StateContexts.RemoveAtSwap(FoundIndex);
+		return Context;
+	}
+
+	return AcquireContext();
+}
+
+void UDlgContextPool::ReleaseStateContext(UDlgContext* Context)
+{
+	if (StateContexts.Num() < GetDefault<UDlgSystemSettings>()->MaxPooledContexts)
+	{
+		StateContexts.Add(Context);
+	}
+	else
+	{
+		ReleaseContext(Context);
+	}
+}
+
+void UDlgContextPool::HandlePreGarbageCollect()
+{
+	for (UDlgContext* Context : StateContexts)
+	{
+		ReleaseContext(Context);
+	}
+	StateContexts.Reset();
+}
+
+UDlgContext* UDlgContextPool::StartPooledDialogue(UDlgDialogue* Dialogue, const TArray<UObject*>& Participants, const TSharedPtr<FDlgMemory>& Memory)
+{
+	static const FString ContextString = TEXT("DlgContextPool - StartDialogue");
+	if (!UDlgContext::ConvertArrayOfParticipantsToMap(ContextString, Dialogue, Participants, ParticipantBinding))
+	{
+		return nullptr;
+	}
+
+	UDlgContext* Context = AcquireContext();
+	Context->SetMemory(Memory);
+	if (Context->StartWithContext(ContextString, Dialogue, ParticipantBinding))
+	{
+		return Context;
+	}
+
+	ReleaseContext(Context);
+	return nullptr;
+}
+
+bool UDlgContextPool::StartDialogueState(
+	FDlgContextState& OutState,
+	UDlgDialogue* Dialogue,
+	const TArray<UObject*>& Participants,
+	const TSharedPtr<FDlgMemory>& Memory
+)
+{
+	UDlgContext* Context = StartPooledDialogue(Dialogue, Participants, Memory);
+	if (!Context)
+	{
+		return false;
+	}
+
+	Context->MoveStateTo(OutState);
+	ReleaseStateContext(Context);
+	return true;
+}
+
+bool UDlgContextPool::UpdateState(FDlgContextState& State, TFunctionRef<bool(UDlgContext& Context)> Function)
+{
+	if (State.HasDialogueEnded())
+	{
+		return false;
+	}
+
+	UDlgContext* Context = AcquireStateContext(State);
+	if (!Context->MoveStateFrom(State))
+	{
+		FDlgLogger::Get().Warning(TEXT("DlgContextPool - UpdateState - The Dialogue or a Participant of the State was destroyed, ending it"));
+		State.bDialogueEnded = true;
+		ReleaseContext(Context);
+		return false;
+	}
+
+	const bool bResult = Function(*Context);
+	Context->MoveStateTo(State);
+	ReleaseStateContext(Context);
+	return bResult;
+}
+
+bool UDlgContextPool::ChooseOption(FDlgContextState& State, int32 OptionIndex)
+{
+	return UpdateState(State, [OptionIndex](UDlgContext& Context)
+	{
+		return Context.ChooseOption(OptionIndex);
+	});
+}
+
+bool UDlgContextPool::ReevaluateOptions(FDlgContextState& State)
+{
+	return UpdateState(State, [](UDlgContext& Context)
+	{
+		return Context.ReevaluateOptions();
+	});
+}
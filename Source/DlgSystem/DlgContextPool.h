@@ -0,0 +1,108 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "DlgContextPool.generated.h"
+
+class UDlgContext;
+class UDlgDialogue;
+struct FDlgContextState;
+struct FDlgMemory;
+
+/**
+ * Pool of the contexts of a world, so that starting a dialogue does not have to create a new UDlgContext every time
+ * and the ended ones do not have to be garbage collected.
+ *
+ * Two ways of using it:
+ *  - StartDialogue + ReleaseContext: same as UDlgManager::StartDialogue, the context must be released once the dialogue ends.
+ *    NOTE: the released contexts are reused, do not keep any reference to them.
+ *  - StartDialogueState + UpdateState/ChooseOption/ReevaluateOptions: the dialogue is kept in a FDlgContextState (no UObject),
+ *    a pooled context is only borrowed while the state is advanced. For systems that never expose the context (e.g. barks).
+ *    The borrowed contexts stay bound to the Dialogue and the Participants until the next garbage collection,
+ *    so that advancing the same dialogue again does not have to bind its conditions again.
+ *
+ * NOTE: the pooled contexts are owned by this subsystem and not by the first participant, do not pool the replicated contexts.
+ */
+UCLASS()
+class DLGSYSTEM_API UDlgContextPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//
+	// USubsystem Interface
+	//
+
+	void Initialize(FSubsystemCollectionBase& Collection) override;
+	void Deinitialize() override;
+
+	//
+	// Own methods
+	//
+
+	// Gets the pool of the world of the WorldContextObject, nullptr if the object is not in a world
+	static UDlgContextPool* Get(const UObject* WorldContextObject);
+
+	// A free (reset) context, created if the pool is empty
+	UDlgContext* AcquireContext();
+
+	// Gives the Context back to the pool, it is reset and reused by the next AcquireContext
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Pool")
+	void ReleaseContext(UDlgContext* Context);
+
+	// Same as UDlgManager::StartDialogueWithContext but the context comes from the pool, release it with ReleaseContext
+	UDlgContext* StartPooledDialogue(UDlgDialogue* Dialogue, const TArray<UObject*>& Participants, const TSharedPtr<FDlgMemory>& Memory = nullptr);
+
+	// Same as UDlgManager::StartDialogue but the context comes from the pool, release it with ReleaseContext
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Pool")
+	UDlgContext* StartDialogue(UDlgDialogue* Dialogue, UPARAM(ref)const TArray<UObject*>& Participants)
+	{
+		return StartPooledDialogue(Dialogue, Participants);
+	}
+
+	// Starts the Dialogue into OutState, no context is kept
+	// Return false if the Dialogue could not be started
+	bool StartDialogueState(
+		FDlgContextState& OutState,
+		UDlgDialogue* Dialogue,
+		const TArray<UObject*>& Participants,
+		const TSharedPtr<FDlgMemory>& Memory = nullptr
+	);
+
+	// Borrows a context for the State and calls Function with it (e.g. to read the active node text), the result is moved back into the State
+	// Return the result of Function, false if the dialogue of the State ended or it can not be advanced anymore (destroyed participants)
+	bool UpdateState(FDlgContextState& State, TFunctionRef<bool(UDlgContext& Context)> Function);
+
+	// Same as UDlgContext::ChooseOption and UDlgContext::ReevaluateOptions but for the State
+	bool ChooseOption(FDlgContextState& State, int32 OptionIndex);
+	bool ReevaluateOptions(FDlgContextState& State);
+
+	// Number of contexts waiting to be reused
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Pool")
+	int32 GetNumFreeContexts() const { return FreeContexts.Num(); }
+
+protected:
+	// A context for the State, the one the State was moved out of or one bound to the same Dialogue if possible
+	UDlgContext* AcquireStateContext(const FDlgContextState& State);
+
+	// Keeps the Context bound to the Dialogue and the Participants of the state moved out of it, see StateContexts
+	void ReleaseStateContext(UDlgContext* Context);
+
+	// Releases the StateContexts so that they do not keep the participants alive
+	void HandlePreGarbageCollect();
+
+protected:
+	UPROPERTY(Transient)
+	TArray<UDlgContext*> FreeContexts;
+
+	// Contexts borrowed by the states, still bound to the Dialogue and the Participants of the last state moved out of them
+	UPROPERTY(Transient)
+	TArray<UDlgContext*> StateContexts;
+
+	FDelegateHandle OnPreGarbageCollectHandle;
+
+	// Reused by all the starts
+	TMap<FName, UObject*> ParticipantBinding;
+};
@@ -2,6 +2,9 @@
 #include "DlgDialogue.h"
 
 #include "UObject/DevObjectVersion.h"
+#if NY_ENGINE_VERSION >= 504
+#include "UObject/AssetRegistryTagsContext.h"
+#endif
 #include "HAL/FileManager.h"
 #include "Misc/Paths.h"
 
@@ -21,6 +24,7 @@
 #include "DlgManager.h"
 #include "Logging/DlgLogger.h"
 #include "DlgHelper.h"
+#include "DlgDialogueIndex.h"
 
 #define LOCTEXT_NAMESPACE "DlgDialogue"
 
@@ -171,6 +175,8 @@ void UDlgDialogue::PostLoad()
 		}
 	}
 
+	RebuildBakedDialogue();
+	FDlgDialogueIndex::Get().OnDialogueLoaded(*this);
 	bWasLoaded = true;
 }
 
@@ -207,12 +213,15 @@ void UDlgDialogue::PostInitProperties()
 			*GUID.ToString(), *GetPathName()
 		);
 	}
+
+	FDlgDialogueIndex::Get().OnDialogueLoaded(*this);
 }
 
 void UDlgDialogue::PostRename(UObject* OldOuter, const FName OldName)
 {
 	Super::PostRename(OldOuter, OldName);
 	Name = GetDialogueFName();
+	FDlgDialogueIndex::Get().OnDialogueRenamed(*this);
 }
 
 void UDlgDialogue::PostDuplicate(bool bDuplicateForPIE)
@@ -241,6 +250,43 @@ void UDlgDialogue::PostEditImport()
 	);
 }
 
+void UDlgDialogue::BeginDestroy()
+{
+	// The index can be already destroyed on exit
+	if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) && !GExitPurge)
+	{
+		FDlgDialogueIndex::Get().OnDialogueUnloaded(*this);
+	}
+
+	Super::BeginDestroy();
+}
+
+#if NY_ENGINE_VERSION >= 504
+void UDlgDialogue::GetAssetRegistryTags(FAssetRegistryTagsContext Context) const
+{
+	Super::GetAssetRegistryTags(Context);
+
+	TArray<TPair<FName, FString>> TagValues;
+	FDlgDialogueIndexEntry::GetTagValues(*this, TagValues);
+	for (TPair<FName, FString>& Pair : TagValues)
+	{
+		Context.AddTag(FAssetRegistryTag(Pair.Key, MoveTemp(Pair.Value), FAssetRegistryTag::TT_Hidden));
+	}
+}
+#else
+void UDlgDialogue::GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const
+{
+	Super::GetAssetRegistryTags(OutTags);
+
+	TArray<TPair<FName, FString>> TagValues;
+	FDlgDialogueIndexEntry::GetTagValues(*this, TagValues);
+	for (TPair<FName, FString>& Pair : TagValues)
+	{
+		OutTags.Add(FAssetRegistryTag(Pair.Key, MoveTemp(Pair.Value), FAssetRegistryTag::TT_Hidden));
+	}
+}
+#endif
+
 #if WITH_EDITOR
 TSharedPtr<IDlgEditorAccess> UDlgDialogue::DialogueEditorAccess = nullptr;
 
@@ -268,6 +314,7 @@ bool UDlgDialogue::Modify(bool bAlwaysMarkDirty)
 void UDlgDialogue::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
+	RebuildBakedDialogue();
 
 	// Signal to the listeners
 	check(OnDialoguePropertyChanged.IsBound());
@@ -617,6 +664,7 @@ void UDlgDialogue::RebuildAndUpdateNode(UDlgNode* Node, const UDlgSystemSettings
 	{
 		Node->UpdateTextsNamespacesAndKeys(Settings, bEdges, bUpdateGraphNode);
 	}
+	Node->CompileTextFormats(bEdges);
 
 	// Sync with the editor aka bUpdateGraphNode = true
 	Node->UpdateGraphNode();
@@ -723,6 +771,9 @@ void UDlgDialogue::UpdateAndRefreshData(bool bUpdateTextsNamespacesAndKeys)
 	// Remove default values
 	AllSpeakerStates.Remove(FName(NAME_None));
 
+	RebuildBakedDialogue();
+	FDlgDialogueIndex::Get().OnDialogueChanged(*this);
+
 	//
 	// Fill ParticipantClasses
 	//
@@ -828,6 +879,7 @@ void UDlgDialogue::SetNodes(const TArray<UDlgNode*>& InNodes)
 	{
 		UpdateGUIDToIndexMap(Nodes[NodeIndex], NodeIndex);
 	}
+	RebuildBakedDialogue();
 }
 
 void UDlgDialogue::SetNode(int32 NodeIndex, UDlgNode* InNode)
@@ -839,6 +891,7 @@ void UDlgDialogue::SetNode(int32 NodeIndex, UDlgNode* InNode)
 
 	Nodes[NodeIndex] = InNode;
 	UpdateGUIDToIndexMap(InNode, NodeIndex);
+	RebuildBakedDialogue();
 }
 
 void UDlgDialogue::UpdateGUIDToIndexMap(const UDlgNode* Node, int32 NodeIndex)
@@ -853,6 +906,10 @@ void UDlgDialogue::UpdateGUIDToIndexMap(const UDlgNode* Node, int32 NodeIndex)
 
 bool UDlgDialogue::IsEndNode(int32 NodeIndex) const
 {
+	if (const FDlgNodeDescriptor* Descriptor = GetNodeDescriptor(NodeIndex))
+	{
+		return Descriptor->bIsEnd;
+	}
 	if (!Nodes.IsValidIndex(NodeIndex))
 	{
 		return false;
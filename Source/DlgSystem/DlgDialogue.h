@@ -6,6 +6,7 @@
 #include "IDlgEditorAccess.h"
 #include "DlgSystemSettings.h"
 #include "DlgDialogueParticipantData.h"
+#include "DlgBakedDialogue.h"
 
 #if NY_ENGINE_VERSION >= 500
 #include "UObject/ObjectSaveContext.h"
@@ -127,6 +128,16 @@ public:
 	*/
 	void PostEditImport() override;
 
+	/** Called before destroying the object. This is called immediately upon deciding to destroy the object, to allow the object to begin an asynchronous cleanup process. */
+	void BeginDestroy() override;
+
+	/** Writes the data used by the FDlgDialogueIndex, so that the Dialogues can be queried without loading them. */
+#if NY_ENGINE_VERSION >= 504
+	void GetAssetRegistryTags(FAssetRegistryTagsContext Context) const override;
+#else
+	void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const override;
+#endif
+
 #if WITH_EDITOR
 	/**
 	 * Note that the object will be modified.  If we are currently recording into the
@@ -282,6 +293,7 @@ public:
 	// Gets all the SpeakerStates used inside this Dialogue
 	UFUNCTION(BlueprintPure, Category = "Dialogue")
 	TSet<FName> GetSpeakerStates() const { return AllSpeakerStates; }
+	const TSet<FName>& GetSpeakerStatesRef() const { return AllSpeakerStates; }
 
 	// Gets the Condition Names that correspond to the provided ParticipantName.
 	UFUNCTION(BlueprintPure, Category = "Dialogue")
@@ -630,6 +642,28 @@ public:
 	// Is the Node at NodeIndex (if it exists) an end node?
 	bool IsEndNode(int32 NodeIndex) const;
 
+	// Rebuilds the flattened runtime data of the Nodes, called after loading and after the Nodes are modified
+	void RebuildBakedDialogue() { BakedDialogue.Build(*this); }
+
+	// Everything falls back to the UDlgNode objects until the next RebuildBakedDialogue
+	void EmptyBakedDialogue() { BakedDialogue.Empty(); }
+
+	// See FDlgBakedDialogue::ValidateConditions, expects HasValidBakedDialogue
+	bool ValidateBakedConditions() { return BakedDialogue.ValidateConditions(*this); }
+
+	// Flattened runtime data of the Nodes, check IsValidFor before using it
+	const FDlgBakedDialogue& GetBakedDialogue() const { return BakedDialogue; }
+	bool HasValidBakedDialogue() const { return BakedDialogue.IsValidFor(*this); }
+
+	// Precomputed data of each Node, same indices as GetNodes
+	const TArray<FDlgNodeDescriptor>& GetNodeDescriptors() const { return BakedDialogue.NodeDescriptors; }
+
+	// Returns nullptr if NodeIndex is not valid or if the baked data of the node is out of date (nodes or edges added without a rebuild)
+	const FDlgNodeDescriptor* GetNodeDescriptor(int32 NodeIndex) const
+	{
+		return BakedDialogue.IsValidForNode(*this, NodeIndex) ? &BakedDialogue.NodeDescriptors[NodeIndex] : nullptr;
+	}
+
 	// Check if a text file in the same folder with the same name (Name) exists and loads the data from that file.
 	void ImportFromFile();
 
@@ -744,6 +778,9 @@ protected:
 	UPROPERTY(VisibleAnywhere, AdvancedDisplay, Category = "Dialogue", DisplayName = "Nodes GUID To Index Map")
 	TMap<FGuid, int32> NodesGUIDToIndexMap;
 
+	// See GetBakedDialogue, not serialized
+	FDlgBakedDialogue BakedDialogue;
+
 	// Useful for syncing on the first run with the text file.
 	bool bIsSyncedWithTextFile = false;
 
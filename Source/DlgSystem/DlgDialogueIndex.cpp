@@ -0,0 +1,669 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgDialogueIndex.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/AssetData.h"
+#include "Interfaces/IPluginManager.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Algo/BinarySearch.h"
+
+#include "IDlgSystemModule.h"
+#include "DlgConstants.h"
+#include "DlgDialogue.h"
+#include "DlgHelper.h"
+#include "Logging/DlgLogger.h"
+
+const FName FDlgDialogueIndex::TagNameVersion(TEXT("DlgIndexVersion"));
+const FName FDlgDialogueIndex::TagNameGUID(TEXT("DlgGUID"));
+const FName FDlgDialogueIndex::TagNameParticipantsData(TEXT("DlgParticipantsData"));
+const FName FDlgDialogueIndex::TagNameSpeakerStates(TEXT("DlgSpeakerStates"));
+
+namespace DlgDialogueIndex
+{
+	using FCondensedJsonWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+	using FCondensedJsonWriterFactory = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+	// Identifiers inside the DlgParticipantsData tag
+	static const TCHAR* IdentifierConditions = TEXT("Conditions");
+	static const TCHAR* IdentifierEvents = TEXT("Events");
+	static const TCHAR* IdentifierInts = TEXT("Ints");
+	static const TCHAR* IdentifierFloats = TEXT("Floats");
+	static const TCHAR* IdentifierBools = TEXT("Bools");
+	static const TCHAR* IdentifierNames = TEXT("Names");
+
+	static void WriteNames(FCondensedJsonWriter& Writer, const TCHAR* Identifier, const TSet<FName>& Names)
+	{
+		if (Names.Num() == 0)
+		{
+			return;
+		}
+
+		Writer.WriteArrayStart(Identifier);
+		for (const FName Name : Names)
+		{
+			Writer.WriteValue(Name.ToString());
+		}
+		Writer.WriteArrayEnd();
+	}
+
+	static void ReadNames(const TArray<TSharedPtr<FJsonValue>>& Values, TSet<FName>& OutNames)
+	{
+		OutNames.Reserve(Values.Num());
+		for (const TSharedPtr<FJsonValue>& Value : Values)
+		{
+			if (Value.IsValid())
+			{
+				OutNames.Add(FName(*Value->AsString()));
+			}
+		}
+	}
+
+	static void ReadNames(const FJsonObject& Object, const TCHAR* Identifier, TSet<FName>& OutNames)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+		if (Object.TryGetArrayField(Identifier, Values) && Values)
+		{
+			ReadNames(*Values, OutNames);
+		}
+	}
+
+	static FString WriteParticipantsData(const TMap<FName, FDlgParticipantData>& ParticipantsData)
+	{
+		FString Result;
+		const TSharedRef<FCondensedJsonWriter> Writer = FCondensedJsonWriterFactory::Create(&Result);
+		Writer->WriteObjectStart();
+		for (const auto& Pair : ParticipantsData)
+		{
+			const FDlgParticipantData& Data = Pair.Value;
+			Writer->WriteObjectStart(Pair.Key.ToString());
+			WriteNames(*Writer, IdentifierConditions, Data.Conditions);
+			WriteNames(*Writer, IdentifierEvents, Data.Events);
+			WriteNames(*Writer, IdentifierInts, Data.IntVariableNames);
+			WriteNames(*Writer, IdentifierFloats, Data.FloatVariableNames);
+			WriteNames(*Writer, IdentifierBools, Data.BoolVariableNames);
+			WriteNames(*Writer, IdentifierNames, Data.NameVariableNames);
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		return Result;
+	}
+
+	static bool ReadParticipantsData(const FString& String, TMap<FName, FDlgParticipantData>& OutParticipantsData)
+	{
+		TSharedPtr<FJsonObject> RootObject;
+		const TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(String);
+		if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+		{
+			return false;
+		}
+
+		OutParticipantsData.Reserve(RootObject->Values.Num());
+		for (const auto& Pair : RootObject->Values)
+		{
+			const TSharedPtr<FJsonObject>* Object = nullptr;
+			if (!Pair.Value.IsValid() || !Pair.Value->TryGetObject(Object) || !Object || !Object->IsValid())
+			{
+				return false;
+			}
+
+			FDlgParticipantData& Data = OutParticipantsData.Add(FName(*Pair.Key));
+			ReadNames(**Object, IdentifierConditions, Data.Conditions);
+			ReadNames(**Object, IdentifierEvents, Data.Events);
+			ReadNames(**Object, IdentifierInts, Data.IntVariableNames);
+			ReadNames(**Object, IdentifierFloats, Data.FloatVariableNames);
+			ReadNames(**Object, IdentifierBools, Data.BoolVariableNames);
+			ReadNames(**Object, IdentifierNames, Data.NameVariableNames);
+		}
+
+		return true;
+	}
+
+	static FString WriteSpeakerStates(const TSet<FName>& SpeakerStates)
+	{
+		FString Result;
+		const TSharedRef<FCondensedJsonWriter> Writer = FCondensedJsonWriterFactory::Create(&Result);
+		Writer->WriteArrayStart();
+		for (const FName SpeakerState : SpeakerStates)
+		{
+			Writer->WriteValue(SpeakerState.ToString());
+		}
+		Writer->WriteArrayEnd();
+		Writer->Close();
+
+		return Result;
+	}
+
+	static bool ReadSpeakerStates(const FString& String, TSet<FName>& OutSpeakerStates)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		const TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(String);
+		if (!FJsonSerializer::Deserialize(Reader, Values))
+		{
+			return false;
+		}
+
+		ReadNames(Values, OutSpeakerStates);
+		return true;
+	}
+
+	static void CopyIndexedData(const FDlgParticipantData& From, FDlgParticipantData& To)
+	{
+		To.Conditions = From.Conditions;
+		To.Events = From.Events;
+		To.IntVariableNames = From.IntVariableNames;
+		To.FloatVariableNames = From.FloatVariableNames;
+		To.BoolVariableNames = From.BoolVariableNames;
+		To.NameVariableNames = From.NameVariableNames;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FDlgIndexedNames
+void FDlgIndexedNames::Add(FName Name)
+{
+	int32& Count = Counts.FindOrAdd(Name);
+	if (Count++ == 0)
+	{
+		Sorted.Insert(Name, Algo::LowerBound(Sorted, Name, &FDlgHelper::PredicateSortFNameAlphabeticallyAscending));
+	}
+}
+
+void FDlgIndexedNames::Remove(FName Name)
+{
+	int32* Count = Counts.Find(Name);
+	if (!ensure(Count))
+	{
+		return;
+	}
+
+	if (--(*Count) == 0)
+	{
+		Counts.Remove(Name);
+		const int32 Index = Algo::BinarySearch(Sorted, Name, &FDlgHelper::PredicateSortFNameAlphabeticallyAscending);
+		if (ensure(Index != INDEX_NONE))
+		{
+			Sorted.RemoveAt(Index);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FDlgDialogueIndexEntry
+void FDlgDialogueIndexEntry::SetFromDialogue(const UDlgDialogue& InDialogue)
+{
+	GUID = InDialogue.HasGUID() ? InDialogue.GetGUID() : FGuid();
+	SpeakerStates = InDialogue.GetSpeakerStatesRef();
+
+	ParticipantsData.Empty();
+	for (const auto& Pair : InDialogue.GetParticipantsData())
+	{
+		DlgDialogueIndex::CopyIndexedData(Pair.Value, ParticipantsData.Add(Pair.Key));
+	}
+}
+
+bool FDlgDialogueIndexEntry::SetFromAssetData(const FAssetData& AssetData)
+{
+	int32 Version = INDEX_NONE;
+	FString GUIDString, ParticipantsDataString, SpeakerStatesString;
+	if (!AssetData.GetTagValue(FDlgDialogueIndex::TagNameVersion, Version) || Version != FDlgDialogueIndex::TagsVersion ||
+		!AssetData.GetTagValue(FDlgDialogueIndex::TagNameGUID, GUIDString) ||
+		!AssetData.GetTagValue(FDlgDialogueIndex::TagNameParticipantsData, ParticipantsDataString) ||
+		!AssetData.GetTagValue(FDlgDialogueIndex::TagNameSpeakerStates, SpeakerStatesString))
+	{
+		return false;
+	}
+
+	FGuid NewGUID;
+	TMap<FName, FDlgParticipantData> NewParticipantsData;
+	TSet<FName> NewSpeakerStates;
+	if (!FGuid::Parse(GUIDString, NewGUID) ||
+		!DlgDialogueIndex::ReadParticipantsData(ParticipantsDataString, NewParticipantsData) ||
+		!DlgDialogueIndex::ReadSpeakerStates(SpeakerStatesString, NewSpeakerStates))
+	{
+		FDlgLogger::Get().Warningf(
+			TEXT("FDlgDialogueIndexEntry::SetFromAssetData - Invalid asset registry tags for Dialogue = `%s`"),
+			*AssetData.ToSoftObjectPath().ToString()
+		);
+		return false;
+	}
+
+	GUID = NewGUID;
+	ParticipantsData = MoveTemp(NewParticipantsData);
+	SpeakerStates = MoveTemp(NewSpeakerStates);
+	return true;
+}
+
+void FDlgDialogueIndexEntry::GetTagValues(const UDlgDialogue& InDialogue, TArray<TPair<FName, FString>>& OutTagValues)
+{
+	const FGuid DialogueGUID = InDialogue.HasGUID() ? InDialogue.GetGUID() : FGuid();
+	OutTagValues.Emplace(FDlgDialogueIndex::TagNameVersion, FString::FromInt(FDlgDialogueIndex::TagsVersion));
+	OutTagValues.Emplace(FDlgDialogueIndex::TagNameGUID, DialogueGUID.ToString());
+	OutTagValues.Emplace(FDlgDialogueIndex::TagNameParticipantsData, DlgDialogueIndex::WriteParticipantsData(InDialogue.GetParticipantsData()));
+	OutTagValues.Emplace(FDlgDialogueIndex::TagNameSpeakerStates, DlgDialogueIndex::WriteSpeakerStates(InDialogue.GetSpeakerStates()));
+}
+
+FGuid FDlgDialogueIndexEntry::GetGUID() const
+{
+	if (const UDlgDialogue* LoadedDialogue = Dialogue.Get())
+	{
+		return LoadedDialogue->HasGUID() ? LoadedDialogue->GetGUID() : FGuid();
+	}
+
+	return GUID;
+}
+
+const TSet<FName>& FDlgDialogueIndexEntry::GetNames(const FDlgParticipantData& Data, EDlgIndexedNameKind Kind)
+{
+	switch (Kind)
+	{
+		case EDlgIndexedNameKind::Int:
+			return Data.IntVariableNames;
+		case EDlgIndexedNameKind::Float:
+			return Data.FloatVariableNames;
+		case EDlgIndexedNameKind::Bool:
+			return Data.BoolVariableNames;
+		case EDlgIndexedNameKind::Name:
+			return Data.NameVariableNames;
+		case EDlgIndexedNameKind::Condition:
+			return Data.Conditions;
+		case EDlgIndexedNameKind::Event:
+		default:
+			return Data.Events;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FDlgDialogueIndex
+TArray<FString> FDlgDialogueIndex::GetSearchPaths()
+{
+	TArray<FString> PathsToSearch = { TEXT("/Game") };
+
+	// Add the current plugin dir
+	// TODO maybe add all the non engine plugin paths? IPluginManager::Get().GetEnabledPlugins()
+	const TSharedPtr<IPlugin> ThisPlugin = IPluginManager::Get().FindPlugin(DIALOGUE_SYSTEM_PLUGIN_NAME.ToString());
+	if (ThisPlugin.IsValid())
+	{
+		FString PluginPath = ThisPlugin->GetMountedAssetPath();
+		// See NOTE in the header
+		PluginPath.RemoveFromEnd(TEXT("/"));
+		PathsToSearch.Add(PluginPath);
+	}
+
+	return PathsToSearch;
+}
+
+void FDlgDialogueIndex::ForEachEntry(TFunctionRef<void(const FSoftObjectPath& Path, const FDlgDialogueIndexEntry& Entry)> Function)
+{
+	if (!bBuilt)
+	{
+		BuildFromAssetRegistry();
+	}
+
+	for (const auto& Pair : Entries)
+	{
+		Function(Pair.Key, Pair.Value);
+	}
+}
+
+const TArray<FName>& FDlgDialogueIndex::GetParticipantNames()
+{
+	if (!bBuilt)
+	{
+		BuildFromAssetRegistry();
+	}
+
+	return ParticipantNames.GetSorted();
+}
+
+const TArray<FName>& FDlgDialogueIndex::GetSpeakerStates()
+{
+	if (!bBuilt)
+	{
+		BuildFromAssetRegistry();
+	}
+
+	return SpeakerStates.GetSorted();
+}
+
+const TArray<FName>& FDlgDialogueIndex::GetParticipantNames(FName ParticipantName, EDlgIndexedNameKind Kind)
+{
+	if (!bBuilt)
+	{
+		BuildFromAssetRegistry();
+	}
+
+	static const TArray<FName> EmptyNames;
+	const FParticipantNames* Names = ParticipantsNames.Find(ParticipantName);
+	return Names ? Names->Names[static_cast<int32>(Kind)].GetSorted() : EmptyNames;
+}
+
+bool FDlgDialogueIndex::FindPathByGUID(const FGuid& GUID, FSoftObjectPath& OutPath)
+{
+	if (!bBuilt)
+	{
+		BuildFromAssetRegistry();
+	}
+
+	for (const auto& Pair : Entries)
+	{
+		if (Pair.Value.GetGUID() == GUID)
+		{
+			OutPath = Pair.Key;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int32 FDlgDialogueIndex::Num()
+{
+	int32 Count = 0;
+	ForEachEntry([&Count](const FSoftObjectPath&, const FDlgDialogueIndexEntry&)
+	{
+		Count++;
+	});
+	return Count;
+}
+
+void FDlgDialogueIndex::Reset()
+{
+	bBuilt = false;
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (It->Value.Dialogue.IsValid())
+		{
+			It->Value.bFromAssetRegistry = false;
+		}
+		else
+		{
+			RemoveEntryNames(It->Value);
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FDlgDialogueIndex::OnDialogueLoaded(const UDlgDialogue& Dialogue)
+{
+	FDlgDialogueIndexEntry& Entry = Entries.FindOrAdd(FSoftObjectPath(&Dialogue));
+	Entry.Dialogue = &Dialogue;
+	SetEntryFromDialogue(Entry, Dialogue);
+}
+
+void FDlgDialogueIndex::OnDialogueChanged(const UDlgDialogue& Dialogue)
+{
+	FSoftObjectPath Path;
+	if (FindPathOfDialogue(Dialogue, Path))
+	{
+		SetEntryFromDialogue(Entries.FindChecked(Path), Dialogue);
+	}
+	else
+	{
+		// Not loaded yet, e.g. UpdateAndRefreshData from PostLoad
+		OnDialogueLoaded(Dialogue);
+	}
+}
+
+void FDlgDialogueIndex::OnDialogueRenamed(const UDlgDialogue& Dialogue)
+{
+	FSoftObjectPath OldPath;
+	if (!FindPathOfDialogue(Dialogue, OldPath))
+	{
+		return;
+	}
+
+	const FSoftObjectPath NewPath(&Dialogue);
+	if (OldPath == NewPath)
+	{
+		return;
+	}
+
+	// Saved assets are moved by OnAssetRenamed, the old entry keeps the data until then
+	FDlgDialogueIndexEntry& OldEntry = Entries.FindChecked(OldPath);
+	if (OldEntry.bFromAssetRegistry)
+	{
+		OldEntry.Dialogue.Reset();
+	}
+	else
+	{
+		RemoveEntry(OldPath);
+	}
+
+	OnDialogueLoaded(Dialogue);
+}
+
+void FDlgDialogueIndex::OnDialogueUnloaded(const UDlgDialogue& Dialogue)
+{
+	FSoftObjectPath Path;
+	if (!FindPathOfDialogue(Dialogue, Path))
+	{
+		return;
+	}
+
+	// Keep the last data of saved Dialogues, it is the same or newer than the one in the asset registry
+	FDlgDialogueIndexEntry& Entry = Entries.FindChecked(Path);
+	if (Entry.bFromAssetRegistry)
+	{
+		Entry.Dialogue.Reset();
+	}
+	else
+	{
+		RemoveEntry(Path);
+	}
+}
+
+void FDlgDialogueIndex::OnAssetAdded(const FAssetData& AssetData)
+{
+	// Added on build
+	if (!bBuilt || !IsDialogueAsset(AssetData))
+	{
+		return;
+	}
+
+	AddFromAssetData(AssetData);
+}
+
+void FDlgDialogueIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+	if (!bBuilt || !IsDialogueAsset(AssetData))
+	{
+		return;
+	}
+
+	RemoveEntry(AssetData.ToSoftObjectPath());
+}
+
+void FDlgDialogueIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	if (!bBuilt || !IsDialogueAsset(AssetData))
+	{
+		return;
+	}
+
+	RemoveEntry(FSoftObjectPath(OldObjectPath));
+	AddFromAssetData(AssetData);
+}
+
+void FDlgDialogueIndex::OnAssetUpdated(const FAssetData& AssetData)
+{
+	OnAssetAdded(AssetData);
+}
+
+void FDlgDialogueIndex::BuildFromAssetRegistry()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(NAME_MODULE_AssetRegistry).Get();
+
+	// The initial scan is not finished yet (editor), only scan the paths we care about, this does not load anything
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		AssetRegistry.ScanPathsSynchronous(GetSearchPaths());
+	}
+
+	FARFilter Filter;
+	Filter.bRecursiveClasses = true;
+#if NY_ENGINE_VERSION >= 501
+	Filter.ClassPaths.Add(UDlgDialogue::StaticClass()->GetClassPathName());
+#else
+	Filter.ClassNames.Add(UDlgDialogue::StaticClass()->GetFName());
+#endif
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	Entries.Reserve(Entries.Num() + Assets.Num());
+	int32 NumLoadedDialogues = 0;
+	for (const FAssetData& AssetData : Assets)
+	{
+		if (!AddFromAssetData(AssetData))
+		{
+			NumLoadedDialogues++;
+		}
+	}
+
+	if (NumLoadedDialogues > 0)
+	{
+		FDlgLogger::Get().Infof(
+			TEXT("FDlgDialogueIndex::BuildFromAssetRegistry - Loaded %d Dialogues saved without the index asset registry tags. Resave them so that they are no longer loaded."),
+			NumLoadedDialogues
+		);
+	}
+
+	bBuilt = true;
+}
+
+bool FDlgDialogueIndex::AddFromAssetData(const FAssetData& AssetData)
+{
+	const FSoftObjectPath Path = AssetData.ToSoftObjectPath();
+	FDlgDialogueIndexEntry* Entry = &Entries.FindOrAdd(Path);
+	Entry->bFromAssetRegistry = true;
+
+	// The loaded Dialogue has the same or newer data
+	if (Entry->Dialogue.IsValid())
+	{
+		return true;
+	}
+	if (SetEntryFromAssetData(*Entry, AssetData))
+	{
+		return true;
+	}
+
+	// Saved without the tags, the data is only available by loading it
+	// NOTE: PostLoad calls OnDialogueLoaded which can add to the Entries
+	if (const UDlgDialogue* Dialogue = Cast<UDlgDialogue>(AssetData.GetAsset()))
+	{
+		Entry = &Entries.FindOrAdd(Path);
+		Entry->bFromAssetRegistry = true;
+		Entry->Dialogue = Dialogue;
+		SetEntryFromDialogue(*Entry, *Dialogue);
+	}
+
+	return false;
+}
+
+bool FDlgDialogueIndex::IsDialogueAsset(const FAssetData& AssetData)
+{
+	const UClass* Class = AssetData.GetClass();
+	return Class && Class->IsChildOf<UDlgDialogue>();
+}
+
+bool FDlgDialogueIndex::FindPathOfDialogue(const UDlgDialogue& Dialogue, FSoftObjectPath& OutPath) const
+{
+	// Fast path, the Dialogue was not renamed since it was added
+	const FSoftObjectPath Path(&Dialogue);
+	const FDlgDialogueIndexEntry* Entry = Entries.Find(Path);
+	if (Entry && Entry->Dialogue.Get() == &Dialogue)
+	{
+		OutPath = Path;
+		return true;
+	}
+
+	for (const auto& Pair : Entries)
+	{
+		if (Pair.Value.Dialogue.Get() == &Dialogue)
+		{
+			OutPath = Pair.Key;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FDlgDialogueIndex::SetEntryFromDialogue(FDlgDialogueIndexEntry& Entry, const UDlgDialogue& Dialogue)
+{
+	RemoveEntryNames(Entry);
+	Entry.SetFromDialogue(Dialogue);
+	AddEntryNames(Entry);
+}
+
+bool FDlgDialogueIndex::SetEntryFromAssetData(FDlgDialogueIndexEntry& Entry, const FAssetData& AssetData)
+{
+	RemoveEntryNames(Entry);
+	const bool bResult = Entry.SetFromAssetData(AssetData);
+	AddEntryNames(Entry);
+	return bResult;
+}
+
+void FDlgDialogueIndex::RemoveEntry(const FSoftObjectPath& Path)
+{
+	if (const FDlgDialogueIndexEntry* Entry = Entries.Find(Path))
+	{
+		RemoveEntryNames(*Entry);
+		Entries.Remove(Path);
+	}
+}
+
+void FDlgDialogueIndex::AddEntryNames(const FDlgDialogueIndexEntry& Entry)
+{
+	for (const FName SpeakerState : Entry.SpeakerStates)
+	{
+		SpeakerStates.Add(SpeakerState);
+	}
+
+	for (const auto& Pair : Entry.ParticipantsData)
+	{
+		ParticipantNames.Add(Pair.Key);
+		FParticipantNames& Names = ParticipantsNames.FindOrAdd(Pair.Key);
+		for (int32 KindIndex = 0; KindIndex < static_cast<int32>(EDlgIndexedNameKind::Num); KindIndex++)
+		{
+			for (const FName Name : FDlgDialogueIndexEntry::GetNames(Pair.Value, static_cast<EDlgIndexedNameKind>(KindIndex)))
+			{
+				Names.Names[KindIndex].Add(Name);
+			}
+		}
+	}
+}
+
+void FDlgDialogueIndex::RemoveEntryNames(const FDlgDialogueIndexEntry& Entry)
+{
+	for (const FName SpeakerState : Entry.SpeakerStates)
+	{
+		SpeakerStates.Remove(SpeakerState);
+	}
+
+	for (const auto& Pair : Entry.ParticipantsData)
+	{
+		if (FParticipantNames* Names = ParticipantsNames.Find(Pair.Key))
+		{
+			for (int32 KindIndex = 0; KindIndex < static_cast<int32>(EDlgIndexedNameKind::Num); KindIndex++)
+			{
+				for (const FName Name : FDlgDialogueIndexEntry::GetNames(Pair.Value, static_cast<EDlgIndexedNameKind>(KindIndex)))
+				{
+					Names->Names[KindIndex].Remove(Name);
+				}
+			}
+		}
+
+		ParticipantNames.Remove(Pair.Key);
+		if (!ParticipantNames.Contains(Pair.Key))
+		{
+			ParticipantsNames.Remove(Pair.Key);
+		}
+	}
+}
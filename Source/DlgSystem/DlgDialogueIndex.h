@@ -0,0 +1,178 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#include "DlgDialogueParticipantData.h"
+
+class UDlgDialogue;
+struct FAssetData;
+
+// Kind of the names of a participant kept by the FDlgDialogueIndex
+enum class EDlgIndexedNameKind : uint8
+{
+	Int = 0,
+	Float,
+	Bool,
+	Name,
+	Condition,
+	Event,
+
+	Num
+};
+
+// Reference counted set of names that keeps them sorted (see FDlgHelper::SortDefault) at all times
+struct DLGSYSTEM_API FDlgIndexedNames
+{
+public:
+	void Add(FName Name);
+	void Remove(FName Name);
+
+	const TArray<FName>& GetSorted() const { return Sorted; }
+	bool Contains(FName Name) const { return Counts.Contains(Name); }
+	int32 Num() const { return Sorted.Num(); }
+
+protected:
+	// Number of Dialogues that use each name
+	TMap<FName, int32> Counts;
+	TArray<FName> Sorted;
+};
+
+// Indexed data of a single Dialogue, see FDlgDialogueIndex
+struct DLGSYSTEM_API FDlgDialogueIndexEntry
+{
+public:
+	// Copies the indexed data from the Dialogue
+	void SetFromDialogue(const UDlgDialogue& InDialogue);
+
+	// Reads the indexed data from the asset registry tags
+	// Return false if the asset was saved without the tags (or with an older version of them)
+	bool SetFromAssetData(const FAssetData& AssetData);
+
+	// Writes the indexed data of the Dialogue as asset registry tag values, see UDlgDialogue::GetAssetRegistryTags
+	static void GetTagValues(const UDlgDialogue& InDialogue, TArray<TPair<FName, FString>>& OutTagValues);
+
+	// The indexed names of the Data
+	static const TSet<FName>& GetNames(const FDlgParticipantData& Data, EDlgIndexedNameKind Kind);
+
+	// The Dialogue if it is loaded
+	const UDlgDialogue* GetLoadedDialogue() const { return Dialogue.Get(); }
+
+	// Live GUID if the Dialogue is loaded
+	FGuid GetGUID() const;
+
+	// Same as the loaded Dialogue (kept in sync by FDlgDialogueIndex::OnDialogueChanged) or as the saved one
+	const TMap<FName, FDlgParticipantData>& GetParticipantsData() const { return ParticipantsData; }
+	const TSet<FName>& GetSpeakerStates() const { return SpeakerStates; }
+
+public:
+	// Only the Conditions, Events and the Int/Float/Bool/Name variable names are indexed from the FDlgParticipantData
+	// NOTE: modify only through FDlgDialogueIndex, the names of the index are counted from these
+	FGuid GUID;
+	TMap<FName, FDlgParticipantData> ParticipantsData;
+	TSet<FName> SpeakerStates;
+
+	TWeakObjectPtr<const UDlgDialogue> Dialogue;
+
+	// Does this exist in the asset registry? false for transient/not yet saved Dialogues
+	bool bFromAssetRegistry = false;
+};
+
+/**
+ * Index of all the Dialogues, loaded or not, used by the UDlgManager queries so that they do not have to load the Dialogues.
+ *
+ * Built on first use from the asset registry tags written by UDlgDialogue::GetAssetRegistryTags, the Dialogues that are loaded
+ * register themselves here and their live data is used instead (unsaved changes, transient Dialogues).
+ * Kept up to date by the asset registry events forwarded from FDlgSystemModule and by UDlgDialogue::UpdateAndRefreshData.
+ *
+ * The names used by all the Dialogues are reference counted and kept sorted, every change of an entry only updates
+ * the names of that entry, so the name queries (details panel pickers) only cost a copy of the result.
+ *
+ * NOTE: Dialogues saved before the tags existed are loaded once when the index is built, resave them to avoid that.
+ */
+class DLGSYSTEM_API FDlgDialogueIndex
+{
+public:
+	static FDlgDialogueIndex& Get()
+	{
+		static FDlgDialogueIndex Instance;
+		return Instance;
+	}
+
+	// Version of the asset registry tags, bump it when the tags change so that the old ones are ignored
+	static constexpr int32 TagsVersion = 1;
+	static const FName TagNameVersion;
+	static const FName TagNameGUID;
+	static const FName TagNameParticipantsData;
+	static const FName TagNameSpeakerStates;
+
+	// Paths the Dialogues are searched in: /Game and the content of this plugin
+	// NOTE: All paths must NOT have the forward slash "/" at the end.
+	static TArray<FString> GetSearchPaths();
+
+	// Iterates over all the Dialogues, builds the index if needed
+	void ForEachEntry(TFunctionRef<void(const FSoftObjectPath& Path, const FDlgDialogueIndexEntry& Entry)> Function);
+
+	// Sorted names used by all the Dialogues, builds the index if needed
+	const TArray<FName>& GetParticipantNames();
+	const TArray<FName>& GetSpeakerStates();
+	const TArray<FName>& GetParticipantNames(FName ParticipantName, EDlgIndexedNameKind Kind);
+
+	// Finds the path of the Dialogue with the GUID, builds the index if needed
+	bool FindPathByGUID(const FGuid& GUID, FSoftObjectPath& OutPath);
+
+	// Number of indexed Dialogues, builds the index if needed
+	int32 Num();
+
+	bool IsBuilt() const { return bBuilt; }
+
+	// Forgets the asset registry data, rebuilt on the next query
+	void Reset();
+
+	// Called by the Dialogues
+	void OnDialogueLoaded(const UDlgDialogue& Dialogue);
+	void OnDialogueChanged(const UDlgDialogue& Dialogue);
+	void OnDialogueRenamed(const UDlgDialogue& Dialogue);
+	void OnDialogueUnloaded(const UDlgDialogue& Dialogue);
+
+	// Asset registry events, forwarded by FDlgSystemModule
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnAssetUpdated(const FAssetData& AssetData);
+
+protected:
+	void BuildFromAssetRegistry();
+
+	// Return false if the Dialogue had to be loaded because it has no tags
+	bool AddFromAssetData(const FAssetData& AssetData);
+
+	static bool IsDialogueAsset(const FAssetData& AssetData);
+	bool FindPathOfDialogue(const UDlgDialogue& Dialogue, FSoftObjectPath& OutPath) const;
+
+	// All the changes of the entries go through these, so that the names stay in sync
+	void SetEntryFromDialogue(FDlgDialogueIndexEntry& Entry, const UDlgDialogue& Dialogue);
+	bool SetEntryFromAssetData(FDlgDialogueIndexEntry& Entry, const FAssetData& AssetData);
+	void RemoveEntry(const FSoftObjectPath& Path);
+	void AddEntryNames(const FDlgDialogueIndexEntry& Entry);
+	void RemoveEntryNames(const FDlgDialogueIndexEntry& Entry);
+
+protected:
+	// Names of a single participant
+	struct FParticipantNames
+	{
+		FDlgIndexedNames Names[static_cast<int32>(EDlgIndexedNameKind::Num)];
+	};
+
+	TMap<FSoftObjectPath, FDlgDialogueIndexEntry> Entries;
+
+	// Names of all the Entries
+	FDlgIndexedNames ParticipantNames;
+	FDlgIndexedNames SpeakerStates;
+	TMap<FName, FParticipantNames> ParticipantsNames;
+
+	// Was the asset registry data added?
+	bool bBuilt = false;
+};
@@ -171,3 +171,17 @@ void FDlgParticipantData::AddTextArgumentData(const FDlgTextArgument& TextArgume
 			break;
 	}
 }
+
+bool FDlgParticipantData::IsReadByConditions(FName Name) const
+{
+	// Superset, the variable sets also contain the names used by the events and text arguments
+	return Conditions.Contains(Name)
+		|| IntVariableNames.Contains(Name)
+		|| FloatVariableNames.Contains(Name)
+		|| BoolVariableNames.Contains(Name)
+		|| NameVariableNames.Contains(Name)
+		|| ClassIntVariableNames.Contains(Name)
+		|| ClassFloatVariableNames.Contains(Name)
+		|| ClassBoolVariableNames.Contains(Name)
+		|| ClassNameVariableNames.Contains(Name);
+}
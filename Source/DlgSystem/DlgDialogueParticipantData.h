@@ -20,6 +20,9 @@ public:
 	void AddEventData(const FDlgEvent& Event);
 	void AddTextArgumentData(const FDlgTextArgument& TextArgument);
 
+	// Is Name a condition name or a variable name read by the conditions of the Dialogue?
+	bool IsReadByConditions(FName Name) const;
+
 public:
 	// FName based conditions (aka conditions of type EventCall).
 	UPROPERTY(BlueprintReadWrite, VisibleAnywhere, Category = "Dialogue|Participant")
@@ -3,6 +3,7 @@
 
 #include "DlgConstants.h"
 #include "DlgContext.h"
+#include "DlgDialogue.h"
 #include "DlgLocalizationHelper.h"
 #include "Nodes/DlgNode_Selector.h"
 #include "Nodes/DlgNode_Speech.h"
@@ -81,7 +82,7 @@ void FDlgEdge::UpdateTextsNamespacesAndKeys(const UObject* ParentObject, const U
 	FDlgLocalizationHelper::UpdateTextNamespaceAndKey(ParentObject, Settings, Text);
 }
 
-bool FDlgEdge::Evaluate(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const
+bool FDlgEdge::Evaluate(const UDlgContext& Context, FDlgTraversalState& AlreadyVisitedNodes) const
 {
 	if (!IsValid())
 	{
@@ -105,10 +106,15 @@ void FDlgEdge::RebuildConstructedText(const UDlgContext& Context, FName Fallback
 		return;
 	}
 
-	FFormatNamedArguments OrderedArguments;
-	for (const FDlgTextArgument& DlgArgument : TextArguments)
+	ConstructedText = FormatText(Context, FallbackParticipantName);
+}
+
+FText FDlgEdge::FormatText(const UDlgContext& Context, FName FallbackParticipantName) const
+{
+	if (TextArguments.Num() <= 0)
 	{
-		OrderedArguments.Add(DlgArgument.DisplayString, DlgArgument.ConstructFormatArgumentValue(Context, FallbackParticipantName));
+		return Text;
 	}
-	ConstructedText = FText::AsCultureInvariant(FText::Format(Text, OrderedArguments));
+
+	return FDlgTextArgument::FormatText(FDlgTextArgument::GetTextFormat(Text, TextFormat), TextArguments, Context, FallbackParticipantName);
 }
@@ -14,6 +14,7 @@ class UDlgContext;
 class UDlgNode;
 class UDlgDialogue;
 class UDlgNodeData;
+struct FDlgTraversalState;
 
 /**
  * The representation of a child in a node. Defined by a TargetIndex which points to the index array in the Dialogue.Nodes
@@ -62,15 +63,30 @@ public:
 	void UpdateTextsNamespacesAndKeys(const UObject* ParentObject, const UDlgSystemSettings& Settings);
 
 	// Rebuilds TextArguments
-	void RebuildTextArguments() { FDlgTextArgument::UpdateTextArgumentArray(Text, TextArguments); }
+	void RebuildTextArguments()
+	{
+		FDlgTextArgument::UpdateTextArgumentArray(Text, TextArguments);
+		CompileTextFormat();
+	}
+
+	// Compiles the Text for FormatText, only if it changed since the last compile
+	void CompileTextFormat() { FDlgTextArgument::CompileTextFormat(Text, TextFormat); }
 	void RebuildTextArgumentsFromPreview(const FText& Preview) { FDlgTextArgument::UpdateTextArgumentArray(Preview, TextArguments); }
 
 	// Returns with true if every condition attached to the edge and every enter condition of the target node are satisfied //
-	bool Evaluate(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const;
+	bool Evaluate(const UDlgContext& Context, FDlgTraversalState& AlreadyVisitedNodes) const;
 
 	// Constructs the ConstructedText.
+	UE_DEPRECATED(5.4, "The edges of the Dialogue are not formatted on node enter anymore, use UDlgContext::GetOptionText or FormatText")
 	void RebuildConstructedText(const UDlgContext& Context, FName FallbackParticipantName);
 
+	// Formats the Text with the TextArguments for the Context, without changing the ConstructedText
+	// NOTE: the contexts format the options on demand and cache the result, see UDlgContext::GetOptionText
+	FText FormatText(const UDlgContext& Context, FName FallbackParticipantName) const;
+
+	// Sets the ConstructedText directly, used by UDlgContext to give its copies of the edge the text formatted for it
+	void SetConstructedText(const FText& NewConstructedText) { ConstructedText = NewConstructedText; }
+
 	const TArray<FDlgTextArgument>& GetTextArguments() const { return TextArguments; }
 
 	// Sets the text and rebuilds the formatted constructed text
@@ -87,7 +103,11 @@ public:
 		Text = NewText;
 	}
 
-	/** Gets the edge text. Empty text, or Text formatted with the text arguments if there is any, when the parent node is entered. */
+	/**
+	 * Gets the edge text. Text formatted with the text arguments (if there is any) only for the copies of the edges given by a UDlgContext,
+	 * the edges of the Dialogue are not formatted on node enter anymore.
+	 */
+	UE_DEPRECATED(5.4, "GetText has been deprecated in favour of UDlgContext::GetOptionText (formatted) and GetUnformattedText")
 	const FText& GetText() const
 	{
 		if (TextArguments.Num() > 0 && !ConstructedText.IsEmpty())
@@ -97,7 +117,7 @@ public:
 		return Text;
 	}
 
-	// This always returns the unformatted text, if you want the formatted text use GetText()
+	// This always returns the unformatted text, if you want the formatted text use UDlgContext::GetOptionText
 	const FText& GetUnformattedText() const { return Text; }
 	FText& GetMutableUnformattedText() { return Text; }
 
@@ -148,6 +168,9 @@ protected:
 
 	// Constructed at runtime from the original text and the arguments if there is any.
 	FText ConstructedText;
+
+	// Text compiled as a format pattern, see CompileTextFormat
+	FTextFormat TextFormat;
 };
 
 template<>
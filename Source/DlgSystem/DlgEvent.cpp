@@ -4,8 +4,9 @@
 #include "DlgConstants.h"
 #include "DlgContext.h"
 #include "NYReflectionHelper.h"
-#include "DlgDialogueParticipant.h"
+#include "DlgNativeDialogueParticipant.h"
 #include "DlgHelper.h"
+#include "DlgManager.h"
 #include "Logging/DlgLogger.h"
 
 void FDlgEvent::Call(UDlgContext& Context, const FString& ContextString, UObject* Participant) const
@@ -40,19 +41,19 @@ void FDlgEvent::Call(UDlgContext& Context, const FString& ContextString, UObject
 	switch (EventType)
 	{
 		case EDlgEventType::Event:
-			IDlgDialogueParticipant::Execute_OnDialogueEvent(Participant, &Context, EventName);
+			FDlgParticipantCalls::OnDialogueEvent(Participant, &Context, EventName);
 			break;
 		case EDlgEventType::ModifyInt:
-			IDlgDialogueParticipant::Execute_ModifyIntValue(Participant, EventName, bDelta, IntValue);
+			FDlgParticipantCalls::ModifyIntValue(Participant, EventName, bDelta, IntValue);
 			break;
 		case EDlgEventType::ModifyFloat:
-			IDlgDialogueParticipant::Execute_ModifyFloatValue(Participant, EventName, bDelta, FloatValue);
+			FDlgParticipantCalls::ModifyFloatValue(Participant, EventName, bDelta, FloatValue);
 			break;
 		case EDlgEventType::ModifyBool:
-			IDlgDialogueParticipant::Execute_ModifyBoolValue(Participant, EventName, bValue);
+			FDlgParticipantCalls::ModifyBoolValue(Participant, EventName, bValue);
 			break;
 		case EDlgEventType::ModifyName:
-			IDlgDialogueParticipant::Execute_ModifyNameValue(Participant, EventName, NameValue);
+			FDlgParticipantCalls::ModifyNameValue(Participant, EventName, NameValue);
 			break;
 
 		case EDlgEventType::ModifyClassIntVariable:
@@ -75,6 +76,12 @@ void FDlgEvent::Call(UDlgContext& Context, const FString& ContextString, UObject
 		default:
 			checkNoEntry();
 	}
+
+	// Let the contexts that reevaluate their options incrementally know
+	if (HasDialogueValue(EventType) || HasClassVariable(EventType))
+	{
+		UDlgManager::NotifyParticipantVariableChanged(Participant, EventName);
+	}
 }
 
 FString FDlgEvent::GetEditorDisplayString(UDlgDialogue* OwnerDialogue) const
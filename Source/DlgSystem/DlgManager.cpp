@@ -3,7 +3,6 @@
 
 #include "UObject/UObjectIterator.h"
 #include "Engine/ObjectLibrary.h"
-#include "Interfaces/IPluginManager.h"
 #include "Engine/Blueprint.h"
 #include "EngineUtils.h"
 #include "Engine/Engine.h"
@@ -12,7 +11,11 @@
 #include "DlgConstants.h"
 #include "DlgDialogueParticipant.h"
 #include "DlgDialogue.h"
+#include "DlgDialogueIndex.h"
 #include "DlgMemory.h"
+#include "DlgMemorySubsystem.h"
+#include "DlgParticipantRegistry.h"
+#include "DlgStreamingSubsystem.h"
 #include "DlgContext.h"
 #include "Logging/DlgLogger.h"
 #include "DlgHelper.h"
@@ -21,6 +24,7 @@
 TWeakObjectPtr<const UObject> UDlgManager::UserWorldContextObjectPtr = nullptr;
 
 bool UDlgManager::bCalledLoadAllDialoguesIntoMemory = false;;
+FDlgOnParticipantVariableChanged UDlgManager::OnParticipantVariableChanged;
 
 UDlgContext* UDlgManager::StartDialogueWithDefaultParticipants(UObject* WorldContextObject, UDlgDialogue* Dialogue)
 {
@@ -42,13 +46,35 @@ UDlgContext* UDlgManager::StartDialogueWithDefaultParticipants(UObject* WorldCon
 	}
 
 	// Gather all objects that have our participant name
-	for (UObject* Participant : GetObjectsWithDialogueParticipantInterface(WorldContextObject))
+	// Only look up the names we need from the registry, the world is searched for the names it does not have (if it does not have all the participants)
+	TSet<FName> NamesToSearch;
+	UDlgParticipantRegistry* Registry = UDlgParticipantRegistry::Get(WorldContextObject);
+	const bool bRegistryIsAuthoritative = Registry && Registry->IsAuthoritative();
+	for (auto& Pair : ObjectMap)
 	{
-		const FName ParticipantName = IDlgDialogueParticipant::Execute_GetParticipantName(Participant);
-		if (ObjectMap.Contains(ParticipantName))
+		if (Registry)
+		{
+			for (UObject* Participant : Registry->GetParticipants(Pair.Key))
+			{
+				Pair.Value.AddUnique(Participant);
+				Participants.AddUnique(Participant);
+			}
+		}
+		if (!bRegistryIsAuthoritative && Pair.Value.Num() == 0)
 		{
-			ObjectMap[ParticipantName].AddUnique(Participant);
-			Participants.AddUnique(Participant);
+			NamesToSearch.Add(Pair.Key);
+		}
+	}
+	if (NamesToSearch.Num() > 0)
+	{
+		for (UObject* Participant : GetObjectsWithDialogueParticipantInterface(WorldContextObject))
+		{
+			const FName ParticipantName = IDlgDialogueParticipant::Execute_GetParticipantName(Participant);
+			if (NamesToSearch.Contains(ParticipantName))
+			{
+				ObjectMap[ParticipantName].AddUnique(Participant);
+				Participants.AddUnique(Participant);
+			}
 		}
 	}
 
@@ -99,7 +125,12 @@ UDlgContext* UDlgManager::StartDialogueWithDefaultParticipants(UObject* WorldCon
 	return StartDialogueWithContext(TEXT("StartDialogueWithDefaultParticipants"), Dialogue, Participants);
 }
 
-UDlgContext* UDlgManager::StartDialogueWithContext(const FString& ContextString, UDlgDialogue* Dialogue, const TArray<UObject*>& Participants)
+UDlgContext* UDlgManager::StartDialogueWithContext(
+	const FString& ContextString,
+	UDlgDialogue* Dialogue,
+	const TArray<UObject*>& Participants,
+	const TSharedPtr<FDlgMemory>& Memory
+)
 {
 	const FString ContextMessage = ContextString.IsEmpty()
 		? FString::Printf(TEXT("StartDialogue"))
@@ -112,6 +143,7 @@ UDlgContext* UDlgManager::StartDialogueWithContext(const FString& ContextString,
 	}
 
 	auto* Context = NewObject<UDlgContext>(Participants[0], UDlgContext::StaticClass());
+	Context->SetMemory(Memory);
 	if (Context->StartWithContext(ContextMessage, Dialogue, ParticipantBinding))
 	{
 		return Context;
@@ -120,6 +152,207 @@ UDlgContext* UDlgManager::StartDialogueWithContext(const FString& ContextString,
 	return nullptr;
 }
 
+UDlgContext* UDlgManager::StartDialogueWithMemory(UDlgDialogue* Dialogue, UPARAM(ref)const TArray<UObject*>& Participants, UObject* MemoryOwner)
+{
+	const UObject* WorldContextObject = MemoryOwner ? MemoryOwner : (Participants.Num() > 0 ? Participants[0] : nullptr);
+	UDlgMemorySubsystem* MemorySubsystem = UDlgMemorySubsystem::Get(WorldContextObject);
+	if (!MemorySubsystem)
+	{
+		FDlgLogger::Get().Errorf(
+			TEXT("StartDialogueWithMemory - FAILED to start dialogue because the MemoryOwner = `%s` (or the first participant) is not in a World"),
+			MemoryOwner ? *MemoryOwner->GetPathName() : TEXT("nullptr")
+		);
+		return nullptr;
+	}
+
+	return StartDialogueWithContext(TEXT("StartDialogueWithMemory"), Dialogue, Participants, MemorySubsystem->GetMemory(MemoryOwner));
+}
+
+bool UDlgManager::StartDialogueWhenLoaded(
+	const TSoftObjectPtr<UDlgDialogue>& Dialogue,
+	const TArray<UObject*>& Participants,
+	int32 Priority,
+	FDlgOnDialogueStartedWhenLoaded OnStarted
+)
+{
+	if (Dialogue.IsNull())
+	{
+		FDlgLogger::Get().Error(TEXT("StartDialogueWhenLoaded - FAILED to start dialogue because the Dialogue is INVALID (is empty)!"));
+		OnStarted.ExecuteIfBound(nullptr);
+		return false;
+	}
+
+	// Already loaded, nothing to wait for
+	if (UDlgDialogue* LoadedDialogue = Dialogue.Get())
+	{
+		UDlgContext* Context = StartDialogueWithContext(TEXT("StartDialogueWhenLoaded"), LoadedDialogue, Participants);
+		OnStarted.ExecuteIfBound(Context);
+		return Context != nullptr;
+	}
+
+	UDlgStreamingSubsystem* StreamingSubsystem = UDlgStreamingSubsystem::Get(Participants.Num() > 0 ? Participants[0] : nullptr);
+	if (!StreamingSubsystem)
+	{
+		FDlgLogger::Get().Errorf(
+			TEXT("StartDialogueWhenLoaded - FAILED to start Dialogue = `%s` because the first participant is not in a game World"),
+			*Dialogue.ToString()
+		);
+		OnStarted.ExecuteIfBound(nullptr);
+		return false;
+	}
+
+	// Do not keep the participants alive while loading
+	TArray<TWeakObjectPtr<UObject>> WeakParticipants;
+	WeakParticipants.Reserve(Participants.Num());
+	for (UObject* Participant : Participants)
+	{
+		WeakParticipants.Add(Participant);
+	}
+
+	StreamingSubsystem->RequestDialogue(
+		Dialogue.ToSoftObjectPath(),
+		Priority,
+		FDlgOnDialogueStreamed::CreateLambda([WeakParticipants, OnStarted, DialoguePath = Dialogue.ToString()](UDlgDialogue* LoadedDialogue)
+		{
+			if (!LoadedDialogue)
+			{
+				FDlgLogger::Get().Errorf(TEXT("StartDialogueWhenLoaded - FAILED to load Dialogue = `%s`"), *DialoguePath);
+				OnStarted.ExecuteIfBound(nullptr);
+				return;
+			}
+
+			TArray<UObject*> LoadedParticipants;
+			LoadedParticipants.Reserve(WeakParticipants.Num());
+			for (const TWeakObjectPtr<UObject>& WeakParticipant : WeakParticipants)
+			{
+				UObject* Participant = WeakParticipant.Get();
+				if (!IsValid(Participant))
+				{
+					FDlgLogger::Get().Errorf(
+						TEXT("StartDialogueWhenLoaded - FAILED to start Dialogue = `%s` because a participant was destroyed while it was loading"),
+						*DialoguePath
+					);
+					OnStarted.ExecuteIfBound(nullptr);
+					return;
+				}
+				LoadedParticipants.Add(Participant);
+			}
+
+			OnStarted.ExecuteIfBound(StartDialogueWithContext(TEXT("StartDialogueWhenLoaded"), LoadedDialogue, LoadedParticipants));
+		})
+	);
+
+	return true;
+}
+
+bool UDlgManager::StartDialogueAsync(
+	TSoftObjectPtr<UDlgDialogue> Dialogue,
+	UPARAM(ref)const TArray<UObject*>& Participants,
+	int32 Priority,
+	const FDlgOnDialogueStartedWhenLoadedDynamic& OnStarted
+)
+{
+	return StartDialogueWhenLoaded(Dialogue, Participants, Priority, FDlgOnDialogueStartedWhenLoaded::CreateLambda([OnStarted](UDlgContext* Context)
+	{
+		OnStarted.ExecuteIfBound(Context);
+	}));
+}
+
+TArray<UDlgContext*> UDlgManager::StartDialoguesBatch(const TArray<FDlgStartDialogueRequest>& Requests)
+{
+	static const FString ContextString = TEXT("StartDialoguesBatch");
+
+	TArray<UDlgContext*> Contexts;
+	Contexts.Reserve(Requests.Num());
+
+	// Each Dialogue is validated once
+	TMap<const UDlgDialogue*, bool> ValidDialogues;
+
+	// Reused by all the requests
+	TMap<FName, UObject*> ParticipantBinding;
+
+	for (int32 Index = 0; Index < Requests.Num(); Index++)
+	{
+		const FDlgStartDialogueRequest& Request = Requests[Index];
+		UDlgDialogue* Dialogue = Request.Dialogue;
+		Contexts.Add(nullptr);
+
+		const bool* bValidDialoguePtr = ValidDialogues.Find(Dialogue);
+		if (!bValidDialoguePtr)
+		{
+			const bool bValidDialogue = IsValid(Dialogue) && Dialogue->GetParticipantsData().Num() > 0;
+			if (!bValidDialogue)
+			{
+				FDlgLogger::Get().Errorf(
+					TEXT("StartDialoguesBatch - FAILED to start the requests with the Dialogue = `%s` because it is INVALID (nullptr) or it does not have any participants"),
+					Dialogue ? *Dialogue->GetPathName() : TEXT("nullptr")
+				);
+			}
+			bValidDialoguePtr = &ValidDialogues.Add(Dialogue, bValidDialogue);
+		}
+		if (!*bValidDialoguePtr)
+		{
+			continue;
+		}
+
+		if (!UDlgContext::ConvertArrayOfParticipantsToMap(ContextString, Dialogue, Request.Participants, ParticipantBinding)
+			|| !UDlgContext::ValidateParticipantsMapForDialogue(ContextString, Dialogue, ParticipantBinding))
+		{
+			FDlgLogger::Get().Errorf(TEXT("StartDialoguesBatch - FAILED to start the request at Index = %d"), Index);
+			continue;
+		}
+
+		auto* Context = NewObject<UDlgContext>(Request.Participants[0], UDlgContext::StaticClass());
+		if (Context->StartWithValidatedParticipants(ContextString, Dialogue, ParticipantBinding))
+		{
+			Contexts.Last() = Context;
+		}
+	}
+
+	return Contexts;
+}
+
+TArray<bool> UDlgManager::ChooseOptionsBatch(const TArray<UDlgContext*>& Contexts, const TArray<int32>& OptionIndices)
+{
+	TArray<bool> Results;
+	Results.Init(false, Contexts.Num());
+	if (Contexts.Num() != OptionIndices.Num())
+	{
+		FDlgLogger::Get().Errorf(
+			TEXT("ChooseOptionsBatch - FAILED because the number of Contexts = %d is DIFFERENT from the number of OptionIndices = %d"),
+			Contexts.Num(), OptionIndices.Num()
+		);
+		return Results;
+	}
+
+	for (int32 Index = 0; Index < Contexts.Num(); Index++)
+	{
+		UDlgContext* Context = Contexts[Index];
+		if (IsValid(Context) && !Context->HasDialogueEnded())
+		{
+			Results[Index] = Context->ChooseOption(OptionIndices[Index]);
+		}
+	}
+
+	return Results;
+}
+
+TArray<bool> UDlgManager::ReevaluateOptionsBatch(const TArray<UDlgContext*>& Contexts)
+{
+	TArray<bool> Results;
+	Results.Init(false, Contexts.Num());
+	for (int32 Index = 0; Index < Contexts.Num(); Index++)
+	{
+		UDlgContext* Context = Contexts[Index];
+		if (IsValid(Context) && !Context->HasDialogueEnded())
+		{
+			Results[Index] = Context->ReevaluateOptions();
+		}
+	}
+
+	return Results;
+}
+
 bool UDlgManager::CanStartDialogue(UDlgDialogue* Dialogue, UPARAM(ref)const TArray<UObject*>& Participants)
 {
 	TMap<FName, UObject*> ParticipantBinding;
@@ -222,23 +455,10 @@ int32 UDlgManager::LoadAllDialoguesIntoMemory(bool bAsync)
 {
 	bCalledLoadAllDialoguesIntoMemory = true;
 
-	// NOTE: All paths must NOT have the forward slash "/" at the end.
-	// If they do, then this won't load Dialogues that are located in the Content root directory
 	UObjectLibrary* ObjectLibrary = UObjectLibrary::CreateLibrary(UDlgDialogue::StaticClass(), false, GIsEditor);
-	TArray<FString> PathsToSearch = { TEXT("/Game") };
+	const TArray<FString> PathsToSearch = FDlgDialogueIndex::GetSearchPaths();
 	ObjectLibrary->AddToRoot();
 
-	// Add the current plugin dir
-	// TODO maybe add all the non engine plugin paths? IPluginManager::Get().GetEnabledPlugins()
-	const TSharedPtr<IPlugin> ThisPlugin = IPluginManager::Get().FindPlugin(DIALOGUE_SYSTEM_PLUGIN_NAME.ToString());
-	if (ThisPlugin.IsValid())
-	{
-		FString PluginPath = ThisPlugin->GetMountedAssetPath();
-		// See NOTE above
-		PluginPath.RemoveFromEnd(TEXT("/"));
-		PathsToSearch.Add(PluginPath);
-	}
-
 	const bool bForceSynchronousScan = !bAsync;
 	const int32 Count = ObjectLibrary->LoadAssetDataFromPaths(PathsToSearch, bForceSynchronousScan);
 	ObjectLibrary->LoadAssetsFromAssetData();
@@ -290,18 +510,42 @@ TArray<UObject*> UDlgManager::GetObjectsWithDialogueParticipantInterface(UObject
 	if (!WorldContextObject)
 		return Array;
 
+	UDlgParticipantRegistry* Registry = UDlgParticipantRegistry::Get(WorldContextObject);
+	if (Registry && Registry->IsAuthoritative())
+	{
+		Array.Reserve(Registry->GetNumParticipants());
+		Registry->ForEachParticipant([&Array](FName ParticipantName, UObject* Participant)
+		{
+			Array.Add(Participant);
+		});
+		return Array;
+	}
+
+	TSet<UObject*> VisitedSet;
 	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
 	{
 		// TObjectIterator has some weird ghost objects in editor, I failed to find a way to validate them
 		// Instead of this ActorIterate is used and the properties inside the actors are examined in a recursive way
 		// Containers are not supported yet
-		TSet<UObject*> VisitedSet;
 		for (TActorIterator<AActor> Itr(World); Itr; ++Itr)
 		{
 			GatherParticipantsRecursive(*Itr, Array, VisitedSet);
 		}
 	}
 
+	// The registered participants the actors do not reference
+	if (Registry)
+	{
+		Registry->ForEachParticipant([&Array, &VisitedSet](FName ParticipantName, UObject* Participant)
+		{
+			if (!VisitedSet.Contains(Participant))
+			{
+				VisitedSet.Add(Participant);
+				Array.Add(Participant);
+			}
+		});
+	}
+
 	// TArray<UObject*> Array2;
 	// for (TObjectIterator<UObject> Itr; Itr; ++Itr)
 	// {
@@ -325,6 +569,17 @@ TMap<FName, FDlgObjectsArray> UDlgManager::GetObjectsMapWithDialogueParticipantI
 {
 	// Maps from Participant Name => Objects that have that participant name
 	TMap<FName, FDlgObjectsArray> ObjectsMap;
+	UDlgParticipantRegistry* Registry = UDlgParticipantRegistry::Get(WorldContextObject);
+	if (Registry && Registry->IsAuthoritative())
+	{
+		// Already grouped, no need to ask for the names again
+		Registry->ForEachParticipant([&ObjectsMap](FName ParticipantName, UObject* Participant)
+		{
+			ObjectsMap.FindOrAdd(ParticipantName).Array.Add(Participant);
+		});
+		return ObjectsMap;
+	}
+
 	for (UObject* Participant : GetObjectsWithDialogueParticipantInterface(WorldContextObject))
 	{
 		const FName ParticipantName = IDlgDialogueParticipant::Execute_GetParticipantName(Participant);
@@ -347,21 +602,25 @@ TMap<FName, FDlgObjectsArray> UDlgManager::GetObjectsMapWithDialogueParticipantI
 
 TArray<UDlgDialogue*> UDlgManager::GetDialoguesWithDuplicateGUIDs()
 {
-	TArray<UDlgDialogue*> Dialogues = GetAllDialoguesFromMemory();
-	TArray<UDlgDialogue*> DuplicateDialogues;
-
+	// Only load the duplicates
 	TSet<FGuid> DialogueGUIDs;
-	for (UDlgDialogue* Dialogue : Dialogues)
+	TArray<FSoftObjectPath> DuplicatePaths;
+	FDlgDialogueIndex::Get().ForEachEntry([&DialogueGUIDs, &DuplicatePaths](const FSoftObjectPath& Path, const FDlgDialogueIndexEntry& Entry)
 	{
-		const FGuid ID = Dialogue->GetGUID();
-		if (DialogueGUIDs.Find(ID) == nullptr)
+		bool bAlreadyExists = false;
+		DialogueGUIDs.Add(Entry.GetGUID(), &bAlreadyExists);
+		if (bAlreadyExists)
 		{
-			// does not exist, good
-			DialogueGUIDs.Add(ID);
+			// how?
+			DuplicatePaths.Add(Path);
 		}
-		else
+	});
+
+	TArray<UDlgDialogue*> DuplicateDialogues;
+	for (const FSoftObjectPath& Path : DuplicatePaths)
+	{
+		if (UDlgDialogue* Dialogue = LoadDialogueFromIndex(Path))
 		{
-			// how?
 			DuplicateDialogues.Add(Dialogue);
 		}
 	}
@@ -371,24 +630,36 @@ TArray<UDlgDialogue*> UDlgManager::GetDialoguesWithDuplicateGUIDs()
 
 TMap<FGuid, UDlgDialogue*> UDlgManager::GetAllDialoguesGUIDsMap()
 {
-	TArray<UDlgDialogue*> Dialogues = GetAllDialoguesFromMemory();
 	TMap<FGuid, UDlgDialogue*> DialoguesMap;
+	for (const auto& Pair : GetAllDialoguesGUIDsPathsMap())
+	{
+		if (UDlgDialogue* Dialogue = LoadDialogueFromIndex(Pair.Value))
+		{
+			DialoguesMap.Add(Pair.Key, Dialogue);
+		}
+	}
+
+	return DialoguesMap;
+}
 
-	for (UDlgDialogue* Dialogue : Dialogues)
+TMap<FGuid, FSoftObjectPath> UDlgManager::GetAllDialoguesGUIDsPathsMap()
+{
+	TMap<FGuid, FSoftObjectPath> PathsMap;
+	FDlgDialogueIndex::Get().ForEachEntry([&PathsMap](const FSoftObjectPath& Path, const FDlgDialogueIndexEntry& Entry)
 	{
-		const FGuid ID = Dialogue->GetGUID();
-		if (DialoguesMap.Contains(ID))
+		const FGuid ID = Entry.GetGUID();
+		if (PathsMap.Contains(ID))
 		{
 			FDlgLogger::Get().Errorf(
 				TEXT("GetAllDialoguesGUIDsMap - ID = `%s` for Dialogue = `%s` already exists"),
-				*ID.ToString(), *Dialogue->GetPathName()
+				*ID.ToString(), *Path.ToString()
 			);
 		}
 
-		DialoguesMap.Add(ID, Dialogue);
-	}
+		PathsMap.Add(ID, Path);
+	});
 
-	return DialoguesMap;
+	return PathsMap;
 }
 
 const TMap<FGuid, FDlgHistory>& UDlgManager::GetDialogueHistory()
@@ -433,10 +704,20 @@ bool UDlgManager::IsObjectANodeData(const UObject* Object)
 
 TArray<UDlgDialogue*> UDlgManager::GetAllDialoguesForParticipantName(FName ParticipantName)
 {
+	// Only load the matching Dialogues
+	TArray<FSoftObjectPath> Paths;
+	FDlgDialogueIndex::Get().ForEachEntry([ParticipantName, &Paths](const FSoftObjectPath& Path, const FDlgDialogueIndexEntry& Entry)
+	{
+		if (Entry.GetParticipantsData().Contains(ParticipantName))
+		{
+			Paths.Add(Path);
+		}
+	});
+
 	TArray<UDlgDialogue*> DialoguesArray;
-	for (UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
+	for (const FSoftObjectPath& Path : Paths)
 	{
-		if (Dialogue->HasParticipant(ParticipantName))
+		if (UDlgDialogue* Dialogue = LoadDialogueFromIndex(Path))
 		{
 			DialoguesArray.Add(Dialogue);
 		}
@@ -447,106 +728,53 @@ TArray<UDlgDialogue*> UDlgManager::GetAllDialoguesForParticipantName(FName Parti
 
 TArray<FName> UDlgManager::GetDialoguesParticipantNames()
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		UniqueNames.Append(Dialogue->GetParticipantNames());
-	}
-
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+	return FDlgDialogueIndex::Get().GetParticipantNames();
 }
 
 TArray<FName> UDlgManager::GetDialoguesSpeakerStates()
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		UniqueNames.Append(Dialogue->GetSpeakerStates());
-	}
-
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+	return FDlgDialogueIndex::Get().GetSpeakerStates();
 }
 
 TArray<FName> UDlgManager::GetDialoguesParticipantIntNames(FName ParticipantName)
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		UniqueNames.Append(Dialogue->GetParticipantIntNames(ParticipantName));
-	}
-
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+	return FDlgDialogueIndex::Get().GetParticipantNames(ParticipantName, EDlgIndexedNameKind::Int);
 }
 
 TArray<FName> UDlgManager::GetDialoguesParticipantFloatNames(FName ParticipantName)
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		UniqueNames.Append(Dialogue->GetParticipantFloatNames(ParticipantName));
-	}
-
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+	return FDlgDialogueIndex::Get().GetParticipantNames(ParticipantName, EDlgIndexedNameKind::Float);
 }
 
 TArray<FName> UDlgManager::GetDialoguesParticipantBoolNames(FName ParticipantName)
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		UniqueNames.Append(Dialogue->GetParticipantBoolNames(ParticipantName));
-	}
-
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+	return FDlgDialogueIndex::Get().GetParticipantNames(ParticipantName, EDlgIndexedNameKind::Bool);
 }
 
 TArray<FName> UDlgManager::GetDialoguesParticipantFNameNames(FName ParticipantName)
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		UniqueNames.Append(Dialogue->GetParticipantFNameNames(ParticipantName));
-	}
-
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+	return FDlgDialogueIndex::Get().GetParticipantNames(ParticipantName, EDlgIndexedNameKind::Name);
 }
 
 TArray<FName> UDlgManager::GetDialoguesParticipantConditionNames(FName ParticipantName)
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		UniqueNames.Append(Dialogue->GetParticipantConditionNames(ParticipantName));
-	}
-
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+	return FDlgDialogueIndex::Get().GetParticipantNames(ParticipantName, EDlgIndexedNameKind::Condition);
 }
 
 TArray<FName> UDlgManager::GetDialoguesParticipantEventNames(FName ParticipantName)
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
+	return FDlgDialogueIndex::Get().GetParticipantNames(ParticipantName, EDlgIndexedNameKind::Event);
+}
+
+UDlgDialogue* UDlgManager::LoadDialogueFromIndex(const FSoftObjectPath& Path)
+{
+	UDlgDialogue* Dialogue = Cast<UDlgDialogue>(Path.ResolveObject());
+	if (!Dialogue)
 	{
-		UniqueNames.Append(Dialogue->GetParticipantEventNames(ParticipantName));
+		Dialogue = Cast<UDlgDialogue>(Path.TryLoad());
 	}
 
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+	return IsValid(Dialogue) ? Dialogue : nullptr;
 }
 
 bool UDlgManager::RegisterDialogueConsoleCommands()
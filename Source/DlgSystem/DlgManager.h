@@ -12,6 +12,12 @@ class AActor;
 class UDlgContext;
 class UDlgDialogue;
 
+// Participant, VariableName
+DECLARE_MULTICAST_DELEGATE_TwoParams(FDlgOnParticipantVariableChanged, const UObject*, FName);
+
+// Started context, nullptr if the Dialogue failed to load or to start
+DECLARE_DELEGATE_OneParam(FDlgOnDialogueStartedWhenLoaded, UDlgContext*);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FDlgOnDialogueStartedWhenLoadedDynamic, UDlgContext*, Context);
 
 USTRUCT(BlueprintType)
 struct DLGSYSTEM_API FDlgObjectsArray
@@ -23,6 +29,20 @@ public:
 	TArray<UObject*> Array;
 };
 
+// A Dialogue to start with its Participants, see UDlgManager::StartDialoguesBatch
+USTRUCT(BlueprintType)
+struct DLGSYSTEM_API FDlgStartDialogueRequest
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data")
+	UDlgDialogue* Dialogue = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data")
+	TArray<UObject*> Participants;
+};
+
 /**
  *  Class providing a collection of static functions to start a conversation and work with Dialogues.
  */
@@ -48,7 +68,13 @@ public:
 	static UDlgContext* StartDialogueWithDefaultParticipants(UObject* WorldContextObject, UDlgDialogue* Dialogue);
 
 	// Supplies where we called this from
-	static UDlgContext* StartDialogueWithContext(const FString& ContextString, UDlgDialogue* Dialogue, const TArray<UObject*>& Participants);
+	// Memory - the dialogue memory the context uses, nullptr for the global FDlgMemory
+	static UDlgContext* StartDialogueWithContext(
+		const FString& ContextString,
+		UDlgDialogue* Dialogue,
+		const TArray<UObject*>& Participants,
+		const TSharedPtr<FDlgMemory>& Memory = nullptr
+	);
 
 	/**
 	 * Starts a Dialogue with the provided Dialogue and Participants array
@@ -65,6 +91,69 @@ public:
 		return StartDialogueWithContext(TEXT("StartDialogue"), Dialogue, Participants);
 	}
 
+	/**
+	 * Same as StartDialogue but the context only reads/writes the dialogue memory of the MemoryOwner
+	 * (e.g. the PlayerState of the player), see UDlgMemorySubsystem.
+	 * A nullptr MemoryOwner uses the memory shared by the world of the first participant.
+	 * This method fails if the MemoryOwner (or the first participant) is not in a world.
+	 *
+	 * @returns The dialogue context object or nullptr if something wrong happened
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Launch")
+	static UDlgContext* StartDialogueWithMemory(UDlgDialogue* Dialogue, UPARAM(ref)const TArray<UObject*>& Participants, UObject* MemoryOwner);
+
+	/**
+	 * Same as StartDialogue but the Dialogue is streamed first (see UDlgStreamingSubsystem), so that starting it does not block on loading.
+	 * The Dialogue is started right away if it is already loaded, otherwise once it is loaded, higher priorities load first.
+	 * OnStarted is called with the context (nullptr if it failed), the start fails if any participant is destroyed while loading.
+	 * This method fails right away if the first participant is not in a game world.
+	 *
+	 * @returns true if the Dialogue was started or is being loaded
+	 */
+	static bool StartDialogueWhenLoaded(
+		const TSoftObjectPtr<UDlgDialogue>& Dialogue,
+		const TArray<UObject*>& Participants,
+		int32 Priority,
+		FDlgOnDialogueStartedWhenLoaded OnStarted
+	);
+
+	// Blueprint version of StartDialogueWhenLoaded
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Launch", meta = (AutoCreateRefTerm = "OnStarted"))
+	static bool StartDialogueAsync(
+		TSoftObjectPtr<UDlgDialogue> Dialogue,
+		UPARAM(ref)const TArray<UObject*>& Participants,
+		int32 Priority,
+		const FDlgOnDialogueStartedWhenLoadedDynamic& OnStarted
+	);
+
+	/**
+	 * Same as calling StartDialogue for each of the Requests, but cheaper for many requests (e.g. crowds of ambient barks):
+	 *  - each Dialogue is validated only once
+	 *  - the participants map is reused between the requests
+	 *  - no strings are formatted unless something fails
+	 *
+	 * @returns The dialogue contexts, in the order of the Requests, nullptr for the requests that failed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Launch")
+	static TArray<UDlgContext*> StartDialoguesBatch(const TArray<FDlgStartDialogueRequest>& Requests);
+
+	/**
+	 * Calls ChooseOption on each of the Contexts with the option at the same index in OptionIndices
+	 * The invalid contexts (nullptr or already ended) are skipped
+	 *
+	 * @returns The results of ChooseOption, in the order of the Contexts, false for the skipped ones
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Control")
+	static TArray<bool> ChooseOptionsBatch(const TArray<UDlgContext*>& Contexts, const TArray<int32>& OptionIndices);
+
+	/**
+	 * Calls ReevaluateOptions on each of the Contexts, the invalid contexts (nullptr or already ended) are skipped
+	 *
+	 * @returns The results of ReevaluateOptions, in the order of the Contexts, false for the skipped ones
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Control")
+	static TArray<bool> ReevaluateOptionsBatch(const TArray<UDlgContext*>& Contexts);
+
 	/**
 	 * Checks if there is any child of the start node which can be enterred based on the conditions
 	 *
@@ -167,6 +256,7 @@ public:
 	static TArray<TWeakObjectPtr<AActor>> GetAllWeakActorsWithDialogueParticipantInterface(UWorld* World);
 
 	// Gets all objects from the World that implement the Dialogue Participant Interface
+	// Uses the UDlgParticipantRegistry of the World if it has all the participants, otherwise iterates through all objects (and adds the registered participants)
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Helper", meta = (WorldContext = "WorldContextObject"))
 	static TArray<UObject*> GetObjectsWithDialogueParticipantInterface(UObject* WorldContextObject);
 
@@ -177,12 +267,18 @@ public:
 	static TMap<FName, FDlgObjectsArray> GetObjectsMapWithDialogueParticipantInterface(UObject* WorldContextObject);
 
 	// Gets all the dialogues that have a duplicate GUID, should not happen, like ever.
+	// Uses the FDlgDialogueIndex, only the duplicate Dialogues are loaded.
 	static TArray<UDlgDialogue*> GetDialoguesWithDuplicateGUIDs();
 
 	// Helper methods that gets all the dialogues in a map by guid.
+	// NOTE: this loads all the Dialogues, use GetAllDialoguesGUIDsPathsMap if you only need the paths
 	static TMap<FGuid, UDlgDialogue*> GetAllDialoguesGUIDsMap();
 
-	// Gets all the loaded dialogues from memory that have the ParticipantName included inside them.
+	// Same as GetAllDialoguesGUIDsMap but does not load any Dialogue, see FDlgDialogueIndex
+	static TMap<FGuid, FSoftObjectPath> GetAllDialoguesGUIDsPathsMap();
+
+	// Gets all the dialogues that have the ParticipantName included inside them.
+	// Uses the FDlgDialogueIndex, only the matching Dialogues are loaded.
 	static TArray<UDlgDialogue*> GetAllDialoguesForParticipantName(FName ParticipantName);
 
 	// Sets the FDlgMemory Dialogue history.
@@ -217,35 +313,35 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Helper", DisplayName = "Is Object A Node Data")
 	static bool IsObjectANodeData(const UObject* Object);
 
-	// Gets all the unique participant names sorted alphabetically from all the Dialogues loaded into memory.
+	// Gets all the unique participant names sorted alphabetically from all the Dialogues (loaded or not, see FDlgDialogueIndex).
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Data")
 	static TArray<FName> GetDialoguesParticipantNames();
 
-	// Gets all the used speaker states sorted alphabetically from all the Dialogues loaded into memory.
+	// Gets all the used speaker states sorted alphabetically from all the Dialogues (loaded or not, see FDlgDialogueIndex).
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Data")
 	static TArray<FName> GetDialoguesSpeakerStates();
 
-	// Gets all the unique int variable names sorted alphabetically for the specified ParticipantName from the loaded Dialogues
+	// Gets all the unique int variable names sorted alphabetically for the specified ParticipantName from all the Dialogues (loaded or not)
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Data")
 	static TArray<FName> GetDialoguesParticipantIntNames(FName ParticipantName);
 
-	// Gets all the unique float variable names sorted alphabetically for the specified ParticipantName from the loaded Dialogues
+	// Gets all the unique float variable names sorted alphabetically for the specified ParticipantName from all the Dialogues (loaded or not)
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Data")
 	static TArray<FName> GetDialoguesParticipantFloatNames(FName ParticipantName);
 
-	// Gets all the unique bool variable names sorted alphabetically for the specified ParticipantName from the loaded Dialogues
+	// Gets all the unique bool variable names sorted alphabetically for the specified ParticipantName from all the Dialogues (loaded or not)
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Data")
 	static TArray<FName> GetDialoguesParticipantBoolNames(FName ParticipantName);
 
-	// Gets all the unique name variable names sorted alphabetically for the specified ParticipantName from the loaded Dialogues
+	// Gets all the unique name variable names sorted alphabetically for the specified ParticipantName from all the Dialogues (loaded or not)
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Data")
 	static TArray<FName> GetDialoguesParticipantFNameNames(FName ParticipantName);
 
-	// Gets all the unique condition names sorted alphabetically for the specified ParticipantName from the loaded Dialogues
+	// Gets all the unique condition names sorted alphabetically for the specified ParticipantName from all the Dialogues (loaded or not)
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Data")
 	static TArray<FName> GetDialoguesParticipantConditionNames(FName ParticipantName);
 
-	// Gets all the unique event names sorted alphabetically for the specified ParticipantName from the loaded Dialogues
+	// Gets all the unique event names sorted alphabetically for the specified ParticipantName from all the Dialogues (loaded or not)
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Data")
 	static TArray<FName> GetDialoguesParticipantEventNames(FName ParticipantName);
 
@@ -343,7 +439,26 @@ public:
 
 	static bool HasCalledLoadAllDialoguesIntoMemory() { return bCalledLoadAllDialoguesIntoMemory; }
 
+	/**
+	 * Lets the contexts that reevaluate their options incrementally (see UDlgContext::SetIncrementalReevaluation)
+	 * know that a variable (or the result of a condition) of the Participant changed.
+	 * NOTE: the Modify events of the Dialogues call this automatically.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Control")
+	static void NotifyParticipantVariableChanged(UObject* Participant, FName VariableName)
+	{
+		OnParticipantVariableChanged.Broadcast(Participant, VariableName);
+	}
+
+	// Broadcast by NotifyParticipantVariableChanged
+	static FDlgOnParticipantVariableChanged OnParticipantVariableChanged;
+
 private:
+	friend class UDlgParticipantRegistry;
+
+	// The Dialogue at Path, loads it if needed
+	static UDlgDialogue* LoadDialogueFromIndex(const FSoftObjectPath& Path);
+
 	static void GatherParticipantsRecursive(UObject* Object, TArray<UObject*>& Array, TSet<UObject*>& AlreadyVisited);
 
 	// Set by the user, we will default to automagically resolve the world
@@ -1,6 +1,7 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #include "DlgMemory.h"
 #include "DlgHelper.h"
+#include "DlgDialogue.h"
 
 void FDlgHistory::Add(int32 NodeIndex, const FGuid& NodeGUID)
 {
@@ -37,3 +38,56 @@ FDlgNodeSavedData& FDlgHistory::GetNodeData(const FGuid& NodeGUID)
 	return NodeData.FindOrAdd(NodeGUID);
 }
 
+
+TBitArray<> FDlgMemory::BuildVisitedNodes(const FDlgHistory& History, const UDlgDialogue& Dialogue)
+{
+	const int32 NumNodes = Dialogue.GetNodes().Num();
+	TBitArray<> VisitedNodes(false, NumNodes);
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+	{
+		VisitedNodes[NodeIndex] = History.Contains(NodeIndex, Dialogue.GetNodeGUIDForIndex(NodeIndex));
+	}
+
+	return VisitedNodes;
+}
+
+void FDlgMemory::SetNodeVisited(const UDlgDialogue& Dialogue, int32 NodeIndex, const FGuid& NodeGUID)
+{
+	const FGuid DialogueGUID = Dialogue.GetGUID();
+	DirtyEntries.Add(DialogueGUID);
+	FDlgHistory& History = HistoryMap.FindOrAdd(DialogueGUID);
+	const bool bCanUseGUIDForSearch = History.CanUseGUIDForSearch();
+	History.Add(NodeIndex, NodeGUID);
+
+	// Still the same search, only this node changed
+	TBitArray<>* VisitedNodes = VisitedNodesCache.Find(DialogueGUID);
+	if (VisitedNodes
+		&& bCanUseGUIDForSearch == History.CanUseGUIDForSearch()
+		&& VisitedNodes->Num() == Dialogue.GetNodes().Num()
+		&& VisitedNodes->IsValidIndex(NodeIndex)
+		&& Dialogue.GetNodeGUIDForIndex(NodeIndex) == NodeGUID)
+	{
+		(*VisitedNodes)[NodeIndex] = true;
+	}
+	else
+	{
+		VisitedNodesCache.Add(DialogueGUID, BuildVisitedNodes(History, Dialogue));
+	}
+}
+
+bool FDlgMemory::IsNodeVisited(const UDlgDialogue& Dialogue, int32 NodeIndex, const FGuid& NodeGUID) const
+{
+	const FGuid DialogueGUID = Dialogue.GetGUID();
+
+	// Only the nodes of the Dialogue are cached, the cache is not built by the reads
+	const TBitArray<>* VisitedNodes = VisitedNodesCache.Find(DialogueGUID);
+	if (!VisitedNodes
+		|| VisitedNodes->Num() != Dialogue.GetNodes().Num()
+		|| !Dialogue.IsValidNodeIndex(NodeIndex)
+		|| Dialogue.GetNodeGUIDForIndex(NodeIndex) != NodeGUID)
+	{
+		return IsNodeVisited(DialogueGUID, NodeIndex, NodeGUID);
+	}
+
+	return (*VisitedNodes)[NodeIndex];
+}
@@ -5,6 +5,8 @@
 
 #include "DlgMemory.generated.h"
 
+class UDlgDialogue;
+
 
 // Struct to store any data a node might want to read/write
 USTRUCT(BlueprintType)
@@ -17,6 +19,14 @@ public:
 	// used by random selector node to avoid repetition
 	UPROPERTY()
 	TArray<FGuid> GUIDList;
+
+	bool operator==(const FDlgNodeSavedData& Other) const { return GUIDList == Other.GUIDList; }
+
+	friend FArchive& operator<<(FArchive& Ar, FDlgNodeSavedData& Data)
+	{
+		Ar << Data.GUIDList;
+		return Ar;
+	}
 };
 
 
@@ -91,8 +101,8 @@ public:
 	TMap<FGuid, FDlgNodeSavedData> NodeData;
 };
 
-// Singleton to store Dialogue history
-// TODO: investigate if this is multiplayer friendly, it does not seem so as there exists only a single global dialogue memory
+// Stores Dialogue history
+// Get() is the global memory used by default, UDlgMemorySubsystem has a memory per world and per player
 USTRUCT()
 struct DLGSYSTEM_API FDlgMemory
 {
@@ -112,11 +122,18 @@ public:
 	}
 
 	// Removes all entries
-	void Empty() { HistoryMap.Empty(); }
+	void Empty()
+	{
+		HistoryMap.Empty();
+		OnAllEntriesChanged();
+	}
+
+	void Reserve(int32 Number) { HistoryMap.Reserve(Number); }
 
 	// Adds an entry to the map or overrides an existing one
 	void SetEntry(const FGuid& DialogueGUID, const FDlgHistory& History)
 	{
+		OnEntryChanged(DialogueGUID);
 		FDlgHistory* OldEntry = HistoryMap.Find(DialogueGUID);
 
 		if (OldEntry == nullptr)
@@ -130,17 +147,41 @@ public:
 	}
 
 	// Returns the entry for the given name, or nullptr if it does not exist */
-	FDlgHistory* GetEntry(const FGuid& DialogueGUID) { return HistoryMap.Find(DialogueGUID); }
+	// NOTE: the entry can be modified, it is considered changed
+	FDlgHistory* GetEntry(const FGuid& DialogueGUID)
+	{
+		OnEntryChanged(DialogueGUID);
+		return HistoryMap.Find(DialogueGUID);
+	}
+	const FDlgHistory* FindEntry(const FGuid& DialogueGUID) const { return HistoryMap.Find(DialogueGUID); }
 
-	FDlgHistory& FindOrAddEntry(const FGuid& DialogueGUID) { return HistoryMap.FindOrAdd(DialogueGUID); }
+	FDlgHistory& FindOrAddEntry(const FGuid& DialogueGUID)
+	{
+		OnEntryChanged(DialogueGUID);
+		return HistoryMap.FindOrAdd(DialogueGUID);
+	}
+
+	// Only touches the node data, the visited nodes cache is kept
+	FDlgNodeSavedData& GetNodeData(const FGuid& DialogueGUID, const FGuid& NodeGUID)
+	{
+		DirtyEntries.Add(DialogueGUID);
+		return HistoryMap.FindOrAdd(DialogueGUID).GetNodeData(NodeGUID);
+	}
 
 	void SetNodeVisited(const FGuid& DialogueGUID, int32 NodeIndex, const FGuid& NodeGUID)
 	{
 		// Add it if it does not exist already
+		OnEntryChanged(DialogueGUID);
 		FDlgHistory& History = HistoryMap.FindOrAdd(DialogueGUID);
 		History.Add(NodeIndex, NodeGUID);
 	}
 
+	// Same as the version above but keeps the visited nodes cache of the Dialogue up to date, built by the first call
+	void SetNodeVisited(const UDlgDialogue& Dialogue, int32 NodeIndex, const FGuid& NodeGUID);
+
+	// Same as the version bellow but O(1) for the nodes of the Dialogue once SetNodeVisited built its visited nodes cache
+	bool IsNodeVisited(const UDlgDialogue& Dialogue, int32 NodeIndex, const FGuid& NodeGUID) const;
+
 	bool IsNodeVisited(const FGuid& DialogueGUID, int32 NodeIndex, const FGuid& NodeGUID) const
 	{
 		// Dialogue entry does not even exist
@@ -178,13 +219,60 @@ public:
 	}
 
 	const TMap<FGuid, FDlgHistory>& GetHistoryMaps() const { return HistoryMap; }
-	void SetHistoryMap(const TMap<FGuid, FDlgHistory>& Map) { HistoryMap = Map; }
+	void SetHistoryMap(const TMap<FGuid, FDlgHistory>& Map)
+	{
+		HistoryMap = Map;
+		OnAllEntriesChanged();
+	}
+
+	//
+	// Changes since the last checkpoint, used by the delta saves of FDlgHistoryCodec
+	//
+
+	// Entries that changed (or could have changed) since the last ClearDirtyEntries
+	const TSet<FGuid>& GetDirtyEntries() const { return DirtyEntries; }
+
+	// Was the whole map replaced/emptied since the last ClearDirtyEntries? (entries could have been removed)
+	bool AreAllEntriesDirty() const { return bAllEntriesDirty; }
+
+	// Checkpoint
+	void ClearDirtyEntries()
+	{
+		DirtyEntries.Empty();
+		bAllEntriesDirty = false;
+	}
+
+private:
+	// FDlgHistory::Contains for every node of the Dialogue, a bit per node index
+	static TBitArray<> BuildVisitedNodes(const FDlgHistory& History, const UDlgDialogue& Dialogue);
+
+	void OnEntryChanged(const FGuid& DialogueGUID)
+	{
+		VisitedNodesCache.Remove(DialogueGUID);
+		DirtyEntries.Add(DialogueGUID);
+	}
+
+	void OnAllEntriesChanged()
+	{
+		VisitedNodesCache.Empty();
+		DirtyEntries.Empty();
+		bAllEntriesDirty = true;
+	}
 
 private:
 	 // Key: Dialogue unique identifier GUID
 	 // Value: set of already visited nodes
 	UPROPERTY()
 	TMap<FGuid, FDlgHistory> HistoryMap;
+
+	// Lookup cache only, HistoryMap is the history (saved and loaded)
+	// Key: Dialogue unique identifier GUID
+	// Value: BuildVisitedNodes of the entry from HistoryMap, dropped every time the entry can change
+	TMap<FGuid, TBitArray<>> VisitedNodesCache;
+
+	// See GetDirtyEntries
+	TSet<FGuid> DirtyEntries;
+	bool bAllEntriesDirty = true;
 };
 
 template<>
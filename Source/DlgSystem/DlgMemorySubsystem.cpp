@@ -0,0 +1,62 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgMemorySubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+
+void UDlgMemorySubsystem::Deinitialize()
+{
+	Memories.Empty();
+	Super::Deinitialize();
+}
+
+UDlgMemorySubsystem* UDlgMemorySubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject || !GEngine)
+	{
+		return nullptr;
+	}
+
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+	{
+		return World->GetSubsystem<UDlgMemorySubsystem>();
+	}
+
+	return nullptr;
+}
+
+TSharedRef<FDlgMemory> UDlgMemorySubsystem::GetMemory(const UObject* MemoryOwner)
+{
+	if (const TSharedRef<FDlgMemory>* MemoryPtr = Memories.Find(MemoryOwner))
+	{
+		return *MemoryPtr;
+	}
+
+	return Memories.Add(MemoryOwner, MakeShared<FDlgMemory>());
+}
+
+TSharedPtr<FDlgMemory> UDlgMemorySubsystem::FindMemory(const UObject* MemoryOwner) const
+{
+	if (const TSharedRef<FDlgMemory>* MemoryPtr = Memories.Find(MemoryOwner))
+	{
+		return *MemoryPtr;
+	}
+
+	return nullptr;
+}
+
+TMap<FGuid, FDlgHistory> UDlgMemorySubsystem::CreateSnapshot(const UObject* MemoryOwner) const
+{
+	if (const TSharedRef<FDlgMemory>* MemoryPtr = Memories.Find(MemoryOwner))
+	{
+		return (*MemoryPtr)->GetHistoryMaps();
+	}
+
+	return {};
+}
+
+void UDlgMemorySubsystem::RestoreSnapshot(const UObject* MemoryOwner, const TMap<FGuid, FDlgHistory>& Snapshot)
+{
+	GetMemory(MemoryOwner)->SetHistoryMap(Snapshot);
+}
@@ -0,0 +1,67 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "DlgMemory.h"
+
+#include "DlgMemorySubsystem.generated.h"
+
+
+/**
+ * Dialogue memories (histories) of a world, one for each memory owner (e.g. the PlayerState of each player)
+ * and one shared by everyone in the world (the nullptr owner).
+ * The contexts started with UDlgManager::StartDialogueWithMemory read/write the memory of their owner only,
+ * the contexts started without one use the global FDlgMemory.
+ */
+UCLASS()
+class DLGSYSTEM_API UDlgMemorySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//
+	// USubsystem Interface
+	//
+
+	void Deinitialize() override;
+
+	//
+	// Own methods
+	//
+
+	// Gets the subsystem of the world of the WorldContextObject, nullptr if the object is not in a world
+	static UDlgMemorySubsystem* Get(const UObject* WorldContextObject);
+
+	// Gets the memory of the MemoryOwner, creates it if it does not exist
+	// The memory stays valid (and owned by the contexts using it) even after RemoveMemory
+	TSharedRef<FDlgMemory> GetMemory(const UObject* MemoryOwner);
+	TSharedPtr<FDlgMemory> FindMemory(const UObject* MemoryOwner) const;
+
+	// Does the MemoryOwner have a memory in this world?
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Memory")
+	bool HasMemory(const UObject* MemoryOwner) const { return Memories.Contains(MemoryOwner); }
+
+	// Forgets the memory of the MemoryOwner (e.g. when the player leaves)
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Memory")
+	void RemoveMemory(const UObject* MemoryOwner) { Memories.Remove(MemoryOwner); }
+
+	// Copies the history of the MemoryOwner only, the other memories are not touched
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Memory")
+	TMap<FGuid, FDlgHistory> CreateSnapshot(const UObject* MemoryOwner) const;
+
+	// Replaces the history of the MemoryOwner with the Snapshot (created by CreateSnapshot)
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Memory")
+	void RestoreSnapshot(const UObject* MemoryOwner, const TMap<FGuid, FDlgHistory>& Snapshot);
+
+	// Number of memories in this world
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Memory")
+	int32 GetNumMemories() const { return Memories.Num(); }
+
+protected:
+	// Key: the memory owner, the default key (nullptr) is the memory shared by the world
+	// Value: the memory, shared with the contexts using it
+	TMap<TObjectKey<UObject>, TSharedRef<FDlgMemory>> Memories;
+};
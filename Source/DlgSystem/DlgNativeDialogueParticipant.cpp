@@ -0,0 +1,198 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgNativeDialogueParticipant.h"
+
+#include "DlgDialogueParticipant.h"
+
+namespace DlgNativeDialogueParticipant
+{
+	// Offset of the IDlgNativeDialogueParticipant inside the objects of each class, INDEX_NONE if the class does not implement it.
+	// The class is kept as a weak pointer so that an entry can never match a new class allocated at the address of a garbage collected one.
+	static TMap<TWeakObjectPtr<const UClass>, int32> NativeOffsets;
+}
+
+void IDlgNativeDialogueParticipant::GetValuesNative(TArrayView<FDlgParticipantValueRequest> Requests) const
+{
+	for (FDlgParticipantValueRequest& Request : Requests)
+	{
+		switch (Request.Type)
+		{
+			case EDlgConditionType::BoolCall:
+				Request.bBoolValue = GetBoolValueNative(Request.ValueName);
+				break;
+			case EDlgConditionType::FloatCall:
+				Request.FloatValue = GetFloatValueNative(Request.ValueName);
+				break;
+			case EDlgConditionType::IntCall:
+				Request.IntValue = GetIntValueNative(Request.ValueName);
+				break;
+			case EDlgConditionType::NameCall:
+				Request.NameValue = GetNameValueNative(Request.ValueName);
+				break;
+			default:
+				checkNoEntry();
+		}
+	}
+}
+
+const IDlgNativeDialogueParticipant* FDlgParticipantCalls::GetNative(const UObject* Participant)
+{
+	check(IsInGameThread());
+	if (Participant == nullptr)
+	{
+		return nullptr;
+	}
+
+	// The offset is the same for all the objects of a class
+	const UClass* Class = Participant->GetClass();
+	const int32* OffsetPtr = DlgNativeDialogueParticipant::NativeOffsets.Find(Class);
+	if (OffsetPtr == nullptr)
+	{
+		const void* Address = const_cast<UObject*>(Participant)->GetNativeInterfaceAddress(UDlgNativeDialogueParticipant::StaticClass());
+		const int32 Offset = Address != nullptr
+			? static_cast<int32>(static_cast<const uint8*>(Address) - reinterpret_cast<const uint8*>(Participant))
+			: INDEX_NONE;
+		OffsetPtr = &DlgNativeDialogueParticipant::NativeOffsets.Add(Class, Offset);
+	}
+
+	if (*OffsetPtr == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	return reinterpret_cast<const IDlgNativeDialogueParticipant*>(reinterpret_cast<const uint8*>(Participant) + *OffsetPtr);
+}
+
+bool FDlgParticipantCalls::CheckCondition(const UObject* Participant, const UDlgContext* Context, FName ConditionName)
+{
+	if (const IDlgNativeDialogueParticipant* Native = GetNative(Participant))
+	{
+		return Native->CheckConditionNative(Context, ConditionName);
+	}
+
+	return IDlgDialogueParticipant::Execute_CheckCondition(Participant, Context, ConditionName);
+}
+
+float FDlgParticipantCalls::GetFloatValue(const UObject* Participant, FName ValueName)
+{
+	if (const IDlgNativeDialogueParticipant* Native = GetNative(Participant))
+	{
+		return Native->GetFloatValueNative(ValueName);
+	}
+
+	return IDlgDialogueParticipant::Execute_GetFloatValue(Participant, ValueName);
+}
+
+int32 FDlgParticipantCalls::GetIntValue(const UObject* Participant, FName ValueName)
+{
+	if (const IDlgNativeDialogueParticipant* Native = GetNative(Participant))
+	{
+		return Native->GetIntValueNative(ValueName);
+	}
+
+	return IDlgDialogueParticipant::Execute_GetIntValue(Participant, ValueName);
+}
+
+bool FDlgParticipantCalls::GetBoolValue(const UObject* Participant, FName ValueName)
+{
+	if (const IDlgNativeDialogueParticipant* Native = GetNative(Participant))
+	{
+		return Native->GetBoolValueNative(ValueName);
+	}
+
+	return IDlgDialogueParticipant::Execute_GetBoolValue(Participant, ValueName);
+}
+
+FName FDlgParticipantCalls::GetNameValue(const UObject* Participant, FName ValueName)
+{
+	if (const IDlgNativeDialogueParticipant* Native = GetNative(Participant))
+	{
+		return Native->GetNameValueNative(ValueName);
+	}
+
+	return IDlgDialogueParticipant::Execute_GetNameValue(Participant, ValueName);
+}
+
+void FDlgParticipantCalls::GetValues(const UObject* Participant, TArrayView<FDlgParticipantValueRequest> Requests)
+{
+	if (const IDlgNativeDialogueParticipant* Native = GetNative(Participant))
+	{
+		Native->GetValuesNative(Requests);
+		return;
+	}
+
+	for (FDlgParticipantValueRequest& Request : Requests)
+	{
+		switch (Request.Type)
+		{
+			case EDlgConditionType::BoolCall:
+				Request.bBoolValue = IDlgDialogueParticipant::Execute_GetBoolValue(Participant, Request.ValueName);
+				break;
+			case EDlgConditionType::FloatCall:
+				Request.FloatValue = IDlgDialogueParticipant::Execute_GetFloatValue(Participant, Request.ValueName);
+				break;
+			case EDlgConditionType::IntCall:
+				Request.IntValue = IDlgDialogueParticipant::Execute_GetIntValue(Participant, Request.ValueName);
+				break;
+			case EDlgConditionType::NameCall:
+				Request.NameValue = IDlgDialogueParticipant::Execute_GetNameValue(Participant, Request.ValueName);
+				break;
+			default:
+				checkNoEntry();
+		}
+	}
+}
+
+bool FDlgParticipantCalls::OnDialogueEvent(UObject* Participant, UDlgContext* Context, FName EventName)
+{
+	if (IDlgNativeDialogueParticipant* Native = GetNative(Participant))
+	{
+		return Native->OnDialogueEventNative(Context, EventName);
+	}
+
+	return IDlgDialogueParticipant::Execute_OnDialogueEvent(Participant, Context, EventName);
+}
+
+bool FDlgParticipantCalls::ModifyFloatValue(UObject* Participant, FName ValueName, bool bDelta, float Value)
+{
+	if (IDlgNativeDialogueParticipant* Native = GetNative(Participant))
+	{
+		return Native->ModifyFloatValueNative(ValueName, bDelta, Value);
+	}
+
+	return IDlgDialogueParticipant::Execute_ModifyFloatValue(Participant, ValueName, bDelta, Value);
+}
+
+bool FDlgParticipantCalls::ModifyIntValue(UObject* Participant, FName ValueName, bool bDelta, int32 Value)
+{
+	if (IDlgNativeDialogueParticipant* Native = GetNative(Participant))
+	{
+		return Native->ModifyIntValueNative(ValueName, bDelta, Value);
+	}
+
+	return IDlgDialogueParticipant::Execute_ModifyIntValue(Participant, ValueName, bDelta, Value);
+}
+
+bool FDlgParticipantCalls::ModifyBoolValue(UObject* Participant, FName ValueName, bool bNewValue)
+{
+	if (IDlgNativeDialogueParticipant* Native = GetNative(Participant))
+	{
+		return Native->ModifyBoolValueNative(ValueName, bNewValue);
+	}
+
+	return IDlgDialogueParticipant::Execute_ModifyBoolValue(Participant, ValueName, bNewValue);
+}
+
+bool FDlgParticipantCalls::ModifyNameValue(UObject* Participant, FName ValueName, FName NameValue)
+{
+	if (IDlgNativeDialogueParticipant* Native = GetNative(Participant))
+	{
+		return Native->ModifyNameValueNative(ValueName, NameValue);
+	}
+
+	return IDlgDialogueParticipant::Execute_ModifyNameValue(Participant, ValueName, NameValue);
+}
+
+void FDlgParticipantCalls::ClearCache()
+{
+	DlgNativeDialogueParticipant::NativeOffsets.Empty();
+}
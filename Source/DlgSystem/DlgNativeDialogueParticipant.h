@@ -0,0 +1,107 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "UObject/Interface.h"
+
+#include "DlgCondition.h"
+
+#include "DlgNativeDialogueParticipant.generated.h"
+
+class UDlgContext;
+
+// Value of a participant requested by a condition array, see IDlgNativeDialogueParticipant::GetValuesNative
+struct DLGSYSTEM_API FDlgParticipantValueRequest
+{
+public:
+	FDlgParticipantValueRequest() {}
+	FDlgParticipantValueRequest(EDlgConditionType InType, FName InValueName) : Type(InType), ValueName(InValueName) {}
+
+public:
+	// One of the FDlgCondition::HasDialogueValue types, only the value of that type is set
+	EDlgConditionType Type = EDlgConditionType::IntCall;
+	FName ValueName;
+
+	int32 IntValue = 0;
+	float FloatValue = 0.f;
+	bool bBoolValue = false;
+	FName NameValue;
+};
+
+UINTERFACE(meta = (CannotImplementInterfaceInBlueprint))
+class DLGSYSTEM_API UDlgNativeDialogueParticipant : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Optional C++ version of the conditions and events of IDlgDialogueParticipant.
+ *
+ * The participants still have to implement IDlgDialogueParticipant. For the ones that also implement this interface
+ * the conditions and events are virtual calls instead of going through the Blueprint VM (see FDlgParticipantCalls),
+ * so Blueprint children of these participants can NOT override the IDlgDialogueParticipant conditions and events.
+ */
+class DLGSYSTEM_API IDlgNativeDialogueParticipant
+{
+	GENERATED_BODY()
+
+public:
+	//
+	// Conditions, same as the ones of IDlgDialogueParticipant
+	//
+
+	virtual bool CheckConditionNative(const UDlgContext* Context, FName ConditionName) const { return false; }
+	virtual float GetFloatValueNative(FName ValueName) const { return 0.f; }
+	virtual int32 GetIntValueNative(FName ValueName) const { return 0; }
+	virtual bool GetBoolValueNative(FName ValueName) const { return false; }
+	virtual FName GetNameValueNative(FName ValueName) const { return NAME_None; }
+
+	// Fills all the values a condition array needs from this participant with a single call.
+	// Called before the conditions of the array are evaluated, so the getters must not have side effects.
+	// The default implementation calls the getters above one by one.
+	virtual void GetValuesNative(TArrayView<FDlgParticipantValueRequest> Requests) const;
+
+	//
+	// Events, same as the ones of IDlgDialogueParticipant
+	//
+
+	virtual bool OnDialogueEventNative(UDlgContext* Context, FName EventName) { return false; }
+	virtual bool ModifyFloatValueNative(FName ValueName, bool bDelta, float Value) { return false; }
+	virtual bool ModifyIntValueNative(FName ValueName, bool bDelta, int32 Value) { return false; }
+	virtual bool ModifyBoolValueNative(FName ValueName, bool bNewValue) { return false; }
+	virtual bool ModifyNameValueNative(FName ValueName, FName NameValue) { return false; }
+};
+
+// Calls the conditions and events of the participants, directly if they implement IDlgNativeDialogueParticipant,
+// through the IDlgDialogueParticipant Blueprint events otherwise.
+// NOTE: game thread only
+struct DLGSYSTEM_API FDlgParticipantCalls
+{
+public:
+	// The native interface of the Participant, nullptr if it does not implement it.
+	// Looked up once per participant class.
+	static const IDlgNativeDialogueParticipant* GetNative(const UObject* Participant);
+	static IDlgNativeDialogueParticipant* GetNative(UObject* Participant)
+	{
+		return const_cast<IDlgNativeDialogueParticipant*>(GetNative(static_cast<const UObject*>(Participant)));
+	}
+
+	static bool CheckCondition(const UObject* Participant, const UDlgContext* Context, FName ConditionName);
+	static float GetFloatValue(const UObject* Participant, FName ValueName);
+	static int32 GetIntValue(const UObject* Participant, FName ValueName);
+	static bool GetBoolValue(const UObject* Participant, FName ValueName);
+	static FName GetNameValue(const UObject* Participant, FName ValueName);
+
+	// Fills the Requests with one call for the native participants, one call per value otherwise
+	static void GetValues(const UObject* Participant, TArrayView<FDlgParticipantValueRequest> Requests);
+
+	static bool OnDialogueEvent(UObject* Participant, UDlgContext* Context, FName EventName);
+	static bool ModifyFloatValue(UObject* Participant, FName ValueName, bool bDelta, float Value);
+	static bool ModifyIntValue(UObject* Participant, FName ValueName, bool bDelta, int32 Value);
+	static bool ModifyBoolValue(UObject* Participant, FName ValueName, bool bNewValue);
+	static bool ModifyNameValue(UObject* Participant, FName ValueName, FName NameValue);
+
+	// Forgets the looked up classes
+	static void ClearCache();
+};
@@ -0,0 +1,59 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgNodeDescriptor.h"
+
+#include "Nodes/DlgNode_End.h"
+#include "Nodes/DlgNode_Proxy.h"
+#include "Nodes/DlgNode_Selector.h"
+#include "Nodes/DlgNode_Speech.h"
+#include "Nodes/DlgNode_SpeechSequence.h"
+#include "Nodes/DlgNode_Start.h"
+
+FDlgNodeDescriptor FDlgNodeDescriptor::FromNode(const UDlgNode& Node, int32 InFirstEdgeIndex)
+{
+	FDlgNodeDescriptor Descriptor;
+
+	// Exact classes, the children of the built-in nodes can override CheckNodeEnterConditions and the other virtuals
+	const UClass* NodeClass = Node.GetClass();
+	if (NodeClass == UDlgNode_Speech::StaticClass())
+	{
+		Descriptor.Kind = EDlgNodeKind::Speech;
+	}
+	else if (NodeClass == UDlgNode_SpeechSequence::StaticClass())
+	{
+		Descriptor.Kind = EDlgNodeKind::SpeechSequence;
+	}
+	else if (NodeClass == UDlgNode_Selector::StaticClass())
+	{
+		Descriptor.Kind = EDlgNodeKind::Selector;
+	}
+	else if (NodeClass == UDlgNode_End::StaticClass())
+	{
+		Descriptor.Kind = EDlgNodeKind::End;
+	}
+	else if (NodeClass == UDlgNode_Proxy::StaticClass())
+	{
+		Descriptor.Kind = EDlgNodeKind::Proxy;
+	}
+	else if (NodeClass == UDlgNode_Start::StaticClass())
+	{
+		Descriptor.Kind = EDlgNodeKind::Start;
+	}
+	else
+	{
+		Descriptor.Kind = EDlgNodeKind::Custom;
+	}
+
+	// Same as the check of UDlgDialogue::IsEndNode
+	Descriptor.bIsEnd = Node.IsA<UDlgNode_End>();
+	if (const UDlgNode_Speech* Speech = Cast<UDlgNode_Speech>(&Node))
+	{
+		Descriptor.bIsVirtualParent = Speech->IsVirtualParent();
+	}
+
+	Descriptor.bHasEnterConditions = Node.HasAnyEnterConditions();
+	Descriptor.bHasTextArguments = Node.GetTextArguments().Num() > 0;
+	Descriptor.bCheckChildrenOnEvaluation = Node.GetCheckChildrenOnEvaluation();
+	Descriptor.FirstEdgeIndex = InFirstEdgeIndex;
+	Descriptor.NumEdges = Node.GetNodeChildren().Num();
+	return Descriptor;
+}
@@ -0,0 +1,52 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UDlgNode;
+
+// Type of a Dialogue node, see FDlgNodeDescriptor
+// Only the built-in node classes have their own kind, their subclasses are Custom (they can override the node virtuals).
+enum class EDlgNodeKind : uint8
+{
+	Unknown = 0,
+	Start,
+	Speech,
+	SpeechSequence,
+	Selector,
+	Proxy,
+	Custom,
+	End
+};
+
+// Precomputed data of a Dialogue node, part of the FDlgBakedDialogue built by UDlgDialogue::RebuildBakedDialogue
+// Answers the frequent runtime queries (end node, node kind, enter conditions, etc.) without RTTI checks on the UDlgNode.
+struct DLGSYSTEM_API FDlgNodeDescriptor
+{
+public:
+	static FDlgNodeDescriptor FromNode(const UDlgNode& Node, int32 InFirstEdgeIndex);
+
+public:
+	EDlgNodeKind Kind = EDlgNodeKind::Unknown;
+
+	// Is a UDlgNode_End (or a child of it)
+	uint8 bIsEnd : 1;
+
+	// Is a UDlgNode_Speech (or a child of it) with IsVirtualParent
+	uint8 bIsVirtualParent : 1;
+
+	// UDlgNode::HasAnyEnterConditions
+	uint8 bHasEnterConditions : 1;
+
+	// UDlgNode::GetTextArguments is not empty
+	uint8 bHasTextArguments : 1;
+
+	// UDlgNode::GetCheckChildrenOnEvaluation
+	uint8 bCheckChildrenOnEvaluation : 1;
+
+	// Range of the node children in FDlgBakedDialogue::Edges
+	int32 FirstEdgeIndex = 0;
+	int32 NumEdges = 0;
+
+	FDlgNodeDescriptor() : bIsEnd(false), bIsVirtualParent(false), bHasEnterConditions(false), bHasTextArguments(false), bCheckChildrenOnEvaluation(false) {}
+};
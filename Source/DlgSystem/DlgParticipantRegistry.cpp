@@ -0,0 +1,539 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgParticipantRegistry.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+
+#include "DlgDialogueParticipant.h"
+#include "DlgManager.h"
+#include "DlgSystemSettings.h"
+#include "Logging/DlgLogger.h"
+
+
+void UDlgParticipantRegistry::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	CellSize = GetDefault<UDlgSystemSettings>()->ParticipantsCellSize;
+	OnPostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &ThisClass::HandlePostGarbageCollect);
+}
+
+void UDlgParticipantRegistry::Deinitialize()
+{
+	if (OnActorSpawnedHandle.IsValid())
+	{
+		if (UWorld* World = GetWorld())
+		{
+			World->RemoveOnActorSpawnedHandler(OnActorSpawnedHandle);
+		}
+		OnActorSpawnedHandle.Reset();
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(OnLevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(OnLevelRemovedHandle);
+	OnLevelAddedHandle.Reset();
+	OnLevelRemovedHandle.Reset();
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(OnPostGarbageCollectHandle);
+	OnPostGarbageCollectHandle.Reset();
+
+	Participants.Empty();
+	ParticipantsByName.Empty();
+	ParticipantsByCell.Empty();
+	PendingSpawnedActors.Empty();
+	bTrackingWorld = false;
+	bHasManualRegistrations = false;
+
+	Super::Deinitialize();
+}
+
+#if NY_ENGINE_VERSION >= 427
+void UDlgParticipantRegistry::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Search the world now instead of on the first query
+	StartTrackingWorld();
+}
+#endif
+
+UDlgParticipantRegistry* UDlgParticipantRegistry::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject || !GEngine)
+	{
+		return nullptr;
+	}
+
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+	{
+		return World->GetSubsystem<UDlgParticipantRegistry>();
+	}
+
+	return nullptr;
+}
+
+bool UDlgParticipantRegistry::RegisterParticipant(UObject* Participant)
+{
+	if (!AddParticipant(Participant))
+	{
+		return false;
+	}
+
+	Participants.FindChecked(Participant).bRegisteredManually = true;
+	bHasManualRegistrations = true;
+	return true;
+}
+
+void UDlgParticipantRegistry::UnregisterParticipant(UObject* Participant)
+{
+	RemoveParticipant(Participant);
+}
+
+void UDlgParticipantRegistry::UpdateParticipant(UObject* Participant)
+{
+	if (IsParticipantRegistered(Participant))
+	{
+		AddParticipant(Participant);
+	}
+}
+
+bool UDlgParticipantRegistry::IsAuthoritative()
+{
+	StartTrackingWorld();
+	return bTrackingWorld || (bHasManualRegistrations && GetDefault<UDlgSystemSettings>()->bUseOnlyRegisteredParticipants);
+}
+
+TArray<UObject*> UDlgParticipantRegistry::GetParticipants(FName ParticipantName)
+{
+	UpdateTracking();
+
+	TArray<UObject*> Array;
+	TArray<UObject*> Renamed;
+	if (const TArray<TWeakObjectPtr<UObject>>* WeakParticipants = ParticipantsByName.Find(ParticipantName))
+	{
+		for (const TWeakObjectPtr<UObject>& WeakParticipant : *WeakParticipants)
+		{
+			UObject* Participant = WeakParticipant.Get();
+			if (IsValid(Participant) && HasSameParticipantName(Participant, ParticipantName, Renamed))
+			{
+				Array.Add(Participant);
+			}
+		}
+	}
+	UpdateRenamedParticipants(Renamed);
+
+	return Array;
+}
+
+void UDlgParticipantRegistry::ForEachParticipant(TFunctionRef<void(FName ParticipantName, UObject* Participant)> Function)
+{
+	UpdateTracking();
+
+	TArray<UObject*> Renamed;
+	for (const auto& Pair : ParticipantsByName)
+	{
+		for (const TWeakObjectPtr<UObject>& WeakParticipant : Pair.Value)
+		{
+			UObject* Participant = WeakParticipant.Get();
+			if (IsValid(Participant) && HasSameParticipantName(Participant, Pair.Key, Renamed))
+			{
+				Function(Pair.Key, Participant);
+			}
+		}
+	}
+
+	// Under their new name
+	UpdateRenamedParticipants(Renamed);
+	for (UObject* Participant : Renamed)
+	{
+		Function(Participants.FindChecked(Participant).Name, Participant);
+	}
+}
+
+TArray<UObject*> UDlgParticipantRegistry::FindParticipantsInRadius(FVector Location, float Radius, FName ParticipantName)
+{
+	UpdateTracking();
+
+	TArray<UObject*> Array;
+	TArray<UObject*> Renamed;
+	const float RadiusSquared = FMath::Square(Radius);
+	auto AddIfInRadius = [this, &Array, &Renamed, &Location, RadiusSquared, ParticipantName](const TWeakObjectPtr<UObject>& WeakParticipant)
+	{
+		UObject* Participant = WeakParticipant.Get();
+		FVector ParticipantLocation;
+		if (IsValid(Participant)
+			&& (ParticipantName.IsNone() || HasSameParticipantName(Participant, ParticipantName, Renamed))
+			&& GetParticipantLocation(Participant, ParticipantLocation)
+			&& FVector::DistSquared(Location, ParticipantLocation) <= RadiusSquared)
+		{
+			Array.Add(Participant);
+		}
+	};
+
+	// Fewer participants than cells to look at (or no spatial hash)
+	const FIntVector MinCell = GetCell(Location - FVector(Radius));
+	const FIntVector MaxCell = GetCell(Location + FVector(Radius));
+	const int64 NumCells = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1) * int64(MaxCell.Z - MinCell.Z + 1);
+	const TArray<TWeakObjectPtr<UObject>>* NameParticipants = ParticipantName.IsNone() ? nullptr : ParticipantsByName.Find(ParticipantName);
+	const int32 NumCandidates = ParticipantName.IsNone() ? Participants.Num() : (NameParticipants ? NameParticipants->Num() : 0);
+	if (CellSize <= 0.f || NumCandidates <= NumCells)
+	{
+		if (NameParticipants)
+		{
+			for (const TWeakObjectPtr<UObject>& WeakParticipant : *NameParticipants)
+			{
+				AddIfInRadius(WeakParticipant);
+			}
+		}
+		else if (ParticipantName.IsNone())
+		{
+			for (const auto& Pair : ParticipantsByName)
+			{
+				for (const TWeakObjectPtr<UObject>& WeakParticipant : Pair.Value)
+				{
+					AddIfInRadius(WeakParticipant);
+				}
+			}
+		}
+
+		UpdateRenamedParticipants(Renamed);
+		return Array;
+	}
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				const TArray<TWeakObjectPtr<UObject>>* CellParticipants = ParticipantsByCell.Find(FIntVector(X, Y, Z));
+				if (!CellParticipants)
+				{
+					continue;
+				}
+
+				for (const TWeakObjectPtr<UObject>& WeakParticipant : *CellParticipants)
+				{
+					if (!ParticipantName.IsNone())
+					{
+						const FRegisteredParticipant* Registered = Participants.Find(WeakParticipant);
+						if (!Registered || Registered->Name != ParticipantName)
+						{
+							continue;
+						}
+					}
+
+					AddIfInRadius(WeakParticipant);
+				}
+			}
+		}
+	}
+
+	UpdateRenamedParticipants(Renamed);
+	return Array;
+}
+
+UObject* UDlgParticipantRegistry::FindNearestParticipant(FVector Location, float Radius, FName ParticipantName)
+{
+	UObject* NearestParticipant = nullptr;
+	float NearestDistanceSquared = TNumericLimits<float>::Max();
+	for (UObject* Participant : FindParticipantsInRadius(Location, Radius, ParticipantName))
+	{
+		FVector ParticipantLocation;
+		GetParticipantLocation(Participant, ParticipantLocation);
+		const float DistanceSquared = FVector::DistSquared(Location, ParticipantLocation);
+		if (DistanceSquared < NearestDistanceSquared)
+		{
+			NearestDistanceSquared = DistanceSquared;
+			NearestParticipant = Participant;
+		}
+	}
+
+	return NearestParticipant;
+}
+
+bool UDlgParticipantRegistry::GetParticipantLocation(const UObject* Participant, FVector& OutLocation)
+{
+	if (!IsValid(Participant))
+	{
+		return false;
+	}
+
+	if (const AActor* Actor = Cast<AActor>(Participant))
+	{
+		OutLocation = Actor->GetActorLocation();
+		return true;
+	}
+
+	if (const USceneComponent* SceneComponent = Cast<USceneComponent>(Participant))
+	{
+		OutLocation = SceneComponent->GetComponentLocation();
+		return true;
+	}
+
+	if (const AActor* OuterActor = Participant->GetTypedOuter<AActor>())
+	{
+		OutLocation = OuterActor->GetActorLocation();
+		return true;
+	}
+
+	return false;
+}
+
+bool UDlgParticipantRegistry::AddParticipant(UObject* Participant)
+{
+	if (!IsValid(Participant) || !Participant->GetClass()->ImplementsInterface(UDlgDialogueParticipant::StaticClass()))
+	{
+		FDlgLogger::Get().Errorf(
+			TEXT("DlgParticipantRegistry - FAILED to register Participant = `%s` because it does not implement the IDlgDialogueParticipant interface"),
+			Participant ? *Participant->GetPathName() : TEXT("nullptr")
+		);
+		return false;
+	}
+
+	const FName ParticipantName = IDlgDialogueParticipant::Execute_GetParticipantName(Participant);
+	const bool bNewParticipant = !Participants.Contains(Participant);
+	FRegisteredParticipant& Registered = Participants.FindOrAdd(Participant);
+
+	// Name
+	if (bNewParticipant || Registered.Name != ParticipantName)
+	{
+		if (!bNewParticipant)
+		{
+			RemoveFromName(Participant, Registered.Name);
+		}
+		ParticipantsByName.FindOrAdd(ParticipantName).Add(Participant);
+		Registered.Name = ParticipantName;
+	}
+
+	// Cell
+	FVector Location;
+	const bool bHasCell = CellSize > 0.f && GetParticipantLocation(Participant, Location);
+	const FIntVector Cell = bHasCell ? GetCell(Location) : FIntVector::ZeroValue;
+	if (Registered.bHasCell && (!bHasCell || Registered.Cell != Cell))
+	{
+		RemoveFromCell(Participant, Registered.Cell);
+		Registered.bHasCell = false;
+	}
+	if (bHasCell && !Registered.bHasCell)
+	{
+		ParticipantsByCell.FindOrAdd(Cell).Add(Participant);
+		Registered.Cell = Cell;
+		Registered.bHasCell = true;
+	}
+
+	return true;
+}
+
+void UDlgParticipantRegistry::RemoveParticipant(UObject* Participant)
+{
+	FRegisteredParticipant Registered;
+	if (!Participants.RemoveAndCopyValue(Participant, Registered))
+	{
+		return;
+	}
+
+	RemoveFromName(Participant, Registered.Name);
+	if (Registered.bHasCell)
+	{
+		RemoveFromCell(Participant, Registered.Cell);
+	}
+}
+
+void UDlgParticipantRegistry::StartTrackingWorld()
+{
+	if (bTrackingWorld || !GetDefault<UDlgSystemSettings>()->bTrackParticipantsAutomatically)
+	{
+		return;
+	}
+
+	// Only the game worlds, the editor worlds change in too many ways
+	UWorld* World = GetWorld();
+	if (!World || !World->IsGameWorld())
+	{
+		return;
+	}
+
+	bTrackingWorld = true;
+	for (TActorIterator<AActor> Itr(World); Itr; ++Itr)
+	{
+		RegisterParticipantsOfActor(*Itr);
+	}
+	OnActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::HandleActorSpawned));
+	// The actors of the streamed levels are not spawned
+	OnLevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::HandleLevelAddedToWorld);
+	OnLevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ThisClass::HandleLevelRemovedFromWorld);
+
+	FDlgLogger::Get().Debugf(TEXT("DlgParticipantRegistry - Tracking World = `%s`, found %d participants"), *World->GetMapName(), Participants.Num());
+}
+
+void UDlgParticipantRegistry::UpdateTracking()
+{
+	StartTrackingWorld();
+
+	for (int32 Index = PendingSpawnedActors.Num() - 1; Index >= 0; Index--)
+	{
+		AActor* Actor = PendingSpawnedActors[Index].Get();
+		if (!IsValid(Actor))
+		{
+			PendingSpawnedActors.RemoveAtSwap(Index);
+		}
+		else if (Actor->IsActorInitialized())
+		{
+			RegisterParticipantsOfActor(Actor);
+			PendingSpawnedActors.RemoveAtSwap(Index);
+		}
+	}
+}
+
+void UDlgParticipantRegistry::HandleActorSpawned(AActor* Actor)
+{
+	// Deferred spawns are broadcast before their properties (and participant names) are set
+	if (Actor && !Actor->IsActorInitialized())
+	{
+		PendingSpawnedActors.Add(Actor);
+		return;
+	}
+
+	RegisterParticipantsOfActor(Actor);
+}
+
+void UDlgParticipantRegistry::HandleLevelAddedToWorld(ULevel* Level, UWorld* InWorld)
+{
+	if (!Level || InWorld != GetWorld())
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (IsValid(Actor))
+		{
+			RegisterParticipantsOfActor(Actor);
+		}
+	}
+}
+
+void UDlgParticipantRegistry::HandleLevelRemovedFromWorld(ULevel* Level, UWorld* InWorld)
+{
+	if (InWorld != GetWorld())
+	{
+		return;
+	}
+
+	// nullptr means all the levels
+	// NOTE: only the tracked participants, the registered ones are kept until they unregister themselves (or are destroyed)
+	TArray<UObject*> Removed;
+	for (const auto& Pair : Participants)
+	{
+		UObject* Participant = Pair.Key.Get();
+		if (Participant && !Pair.Value.bRegisteredManually && (!Level || Participant->IsIn(Level)))
+		{
+			Removed.Add(Participant);
+		}
+	}
+	for (UObject* Participant : Removed)
+	{
+		RemoveParticipant(Participant);
+	}
+}
+
+bool UDlgParticipantRegistry::HasSameParticipantName(UObject* Participant, FName RegisteredName, TArray<UObject*>& OutRenamed) const
+{
+	if (IDlgDialogueParticipant::Execute_GetParticipantName(Participant) == RegisteredName)
+	{
+		return true;
+	}
+
+	OutRenamed.AddUnique(Participant);
+	return false;
+}
+
+void UDlgParticipantRegistry::UpdateRenamedParticipants(const TArray<UObject*>& Renamed)
+{
+	for (UObject* Participant : Renamed)
+	{
+		AddParticipant(Participant);
+	}
+}
+
+void UDlgParticipantRegistry::HandlePostGarbageCollect()
+{
+	RemoveDestroyedParticipants();
+}
+
+void UDlgParticipantRegistry::RemoveDestroyedParticipants()
+{
+	for (auto It = Participants.CreateIterator(); It; ++It)
+	{
+		if (It.Key().IsValid())
+		{
+			continue;
+		}
+
+		// Removes all the invalid ones of the name/cell
+		RemoveFromName(nullptr, It.Value().Name);
+		if (It.Value().bHasCell)
+		{
+			RemoveFromCell(nullptr, It.Value().Cell);
+		}
+		It.RemoveCurrent();
+	}
+}
+
+void UDlgParticipantRegistry::RegisterParticipantsOfActor(AActor* Actor)
+{
+	TArray<UObject*> ActorParticipants;
+	TSet<UObject*> VisitedSet;
+	UDlgManager::GatherParticipantsRecursive(Actor, ActorParticipants, VisitedSet);
+	for (UObject* Participant : ActorParticipants)
+	{
+		AddParticipant(Participant);
+	}
+}
+
+FIntVector UDlgParticipantRegistry::GetCell(const FVector& Location) const
+{
+	if (CellSize <= 0.f)
+	{
+		return FIntVector::ZeroValue;
+	}
+
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize)
+	);
+}
+
+void UDlgParticipantRegistry::RemoveFromName(UObject* Participant, FName ParticipantName)
+{
+	if (TArray<TWeakObjectPtr<UObject>>* WeakParticipants = ParticipantsByName.Find(ParticipantName))
+	{
+		// Also forget the destroyed ones
+		WeakParticipants->RemoveAllSwap([Participant](const TWeakObjectPtr<UObject>& WeakParticipant)
+		{
+			return !WeakParticipant.IsValid() || WeakParticipant.Get() == Participant;
+		});
+		if (WeakParticipants->Num() == 0)
+		{
+			ParticipantsByName.Remove(ParticipantName);
+		}
+	}
+}
+
+void UDlgParticipantRegistry::RemoveFromCell(UObject* Participant, const FIntVector& Cell)
+{
+	if (TArray<TWeakObjectPtr<UObject>>* WeakParticipants = ParticipantsByCell.Find(Cell))
+	{
+		WeakParticipants->RemoveAllSwap([Participant](const TWeakObjectPtr<UObject>& WeakParticipant)
+		{
+			return !WeakParticipant.IsValid() || WeakParticipant.Get() == Participant;
+		});
+		if (WeakParticipants->Num() == 0)
+		{
+			ParticipantsByCell.Remove(Cell);
+		}
+	}
+}
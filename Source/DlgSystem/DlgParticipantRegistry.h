@@ -0,0 +1,149 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#include "NYEngineVersionHelpers.h"
+
+#include "DlgParticipantRegistry.generated.h"
+
+class AActor;
+class ULevel;
+
+/**
+ * Participants (objects implementing the IDlgDialogueParticipant interface) of a world, by participant name,
+ * so that UDlgManager::StartDialogueWithDefaultParticipants does not have to search the whole world.
+ *
+ * By default the participants must register/unregister themselves. If UDlgSystemSettings::bTrackParticipantsAutomatically is enabled
+ * the game worlds are searched ONCE (on begin play or on the first query) and then only the spawned actors and the streamed levels are searched.
+ * If the registry does not have every participant (editor worlds, only some participants registered themselves) UDlgManager still searches
+ * the world for the participant names the registry has no entry for, unless UDlgSystemSettings::bUseOnlyRegisteredParticipants is enabled.
+ * The streamed out levels only remove the participants found by the tracking, the registered ones have to unregister themselves.
+ *
+ * The participants are also kept in a spatial hash (see UDlgSystemSettings::ParticipantsCellSize) for the nearest participant queries.
+ * NOTE: The location is read on registration, participants that move must call UpdateParticipant.
+ * The names are checked when the participants are returned, the renamed participants are moved to their new name then.
+ */
+UCLASS()
+class DLGSYSTEM_API UDlgParticipantRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//
+	// USubsystem Interface
+	//
+
+	void Initialize(FSubsystemCollectionBase& Collection) override;
+	void Deinitialize() override;
+
+#if NY_ENGINE_VERSION >= 427
+	void OnWorldBeginPlay(UWorld& InWorld) override;
+#endif
+
+	//
+	// Own methods
+	//
+
+	// Gets the registry of the world of the WorldContextObject, nullptr if the object is not in a world
+	static UDlgParticipantRegistry* Get(const UObject* WorldContextObject);
+
+	// Adds the Participant (must implement the IDlgDialogueParticipant interface), same as UpdateParticipant if it is already registered
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Participants")
+	bool RegisterParticipant(UObject* Participant);
+
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Participants")
+	void UnregisterParticipant(UObject* Participant);
+
+	// Reads the participant name and the location of the registered Participant again
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Participants")
+	void UpdateParticipant(UObject* Participant);
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Participants")
+	bool IsParticipantRegistered(UObject* Participant) const { return Participants.Contains(Participant); }
+
+	// Is this the list of all the participants of the world? If not the world has to be searched for the missing ones
+	// True if the world is tracked or if participants are registered and UDlgSystemSettings::bUseOnlyRegisteredParticipants is enabled
+	bool IsAuthoritative();
+
+	// The registered participants with the ParticipantName
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Participants")
+	TArray<UObject*> GetParticipants(FName ParticipantName);
+
+	// Calls Function for each registered participant
+	void ForEachParticipant(TFunctionRef<void(FName ParticipantName, UObject* Participant)> Function);
+
+	// The registered participants that were within Radius of Location when they were registered/updated and still are
+	// ParticipantName - if not none only the participants with this name are returned
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Participants")
+	TArray<UObject*> FindParticipantsInRadius(FVector Location, float Radius, FName ParticipantName = NAME_None);
+
+	// The closest participant within Radius of Location, see FindParticipantsInRadius
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Participants")
+	UObject* FindNearestParticipant(FVector Location, float Radius, FName ParticipantName = NAME_None);
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Participants")
+	int32 GetNumParticipants() const { return Participants.Num(); }
+
+	// Location of the Participant: its own if it is an actor or a scene component, the location of its actor otherwise
+	static bool GetParticipantLocation(const UObject* Participant, FVector& OutLocation);
+
+protected:
+	bool AddParticipant(UObject* Participant);
+	void RemoveParticipant(UObject* Participant);
+
+	// Searches the world once and starts listening for the spawned actors, if enabled
+	void StartTrackingWorld();
+
+	// Registers the participants of the spawned actors that finished spawning
+	void UpdateTracking();
+
+	void HandleActorSpawned(AActor* Actor);
+	void HandleLevelAddedToWorld(ULevel* Level, UWorld* InWorld);
+	void HandleLevelRemovedFromWorld(ULevel* Level, UWorld* InWorld);
+	void HandlePostGarbageCollect();
+
+	// Is the registered name of the Participant still its name? If not it is added to OutRenamed, see UpdateRenamedParticipants
+	bool HasSameParticipantName(UObject* Participant, FName RegisteredName, TArray<UObject*>& OutRenamed) const;
+	void UpdateRenamedParticipants(const TArray<UObject*>& Renamed);
+
+	// Forgets the destroyed participants
+	void RemoveDestroyedParticipants();
+
+	void RegisterParticipantsOfActor(AActor* Actor);
+
+	FIntVector GetCell(const FVector& Location) const;
+	void RemoveFromName(UObject* Participant, FName ParticipantName);
+	void RemoveFromCell(UObject* Participant, const FIntVector& Cell);
+
+protected:
+	struct FRegisteredParticipant
+	{
+		FName Name;
+		FIntVector Cell = FIntVector::ZeroValue;
+		bool bHasCell = false;
+
+		// Registered with RegisterParticipant, not by the world tracking
+		bool bRegisteredManually = false;
+	};
+
+	// NOTE: weak keys so that the destroyed participants can be found and removed
+	TMap<TWeakObjectPtr<UObject>, FRegisteredParticipant> Participants;
+	TMap<FName, TArray<TWeakObjectPtr<UObject>>> ParticipantsByName;
+	TMap<FIntVector, TArray<TWeakObjectPtr<UObject>>> ParticipantsByCell;
+
+	// Cell size of the spatial hash, copied from the settings, <= 0 if disabled
+	float CellSize = 0.f;
+
+	// Spawned actors that have not finished spawning (deferred spawns) when they were spawned
+	TArray<TWeakObjectPtr<AActor>> PendingSpawnedActors;
+
+	FDelegateHandle OnActorSpawnedHandle;
+	FDelegateHandle OnLevelAddedHandle;
+	FDelegateHandle OnLevelRemovedHandle;
+	FDelegateHandle OnPostGarbageCollectHandle;
+	bool bTrackingWorld = false;
+	bool bHasManualRegistrations = false;
+};
@@ -0,0 +1,243 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgStreamingSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+
+#include "DlgDialogue.h"
+#include "DlgDialogueIndex.h"
+#include "DlgSystemSettings.h"
+#include "Logging/DlgLogger.h"
+
+
+void UDlgStreamingSubsystem::Deinitialize()
+{
+	TArray<FSoftObjectPath> Paths;
+	StreamedDialogues.GetKeys(Paths);
+	for (const FSoftObjectPath& Path : Paths)
+	{
+		ReleaseStreamedDialogue(Path);
+	}
+	StreamedDialogues.Empty();
+
+	Super::Deinitialize();
+}
+
+void UDlgStreamingSubsystem::Tick(float DeltaTime)
+{
+	const float UnloadDelay = GetDefault<UDlgSystemSettings>()->StreamedDialoguesUnloadDelay;
+	if (UnloadDelay <= 0.f)
+	{
+		return;
+	}
+
+	const double NowSeconds = FPlatformTime::Seconds();
+	if (NowSeconds < NextUnloadCheckSeconds)
+	{
+		return;
+	}
+	NextUnloadCheckSeconds = NowSeconds + UnloadCheckInterval;
+
+	TArray<FSoftObjectPath> UnusedPaths;
+	for (const auto& Pair : StreamedDialogues)
+	{
+		// Still loading
+		if (Pair.Value.PendingCallbacks.Num() > 0)
+		{
+			continue;
+		}
+
+		if (NowSeconds - Pair.Value.LastUsedSeconds >= UnloadDelay)
+		{
+			UnusedPaths.Add(Pair.Key);
+		}
+	}
+
+	for (const FSoftObjectPath& Path : UnusedPaths)
+	{
+		FDlgLogger::Get().Debugf(TEXT("DlgStreamingSubsystem - Releasing the unused Dialogue = `%s`"), *Path.ToString());
+		ReleaseStreamedDialogue(Path);
+	}
+}
+
+TStatId UDlgStreamingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDlgStreamingSubsystem, STATGROUP_Tickables);
+}
+
+bool UDlgStreamingSubsystem::IsTickable() const
+{
+	return !IsTemplate() && StreamedDialogues.Num() > 0;
+}
+
+ETickableTickType UDlgStreamingSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+UDlgStreamingSubsystem* UDlgStreamingSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject || !GEngine)
+	{
+		return nullptr;
+	}
+
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+	{
+		if (const UGameInstance* GameInstance = World->GetGameInstance())
+		{
+			return GameInstance->GetSubsystem<UDlgStreamingSubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+TSharedPtr<FStreamableHandle> UDlgStreamingSubsystem::RequestDialogue(const FSoftObjectPath& Path, int32 Priority, FDlgOnDialogueStreamed OnStreamed)
+{
+	if (Path.IsNull())
+	{
+		FDlgLogger::Get().Error(TEXT("DlgStreamingSubsystem - RequestDialogue - FAILED because the Path is empty"));
+		OnStreamed.ExecuteIfBound(nullptr);
+		return nullptr;
+	}
+
+	FStreamedDialogue& StreamedDialogue = StreamedDialogues.FindOrAdd(Path);
+	StreamedDialogue.LastUsedSeconds = FPlatformTime::Seconds();
+	StreamedDialogue.PendingCallbacks.Add(MoveTemp(OnStreamed));
+
+	// NOTE: the delegate might be called before this returns
+	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(
+		Path,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::HandleDialogueStreamed, Path),
+		Priority
+	);
+	if (!Handle.IsValid())
+	{
+		FDlgLogger::Get().Errorf(TEXT("DlgStreamingSubsystem - RequestDialogue - FAILED to request the Dialogue = `%s`"), *Path.ToString());
+		ReleaseStreamedDialogue(Path);
+		return nullptr;
+	}
+
+	// Released in the meantime
+	if (FStreamedDialogue* StreamedDialoguePtr = StreamedDialogues.Find(Path))
+	{
+		StreamedDialoguePtr->Handles.Add(Handle);
+	}
+	return Handle;
+}
+
+TSharedPtr<FStreamableHandle> UDlgStreamingSubsystem::RequestDialogueByGUID(const FGuid& GUID, int32 Priority, FDlgOnDialogueStreamed OnStreamed)
+{
+	FSoftObjectPath Path;
+	if (!FDlgDialogueIndex::Get().FindPathByGUID(GUID, Path))
+	{
+		FDlgLogger::Get().Errorf(TEXT("DlgStreamingSubsystem - RequestDialogueByGUID - FAILED to find a Dialogue with the GUID = `%s`"), *GUID.ToString());
+		OnStreamed.ExecuteIfBound(nullptr);
+		return nullptr;
+	}
+
+	return RequestDialogue(Path, Priority, MoveTemp(OnStreamed));
+}
+
+TFuture<UDlgDialogue*> UDlgStreamingSubsystem::RequestDialogueFuture(const FSoftObjectPath& Path, int32 Priority)
+{
+	// The callback is always called (with nullptr on failure), so the promise is always set
+	TSharedRef<TPromise<UDlgDialogue*>> Promise = MakeShared<TPromise<UDlgDialogue*>>();
+	TFuture<UDlgDialogue*> Future = Promise->GetFuture();
+	RequestDialogue(Path, Priority, FDlgOnDialogueStreamed::CreateLambda([Promise](UDlgDialogue* Dialogue)
+	{
+		Promise->SetValue(Dialogue);
+	}));
+
+	return Future;
+}
+
+void UDlgStreamingSubsystem::RequestDialogueAsync(TSoftObjectPtr<UDlgDialogue> Dialogue, int32 Priority, const FDlgOnDialogueStreamedDynamic& OnStreamed)
+{
+	RequestDialogue(Dialogue.ToSoftObjectPath(), Priority, FDlgOnDialogueStreamed::CreateLambda([OnStreamed](UDlgDialogue* LoadedDialogue)
+	{
+		OnStreamed.ExecuteIfBound(LoadedDialogue);
+	}));
+}
+
+void UDlgStreamingSubsystem::TouchDialogue(TSoftObjectPtr<UDlgDialogue> Dialogue)
+{
+	if (FStreamedDialogue* StreamedDialogue = StreamedDialogues.Find(Dialogue.ToSoftObjectPath()))
+	{
+		StreamedDialogue->LastUsedSeconds = FPlatformTime::Seconds();
+	}
+}
+
+void UDlgStreamingSubsystem::ReleaseDialogue(TSoftObjectPtr<UDlgDialogue> Dialogue)
+{
+	ReleaseStreamedDialogue(Dialogue.ToSoftObjectPath());
+}
+
+bool UDlgStreamingSubsystem::IsDialogueStreamed(TSoftObjectPtr<UDlgDialogue> Dialogue) const
+{
+	const FStreamedDialogue* StreamedDialogue = StreamedDialogues.Find(Dialogue.ToSoftObjectPath());
+	return StreamedDialogue && StreamedDialogue->PendingCallbacks.Num() == 0 && Dialogue.Get() != nullptr;
+}
+
+void UDlgStreamingSubsystem::HandleDialogueStreamed(FSoftObjectPath Path)
+{
+	FStreamedDialogue* StreamedDialogue = StreamedDialogues.Find(Path);
+	if (!StreamedDialogue)
+	{
+		return;
+	}
+
+	UDlgDialogue* Dialogue = Cast<UDlgDialogue>(Path.ResolveObject());
+	if (!Dialogue)
+	{
+		FDlgLogger::Get().Errorf(TEXT("DlgStreamingSubsystem - FAILED to load the Dialogue = `%s`"), *Path.ToString());
+	}
+
+	StreamedDialogue->LastUsedSeconds = FPlatformTime::Seconds();
+
+	// The callbacks might request/release Dialogues
+	TArray<FDlgOnDialogueStreamed> Callbacks = MoveTemp(StreamedDialogue->PendingCallbacks);
+	StreamedDialogue->PendingCallbacks.Reset();
+	if (!Dialogue)
+	{
+		ReleaseStreamedDialogue(Path);
+	}
+
+	for (const FDlgOnDialogueStreamed& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound(Dialogue);
+	}
+}
+
+void UDlgStreamingSubsystem::ReleaseStreamedDialogue(const FSoftObjectPath& Path)
+{
+	FStreamedDialogue StreamedDialogue;
+	if (!StreamedDialogues.RemoveAndCopyValue(Path, StreamedDialogue))
+	{
+		return;
+	}
+
+	for (const TSharedPtr<FStreamableHandle>& Handle : StreamedDialogue.Handles)
+	{
+		if (!Handle.IsValid())
+		{
+			continue;
+		}
+
+		if (Handle->IsLoadingInProgress())
+		{
+			Handle->CancelHandle();
+		}
+		else
+		{
+			Handle->ReleaseHandle();
+		}
+	}
+
+	for (const FDlgOnDialogueStreamed& Callback : StreamedDialogue.PendingCallbacks)
+	{
+		Callback.ExecuteIfBound(nullptr);
+	}
+}
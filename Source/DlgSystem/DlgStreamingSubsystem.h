@@ -0,0 +1,121 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "Tickable.h"
+#include "Async/Future.h"
+
+#include "DlgStreamingSubsystem.generated.h"
+
+class UDlgDialogue;
+
+// Dialogue, nullptr if it failed to load
+DECLARE_DELEGATE_OneParam(FDlgOnDialogueStreamed, UDlgDialogue*);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FDlgOnDialogueStreamedDynamic, UDlgDialogue*, Dialogue);
+
+
+/**
+ * Streams the Dialogues asynchronously (prioritized, see FStreamableManager) so that starting a Dialogue does not
+ * have to block on loading it, see UDlgManager::StartDialogueWhenLoaded.
+ *
+ * The streamed Dialogues are kept loaded while they are used, the ones not requested (or touched) for
+ * UDlgSystemSettings::StreamedDialoguesUnloadDelay seconds are released and garbage collected once nothing else references them.
+ * NOTE: the running contexts reference their Dialogue, so releasing it here never unloads a Dialogue that is in use.
+ */
+UCLASS()
+class DLGSYSTEM_API UDlgStreamingSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	//
+	// USubsystem Interface
+	//
+
+	void Deinitialize() override;
+
+	//
+	// FTickableGameObject Interface
+	//
+
+	void Tick(float DeltaTime) override;
+	TStatId GetStatId() const override;
+	bool IsTickable() const override;
+	ETickableTickType GetTickableTickType() const override;
+	bool IsTickableWhenPaused() const override { return true; }
+
+	//
+	// Own methods
+	//
+
+	// Gets the subsystem of the game instance of the WorldContextObject, nullptr if the object is not in a game world
+	static UDlgStreamingSubsystem* Get(const UObject* WorldContextObject);
+
+	// Streams the Dialogue at Path, higher priorities load first
+	// OnStreamed is called once the Dialogue is loaded (maybe before this returns if it was already loaded),
+	// with nullptr if it failed to load or the subsystem was deinitialized in the meantime
+	// Return the handle of this request, nullptr if the Path is invalid
+	TSharedPtr<FStreamableHandle> RequestDialogue(
+		const FSoftObjectPath& Path,
+		int32 Priority = FStreamableManager::DefaultAsyncLoadPriority,
+		FDlgOnDialogueStreamed OnStreamed = {}
+	);
+
+	// Same as RequestDialogue but the Dialogue is found by its GUID in the FDlgDialogueIndex
+	TSharedPtr<FStreamableHandle> RequestDialogueByGUID(
+		const FGuid& GUID,
+		int32 Priority = FStreamableManager::DefaultAsyncLoadPriority,
+		FDlgOnDialogueStreamed OnStreamed = {}
+	);
+
+	// Same as RequestDialogue but the result is a future, set to nullptr if the Dialogue failed to load
+	TFuture<UDlgDialogue*> RequestDialogueFuture(const FSoftObjectPath& Path, int32 Priority = FStreamableManager::DefaultAsyncLoadPriority);
+
+	// Streams the Dialogue, OnStreamed is called once it is loaded, see RequestDialogue
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Streaming", meta = (AutoCreateRefTerm = "OnStreamed"))
+	void RequestDialogueAsync(TSoftObjectPtr<UDlgDialogue> Dialogue, int32 Priority, const FDlgOnDialogueStreamedDynamic& OnStreamed);
+
+	// Marks the streamed Dialogue as used now, so that it is not unloaded for another StreamedDialoguesUnloadDelay seconds
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Streaming")
+	void TouchDialogue(TSoftObjectPtr<UDlgDialogue> Dialogue);
+
+	// Releases the streamed Dialogue now, the pending requests are canceled (their callbacks get nullptr)
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Streaming")
+	void ReleaseDialogue(TSoftObjectPtr<UDlgDialogue> Dialogue);
+
+	// Is the Dialogue requested and loaded?
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Streaming")
+	bool IsDialogueStreamed(TSoftObjectPtr<UDlgDialogue> Dialogue) const;
+
+	// Number of Dialogues requested (loaded or still loading)
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Streaming")
+	int32 GetNumStreamedDialogues() const { return StreamedDialogues.Num(); }
+
+protected:
+	void HandleDialogueStreamed(FSoftObjectPath Path);
+
+	// Releases the handles of the Dialogue and calls the pending callbacks with nullptr
+	void ReleaseStreamedDialogue(const FSoftObjectPath& Path);
+
+protected:
+	struct FStreamedDialogue
+	{
+		// One for each request, all of them keep the Dialogue loaded
+		TArray<TSharedPtr<FStreamableHandle>> Handles;
+
+		// Callbacks of the requests made while the Dialogue was still loading
+		TArray<FDlgOnDialogueStreamed> PendingCallbacks;
+
+		// FPlatformTime::Seconds of the last request/touch
+		double LastUsedSeconds = 0.0;
+	};
+
+	// How often (in seconds) the unused Dialogues are looked for
+	static constexpr double UnloadCheckInterval = 1.0;
+
+	FStreamableManager StreamableManager;
+	TMap<FSoftObjectPath, FStreamedDialogue> StreamedDialogues;
+	double NextUnloadCheckSeconds = 0.0;
+};
@@ -23,10 +23,14 @@
 #include "DlgConstants.h"
 #include "DlgManager.h"
 #include "DlgDialogue.h"
+#include "DlgDialogueIndex.h"
+#include "DlgNativeDialogueParticipant.h"
 #include "GameplayDebugger/DlgGameplayDebuggerCategory.h"
 #include "GameplayDebugger/SDlgDataDisplay.h"
 #include "Logging/DlgLogger.h"
 #include "DlgHelper.h"
+#include "NYReflectionHelper.h"
+#include "IO/IDlgParser.h"
 
 #define LOCTEXT_NAMESPACE "FDlgSystemModule"
 
@@ -53,6 +57,44 @@ void FDlgSystemModule::StartupModule()
 	OnAssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &Self::HandleOnAssetRemoved);
 	OnAssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &Self::HandleOnAssetRenamed);
 
+	// Keep the FDlgDialogueIndex up to date
+	OnAssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &Self::HandleOnAssetAdded);
+#if NY_ENGINE_VERSION >= 500
+	OnAssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &Self::HandleOnAssetUpdated);
+#endif
+
+	// The properties of the reloaded classes can change, the cached ones are no longer valid
+	// NOTE: the blueprint compile is handled in the editor module
+	const auto ClearReflectionCaches = []()
+	{
+		FNYReflectionHelper::ClearPropertyCache();
+		FDlgParticipantCalls::ClearCache();
+		IDlgParser::ClearClassCache();
+	};
+#if NY_ENGINE_VERSION >= 427
+	OnReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([ClearReflectionCaches](EReloadCompleteReason Reason)
+	{
+		ClearReflectionCaches();
+	});
+#elif WITH_HOT_RELOAD
+	// No ReloadCompleteDelegate, every hot reloaded class is registered here before it is reinstanced
+	OnReloadCompleteHandle = FCoreUObjectDelegates::RegisterClassForHotReloadReinstancingDelegate.AddLambda(
+		[ClearReflectionCaches](UClass* OldClass, UClass* NewClass, EHotReloadedClassFlags Flags)
+		{
+			ClearReflectionCaches();
+		}
+	);
+#endif
+
+	// The loaded modules can add classes the parsers have to find
+	OnModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda([](FName ModuleName, EModuleChangeReason Reason)
+	{
+		if (Reason == EModuleChangeReason::ModuleLoaded)
+		{
+			IDlgParser::ClearClassCache();
+		}
+	});
+
 #if WITH_GAMEPLAY_DEBUGGER
 	// If the gameplay debugger is available, register the category and notify the editor about the changes
 	IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
@@ -128,6 +170,16 @@ void FDlgSystemModule::ShutdownModule()
 		{
 			AssetRegistry.OnAssetRenamed().Remove(OnAssetRenamedHandle);
 		}
+		if (OnAssetAddedHandle.IsValid())
+		{
+			AssetRegistry.OnAssetAdded().Remove(OnAssetAddedHandle);
+		}
+#if NY_ENGINE_VERSION >= 500
+		if (OnAssetUpdatedHandle.IsValid())
+		{
+			AssetRegistry.OnAssetUpdated().Remove(OnAssetUpdatedHandle);
+		}
+#endif
 	}
 
 	if (OnPreLoadMapHandle.IsValid())
@@ -138,6 +190,24 @@ void FDlgSystemModule::ShutdownModule()
 	{
 		FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(OnPostLoadMapWithWorldHandle);
 	}
+#if NY_ENGINE_VERSION >= 427
+	if (OnReloadCompleteHandle.IsValid())
+	{
+		FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(OnReloadCompleteHandle);
+	}
+#elif WITH_HOT_RELOAD
+	if (OnReloadCompleteHandle.IsValid())
+	{
+		FCoreUObjectDelegates::RegisterClassForHotReloadReinstancingDelegate.Remove(OnReloadCompleteHandle);
+	}
+#endif
+	if (OnModulesChangedHandle.IsValid())
+	{
+		FModuleManager::Get().OnModulesChanged().Remove(OnModulesChangedHandle);
+	}
+	FNYReflectionHelper::ClearPropertyCache();
+	FDlgParticipantCalls::ClearCache();
+	IDlgParser::ClearClassCache();
 
 	FDlgLogger::Get().Info(TEXT("DlgSystemModule: ShutdownModule"));
 	FDlgLogger::OnShutdown();
@@ -257,8 +327,19 @@ void FDlgSystemModule::HandleOnInMemoryAssetDeleted(UObject* DeletedObject)
 	}
 }
 
+void FDlgSystemModule::HandleOnAssetAdded(const FAssetData& AddedAsset)
+{
+	FDlgDialogueIndex::Get().OnAssetAdded(AddedAsset);
+}
+
+void FDlgSystemModule::HandleOnAssetUpdated(const FAssetData& UpdatedAsset)
+{
+	FDlgDialogueIndex::Get().OnAssetUpdated(UpdatedAsset);
+}
+
 void FDlgSystemModule::HandleOnAssetRemoved(const FAssetData& RemovedAsset)
 {
+	FDlgDialogueIndex::Get().OnAssetRemoved(RemovedAsset);
 	if (!RemovedAsset.IsAssetLoaded())
 	{
 		return;
@@ -267,6 +348,7 @@ void FDlgSystemModule::HandleOnAssetRemoved(const FAssetData& RemovedAsset)
 
 void FDlgSystemModule::HandleOnAssetRenamed(const FAssetData& AssetRenamed, const FString& OldObjectPath)
 {
+	FDlgDialogueIndex::Get().OnAssetRenamed(AssetRenamed, OldObjectPath);
 	UObject* ObjectRenamed = AssetRenamed.GetAsset();
 	if (UDlgDialogue* Dialogue = Cast<UDlgDialogue>(ObjectRenamed))
 	{
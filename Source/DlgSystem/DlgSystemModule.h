@@ -39,6 +39,12 @@ private:
 	// Handle the event from the asset registry when an asset was deleted.
 	void HandleOnInMemoryAssetDeleted(UObject* DeletedObject);
 
+	// Handle the event for when assets are added to the asset registry.
+	void HandleOnAssetAdded(const FAssetData& AddedAsset);
+
+	// Handle the event for when the tags of assets are updated in the asset registry.
+	void HandleOnAssetUpdated(const FAssetData& UpdatedAsset);
+
 	// Handle the event for when assets are removed from the asset registry.
 	void HandleOnAssetRemoved(const FAssetData& RemovedAsset);
 
@@ -78,6 +84,10 @@ private:
 	FDelegateHandle OnPreLoadMapHandle;
 	FDelegateHandle OnPostLoadMapWithWorldHandle;
 	FDelegateHandle OnInMemoryAssetDeletedHandle;
+	FDelegateHandle OnAssetAddedHandle;
+	FDelegateHandle OnAssetUpdatedHandle;
 	FDelegateHandle OnAssetRemovedHandle;
 	FDelegateHandle OnAssetRenamedHandle;
+	FDelegateHandle OnReloadCompleteHandle;
+	FDelegateHandle OnModulesChangedHandle;
 };
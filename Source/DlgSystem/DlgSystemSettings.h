@@ -261,6 +261,43 @@ public:
 	UPROPERTY(Category = "Runtime", Config, EditAnywhere)
 	EDlgNoSatisfiedChildBehavior NoSatisfiedChildBehavior;
 
+	// The Dialogues streamed by the UDlgStreamingSubsystem (e.g. UDlgManager::StartDialogueWhenLoaded) are kept loaded
+	// for this many seconds after they were last requested. If this is <= 0 they are kept until the game instance shuts down.
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere, meta = (Units = "s"))
+	float StreamedDialoguesUnloadDelay = 120.f;
+
+	// If enabled the UDlgParticipantRegistry of each game world searches the world once for the participants and then only the spawned actors
+	// and the streamed in levels, so that StartDialogueWithDefaultParticipants does not have to search the whole world every time.
+	// NOTE: the participants created in other ways (e.g. components added at runtime) are only found if they register themselves
+	// (UDlgParticipantRegistry::RegisterParticipant), by default the world is searched unless the participants register themselves.
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere)
+	bool bTrackParticipantsAutomatically = false;
+
+	// If enabled and some participants registered themselves (UDlgParticipantRegistry::RegisterParticipant) the world is not searched anymore,
+	// only the registered participants are used. Only enable it if every participant registers itself.
+	// If disabled the world is still searched for the participants names that no registered participant has.
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere)
+	bool bUseOnlyRegisteredParticipants = false;
+
+	// Size of the cells of the spatial hash of the UDlgParticipantRegistry used by the nearest participant queries
+	// If this is <= 0 the queries check every participant
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere, meta = (Units = "cm"))
+	float ParticipantsCellSize = 2000.f;
+
+	// Maximum number of free contexts kept by the UDlgContextPool of each world, the contexts released above this are garbage collected
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere, meta = (ClampMin = "0"))
+	int32 MaxPooledContexts = 64;
+
+	// Evaluates the conditions that only read class variables (or the history of the context) of the options of big nodes on worker threads.
+	// The other conditions (participant calls, custom conditions) are still evaluated on the game thread, after them.
+	// NOTE: the participant calls and custom conditions must not change the class variables read by the conditions of the same node.
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere)
+	bool bParallelConditionsEvaluation = false;
+
+	// Minimum number of edges of a node to evaluate its conditions on worker threads, see bParallelConditionsEvaluation
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere, meta = (ClampMin = "1"))
+	int32 ParallelConditionsMinEdges = 32;
+
 
 	// The dialogue text format used for saving and reloading from text files.
 	UPROPERTY(Category = "Dialogue", Config, EditAnywhere, DisplayName = "Text Format")
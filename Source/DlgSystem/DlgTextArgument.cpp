@@ -7,6 +7,7 @@
 #include "DlgContext.h"
 #include "DlgHelper.h"
 #include "DlgDialogueParticipant.h"
+#include "DlgNativeDialogueParticipant.h"
 #include "NYReflectionHelper.h"
 #include "Logging/DlgLogger.h"
 
@@ -27,13 +28,13 @@ FFormatArgumentValue FDlgTextArgument::ConstructFormatArgumentValue(const UDlgCo
 	switch (Type)
 	{
 		case EDlgTextArgumentType::DialogueInt:
-			return FFormatArgumentValue(IDlgDialogueParticipant::Execute_GetIntValue(Participant, VariableName));
+			return FFormatArgumentValue(FDlgParticipantCalls::GetIntValue(Participant, VariableName));
 
 		case EDlgTextArgumentType::ClassInt:
 			return FFormatArgumentValue(FNYReflectionHelper::GetVariable<FIntProperty, int32>(Participant, VariableName));
 
 		case EDlgTextArgumentType::DialogueFloat:
-			return FFormatArgumentValue(IDlgDialogueParticipant::Execute_GetFloatValue(Participant, VariableName));
+			return FFormatArgumentValue(FDlgParticipantCalls::GetFloatValue(Participant, VariableName));
 
 		case EDlgTextArgumentType::ClassFloat:
 			return FFormatArgumentValue(FNYReflectionHelper::GetVariable<FFloatProperty, float>(Participant, VariableName));
@@ -65,6 +66,57 @@ FFormatArgumentValue FDlgTextArgument::ConstructFormatArgumentValue(const UDlgCo
 	}
 }
 
+FText FDlgTextArgument::FormatText(const FTextFormat& TextFormat, const TArray<FDlgTextArgument>& Arguments, const UDlgContext& Context, FName NodeOwner)
+{
+	FFormatNamedArguments OrderedArguments;
+	OrderedArguments.Reserve(Arguments.Num());
+	for (const FDlgTextArgument& DlgArgument : Arguments)
+	{
+		OrderedArguments.Add(DlgArgument.DisplayString, DlgArgument.ConstructFormatArgumentValue(Context, NodeOwner));
+	}
+
+	return FText::AsCultureInvariant(FText::Format(TextFormat, MoveTemp(OrderedArguments)));
+}
+
+const FTextFormat& FDlgTextArgument::CompileTextFormat(const FText& Text, FTextFormat& InOutTextFormat)
+{
+	// The pattern is only parsed again if the Text changed, FTextFormat handles the culture changes itself
+	if (!InOutTextFormat.GetSourceText().IdenticalTo(Text))
+	{
+		InOutTextFormat = FTextFormat(Text);
+	}
+
+	return InOutTextFormat;
+}
+
+FTextFormat FDlgTextArgument::GetTextFormat(const FText& Text, const FTextFormat& CompiledTextFormat)
+{
+	if (CompiledTextFormat.GetSourceText().IdenticalTo(Text))
+	{
+		return CompiledTextFormat;
+	}
+
+	return FTextFormat(Text);
+}
+
+bool FDlgTextArgument::GetReadVariable(FName NodeOwner, FName& OutParticipantName, FName& OutVariableName) const
+{
+	switch (Type)
+	{
+		case EDlgTextArgumentType::DialogueInt:
+		case EDlgTextArgumentType::DialogueFloat:
+		case EDlgTextArgumentType::ClassInt:
+		case EDlgTextArgumentType::ClassFloat:
+		case EDlgTextArgumentType::ClassText:
+			OutParticipantName = ParticipantName == NAME_None ? NodeOwner : ParticipantName;
+			OutVariableName = VariableName;
+			return true;
+
+		default:
+			return false;
+	}
+}
+
 void FDlgTextArgument::UpdateTextArgumentArray(const FText& Text, TArray<FDlgTextArgument>& InOutArgumentArray)
 {
 	TArray<FString> NewArgumentParams;
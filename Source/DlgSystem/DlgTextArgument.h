@@ -75,6 +75,20 @@ public:
 	// Construct the argument for usage in FText::Format
 	FFormatArgumentValue ConstructFormatArgumentValue(const UDlgContext& Context, FName NodeOwner) const;
 
+	// Formats the compiled TextFormat with the values of the Arguments for the Context
+	static FText FormatText(const FTextFormat& TextFormat, const TArray<FDlgTextArgument>& Arguments, const UDlgContext& Context, FName NodeOwner);
+
+	// Compiles Text into InOutTextFormat, only if InOutTextFormat was not compiled from this Text already
+	// Called when the text changes (load, edit, UDlgDialogue::UpdateAndRefreshData), the formatting only reads it, see GetTextFormat
+	static const FTextFormat& CompileTextFormat(const FText& Text, FTextFormat& InOutTextFormat);
+
+	// Gets CompiledTextFormat if it was compiled from Text, otherwise Text is compiled into a temporary (the text changed without CompileTextFormat)
+	static FTextFormat GetTextFormat(const FText& Text, const FTextFormat& CompiledTextFormat);
+
+	// Gets the participant variable this argument reads, used to know when a text formatted with it is out of date
+	// @return false if the value is not read from a variable (display name, gender, custom)
+	bool GetReadVariable(FName NodeOwner, FName& OutParticipantName, FName& OutVariableName) const;
+
 	// Helper method to update the array InOutArgumentArray with the new arguments from Text.
 	static void UpdateTextArgumentArray(const FText& Text, TArray<FDlgTextArgument>& InOutArgumentArray);
 
@@ -0,0 +1,125 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/**
+ * Set of Node indices touched by a single recursive walk through a Dialogue
+ * (UDlgContext::EnterNode, UDlgContext::IsNodeEnterable, FDlgEdge::Evaluate, UDlgNode::ReevaluateChildren, etc).
+ *
+ * It is a bitset with an inline buffer, for dialogues with less than InlineNodesNum nodes it never allocates.
+ * It is always passed by reference, if a node must only be marked for the duration of a call
+ * (so that sibling edges do not see each other) use FDlgTraversalState::FScopedVisit.
+ */
+struct DLGSYSTEM_API FDlgTraversalState
+{
+public:
+	// Number of node indices that fit into the inline buffer
+	static constexpr int32 InlineNodesNum = 512;
+
+	FDlgTraversalState() {}
+
+	// Helper constructor, starts with NodeIndex already visited
+	explicit FDlgTraversalState(int32 NodeIndex) { Add(NodeIndex); }
+
+	// Is the NodeIndex marked as visited?
+	bool Contains(int32 NodeIndex) const
+	{
+		if (NodeIndex < 0)
+		{
+			return false;
+		}
+
+		const int32 WordIndex = NodeIndex / BitsPerWord;
+		return Words.IsValidIndex(WordIndex) && (Words[WordIndex] & GetBitMask(NodeIndex)) != 0;
+	}
+
+	// Marks the NodeIndex as visited
+	// @return true if the node was not already visited
+	bool Add(int32 NodeIndex)
+	{
+		if (NodeIndex < 0)
+		{
+			return false;
+		}
+
+		const int32 WordIndex = NodeIndex / BitsPerWord;
+		if (WordIndex >= Words.Num())
+		{
+			Words.AddZeroed(WordIndex + 1 - Words.Num());
+		}
+
+		const uint32 BitMask = GetBitMask(NodeIndex);
+		if ((Words[WordIndex] & BitMask) != 0)
+		{
+			return false;
+		}
+
+		Words[WordIndex] |= BitMask;
+		return true;
+	}
+
+	// Removes the visited mark from NodeIndex
+	void Remove(int32 NodeIndex)
+	{
+		if (NodeIndex < 0)
+		{
+			return;
+		}
+
+		const int32 WordIndex = NodeIndex / BitsPerWord;
+		if (Words.IsValidIndex(WordIndex))
+		{
+			Words[WordIndex] &= ~GetBitMask(NodeIndex);
+		}
+	}
+
+	// Clears all the marks, keeps the memory
+	void Reset() { Words.Reset(); }
+
+	bool IsEmpty() const
+	{
+		for (const uint32 Word : Words)
+		{
+			if (Word != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Marks a node as visited for the lifetime of this object.
+	// If the node was already marked before it stays marked after this goes out of scope.
+	struct FScopedVisit
+	{
+	public:
+		FScopedVisit(FDlgTraversalState& InState, int32 InNodeIndex)
+			: State(InState), NodeIndex(InNodeIndex), bAdded(InState.Add(InNodeIndex)) {}
+
+		~FScopedVisit()
+		{
+			if (bAdded)
+			{
+				State.Remove(NodeIndex);
+			}
+		}
+
+	private:
+		FScopedVisit(const FScopedVisit&) = delete;
+		FScopedVisit& operator=(const FScopedVisit&) = delete;
+
+		FDlgTraversalState& State;
+		int32 NodeIndex;
+		bool bAdded;
+	};
+
+private:
+	static constexpr int32 BitsPerWord = 32;
+
+	static uint32 GetBitMask(int32 NodeIndex) { return 1u << (NodeIndex % BitsPerWord); }
+
+private:
+	TArray<uint32, TInlineAllocator<InlineNodesNum / BitsPerWord>> Words;
+};
@@ -8,6 +8,7 @@
 #include "Widgets/Input/SCheckBox.h"
 #include "Widgets/Input/SEditableTextBox.h"
 
+#include "DlgSystem/DlgNativeDialogueParticipant.h"
 #include "DlgSystem/NYReflectionHelper.h"
 #include "UObject/TextProperty.h"
 
@@ -88,25 +89,25 @@ void SDlgDataPropertyValue::UpdateVariableNodeFromActor()
 	{
 		case EDlgDataDisplayVariableTreeNodeType::Integer:
 		{
-			const int32 Value = IDlgDialogueParticipant::Execute_GetIntValue(Actor.Get(), VariableName);
+			const int32 Value = FDlgParticipantCalls::GetIntValue(Actor.Get(), VariableName);
 			VariableNode->SetVariableValue(FString::FromInt(Value));
 			break;
 		}
 		case EDlgDataDisplayVariableTreeNodeType::Float:
 		{
-			const float Value = IDlgDialogueParticipant::Execute_GetFloatValue(Actor.Get(), VariableName);
+			const float Value = FDlgParticipantCalls::GetFloatValue(Actor.Get(), VariableName);
 			VariableNode->SetVariableValue(FString::SanitizeFloat(Value));
 			break;
 		}
 		case EDlgDataDisplayVariableTreeNodeType::Bool:
 		{
-			const bool Value = IDlgDialogueParticipant::Execute_GetBoolValue(Actor.Get(), VariableName);
+			const bool Value = FDlgParticipantCalls::GetBoolValue(Actor.Get(), VariableName);
 			VariableNode->SetVariableValue(BoolToFString(Value));
 			break;
 		}
 		case EDlgDataDisplayVariableTreeNodeType::FName:
 		{
-			const FName Value = IDlgDialogueParticipant::Execute_GetNameValue(Actor.Get(), VariableName);
+			const FName Value = FDlgParticipantCalls::GetNameValue(Actor.Get(), VariableName);
 			VariableNode->SetVariableValue(Value.ToString());
 			break;
 		}
@@ -150,7 +151,7 @@ void SDlgDataPropertyValue::UpdateVariableNodeFromActor()
 		}
 		case EDlgDataDisplayVariableTreeNodeType::Condition:
 		{
-			const bool Value = IDlgDialogueParticipant::Execute_CheckCondition(Actor.Get(), nullptr, VariableName);
+			const bool Value = FDlgParticipantCalls::CheckCondition(Actor.Get(), nullptr, VariableName);
 			VariableNode->SetVariableValue(BoolToFString(Value));
 			break;
 		}
@@ -216,25 +217,25 @@ void SDlgDataTextPropertyValue::HandleTextCommitted(const FText& NewText, ETextC
 		case EDlgDataDisplayVariableTreeNodeType::Integer:
 		{
 			const int32 Value = NewString.IsNumeric() ? FCString::Atoi(*NewString) : 0;
-			IDlgDialogueParticipant::Execute_ModifyIntValue(Actor.Get(), VariableName, false, Value);
+			FDlgParticipantCalls::ModifyIntValue(Actor.Get(), VariableName, false, Value);
 			break;
 		}
 		case EDlgDataDisplayVariableTreeNodeType::Float:
 		{
 			const float Value = NewString.IsNumeric() ? FCString::Atof(*NewString) : 0.f;
-			IDlgDialogueParticipant::Execute_ModifyFloatValue(Actor.Get(), VariableName, false, Value);
+			FDlgParticipantCalls::ModifyFloatValue(Actor.Get(), VariableName, false, Value);
 			break;
 		}
 		case EDlgDataDisplayVariableTreeNodeType::Bool:
 		{
 			const bool Value = FStringToBool(NewString);
-			IDlgDialogueParticipant::Execute_ModifyBoolValue(Actor.Get(), VariableName, Value);
+			FDlgParticipantCalls::ModifyBoolValue(Actor.Get(), VariableName, Value);
 			break;
 		}
 		case EDlgDataDisplayVariableTreeNodeType::FName:
 		{
 			const FName Value(*NewString);
-			IDlgDialogueParticipant::Execute_ModifyNameValue(Actor.Get(), VariableName, Value);
+			FDlgParticipantCalls::ModifyNameValue(Actor.Get(), VariableName, Value);
 			break;
 		}
 
@@ -352,7 +353,7 @@ FReply SDlgDataEventPropertyValue::HandleTriggerEventClicked()
 	const FName EventName = VariableNode->GetVariableName();
 	if (bEvent)
 	{
-		IDlgDialogueParticipant::Execute_OnDialogueEvent(Actor.Get(), nullptr, EventName);
+		FDlgParticipantCalls::OnDialogueEvent(Actor.Get(), nullptr, EventName);
 	}
 	else
 	{
@@ -442,7 +443,7 @@ void SDlgDataBoolPropertyValue::HandleCheckStateChanged(ECheckBoxState InNewStat
 	}
 	else
 	{
-		IDlgDialogueParticipant::Execute_ModifyBoolValue(Actor.Get(), VariableName, Value);
+		FDlgParticipantCalls::ModifyBoolValue(Actor.Get(), VariableName, Value);
 	}
 	UpdateVariableNodeFromActor();
 }
@@ -7,11 +7,50 @@
 #include "UObject/UnrealType.h"
 #include "UObject/EnumProperty.h"
 #include "UObject/TextProperty.h"
+#include "Misc/StringBuilder.h"
 
 #include "DlgSystem/NYReflectionHelper.h"
 
 DEFINE_LOG_CATEGORY(LogDlgConfigParser);
 
+namespace DlgConfigParser
+{
+	// Same as FString::IsNumeric
+	static bool IsNumeric(FStringView Word)
+	{
+		if (Word.IsEmpty())
+		{
+			return false;
+		}
+		if (Word[0] == '-' || Word[0] == '+')
+		{
+			Word.RightChopInline(1);
+		}
+
+		bool bHasDot = false;
+		for (const TCHAR Char : Word)
+		{
+			if (Char == '.')
+			{
+				if (bHasDot)
+				{
+					return false;
+				}
+				bHasDot = true;
+			}
+			else if (!FChar::IsDigit(Char))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Null terminated copy of a number for the FCString conversions, on the stack
+	using FNumberBuilder = TStringBuilder<64>;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 FDlgConfigParser::FDlgConfigParser(const FString InPreTag) :
 	PreTag(InPreTag)
@@ -33,6 +72,7 @@ void FDlgConfigParser::InitializeParser(const FString& FilePath)
 	From = 0;
 	Len = 0;
 	bHasValidWord = false;
+	PropertyTables.Empty();
 
 	if (!FFileHelper::LoadFileToString(String, *FilePath))
 	{
@@ -55,6 +95,7 @@ void FDlgConfigParser::InitializeParserFromString(const FString& Text)
 	From = 0;
 	Len = 0;
 	bHasValidWord = false;
+	PropertyTables.Empty();
 	FindNextWord();
 }
 
@@ -82,8 +123,8 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 	}
 	check(From < String.Len());
 
-	const FString PropertyName = GetActiveWord();
-	auto* PropertyBase = ReferenceClass->FindPropertyByName(*PropertyName);
+	const FStringView PropertyName = GetActiveWordView();
+	auto* PropertyBase = FindPropertyByName(ReferenceClass, PropertyName);
 	if (PropertyBase != nullptr)
 	{
 		// check primitive types and enums
@@ -107,7 +148,7 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 		}
 	}
 
-	auto* ComplexPropBase = ReferenceClass->FindPropertyByName(*PropertyName);
+	auto* ComplexPropBase = PropertyBase;
 
 	// struct
 	if (auto* StructProperty = FNYReflectionHelper::SmartCastProperty<FStructProperty>(ComplexPropBase))
@@ -120,14 +161,15 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 	}
 
 	// check complex object - type name has to be here as well (dynamic array)
-	const FString TypeName = PreTag + PropertyName;
-	if (!FindNextWord("block name"))
+	FString TypeName = PreTag;
+	TypeName.Append(PropertyName.GetData(), PropertyName.Len());
+	if (!FindNextWord(TEXT("block name")))
 	{
 		return false;
 	}
 
 	const bool bLoadByRef = IsNextWordString();
-	const FString VariableName = GetActiveWord();
+	const FStringView VariableName = GetActiveWordView();
 
 	// check if it is stored as reference
 	if (bLoadByRef)
@@ -140,9 +182,10 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 
 		auto* ObjectPtrPtr = static_cast<UObject**>(ComplexPropBase->template ContainerPtrToValuePtr<void>(TargetObject));
 		*ObjectPtrPtr = nullptr; // reset first
-		if (!VariableName.TrimStartAndEnd().IsEmpty()) // null reference?
+		const FString Path(VariableName);
+		if (!Path.TrimStartAndEnd().IsEmpty()) // null reference?
 		{
-			*ObjectPtrPtr = StaticLoadObject(UObject::StaticClass(), DefaultObjectOuter, *VariableName);
+			*ObjectPtrPtr = StaticLoadObject(UObject::StaticClass(), DefaultObjectOuter, *Path);
 		}
 		FindNextWord();
 		return true;
@@ -153,11 +196,11 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 	// - nullptr - PropertyName ""
 	if (bHasNullptr)
 	{
-		ComplexPropBase = ReferenceClass->FindPropertyByName(*PropertyName);
+		ComplexPropBase = FindPropertyByName(ReferenceClass, PropertyName);
 	}
 	else
 	{
-		ComplexPropBase = ReferenceClass->FindPropertyByName(*VariableName);
+		ComplexPropBase = FindPropertyByName(ReferenceClass, VariableName);
 	}
 	if (auto* ObjectProperty = FNYReflectionHelper::SmartCastProperty<FObjectProperty>(ComplexPropBase))
 	{
@@ -166,12 +209,15 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 		{
 			return false;
 		}
-		auto ObjectInitializer = std::bind(&FDlgConfigParser::OnInitObject, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+		auto ObjectInitializer = [this](void* ValuePtr, const UClass* ChildClass, UObject* OuterInit)
+		{
+			return OnInitObject(ValuePtr, ChildClass, OuterInit);
+		};
 		return ReadComplexProperty<FObjectProperty>(TargetObject, ComplexPropBase, Class, ObjectInitializer, DefaultObjectOuter);
 	}
 
 	UE_LOG(LogDlgConfigParser, Warning, TEXT("Invalid token `%s` in script `%s` (line: %d) (Property expected for PropertyName = `%s`)"),
-		   *GetActiveWord(), *FileName, GetActiveLineNumber(), *PropertyName);
+		   *GetActiveWord(), *FileName, GetActiveLineNumber(), *FString(PropertyName));
 	FindNextWord();
 	return false;
 }
@@ -179,14 +225,15 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool FDlgConfigParser::ReadPurePropertyBlock(void* TargetObject, const UStruct* ReferenceClass, bool bBlockStartAlreadyRead, UObject* Outer)
 {
-	if (!bBlockStartAlreadyRead && !FindNextWordAndCheckIfBlockStart(ReferenceClass->GetName()))
+	const FString BlockName = ReferenceClass->GetName();
+	if (!bBlockStartAlreadyRead && !FindNextWordAndCheckIfBlockStart(BlockName))
 	{
 		return false;
 	}
 
 	// parse precondition properties
 	FindNextWord();
-	while (!CheckIfBlockEnd(ReferenceClass->GetName()))
+	while (!CheckIfBlockEnd(BlockName))
 	{
 		if (!bHasValidWord)
 		{
@@ -208,16 +255,45 @@ bool FDlgConfigParser::GetActiveWordAsFloat(float& FloatValue) const
 		return false;
 	}
 
-	const FString FloatString = String.Mid(From, Len);
-	if (FloatString.Len() == 0 || !FloatString.IsNumeric())
+	const FStringView FloatString = GetActiveWordView();
+	if (!DlgConfigParser::IsNumeric(FloatString))
 	{
 		return false;
 	}
 
-	FloatValue = FCString::Atof(*FloatString);
+	DlgConfigParser::FNumberBuilder Builder;
+	Builder.Append(FloatString);
+	FloatValue = FCString::Atof(Builder.ToString());
 	return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+FProperty* FDlgConfigParser::FindPropertyByName(const UStruct* ReferenceClass, FStringView Name)
+{
+	// If the name was never used there is no property with it
+	const FName PropertyName(Name.Len(), Name.GetData(), FNAME_Find);
+	if (PropertyName.IsNone())
+	{
+		return nullptr;
+	}
+
+	TMap<FName, FProperty*>* PropertyTablePtr = PropertyTables.Find(ReferenceClass);
+	if (PropertyTablePtr == nullptr)
+	{
+		// Same order as FindPropertyByName, the first property with the name wins
+		PropertyTablePtr = &PropertyTables.Add(ReferenceClass);
+		for (TFieldIterator<FProperty> PropIt(ReferenceClass); PropIt; ++PropIt)
+		{
+			if (!PropertyTablePtr->Contains(PropIt->GetFName()))
+			{
+				PropertyTablePtr->Add(PropIt->GetFName(), *PropIt);
+			}
+		}
+	}
+
+	return PropertyTablePtr->FindRef(PropertyName);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 FString FDlgConfigParser::ConstructConfigFile(const UStruct* ReferenceType, void* SourceObject)
 {
@@ -348,12 +424,12 @@ bool FDlgConfigParser::FindNextWord()
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-bool FDlgConfigParser::FindNextWord(const FString& ExpectedStuff)
+bool FDlgConfigParser::FindNextWord(const TCHAR* ExpectedStuff)
 {
 	const bool bNotEof = FindNextWord();
 	if (!bNotEof)
 	{
-		UE_LOG(LogDlgConfigParser, Warning, TEXT("Unexpected end of file while reading %s (expected: %s)"), *FileName, *ExpectedStuff);
+		UE_LOG(LogDlgConfigParser, Warning, TEXT("Unexpected end of file while reading %s (expected: %s)"), *FileName, ExpectedStuff);
 	}
 
 	return bNotEof;
@@ -362,7 +438,7 @@ bool FDlgConfigParser::FindNextWord(const FString& ExpectedStuff)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool FDlgConfigParser::FindNextWordAndCheckIfBlockStart(const FString& BlockName)
 {
-	if (!FindNextWord() || !CompareToActiveWord("{"))
+	if (!FindNextWord() || !CompareToActiveWord(TEXT("{")))
 	{
 		UE_LOG(LogDlgConfigParser, Warning, TEXT("Block start signal expected but not found for %s block in script %s (line: %d)"),
 											*BlockName, *FileName, GetActiveLineNumber());
@@ -396,25 +472,9 @@ bool FDlgConfigParser::CheckIfBlockEnd(const FString& BlockName)
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-bool FDlgConfigParser::CompareToActiveWord(const FString& StringToCompare) const
+bool FDlgConfigParser::CompareToActiveWord(FStringView StringToCompare) const
 {
-	// Length differs?
-	if (!bHasValidWord || StringToCompare.Len() != Len)
-	{
-		return false;
-	}
-
-	// Content differs?
-	const TCHAR* SubStr = &String[From];
-	for (int32 i = 0; i < Len; ++i)
-	{
-		if (SubStr[i] != StringToCompare[i])
-		{
-			return false;
-		}
-	}
-
-	return true;
+	return bHasValidWord && GetActiveWordView().Equals(StringToCompare, ESearchCase::CaseSensitive);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -462,36 +522,34 @@ void FDlgConfigParser::ConstructConfigFileInternal(const UStruct* ReferenceType,
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool FDlgConfigParser::TryToReadPrimitiveProperty(void* TargetObject, FProperty* PropertyBase)
 {
-	if (ReadPrimitiveProperty<bool, FBoolProperty>(TargetObject, PropertyBase, std::bind(&FDlgConfigParser::GetAsBool, this), "Bool", false))
-	{
-		return true;
-	}
-	if (ReadPrimitiveProperty<float, FFloatProperty>(TargetObject, PropertyBase, std::bind(&FDlgConfigParser::GetAsFloat, this), "float", false))
-	{
-		return true;
-	}
-	if (ReadPrimitiveProperty<int32, FIntProperty>(TargetObject, PropertyBase, std::bind(&FDlgConfigParser::GetAsInt32, this), "int32", false))
-	{
-		return true;
-	}
-	if (ReadPrimitiveProperty<int64, FInt64Property>(TargetObject, PropertyBase, std::bind(&FDlgConfigParser::GetAsInt64, this), "int64", false))
-	{
-		return true;
-	}
-	if (ReadPrimitiveProperty<FName, FNameProperty>(TargetObject, PropertyBase, std::bind(&FDlgConfigParser::GetAsName, this), "FName", false))
+	// Arrays are read by the reader of their elements
+	const FProperty* ValueProperty = PropertyBase;
+	if (const auto* ArrayProperty = FNYReflectionHelper::CastProperty<FArrayProperty>(PropertyBase))
 	{
-		return true;
+		ValueProperty = ArrayProperty->Inner;
 	}
-	if (ReadPrimitiveProperty<FString, FStrProperty>(TargetObject, PropertyBase, std::bind(&FDlgConfigParser::GetAsString, this), "FString", true))
+	if (ValueProperty == nullptr)
 	{
-		return true;
-	}
-	if (ReadPrimitiveProperty<FText, FTextProperty>(TargetObject, PropertyBase, std::bind(&FDlgConfigParser::GetAsText, this), "FText", true))
-	{
-		return true;
+		return false;
 	}
 
-	return false;
+	const FPrimitiveReader* Reader = GetPrimitiveReaders().Find(ValueProperty->GetClass()->GetFName());
+	return Reader != nullptr && (this->*Reader->Read)(TargetObject, PropertyBase, Reader->TypeName);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const TMap<FName, FDlgConfigParser::FPrimitiveReader>& FDlgConfigParser::GetPrimitiveReaders()
+{
+	static const TMap<FName, FPrimitiveReader> Readers = {
+		{ FBoolProperty::StaticClass()->GetFName(), { &FDlgConfigParser::ReadPrimitiveProperty<bool, FBoolProperty, &FDlgConfigParser::GetAsBool, false>, TEXT("Bool") } },
+		{ FFloatProperty::StaticClass()->GetFName(), { &FDlgConfigParser::ReadPrimitiveProperty<float, FFloatProperty, &FDlgConfigParser::GetAsFloat, false>, TEXT("float") } },
+		{ FIntProperty::StaticClass()->GetFName(), { &FDlgConfigParser::ReadPrimitiveProperty<int32, FIntProperty, &FDlgConfigParser::GetAsInt32, false>, TEXT("int32") } },
+		{ FInt64Property::StaticClass()->GetFName(), { &FDlgConfigParser::ReadPrimitiveProperty<int64, FInt64Property, &FDlgConfigParser::GetAsInt64, false>, TEXT("int64") } },
+		{ FNameProperty::StaticClass()->GetFName(), { &FDlgConfigParser::ReadPrimitiveProperty<FName, FNameProperty, &FDlgConfigParser::GetAsName, false>, TEXT("FName") } },
+		{ FStrProperty::StaticClass()->GetFName(), { &FDlgConfigParser::ReadPrimitiveProperty<FString, FStrProperty, &FDlgConfigParser::GetAsString, true>, TEXT("FString") } },
+		{ FTextProperty::StaticClass()->GetFName(), { &FDlgConfigParser::ReadPrimitiveProperty<FText, FTextProperty, &FDlgConfigParser::GetAsText, true>, TEXT("FText") } }
+	};
+	return Readers;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -506,7 +564,7 @@ bool FDlgConfigParser::TryToReadEnum(void* Target, FProperty* PropertyBase)
 		}
 		else
 		{
-			Value = FName(*String.Mid(From, Len));
+			Value = FName(GetActiveWordView());
 		}
 
 		auto* Prop = FNYReflectionHelper::SmartCastProperty<FEnumProperty>(PropertyBase);
@@ -548,12 +606,13 @@ bool FDlgConfigParser::ReadSet(void* TargetObject, FSetProperty& Property, UObje
 	FScriptSetHelper Helper(&Property, Property.ContainerPtrToValuePtr<uint8>(TargetObject));
 	Helper.EmptyElements();
 
-	if (!FindNextWordAndCheckIfBlockStart("Set block"))
+	const FString BlockName = TEXT("Set block");
+	if (!FindNextWordAndCheckIfBlockStart(BlockName))
 	{
 		return false;
 	}
 
-	while (!FindNextWordAndCheckIfBlockEnd("Set block"))
+	while (!FindNextWordAndCheckIfBlockEnd(BlockName))
 	{
 		const int32 Index = Helper.AddDefaultValue_Invalid_NeedsRehash();
 		bool bDone = false;
@@ -585,12 +644,13 @@ bool FDlgConfigParser::ReadMap(void* TargetObject, FMapProperty& Property, UObje
 	FScriptMapHelper Helper(&Property, Property.ContainerPtrToValuePtr<uint8>(TargetObject));
 	Helper.EmptyValues();
 
-	if (!FindNextWordAndCheckIfBlockStart("Map block") || !FindNextWord("map entry"))
+	const FString BlockName = TEXT("Map block");
+	if (!FindNextWordAndCheckIfBlockStart(BlockName) || !FindNextWord(TEXT("map entry")))
 	{
 		return false;
 	}
 
-	while (!CheckIfBlockEnd("Map block"))
+	while (!CheckIfBlockEnd(BlockName))
 	{
 		const int32 Index = Helper.AddDefaultValue_Invalid_NeedsRehash();
 		void* Ptrs[] = { Helper.GetKeyPtr(Index), Helper.GetValuePtr(Index) };
@@ -612,7 +672,7 @@ bool FDlgConfigParser::ReadMap(void* TargetObject, FMapProperty& Property, UObje
 			auto* StructVal = FNYReflectionHelper::CastProperty<FStructProperty>(Props[i]);
 			if (StructVal != nullptr)
 			{
-				if (!CompareToActiveWord("{"))
+				if (!CompareToActiveWord(TEXT("{")))
 				{
 					UE_LOG(LogDlgConfigParser, Warning, TEXT("Syntax error: missing struct block start '{' in script %s(:%d)"),
 							*FileName, GetActiveLineNumber());
@@ -631,7 +691,7 @@ bool FDlgConfigParser::ReadMap(void* TargetObject, FMapProperty& Property, UObje
 					return false;
 				}
 				bDone = false;
-				if (!FindNextWord("Map Key or Value or End"))
+				if (!FindNextWord(TEXT("Map Key or Value or End")))
 				{
 					return false;
 				}
@@ -699,9 +759,9 @@ void FDlgConfigParser::OnInvalidValue(const FString& PropType) const
 bool FDlgConfigParser::GetAsBool() const
 {
 	bool bValue = false;
-	if (CompareToActiveWord("True"))
+	if (CompareToActiveWord(TEXT("True")))
 		bValue = true;
-	else if (!CompareToActiveWord("False"))
+	else if (!CompareToActiveWord(TEXT("False")))
 		OnInvalidValue("Bool");
 	return bValue;
 }
@@ -718,11 +778,17 @@ float FDlgConfigParser::GetAsFloat() const
 int32 FDlgConfigParser::GetAsInt32() const
 {
 	int32 Value = 0;
-	const FString IntString = String.Mid(From, Len);
-	if (IntString.Len() == 0 || (!IntString.IsNumeric()))
+	const FStringView IntString = GetActiveWordView();
+	if (!DlgConfigParser::IsNumeric(IntString))
+	{
 		OnInvalidValue("int32");
+	}
 	else
-		Value = FCString::Atoi(*IntString);
+	{
+		DlgConfigParser::FNumberBuilder Builder;
+		Builder.Append(IntString);
+		Value = FCString::Atoi(Builder.ToString());
+	}
 	return Value;
 }
 
@@ -730,11 +796,17 @@ int32 FDlgConfigParser::GetAsInt32() const
 int64 FDlgConfigParser::GetAsInt64() const
 {
 	int64 Value = 0;
-	const FString IntString = String.Mid(From, Len);
-	if (IntString.Len() == 0 || (!IntString.IsNumeric()))
+	const FStringView IntString = GetActiveWordView();
+	if (!DlgConfigParser::IsNumeric(IntString))
+	{
 		OnInvalidValue("int64");
+	}
 	else
-		Value = FCString::Atoi64(*IntString);
+	{
+		DlgConfigParser::FNumberBuilder Builder;
+		Builder.Append(IntString);
+		Value = FCString::Atoi64(Builder.ToString());
+	}
 	return Value;
 }
 
@@ -745,7 +817,7 @@ FName FDlgConfigParser::GetAsName() const
 	if (Len <= 0)
 		OnInvalidValue("FName");
 	else
-		Value = FName(*String.Mid(From, Len));
+		Value = FName(GetActiveWordView());
 	return Value;
 }
 
@@ -753,7 +825,7 @@ FName FDlgConfigParser::GetAsName() const
 FString FDlgConfigParser::GetAsString() const
 {
 	if (Len > 0)
-		return String.Mid(From, Len);
+		return FString(GetActiveWordView());
 
 	return "";
 }
@@ -763,7 +835,7 @@ FText FDlgConfigParser::GetAsText() const
 {
 	FString Input;
 	if (Len > 0)
-		Input = String.Mid(From, Len);
+		Input = FString(GetActiveWordView());
 
-	return FText::FromString(Input);
+	return FText::FromString(MoveTemp(Input));
 }
@@ -1,8 +1,8 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #pragma once
 
-#include <functional>
 #include "CoreTypes.h"
+#include "Containers/StringView.h"
 #include "Logging/LogMacros.h"
 
 #include "IDlgParser.h"
@@ -118,7 +118,7 @@ private:
 	 *
 	 * @return Whether a new word was found (false -> end of file)
 	 */
-	bool FindNextWord(const FString& ExpectedStuff);
+	bool FindNextWord(const TCHAR* ExpectedStuff);
 
 	/**
 	 * Jumps to the next word in the parsed config, and checks if it is a block start character ("{")
@@ -147,7 +147,7 @@ private:
 	 *
 	 * @return Whether the word and the strings are equal
 	 */
-	bool CompareToActiveWord(const FString& StringToCompare) const;
+	bool CompareToActiveWord(FStringView StringToCompare) const;
 
 	/**
 	 * Calculates the line count for the current word
@@ -160,10 +160,22 @@ private:
 	bool HasValidWord() const { return bHasValidWord; }
 
 	/**
-	 * Should be avoided whenever possible (use CompareToActiveWord)
+	 * Should be avoided whenever possible (use CompareToActiveWord or GetActiveWordView)
 	 * @return the active word, or an empty string if there isn't any
 	 */
-	FString GetActiveWord() const { return bHasValidWord ? String.Mid(From, Len) : ""; }
+	FString GetActiveWord() const { return FString(GetActiveWordView()); }
+
+	/**
+	 * Same as GetActiveWord without copying the word
+	 * @return the active word inside the parsed config (valid until the parser is initialized again), or an empty view if there isn't any
+	 */
+	FStringView GetActiveWordView() const { return bHasValidWord ? FStringView(String).Mid(From, Len) : FStringView(); }
+
+	/**
+	 * Same as ReferenceClass->FindPropertyByName, the properties of each struct are looked up by their FName in a table built on first use
+	 * @return the property, or nullptr if there is none with the Name
+	 */
+	FProperty* FindPropertyByName(const UStruct* ReferenceClass, FStringView Name);
 
 	/**
 	 * @param FloatValue: out float value if the call succeeds
@@ -184,6 +196,16 @@ private:
 	/** Tries to read the actual config value as a primitive property (all supported primitive is checked) */
 	bool TryToReadPrimitiveProperty(void* Target, FProperty* PropertyBase);
 
+	// A ReadPrimitiveProperty instance and the name of its type for logs
+	struct FPrimitiveReader
+	{
+		bool (FDlgConfigParser::*Read)(void* Target, FProperty* PropertyBase, const TCHAR* TypeName);
+		const TCHAR* TypeName;
+	};
+
+	/** The readers of the supported primitives keyed by the name of their property class (e.g. BoolProperty) */
+	static const TMap<FName, FPrimitiveReader>& GetPrimitiveReaders();
+
 	bool TryToReadEnum(void* TargetObject, FProperty* PropertyBase);
 
 	/** Return value shows if it was read properly or not */
@@ -197,17 +219,13 @@ private:
 	 *
 	 * @param Target The struct/object whose properties are searched and modified based on the config string
 	 * @param PropertyBase The property - can be a TypeProperty or an ArrayProperty storing Type-s
-	 * @param OnGetAsValue Function returning the actual word converted to Type
 	 * @param TypeName The name of the type for logs (e.g. "bool")
+	 * @tparam GetAsValue Function returning the actual word converted to Type
 	 *
 	 * @return true if the property was a PropertyType or an array containging Type
 	 */
-	template <typename Type, typename PropertyType>
-	bool ReadPrimitiveProperty(void* Target,
-							   FProperty* PropertyBase,
-							   std::function<Type()> OnGetAsValue,
-							   const FString& TypeName,
-							   bool bCanBeEmpty);
+	template <typename Type, typename PropertyType, Type (FDlgConfigParser::*GetAsValue)() const, bool bCanBeEmpty>
+	bool ReadPrimitiveProperty(void* Target, FProperty* PropertyBase, const TCHAR* TypeName);
 
 
 	/**
@@ -221,11 +239,11 @@ private:
 	 *
 	 * @return true if the complex type was read properly
 	 */
-	template <typename PropertyType>
+	template <typename PropertyType, typename InitValueFunctionType>
 	bool ReadComplexProperty(void* Target,
 							 FProperty* Property,
 							 const UStruct* ReferenceType,
-							 std::function<void*(void*, const UClass*, UObject*)> OnInitValue,
+							 const InitValueFunctionType& OnInitValue,
 							 UObject* Outer);
 
 
@@ -258,6 +276,9 @@ private:
 	/** optional pretag before struct and class names */
 	const FString PreTag;
 
+	/** properties of the read structs by their name, see FindPropertyByName */
+	TMap<const UStruct*, TMap<FName, FProperty*>> PropertyTables;
+
 	bool bHasValidWord = false;
 
 	// Nullptr value?
@@ -268,12 +289,8 @@ private:
 };
 
 
-template <typename Type, typename PropertyType>
-bool FDlgConfigParser::ReadPrimitiveProperty(void* Target,
-											 FProperty* PropertyBase,
-											 std::function<Type()> OnGetAsValue,
-											 const FString& TypeName,
-											 bool bCanBeEmpty)
+template <typename Type, typename PropertyType, Type (FDlgConfigParser::*GetAsValue)() const, bool bCanBeEmpty>
+bool FDlgConfigParser::ReadPrimitiveProperty(void* Target, FProperty* PropertyBase, const TCHAR* TypeName)
 {
 	// try to find a member variable with the name
 	PropertyType* Property = FNYReflectionHelper::CastProperty<PropertyType>(PropertyBase);
@@ -291,10 +308,11 @@ bool FDlgConfigParser::ReadPrimitiveProperty(void* Target,
 
 		TArray<Type>* Array = ArrayProp->ContainerPtrToValuePtr<TArray<Type>>(Target);
 		Array->Empty();
-		if (FindNextWordAndCheckIfBlockStart(TypeName + "Array"))
+		const FString BlockName = FString(TypeName) + TEXT("Array");
+		if (FindNextWordAndCheckIfBlockStart(BlockName))
 		{
 			// read values until the block ends
-			while (!FindNextWordAndCheckIfBlockEnd(TypeName + "Array"))
+			while (!FindNextWordAndCheckIfBlockEnd(BlockName))
 			{
 				if (!bHasValidWord && !bCanBeEmpty)
 				{
@@ -302,7 +320,7 @@ bool FDlgConfigParser::ReadPrimitiveProperty(void* Target,
 				}
 				else
 				{
-					Array->Add(OnGetAsValue());
+					Array->Add((this->*GetAsValue)());
 				}
 			}
 		}
@@ -313,11 +331,11 @@ bool FDlgConfigParser::ReadPrimitiveProperty(void* Target,
 		FindNextWord();
 		if (bHasValidWord || bCanBeEmpty)
 		{
-			Property->SetPropertyValue_InContainer(Target, OnGetAsValue());
+			Property->SetPropertyValue_InContainer(Target, (this->*GetAsValue)());
 		}
 		else
 		{
-			UE_LOG(LogDlgConfigParser, Warning, TEXT("Unexpected end of file while %s value was expected (config %s)"), *TypeName, *FileName)
+			UE_LOG(LogDlgConfigParser, Warning, TEXT("Unexpected end of file while %s value was expected (config %s)"), TypeName, *FileName)
 		}
 	}
 
@@ -326,11 +344,11 @@ bool FDlgConfigParser::ReadPrimitiveProperty(void* Target,
 }
 
 
-template <typename PropertyType>
+template <typename PropertyType, typename InitValueFunctionType>
 bool FDlgConfigParser::ReadComplexProperty(void* Target,
 										   FProperty* Property,
 										   const UStruct* ReferenceType,
-										   std::function<void*(void*, const UClass*, UObject*)> OnInitValue,
+										   const InitValueFunctionType& OnInitValue,
 										   UObject* Outer)
 {
 	PropertyType* ElementProp = FNYReflectionHelper::CastProperty<PropertyType>(Property);
@@ -345,12 +363,13 @@ bool FDlgConfigParser::ReadComplexProperty(void* Target,
 		// Array
 		FScriptArrayHelper Helper(ArrayProp, ArrayProp->ContainerPtrToValuePtr<uint8>(Target));
 		Helper.EmptyValues();
-		if (!FindNextWordAndCheckIfBlockStart(ReferenceType->GetName() + "Array element") || !FindNextWord("{ or }"))
+		const FString BlockName = ReferenceType->GetName() + TEXT("Array element");
+		if (!FindNextWordAndCheckIfBlockStart(BlockName) || !FindNextWord(TEXT("{ or }")))
 		{
 			return false;
 		}
 
-		while (!CheckIfBlockEnd(ReferenceType->GetName() + "Array element"))
+		while (!CheckIfBlockEnd(BlockName))
 		{
 			const UClass* ReferenceClass = Cast<UClass>(ReferenceType);
 			if (ReferenceClass != nullptr)
@@ -379,7 +398,7 @@ bool FDlgConfigParser::ReadComplexProperty(void* Target,
 					return false;
 				}
 			}
-			else if (!CompareToActiveWord("{"))
+			else if (!CompareToActiveWord(TEXT("{")))
 			{
 				if (!bHasValidWord)
 				{
@@ -13,7 +13,6 @@ DEFINE_LOG_CATEGORY(LogDlgConfigWriter);
 const TCHAR* FDlgConfigWriter::EOL_LF = TEXT("\n");
 const TCHAR* FDlgConfigWriter::EOL_CRLF = TEXT("\r\n");
 const TCHAR* FDlgConfigWriter::EOL = EOL_LF;
-const FString FDlgConfigWriter::EOL_String{EOL};
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -28,15 +27,19 @@ FDlgConfigWriter::FDlgConfigWriter(const FString InComplexNamePrefix,
 void FDlgConfigWriter::Write(const UStruct* const StructDefinition, const void* const Object)
 {
 	TopLevelObjectPtr = Object;
-	WriteComplexMembersToString(StructDefinition, Object, "", EOL, ConfigText);
+
+	// Everything is appended to the builder, ConfigText is only touched once
+	TStringBuilder<2048> Builder;
+	WriteComplexMembersToString(StructDefinition, Object, TEXT(""), EOL, Builder);
+	ConfigText.Append(Builder.GetData(), Builder.Len());
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void FDlgConfigWriter::WriteComplexMembersToString(const UStruct* StructDefinition,
 												   const void* Object,
-												   const FString& PreString,
-												   const FString& PostString,
-												   FString& Target)
+												   FStringView PreString,
+												   FStringView PostString,
+												   FStringBuilderBase& Target)
 {
 	if (StructDefinition == nullptr)
 	{
@@ -108,10 +111,10 @@ void FDlgConfigWriter::WriteComplexMembersToString(const UStruct* StructDefiniti
 bool FDlgConfigWriter::WritePropertyToString(const FProperty* Property,
 											 const void* Object,
 											 bool bContainerElement,
-											 const FString& PreString,
-											 const FString& PostString,
+											 FStringView PreString,
+											 FStringView PostString,
 											 bool bPointerAsRef,
-											 FString& Target)
+											 FStringBuilderBase& Target)
 {
 	if (CanSkipProperty(Property))
 	{
@@ -161,36 +164,36 @@ bool FDlgConfigWriter::WritePropertyToString(const FProperty* Property,
 bool FDlgConfigWriter::WritePrimitiveElementToString(const FProperty* Property,
 													 const void* Object,
 													 bool bInContainer,
-													 const FString& PreS,
-													 const FString& PostS,
-													 FString& Target)
+													 FStringView PreS,
+													 FStringView PostS,
+													 FStringBuilderBase& Target)
 {
 	// Try every possible primitive type
-	if (WritePrimitiveElementToStringTemplated<FBoolProperty, bool>(Property, Object, bInContainer, BoolToString, PreS, PostS, Target))
+	if (WritePrimitiveElementToStringTemplated<FBoolProperty, bool>(Property, Object, bInContainer, AppendBool, PreS, PostS, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveElementToStringTemplated<FIntProperty, int32>(Property, Object, bInContainer, IntToString, PreS, PostS, Target))
+	if (WritePrimitiveElementToStringTemplated<FIntProperty, int32>(Property, Object, bInContainer, AppendInt, PreS, PostS, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveElementToStringTemplated<FInt64Property, int64>(Property, Object, bInContainer, IntToString, PreS, PostS, Target))
+	if (WritePrimitiveElementToStringTemplated<FInt64Property, int64>(Property, Object, bInContainer, AppendInt, PreS, PostS, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveElementToStringTemplated<FFloatProperty, float>(Property, Object, bInContainer, FloatToString, PreS, PostS, Target))
+	if (WritePrimitiveElementToStringTemplated<FFloatProperty, float>(Property, Object, bInContainer, AppendFloat, PreS, PostS, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveElementToStringTemplated<FStrProperty, FString>(Property, Object, bInContainer, StringToString, PreS, PostS, Target))
+	if (WritePrimitiveElementToStringTemplated<FStrProperty, FString>(Property, Object, bInContainer, AppendString, PreS, PostS, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveElementToStringTemplated<FNameProperty, FName>(Property, Object, bInContainer, NameToString, PreS, PostS, Target))
+	if (WritePrimitiveElementToStringTemplated<FNameProperty, FName>(Property, Object, bInContainer, AppendNameString, PreS, PostS, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveElementToStringTemplated<FTextProperty, FText>(Property, Object, bInContainer, TextToString, PreS, PostS, Target))
+	if (WritePrimitiveElementToStringTemplated<FTextProperty, FText>(Property, Object, bInContainer, AppendText, PreS, PostS, Target))
 	{
 		return true;
 	}
@@ -203,7 +206,11 @@ bool FDlgConfigWriter::WritePrimitiveElementToString(const FProperty* Property,
 		{
 			const void* Value = EnumProp->ContainerPtrToValuePtr<uint8>(Object);
 			const FName EnumName = EnumProp->GetEnum()->GetNameByIndex(EnumProp->GetUnderlyingProperty()->GetSignedIntPropertyValue(Value));
-			Target += PreS + Property->GetName() + " " + NameToString(EnumName) + PostS;
+			Target << PreS;
+			AppendName(Target, Property->GetFName());
+			Target << TEXT(" ");
+			AppendNameString(Target, EnumName);
+			Target << PostS;
 			return true;
 		}
 	}
@@ -214,9 +221,9 @@ bool FDlgConfigWriter::WritePrimitiveElementToString(const FProperty* Property,
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool FDlgConfigWriter::WritePrimitiveArrayToString(const FProperty* Property,
 												   const void* Object,
-												   const FString& PreString,
-												   const FString& PostString,
-												   FString& Target)
+												   FStringView PreString,
+												   FStringView PostString,
+												   FStringBuilderBase& Target)
 {
 	const auto* ArrayProp = FNYReflectionHelper::CastProperty<FArrayProperty>(Property);
 	if (ArrayProp == nullptr)
@@ -225,31 +232,31 @@ bool FDlgConfigWriter::WritePrimitiveArrayToString(const FProperty* Property,
 	}
 
 	// Try every possible primitive array type
-	if (WritePrimitiveArrayToStringTemplated<FBoolProperty, bool>(ArrayProp, Object, BoolToString, PreString, PostString, Target))
+	if (WritePrimitiveArrayToStringTemplated<FBoolProperty, bool>(ArrayProp, Object, AppendBool, PreString, PostString, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveArrayToStringTemplated<FIntProperty, int32>(ArrayProp, Object, IntToString, PreString, PostString, Target))
+	if (WritePrimitiveArrayToStringTemplated<FIntProperty, int32>(ArrayProp, Object, AppendInt, PreString, PostString, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveArrayToStringTemplated<FInt64Property, int64>(ArrayProp, Object, IntToString, PreString, PostString, Target))
+	if (WritePrimitiveArrayToStringTemplated<FInt64Property, int64>(ArrayProp, Object, AppendInt, PreString, PostString, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveArrayToStringTemplated<FFloatProperty, float>(ArrayProp, Object, FloatToString, PreString, PostString, Target))
+	if (WritePrimitiveArrayToStringTemplated<FFloatProperty, float>(ArrayProp, Object, AppendFloat, PreString, PostString, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveArrayToStringTemplated<FStrProperty, FString>(ArrayProp, Object, StringToString, PreString, PostString, Target))
+	if (WritePrimitiveArrayToStringTemplated<FStrProperty, FString>(ArrayProp, Object, AppendString, PreString, PostString, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveArrayToStringTemplated<FNameProperty, FName>(ArrayProp, Object, NameToString, PreString, PostString, Target))
+	if (WritePrimitiveArrayToStringTemplated<FNameProperty, FName>(ArrayProp, Object, AppendNameString, PreString, PostString, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveArrayToStringTemplated<FTextProperty, FText>(ArrayProp, Object, TextToString, PreString, PostString, Target))
+	if (WritePrimitiveArrayToStringTemplated<FTextProperty, FText>(ArrayProp, Object, AppendText, PreString, PostString, Target))
 	{
 		return true;
 	}
@@ -261,10 +268,10 @@ bool FDlgConfigWriter::WritePrimitiveArrayToString(const FProperty* Property,
 bool FDlgConfigWriter::WriteComplexElementToString(const FProperty* Property,
 												   const void* Object,
 												   bool bContainerElement,
-												   const FString& PreString,
-												   const FString& PostString,
+												   FStringView PreString,
+												   FStringView PostString,
 												   bool bPointerAsRef,
-												   FString& Target)
+												   FStringBuilderBase& Target)
 {
 	if (Property == nullptr)
 	{
@@ -295,17 +302,20 @@ bool FDlgConfigWriter::WriteComplexElementToString(const FProperty* Property,
 	if (const auto* ObjectProperty = FNYReflectionHelper::CastProperty<FObjectProperty>(Property))
 	{
 		UObject** ObjPtrPtr = ((UObject**)ObjectProperty->ContainerPtrToValuePtr<void>(Object, 0));
-		const FString Path = *ObjPtrPtr != nullptr ? (*ObjPtrPtr)->GetPathName() : "";
 		auto WritePathName = [&]()
 		{
-			if (bContainerElement)
+			Target << PreString;
+			if (!bContainerElement)
 			{
-				Target += PreString + "\"" + Path + "\"" + PostString;
+				AppendName(Target, Property->GetFName());
+				Target << TEXT(" ");
 			}
-			else
+			Target << TEXT("\"");
+			if (*ObjPtrPtr != nullptr)
 			{
-				Target += PreString + Property->GetName() + " \"" + Path + "\"" + PostString;
+				(*ObjPtrPtr)->GetPathName(nullptr, Target);
 			}
+			Target << TEXT("\"") << PostString;
 		};
 
 		if (CanSaveAsReference(ObjectProperty, *ObjPtrPtr) || bPointerAsRef)
@@ -340,11 +350,11 @@ bool FDlgConfigWriter::WriteComplexElementToString(const FProperty* Property,
 void FDlgConfigWriter::WriteComplexToString(const UStruct* StructDefinition,
 											const FProperty* Property,
 											const void* Object,
-											const FString& PreString,
-											const FString& PostString,
+											FStringView PreString,
+											FStringView PostString,
 											bool bContainerElement,
 											bool bWriteType,
-											FString& Target)
+											FStringBuilderBase& Target)
 {
 	if (CanSkipProperty(Property) || StructDefinition == nullptr)
 	{
@@ -360,42 +370,57 @@ void FDlgConfigWriter::WriteComplexToString(const UStruct* StructDefinition,
 	const bool bLinePerMember = WouldWriteNonPrimitive(StructDefinition, Object);
 
 	// WARNING: bWriteType implicates objectproperty, if that changes this code (cause of the object cast) should be updated accordingly
-	const FString TypeString = bWriteType ? GetNameWithoutPrefix(Property, UnrealObject) + " ": "";
-	if (bContainerElement)
+	Target << PreString;
+	if (bWriteType)
 	{
-		if (TypeString.Len() > 0)
-		{
-			Target += PreString + TypeString + (bLinePerMember ? EOL + PreString + "{" + EOL : "{ ");
-		}
-		else
+		Target << GetNameWithoutPrefix(Property, UnrealObject) << TEXT(" ");
+	}
+	if (!bContainerElement)
+	{
+		AppendName(Target, Property->GetFName());
+	}
+	if (bLinePerMember)
+	{
+		// The type or the name has its own line
+		if (bWriteType || !bContainerElement)
 		{
-			Target += PreString + (bLinePerMember ? "{" + EOL_String : "{ ");
+			Target << EOL << PreString;
 		}
+		Target << TEXT("{") << EOL;
 	}
 	else
 	{
-		Target += PreString + TypeString + Property->GetName() + (bLinePerMember ? EOL + PreString + "{" + EOL : " { ");
+		Target << (bContainerElement ? TEXT("{ ") : TEXT(" { "));
 	}
 
 	// Write the properties of the Struct/Object
-	WriteComplexMembersToString(StructDefinition, Object, (bLinePerMember ? PreString + "\t" : " "), (bLinePerMember ? EOL_String : ""), Target);
+	TStringBuilder<64> MembersPreString;
+	if (bLinePerMember)
+	{
+		MembersPreString << PreString << TEXT("\t");
+	}
+	else
+	{
+		MembersPreString << TEXT(" ");
+	}
+	WriteComplexMembersToString(StructDefinition, Object, MembersPreString.ToView(), (bLinePerMember ? EOL : TEXT("")), Target);
 
 	if (bLinePerMember)
 	{
-		Target += PreString + "}" + PostString;
+		Target << PreString << TEXT("}") << PostString;
 	}
 	else
 	{
-		Target += " }" + PostString;
+		Target << TEXT(" }") << PostString;
 	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool FDlgConfigWriter::WriteComplexArrayToString(const FProperty* Property,
 												 const void* Object,
-												 const FString& PreString,
-												 const FString& PostString,
-												 FString& Target)
+												 FStringView PreString,
+												 FStringView PostString,
+												 FStringBuilderBase& Target)
 {
 	const auto* ArrayProp = FNYReflectionHelper::CastProperty<FArrayProperty>(Property);
 	if (ArrayProp == nullptr)
@@ -425,26 +450,35 @@ bool FDlgConfigWriter::WriteComplexArrayToString(const FProperty* Property,
 
 	if (Helper.Num() == 1 && !WouldWriteNonPrimitive(GetComplexType(ArrayProp->Inner), Helper.GetConstRawPtr(0)))
 	{
-		Target += PreString + TypeText + ArrayProp->Inner->GetName() + " {";
+		Target << PreString << TypeText;
+		AppendName(Target, ArrayProp->Inner->GetFName());
+		Target << TEXT(" {");
 		for (int32 i = 0; i < Helper.Num(); ++i)
 		{
-			WriteComplexElementToString(ArrayProp->Inner, Helper.GetConstRawPtr(i), true, " ", "", CanSaveAsReference(ArrayProp, nullptr), Target);
+			WriteComplexElementToString(ArrayProp->Inner, Helper.GetConstRawPtr(i), true, TEXT(" "), TEXT(""), CanSaveAsReference(ArrayProp, nullptr), Target);
 		}
-		Target += " }" + PostString;
+		Target << TEXT(" }") << PostString;
 	}
 	else
 	{
-		Target += PreString + TypeText + ArrayProp->Inner->GetName() + EOL;
-		Target += PreString + "{" + EOL;
+		Target << PreString << TypeText;
+		AppendName(Target, ArrayProp->Inner->GetFName());
+		Target << EOL;
+		Target << PreString << TEXT("{") << EOL;
+
+		TStringBuilder<64> ElementPreString;
+		ElementPreString << PreString << TEXT("\t");
 		for (int32 i = 0; i < Helper.Num(); ++i)
 		{
 			if (bWriteIndex)
 			{
-				Target += PreString + "\t// " + FString::FromInt(i) + EOL;
+				Target << ElementPreString << TEXT("// ");
+				Target.Appendf(TEXT("%d"), i);
+				Target << EOL;
 			}
-			WriteComplexElementToString(ArrayProp->Inner, Helper.GetConstRawPtr(i), true, PreString + "\t", EOL, CanSaveAsReference(ArrayProp, nullptr), Target);
+			WriteComplexElementToString(ArrayProp->Inner, Helper.GetConstRawPtr(i), true, ElementPreString.ToView(), EOL, CanSaveAsReference(ArrayProp, nullptr), Target);
 		}
-		Target += PreString + "}" + EOL;
+		Target << PreString << TEXT("}") << EOL;
 	}
 
 	return true;
@@ -453,9 +487,9 @@ bool FDlgConfigWriter::WriteComplexArrayToString(const FProperty* Property,
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool FDlgConfigWriter::WriteMapToString(const FProperty* Property,
 										const void* Object,
-										const FString& PreString,
-										const FString& PostString,
-										FString& Target)
+										FStringView PreString,
+										FStringView PostString,
+										FStringBuilderBase& Target)
 {
 	const auto* MapProp = FNYReflectionHelper::CastProperty<FMapProperty>(Property);
 	if (MapProp == nullptr)
@@ -474,7 +508,9 @@ bool FDlgConfigWriter::WriteMapToString(const FProperty* Property,
 	if (IsPrimitive(MapProp->KeyProp) && IsPrimitive(MapProp->ValueProp))
 	{
 		// Both Key and Value are primitives
-		Target += PreString + MapProp->GetName() + " { ";
+		Target << PreString;
+		AppendName(Target, MapProp->GetFName());
+		Target << TEXT(" { ");
 
 		// GetMaxIndex() instead of Num() - the container is not contiguous
 		// elements are in [0, GetMaxIndex[, some of them are invalid (Num() returns with the valid element num)
@@ -485,16 +521,21 @@ bool FDlgConfigWriter::WriteMapToString(const FProperty* Property,
 				continue;
 			}
 
-			WritePrimitiveElementToString(MapProp->KeyProp, Helper.GetPairPtr(i), true, "", " ", Target);
-			WritePrimitiveElementToString(MapProp->ValueProp, Helper.GetPairPtr(i), true, "", " ", Target);
+			WritePrimitiveElementToString(MapProp->KeyProp, Helper.GetPairPtr(i), true, TEXT(""), TEXT(" "), Target);
+			WritePrimitiveElementToString(MapProp->ValueProp, Helper.GetPairPtr(i), true, TEXT(""), TEXT(" "), Target);
 		}
-		Target += "}" + PostString;
+		Target << TEXT("}") << PostString;
 	}
 	else
 	{
 		// Either Key or Value is not a primitive
-		Target += PreString + MapProp->GetName() + EOL;
-		Target += PreString + "{" + EOL;
+		Target << PreString;
+		AppendName(Target, MapProp->GetFName());
+		Target << EOL;
+		Target << PreString << TEXT("{") << EOL;
+
+		TStringBuilder<64> ElementPreString;
+		ElementPreString << PreString << TEXT("\t");
 
 		// GetMaxIndex() instead of Num() - the container is not contiguous
 		// elements are in [0, GetMaxIndex[, some of them are invalid (Num() returns with the valid element num)
@@ -505,10 +546,10 @@ bool FDlgConfigWriter::WriteMapToString(const FProperty* Property,
 				continue;
 			}
 
-			WritePropertyToString(MapProp->KeyProp, Helper.GetPairPtr(i), true, PreString + "\t", EOL, CanSaveAsReference(MapProp, nullptr), Target);
-			WritePropertyToString(MapProp->ValueProp, Helper.GetPairPtr(i), true, PreString + "\t", EOL, CanSaveAsReference(MapProp, nullptr), Target);
+			WritePropertyToString(MapProp->KeyProp, Helper.GetPairPtr(i), true, ElementPreString.ToView(), EOL, CanSaveAsReference(MapProp, nullptr), Target);
+			WritePropertyToString(MapProp->ValueProp, Helper.GetPairPtr(i), true, ElementPreString.ToView(), EOL, CanSaveAsReference(MapProp, nullptr), Target);
 		}
-		Target += PreString + "}" + EOL;
+		Target << PreString << TEXT("}") << EOL;
 	}
 
 	return true;
@@ -517,9 +558,9 @@ bool FDlgConfigWriter::WriteMapToString(const FProperty* Property,
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool FDlgConfigWriter::WriteSetToString(const FProperty* Property,
 										const void* Object,
-										const FString& PreString,
-										const FString& PostString,
-										FString& Target)
+										FStringView PreString,
+										FStringView PostString,
+										FStringBuilderBase& Target)
 {
 	const auto* SetProp = FNYReflectionHelper::CastProperty<FSetProperty>(Property);
 	if (SetProp == nullptr)
@@ -539,19 +580,21 @@ bool FDlgConfigWriter::WriteSetToString(const FProperty* Property,
 	{
 		const bool bLinePerItem = CanWriteOneLinePerItem(SetProp);
 
-		// Add space indentation
-		FString SubPreString = PreString;
-		for (int32 i = 0; i < SetProp->GetName().Len() + 3; ++i)
+		// Add space indentation, every item starts on a new line
+		const FString SetName = SetProp->GetName();
+		TStringBuilder<128> ItemPreString;
+		ItemPreString << EOL << PreString;
+		for (int32 i = 0; i < SetName.Len() + 3; ++i)
 		{
-			SubPreString += " ";
+			ItemPreString << TEXT(" ");
 		}
 
 		// SetName {
-		Target += PreString + SetProp->GetName() + " {";
+		Target << PreString << SetName << TEXT(" {");
 		if (!bLinePerItem)
 		{
 			// Add space because there is no new line
-			Target += " ";
+			Target << TEXT(" ");
 		}
 
 		// Set content
@@ -565,16 +608,20 @@ bool FDlgConfigWriter::WriteSetToString(const FProperty* Property,
 
 			if (bLinePerItem)
 			{
-				WritePrimitiveElementToString(SetProp->ElementProp, Helper.GetElementPtr(i), true, EOL + SubPreString, "", Target);
+				WritePrimitiveElementToString(SetProp->ElementProp, Helper.GetElementPtr(i), true, ItemPreString.ToView(), TEXT(""), Target);
 			}
 			else
 			{
-				WritePrimitiveElementToString(SetProp->ElementProp, Helper.GetElementPtr(i), true, "", " ", Target);
+				WritePrimitiveElementToString(SetProp->ElementProp, Helper.GetElementPtr(i), true, TEXT(""), TEXT(" "), Target);
 			}
 		}
 
 		// }
-		Target += (bLinePerItem ? " " : "") + FString("}") + PostString;
+		if (bLinePerItem)
+		{
+			Target << TEXT(" ");
+		}
+		Target << TEXT("}") << PostString;
 	}
 	else
 	{
@@ -1,8 +1,8 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #pragma once
 
-#include <functional>
 #include "Logging/LogMacros.h"
+#include "Misc/StringBuilder.h"
 #include "UObject/UnrealType.h"
 #include "Misc/FileHelper.h"
 
@@ -65,65 +65,65 @@ protected:
 	void WriteComplexToString(const UStruct* StructDefinition,
 							  const FProperty* Property,
 							  const void* Object,
-							  const FString& PreString,
-							  const FString& PostString,
+							  FStringView PreString,
+							  FStringView PostString,
 							  bool bContainerElement,
 							  bool bWriteType,
-							  FString& Target);
+							  FStringBuilderBase& Target);
 
 	void WriteComplexMembersToString(const UStruct* StructDefinition,
 									 const void* Object,
-									 const FString& PreString,
-									 const FString& PostString,
-									 FString& Target);
+									 FStringView PreString,
+									 FStringView PostString,
+									 FStringBuilderBase& Target);
 
 	bool WritePropertyToString(const FProperty* Property,
 							   const void* Object,
 							   bool bContainerElement,
-							   const FString& PreString,
-							   const FString& PostString,
+							   FStringView PreString,
+							   FStringView PostString,
 							   bool bPointerAsRef,
-							   FString& Target);
+							   FStringBuilderBase& Target);
 
 	// object is pointer to the owner
 	bool WritePrimitiveElementToString(const FProperty* Property,
 									   const void* Object,
 									   bool bContainerElement,
-									   const FString& PreString,
-									   const FString& PostString,
-									   FString& Target);
+									   FStringView PreString,
+									   FStringView PostString,
+									   FStringBuilderBase& Target);
 
 	bool WritePrimitiveArrayToString(const FProperty* Property,
 									 const void* Object,
-									 const FString& PreString,
-									 const FString& PostString,
-									 FString& Target);
+									 FStringView PreString,
+									 FStringView PostString,
+									 FStringBuilderBase& Target);
 
 	bool WriteComplexElementToString(const FProperty* Property,
 									 const void* Object,
 									 bool bContainerElement,
-									 const FString& PreString,
-									 const FString& PostString,
+									 FStringView PreString,
+									 FStringView PostString,
 									 bool bPointerAsRef,
-									 FString& Target);
+									 FStringBuilderBase& Target);
 
 	bool WriteComplexArrayToString(const FProperty* Property,
 								   const void* Object,
-								   const FString& PreString,
-								   const FString& PostString,
-								   FString& Target);
+								   FStringView PreString,
+								   FStringView PostString,
+								   FStringBuilderBase& Target);
 
 	bool WriteMapToString(const FProperty* Property,
 						  const void* Object,
-						  const FString& PreString,
-						  const FString& PostString,
-						  FString& Target);
+						  FStringView PreString,
+						  FStringView PostString,
+						  FStringBuilderBase& Target);
 
 	bool WriteSetToString(const FProperty* Property,
 						  const void* Object,
-						  const FString& PreString,
-						  const FString& PostString,
-						  FString& Target);
+						  FStringView PreString,
+						  FStringView PostString,
+						  FStringBuilderBase& Target);
 
 	bool IsPrimitive(const FProperty* Property);
 	bool IsContainer(const FProperty* Property);
@@ -140,22 +140,26 @@ protected:
 
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	template <typename PropertyType, typename VariableType>
+	template <typename PropertyType, typename VariableType, typename AppendFunctionType>
 	bool WritePrimitiveElementToStringTemplated(const FProperty* Property,
 												const void* Object,
 												bool bContainerElement,
-												std::function<FString(const VariableType&)> GetAsString,
-												const FString& PreString,
-												const FString& PostString,
-												FString& Target)
+												AppendFunctionType AppendValue,
+												FStringView PreString,
+												FStringView PostString,
+												FStringBuilderBase& Target)
 	{
 		const PropertyType* CastedProperty = FNYReflectionHelper::CastProperty<PropertyType>(Property);
 		if (CastedProperty != nullptr)
 		{
-			Target += PreString +
-					  (bContainerElement ? "" : (CastedProperty->GetName() + " ")) +
-					  GetAsString(CastedProperty->GetPropertyValue_InContainer(Object, 0)) +
-					  PostString;
+			Target << PreString;
+			if (!bContainerElement)
+			{
+				AppendName(Target, CastedProperty->GetFName());
+				Target << TEXT(" ");
+			}
+			AppendValue(Target, CastedProperty->GetPropertyValue_InContainer(Object, 0));
+			Target << PostString;
 			return true;
 		}
 
@@ -163,13 +167,13 @@ protected:
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	template <typename PropertyType, typename VariableType>
+	template <typename PropertyType, typename VariableType, typename AppendFunctionType>
 	bool WritePrimitiveArrayToStringTemplated(const FArrayProperty* ArrayProp,
 											  const void* Object,
-											  std::function<FString(const VariableType&)> ToString,
-											  const FString& PreString,
-											  const FString& PostString,
-											  FString& Target)
+											  AppendFunctionType AppendValue,
+											  FStringView PreString,
+											  FStringView PostString,
+											  FStringBuilderBase& Target)
 	{
 		if (FNYReflectionHelper::CastProperty<PropertyType>(ArrayProp->Inner) == nullptr)
 		{
@@ -184,68 +188,103 @@ protected:
 		const bool bLinePerItem = CanWriteOneLinePerItem(ArrayProp);
 
 		// Empty array
-		const TArray<VariableType> Array = *ArrayPtr;
+		const TArray<VariableType>& Array = *ArrayPtr;
 		if (Array.Num() == 0 && bDontWriteEmptyContainer)
 		{
 			return true;
 		}
 
 		// Establish indentation to be the same as the ArrayName.len + 3 spaces
-		FString SubPreString = PreString;
-		for (int32 i = 0; i < ArrayProp->GetName().Len() + 3; ++i)
+		const FString ArrayName = ArrayProp->GetName();
+		TStringBuilder<128> SubPreString;
+		SubPreString << PreString;
+		for (int32 i = 0; i < ArrayName.Len() + 3; ++i)
 		{
-			SubPreString += " ";
+			SubPreString << TEXT(" ");
 		}
 
 		// ArrayName {
-		Target += PreString + ArrayProp->GetName() + " {" + (bLinePerItem ? EOL_String : " ");
+		Target << PreString << ArrayName << TEXT(" {") << (bLinePerItem ? EOL : TEXT(" "));
 
 		// Array content
 		for (int32 i = 0; i < Array.Num(); ++i)
 		{
 			if (bLinePerItem)
 			{
-				Target += SubPreString + ToString(Array[i]) + EOL;
+				Target << SubPreString;
+				AppendValue(Target, Array[i]);
+				Target << EOL;
 			}
 			else
 			{
-				Target += ToString(Array[i]) + " ";
+				AppendValue(Target, Array[i]);
+				Target << TEXT(" ");
 			}
 		}
 
 		// }
-		Target += (bLinePerItem ? PreString : "") + "}" + PostString;
+		if (bLinePerItem)
+		{
+			Target << PreString;
+		}
+		Target << TEXT("}") << PostString;
 
 		return true;
 	}
 
-	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	template <typename PropertyType, typename VariableType>
-	bool WritePrimitiveToStringTemplated(const FProperty* Property,
-										 const void* Object,
-										 bool bContainerElement,
-										 std::function<FString(const VariableType&)> GetAsString,
-										 const FString& PreString,
-										 const FString& PostString,
-										 FString& Target)
+	// Value to string functions, they append the value to Target
+	static void AppendBool(FStringBuilderBase& Target, const bool& bBool)
 	{
-		const PropertyType* CastedProperty = FNYReflectionHelper::CastProperty<PropertyType>(Property);
-		if (CastedProperty != nullptr)
-		{
-			Target += PreString +
-					  (bContainerElement ? "" : (CastedProperty->GetName() + " ")) +
-					  GetAsString(*((VariableType*)(Object))) +
-					  PostString;
-			return true;
-		}
+		Target << (bBool ? TEXT("True") : TEXT("False"));
+	}
 
-		return false;
+	static void AppendInt(FStringBuilderBase& Target, const int64& IntVal)
+	{
+		Target.Appendf(TEXT("%lld"), IntVal);
+	}
+
+	static void AppendFloat(FStringBuilderBase& Target, const float& FloatVal)
+	{
+		Target << FString::SanitizeFloat(FloatVal);
 	}
 
-	/** Converts all endlines to be of one type. */
-	static FString NormalizeEndlines(const FString& Original)
+	static void AppendString(FStringBuilderBase& Target, const FString& String)
 	{
-		return Original.Replace(EOL_CRLF, EOL_LF, ESearchCase::IgnoreCase);
+		AppendQuoted(Target, String);
+	}
+
+	static void AppendNameString(FStringBuilderBase& Target, const FName& Name)
+	{
+		TStringBuilder<128> NameString;
+		Name.AppendString(NameString);
+		AppendQuoted(Target, NameString);
+	}
+
+	static void AppendText(FStringBuilderBase& Target, const FText& Text)
+	{
+		AppendQuoted(Target, Text.ToString());
+	}
+
+	// Appends the Name without converting it to an FString first
+	static void AppendName(FStringBuilderBase& Target, FName Name)
+	{
+		Name.AppendString(Target);
+	}
+
+	/** Appends the String between quotes with all endlines converted to be of one type (CRLF -> LF). */
+	static void AppendQuoted(FStringBuilderBase& Target, FStringView String)
+	{
+		Target << TEXT("\"");
+		for (int32 Index = 0; Index < String.Len(); ++Index)
+		{
+			// Skip the CR of CRLF
+			if (String[Index] == '\r' && Index + 1 < String.Len() && String[Index + 1] == '\n')
+			{
+				continue;
+			}
+			Target.AppendChar(String[Index]);
+		}
+		Target << TEXT("\"");
 	}
 
 private:
@@ -254,43 +293,9 @@ private:
 	static const TCHAR* EOL_CRLF;
 	static const TCHAR* EOL;
 
-	// Helper strings
-	static const FString EOL_String;
-
 	FString ConfigText = "";
 
 	const void* TopLevelObjectPtr = nullptr;
 	const FString ComplexNamePrefix;
 	const bool bDontWriteEmptyContainer;
-
-	// Conversion to string functions
-	const std::function<FString(const bool&)> BoolToString = [](const bool& bBool) -> FString
-	{
-		return bBool ? "True" : "False";
-	};
-
-	const std::function<FString(const int64&)> IntToString = [](const int64& IntVal) -> FString
-	{
-		return FString::Printf(TEXT("%lld"), IntVal);
-	};
-
-	const std::function<FString(const float&)> FloatToString = [](const float& FloatVal) -> FString
-	{
-		return FString::SanitizeFloat(FloatVal);
-	};
-
-	const std::function<FString(const FString&)> StringToString = [](const FString& String) -> FString
-	{
-		return FString("\"") + NormalizeEndlines(String) + "\"";
-	};
-
-	const std::function<FString(const FName&)> NameToString = [](const FName& Name) -> FString
-	{
-		return FString("\"") + NormalizeEndlines(Name.ToString()) + "\"";
-	};
-
-	const std::function<FString(const FText&)> TextToString = [](const FText& Text) -> FString
-	{
-		return FString("\"") + NormalizeEndlines(Text.ToString()) + "\"";
-	};
 };
@@ -0,0 +1,371 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgHistoryCodec.h"
+
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "DlgSystem/DlgMemory.h"
+#include "DlgSystem/Logging/DlgLogger.h"
+
+namespace DlgHistoryCodec
+{
+	// Maps the GUIDs to their index in the dictionary
+	struct FGUIDDictionary
+	{
+		void Add(const FGuid& GUID)
+		{
+			if (!Indices.Contains(GUID))
+			{
+				Indices.Add(GUID, GUIDs.Add(GUID));
+			}
+		}
+
+		uint32 GetIndex(const FGuid& GUID) const
+		{
+			return static_cast<uint32>(Indices.FindChecked(GUID));
+		}
+
+		TArray<FGuid> GUIDs;
+		TMap<FGuid, int32> Indices;
+	};
+
+	// Small negative numbers are also small variable length integers
+	static uint32 ZigZagEncode(int32 Value)
+	{
+		return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+	}
+
+	static int32 ZigZagDecode(uint32 Value)
+	{
+		return static_cast<int32>((Value >> 1) ^ (0u - (Value & 1u)));
+	}
+
+	static void WriteUInt(FArchive& Ar, uint32 Value)
+	{
+		Ar.SerializeIntPacked(Value);
+	}
+
+	static void WriteCount(FArchive& Ar, int32 Count)
+	{
+		WriteUInt(Ar, static_cast<uint32>(Count));
+	}
+
+	static bool ReadUInt(FArchive& Ar, uint32& OutValue)
+	{
+		OutValue = 0;
+		Ar.SerializeIntPacked(OutValue);
+		return !Ar.IsError();
+	}
+
+	// Every element takes at least MinElementSize bytes, don't trust counts that are bigger than the remaining data
+	static bool ReadCount(FArchive& Ar, int32 MinElementSize, int32& OutCount)
+	{
+		uint32 Count = 0;
+		if (!ReadUInt(Ar, Count) || Count > static_cast<uint32>(MAX_int32))
+		{
+			return false;
+		}
+
+		const int64 TotalSize = Ar.TotalSize();
+		if (TotalSize >= 0 && static_cast<int64>(Count) * MinElementSize > TotalSize - Ar.Tell())
+		{
+			return false;
+		}
+
+		OutCount = static_cast<int32>(Count);
+		return true;
+	}
+
+	static bool ReadGUID(FArchive& Ar, const TArray<FGuid>& GUIDs, FGuid& OutGUID)
+	{
+		uint32 Index = 0;
+		if (!ReadUInt(Ar, Index) || Index >= static_cast<uint32>(GUIDs.Num()))
+		{
+			return false;
+		}
+
+		OutGUID = GUIDs[Index];
+		return true;
+	}
+
+	static void GatherGUIDs(const FGuid& DialogueGUID, const FDlgHistory& History, FGUIDDictionary& Dictionary)
+	{
+		Dictionary.Add(DialogueGUID);
+		for (const FGuid& NodeGUID : History.VisitedNodeGUIDs)
+		{
+			Dictionary.Add(NodeGUID);
+		}
+		for (const auto& Pair : History.NodeData)
+		{
+			Dictionary.Add(Pair.Key);
+			for (const FGuid& GUID : Pair.Value.GUIDList)
+			{
+				Dictionary.Add(GUID);
+			}
+		}
+	}
+
+	static void WriteHistory(FArchive& Ar, const FGuid& DialogueGUID, const FDlgHistory& History, const FGUIDDictionary& Dictionary)
+	{
+		WriteUInt(Ar, Dictionary.GetIndex(DialogueGUID));
+
+		// Sorted unique indices, the differences are small
+		TArray<int32> NodeIndices = History.VisitedNodeIndices.Array();
+		NodeIndices.Sort();
+		WriteCount(Ar, NodeIndices.Num());
+		uint32 PreviousIndex = 0;
+		for (int32 Index = 0; Index < NodeIndices.Num(); Index++)
+		{
+			const uint32 NodeIndex = static_cast<uint32>(NodeIndices[Index]);
+			WriteUInt(Ar, Index == 0 ? ZigZagEncode(NodeIndices[Index]) : NodeIndex - PreviousIndex);
+			PreviousIndex = NodeIndex;
+		}
+
+		WriteCount(Ar, History.VisitedNodeGUIDs.Num());
+		for (const FGuid& NodeGUID : History.VisitedNodeGUIDs)
+		{
+			WriteUInt(Ar, Dictionary.GetIndex(NodeGUID));
+		}
+
+		WriteCount(Ar, History.NodeData.Num());
+		for (const auto& Pair : History.NodeData)
+		{
+			WriteUInt(Ar, Dictionary.GetIndex(Pair.Key));
+			WriteCount(Ar, Pair.Value.GUIDList.Num());
+			for (const FGuid& GUID : Pair.Value.GUIDList)
+			{
+				WriteUInt(Ar, Dictionary.GetIndex(GUID));
+			}
+		}
+	}
+
+	// Decodes directly into the History
+	static bool ReadHistory(FArchive& Ar, const TArray<FGuid>& GUIDs, FDlgHistory& History)
+	{
+		int32 NumNodeIndices = 0;
+		if (!ReadCount(Ar, 1, NumNodeIndices))
+		{
+			return false;
+		}
+		History.VisitedNodeIndices.Empty(NumNodeIndices);
+		uint32 PreviousIndex = 0;
+		for (int32 Index = 0; Index < NumNodeIndices; Index++)
+		{
+			uint32 Value = 0;
+			if (!ReadUInt(Ar, Value))
+			{
+				return false;
+			}
+
+			const uint32 NodeIndex = Index == 0 ? static_cast<uint32>(ZigZagDecode(Value)) : PreviousIndex + Value;
+			History.VisitedNodeIndices.Add(static_cast<int32>(NodeIndex));
+			PreviousIndex = NodeIndex;
+		}
+
+		int32 NumNodeGUIDs = 0;
+		if (!ReadCount(Ar, 1, NumNodeGUIDs))
+		{
+			return false;
+		}
+		History.VisitedNodeGUIDs.Empty(NumNodeGUIDs);
+		for (int32 Index = 0; Index < NumNodeGUIDs; Index++)
+		{
+			FGuid NodeGUID;
+			if (!ReadGUID(Ar, GUIDs, NodeGUID))
+			{
+				return false;
+			}
+			History.VisitedNodeGUIDs.Add(NodeGUID);
+		}
+
+		int32 NumNodeData = 0;
+		if (!ReadCount(Ar, 2, NumNodeData))
+		{
+			return false;
+		}
+		History.NodeData.Empty(NumNodeData);
+		for (int32 Index = 0; Index < NumNodeData; Index++)
+		{
+			FGuid NodeGUID;
+			int32 NumGUIDs = 0;
+			if (!ReadGUID(Ar, GUIDs, NodeGUID) || !ReadCount(Ar, 1, NumGUIDs))
+			{
+				return false;
+			}
+
+			TArray<FGuid>& GUIDList = History.NodeData.Add(NodeGUID).GUIDList;
+			GUIDList.SetNum(NumGUIDs);
+			for (FGuid& GUID : GUIDList)
+			{
+				if (!ReadGUID(Ar, GUIDs, GUID))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgHistoryCodec::SaveMemory(FArchive& Ar, const FDlgMemory& Memory)
+{
+	TArray<FGuid> DialogueGUIDs;
+	Memory.GetHistoryMaps().GetKeys(DialogueGUIDs);
+	SaveEntries(Ar, Memory, DialogueGUIDs, false);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgHistoryCodec::SaveMemoryDelta(FArchive& Ar, FDlgMemory& Memory, bool bCheckpoint)
+{
+	if (Memory.AreAllEntriesDirty())
+	{
+		// Entries could have been removed, only a full save can represent that
+		SaveMemory(Ar, Memory);
+	}
+	else
+	{
+		// Entries marked as changed that were never added have nothing to save
+		TArray<FGuid> DialogueGUIDs;
+		DialogueGUIDs.Reserve(Memory.GetDirtyEntries().Num());
+		for (const FGuid& DialogueGUID : Memory.GetDirtyEntries())
+		{
+			if (Memory.FindEntry(DialogueGUID))
+			{
+				DialogueGUIDs.Add(DialogueGUID);
+			}
+		}
+		SaveEntries(Ar, Memory, DialogueGUIDs, true);
+	}
+
+	if (bCheckpoint)
+	{
+		Memory.ClearDirtyEntries();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgHistoryCodec::SaveEntries(FArchive& Ar, const FDlgMemory& Memory, const TArray<FGuid>& DialogueGUIDs, bool bDelta)
+{
+	check(Ar.IsSaving());
+
+	// Header
+	uint32 MagicValue = Magic;
+	int32 Version = static_cast<int32>(EVersion::LatestVersion);
+	uint8 bDeltaValue = bDelta ? 1 : 0;
+	Ar << MagicValue;
+	Ar << Version;
+	Ar << bDeltaValue;
+
+	// GUID dictionary
+	DlgHistoryCodec::FGUIDDictionary Dictionary;
+	for (const FGuid& DialogueGUID : DialogueGUIDs)
+	{
+		DlgHistoryCodec::GatherGUIDs(DialogueGUID, *Memory.FindEntry(DialogueGUID), Dictionary);
+	}
+	DlgHistoryCodec::WriteCount(Ar, Dictionary.GUIDs.Num());
+	for (FGuid& GUID : Dictionary.GUIDs)
+	{
+		Ar << GUID;
+	}
+
+	// Entries
+	DlgHistoryCodec::WriteCount(Ar, DialogueGUIDs.Num());
+	for (const FGuid& DialogueGUID : DialogueGUIDs)
+	{
+		DlgHistoryCodec::WriteHistory(Ar, DialogueGUID, *Memory.FindEntry(DialogueGUID), Dictionary);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgHistoryCodec::LoadMemory(FArchive& Ar, FDlgMemory& Memory)
+{
+	check(Ar.IsLoading());
+
+	// Header
+	uint32 MagicValue = 0;
+	int32 Version = INDEX_NONE;
+	uint8 bDeltaValue = 0;
+	Ar << MagicValue;
+	if (Ar.IsError() || MagicValue != Magic)
+	{
+		FDlgLogger::Get().Error(TEXT("FDlgHistoryCodec::LoadMemory - The data is not a Dialogue history"));
+		return false;
+	}
+	Ar << Version;
+	Ar << bDeltaValue;
+	if (Ar.IsError() || Version < 0 || Version > static_cast<int32>(EVersion::LatestVersion))
+	{
+		FDlgLogger::Get().Errorf(
+			TEXT("FDlgHistoryCodec::LoadMemory - Unsupported version = %d, latest supported version = %d"),
+			Version, static_cast<int32>(EVersion::LatestVersion)
+		);
+		return false;
+	}
+
+	// GUID dictionary
+	int32 NumGUIDs = 0;
+	if (!DlgHistoryCodec::ReadCount(Ar, sizeof(FGuid), NumGUIDs))
+	{
+		FDlgLogger::Get().Error(TEXT("FDlgHistoryCodec::LoadMemory - Invalid GUID dictionary"));
+		return false;
+	}
+	TArray<FGuid> GUIDs;
+	GUIDs.SetNum(NumGUIDs);
+	for (FGuid& GUID : GUIDs)
+	{
+		Ar << GUID;
+	}
+
+	// Entries
+	int32 NumEntries = 0;
+	if (Ar.IsError() || !DlgHistoryCodec::ReadCount(Ar, 4, NumEntries))
+	{
+		FDlgLogger::Get().Error(TEXT("FDlgHistoryCodec::LoadMemory - Invalid number of entries"));
+		return false;
+	}
+
+	const bool bDelta = bDeltaValue != 0;
+	if (!bDelta)
+	{
+		Memory.Empty();
+		Memory.Reserve(NumEntries);
+	}
+	for (int32 Index = 0; Index < NumEntries; Index++)
+	{
+		FGuid DialogueGUID;
+		if (!DlgHistoryCodec::ReadGUID(Ar, GUIDs, DialogueGUID)
+			|| !DlgHistoryCodec::ReadHistory(Ar, GUIDs, Memory.FindOrAddEntry(DialogueGUID)))
+		{
+			FDlgLogger::Get().Errorf(TEXT("FDlgHistoryCodec::LoadMemory - Invalid entry at index = %d"), Index);
+			return false;
+		}
+	}
+
+	Memory.ClearDirtyEntries();
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TArray<uint8> FDlgHistoryCodec::SaveMemoryToBytes(const FDlgMemory& Memory)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	SaveMemory(Writer, Memory);
+	return Bytes;
+}
+
+TArray<uint8> FDlgHistoryCodec::SaveMemoryDeltaToBytes(FDlgMemory& Memory, bool bCheckpoint)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	SaveMemoryDelta(Writer, Memory, bCheckpoint);
+	return Bytes;
+}
+
+bool FDlgHistoryCodec::LoadMemoryFromBytes(const TArray<uint8>& Bytes, FDlgMemory& Memory)
+{
+	FMemoryReader Reader(Bytes);
+	return LoadMemory(Reader, Memory);
+}
@@ -0,0 +1,56 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+
+struct FDlgMemory;
+
+/**
+ * Compact binary format of the Dialogue history (FDlgMemory), an alternative of the UPROPERTY (tagged property) serialization.
+ *
+ * Layout:
+ *  - Header: Magic, Version (FDlgHistoryCodec::EVersion), bDelta
+ *  - GUID dictionary: every Dialogue/Node GUID used by the entries, each GUID is written only once
+ *  - Entries: Dialogue GUID index, sorted and delta encoded visited node indices, visited node GUID indices, node data
+ *  All the counts, indices and GUID indices are variable length integers (FArchive::SerializeIntPacked).
+ *
+ * Delta saves only write the entries changed since the last checkpoint (see FDlgMemory::GetDirtyEntries),
+ * loading a delta on top of the memory the previous save/delta was loaded into restores the same memory.
+ * Loading decodes directly into the entries of the memory, there is no intermediate history map.
+ */
+class DLGSYSTEM_API FDlgHistoryCodec
+{
+public:
+	enum class EVersion : int32
+	{
+		Initial = 0,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	// "DLGH"
+	static constexpr uint32 Magic = 0x48474C44;
+
+	// Writes all the entries of the Memory
+	static void SaveMemory(FArchive& Ar, const FDlgMemory& Memory);
+
+	// Writes only the entries changed since the last checkpoint, a full save if the Memory was emptied/replaced since then
+	// bCheckpoint - clears the changes of the Memory after writing them
+	static void SaveMemoryDelta(FArchive& Ar, FDlgMemory& Memory, bool bCheckpoint = true);
+
+	// Reads a full save (Memory is replaced) or a delta (only the entries of the delta are replaced)
+	// The Memory is at a checkpoint after loading.
+	// Return false if the data is not valid, the Memory can be partially loaded in that case
+	static bool LoadMemory(FArchive& Ar, FDlgMemory& Memory);
+
+	// Helpers for byte arrays
+	static TArray<uint8> SaveMemoryToBytes(const FDlgMemory& Memory);
+	static TArray<uint8> SaveMemoryDeltaToBytes(FDlgMemory& Memory, bool bCheckpoint = true);
+	static bool LoadMemoryFromBytes(const TArray<uint8>& Bytes, FDlgMemory& Memory);
+
+private:
+	static void SaveEntries(FArchive& Ar, const FDlgMemory& Memory, const TArray<FGuid>& DialogueGUIDs, bool bDelta);
+};
@@ -16,12 +16,24 @@
 #include "Internationalization/Culture.h"
 #include "Misc/OutputDevice.h"
 #include "Misc/FeedbackContext.h"
+#include "Misc/ScopeRWLock.h"
 
 #include "DlgSystem/NYReflectionHelper.h"
 
 
 DEFINE_LOG_CATEGORY(LogDlgJsonParser);
 
+namespace DlgJsonParser
+{
+	// Property tables of the structs, see FDlgJsonParser::GetPropertyTable.
+	// The struct is kept as a weak pointer so that an entry can never match a new struct allocated at the address of a garbage collected one.
+	static FRWLock PropertyTablesLock;
+	static TMap<TWeakObjectPtr<const UStruct>, TSharedRef<const TMap<FString, FProperty*>, ESPMode::ThreadSafe>> PropertyTables;
+
+	// FNYReflectionHelper::GetPropertyCacheGeneration the tables were built in
+	static int32 PropertyTablesGeneration = INDEX_NONE;
+}
+
 bool GetTextFromObject(const TSharedRef<FJsonObject>& Obj, FText& TextOut)
 {
 	// get the prioritized culture name list
@@ -66,6 +78,49 @@ FString GetStringForJsonType(const EJson Type)
 	}
 }
 
+EJson GetJsonTypeForNotation(const EJsonNotation Notation)
+{
+	switch (Notation)
+	{
+		case EJsonNotation::ObjectStart:
+			return EJson::Object;
+		case EJsonNotation::ArrayStart:
+			return EJson::Array;
+		case EJsonNotation::Boolean:
+			return EJson::Boolean;
+		case EJsonNotation::String:
+			return EJson::String;
+		case EJsonNotation::Number:
+			return EJson::Number;
+		case EJsonNotation::Null:
+			return EJson::Null;
+		default:
+			return EJson::None;
+	}
+}
+
+// Scalar values reused by the streaming reader for every token, see FDlgJsonParser::GetScalarJsonValue
+class FDlgJsonScalarString : public FJsonValueString
+{
+public:
+	FDlgJsonScalarString() : FJsonValueString(FString()) {}
+	void Set(const FString& InValue) { Value = InValue; }
+};
+
+class FDlgJsonScalarNumber : public FJsonValueNumber
+{
+public:
+	FDlgJsonScalarNumber() : FJsonValueNumber(0.0) {}
+	void Set(double InValue) { Value = InValue; }
+};
+
+class FDlgJsonScalarBoolean : public FJsonValueBoolean
+{
+public:
+	FDlgJsonScalarBoolean() : FJsonValueBoolean(false) {}
+	void Set(bool bInValue) { Value = bInValue; }
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void FDlgJsonParser::InitializeParser(const FString& FilePath)
 {
@@ -101,7 +156,14 @@ void FDlgJsonParser::ReadAllProperty( const UStruct* ReferenceClass, void* Targe
 
 	// TODO use DefaultObjectOuter;
 	DefaultObjectOuter = InDefaultObjectOuter;
-	bIsValidFile = JsonObjectStringToUStruct(ReferenceClass, TargetObject);
+	if (bUseStreamingReader)
+	{
+		bIsValidFile = JsonStringToUStructStreaming(ReferenceClass, TargetObject);
+	}
+	else
+	{
+		bIsValidFile = JsonObjectStringToUStruct(ReferenceClass, TargetObject);
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -794,37 +856,16 @@ bool FDlgJsonParser::JsonAttributesToUStruct(const TMap<FString, TSharedPtr<FJso
 		return false;
 	}
 
-	// iterate over the struct properties
-	for (TFieldIterator<FProperty> PropIt(StructDefinition); PropIt; ++PropIt)
+	// iterate over the json attributes
+	// NOTE: the keys of JsonAttributes are case insensitive, so there is at most one attribute for each property
+	const TSharedRef<const FPropertyTable, ESPMode::ThreadSafe> PropertyTable = GetPropertyTable(StructDefinition);
+	for (const auto& Elem : JsonAttributes)
 	{
-		auto* Property = *PropIt;
-		if (!ensure(Property))
-			continue;
-
-		const FString PropertyName = Property->GetName();
-
-		// Check to see if we should ignore this property
-		if (CheckFlags != 0 && !Property->HasAnyPropertyFlags(CheckFlags))
-		{
-			continue;
-		}
-		// TODO skip property
-
-		// Find a JSON value matching this property name
-		TSharedPtr<FJsonValue> JsonValue;
-		for (auto& Elem : JsonAttributes)
-		{
-			// use case insensitive search since FName may change case strangely on us
-			// TODO does this break on struct/classes with properties of similar name?
-			if (PropertyName.Equals(Elem.Key, ESearchCase::IgnoreCase))
-			{
-				JsonValue = Elem.Value;
-				break;
-			}
-		}
-		if (!JsonValue.IsValid())
+		// we allow values to not be found since this mirrors the typical UObject mantra that all the fields are optional when deserializing
+		FProperty* Property = PropertyTable->FindRef(Elem.Key);
+		const TSharedPtr<FJsonValue>& JsonValue = Elem.Value;
+		if (Property == nullptr || !JsonValue.IsValid())
 		{
-			// we allow values to not be found since this mirrors the typical UObject mantra that all the fields are optional when deserializing
 			continue;
 		}
 
@@ -847,7 +888,7 @@ bool FDlgJsonParser::JsonAttributesToUStruct(const TMap<FString, TSharedPtr<FJso
 				LogDlgJsonParser,
 				Error,
 				TEXT("JsonObjectToUStruct - Unable to parse %s.%s from JSON"),
-				*StructDefinition->GetName(), *PropertyName
+				*StructDefinition->GetName(), *Property->GetName()
 			);
 			continue;
 		}
@@ -873,3 +914,667 @@ bool FDlgJsonParser::JsonObjectStringToUStruct(const UStruct* StructDefinition,
 	}
 	return true;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonParser::ConvertScalarJsonReaderToProperty(EJsonNotation Notation, FProperty* Property, void* ContainerPtr, void* ValuePtr)
+{
+	check(Property);
+	if (bLogVerbose)
+	{
+		UE_LOG(LogDlgJsonParser, Verbose, TEXT("ConvertScalarJsonReaderToProperty, Property = `%s`"), *Property->GetPathName());
+	}
+
+	// Scalars are converted the same way as in the DOM
+	const bool bArrayStart = Notation == EJsonNotation::ArrayStart;
+	const bool bObjectStart = Notation == EJsonNotation::ObjectStart;
+	if (!bArrayStart && !bObjectStart)
+	{
+		return ConvertScalarJsonValueToProperty(GetScalarJsonValue(Notation), Property, ContainerPtr, ValuePtr);
+	}
+	if (ValuePtr == nullptr)
+	{
+		// Nothing else to do
+		return SkipJsonValue(Notation);
+	}
+
+	// TArray
+	auto* ArrayProperty = FNYReflectionHelper::CastProperty<FArrayProperty>(Property);
+	if (bArrayStart && ArrayProperty)
+	{
+		FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+		Helper.EmptyValues();
+
+		// set the property values
+		bool bReturnStatus = true;
+		EJsonNotation ItemNotation;
+		while (ReadNextJsonNotation(ItemNotation) && ItemNotation != EJsonNotation::ArrayEnd)
+		{
+			const int32 Index = Helper.AddValue();
+			if (!JsonReaderToProperty(ItemNotation, ArrayProperty->Inner, ContainerPtr, Helper.GetRawPtr(Index)))
+			{
+				bReturnStatus = false;
+				UE_LOG(
+					LogDlgJsonParser,
+					Error,
+					TEXT("ConvertScalarJsonReaderToProperty - Unable to deserialize array element [%d] for property %s"),
+					Index, *Property->GetNameCPP()
+				);
+			}
+		}
+
+		return bReturnStatus && !bJsonReaderFailed;
+	}
+
+	// Set
+	auto* SetProperty = FNYReflectionHelper::CastProperty<FSetProperty>(Property);
+	if (bArrayStart && SetProperty)
+	{
+		FScriptSetHelper Helper(SetProperty, ValuePtr);
+		Helper.EmptyElements();
+
+		// set the property values
+		bool bReturnStatus = true;
+		int32 Index = 0;
+		EJsonNotation ItemNotation;
+		while (ReadNextJsonNotation(ItemNotation) && ItemNotation != EJsonNotation::ArrayEnd)
+		{
+			const int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+			if (!JsonReaderToProperty(ItemNotation, SetProperty->ElementProp, ContainerPtr, Helper.GetElementPtr(NewIndex)))
+			{
+				bReturnStatus = false;
+				UE_LOG(
+					LogDlgJsonParser,
+					Error,
+					TEXT("ConvertScalarJsonReaderToProperty - Unable to deserialize set element [%d] for property %s"),
+					Index,
+					*Property->GetNameCPP()
+				);
+			}
+			Index++;
+		}
+
+		Helper.Rehash();
+		return bReturnStatus && !bJsonReaderFailed;
+	}
+
+	// TMap
+	auto* MapProperty = FNYReflectionHelper::CastProperty<FMapProperty>(Property);
+	if (bObjectStart && MapProperty)
+	{
+		FScriptMapHelper Helper(MapProperty, ValuePtr);
+		Helper.EmptyValues();
+
+		// set the property values
+		bool bReturnStatus = true;
+		EJsonNotation EntryNotation;
+		while (ReadNextJsonNotation(EntryNotation) && EntryNotation != EJsonNotation::ObjectEnd)
+		{
+			const int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+
+			// NOTE if key is a FStructProperty no need to Import the text item here as it will do that below in UStruct
+			// Add key, before reading the value as that changes the identifier
+			const FString Key = JsonReader->GetIdentifier();
+			const bool bKeySuccess = JsonValueToProperty(GetScalarJsonValue(Key), Helper.GetKeyProperty(), ContainerPtr, Helper.GetKeyPtr(NewIndex));
+
+			// Add value
+			const bool bValueSuccess = JsonReaderToProperty(EntryNotation, Helper.GetValueProperty(), ContainerPtr, Helper.GetValuePtr(NewIndex));
+
+			if (!bKeySuccess || !bValueSuccess)
+			{
+				Helper.RemoveAt(NewIndex);
+				bReturnStatus = false;
+				UE_LOG(
+					LogDlgJsonParser,
+					Error,
+					TEXT("ConvertScalarJsonReaderToProperty - Unable to deserialize map element [key: %s] for property %s"),
+					*Key, *Property->GetNameCPP()
+				);
+			}
+		}
+
+		Helper.Rehash();
+		return bReturnStatus && !bJsonReaderFailed;
+	}
+
+	// UStruct, default struct export
+	auto* StructProperty = FNYReflectionHelper::CastProperty<FStructProperty>(Property);
+	if (bObjectStart && StructProperty)
+	{
+		if (!JsonReaderToUStruct(StructProperty->Struct, ValuePtr))
+		{
+			UE_LOG(
+				LogDlgJsonParser,
+				Error,
+				TEXT("ConvertScalarJsonReaderToProperty - JsonReaderToUStruct failed for property %s"),
+				*Property->GetNameCPP()
+			);
+			return false;
+		}
+
+		return true;
+	}
+
+	// UObject
+	auto* ObjectProperty = FNYReflectionHelper::CastProperty<FObjectProperty>(Property);
+	if (bObjectStart && ObjectProperty)
+	{
+		return ConvertJsonReaderToObjectProperty(ObjectProperty, ContainerPtr, ValuePtr);
+	}
+
+	// Everything else is rare (FText from culture keys, mismatched JSON types), convert the DOM of this value
+	const TSharedPtr<FJsonValue> JsonValue = ReadJsonValue(Notation);
+	if (!JsonValue.IsValid())
+	{
+		return false;
+	}
+
+	return ConvertScalarJsonValueToProperty(JsonValue, Property, ContainerPtr, ValuePtr);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonParser::ConvertJsonReaderToObjectProperty(FObjectProperty* ObjectProperty, void* ContainerPtr, void* ValuePtr)
+{
+	// NOTE: The Value here should be a pointer to a pointer
+	// Because the UObjects are pointers, we must deference it. So instead of it being a void** we want it to be a void*
+	auto* ObjectPtrPtr = static_cast<UObject**>(ObjectProperty->ContainerPtrToValuePtr<void>(ValuePtr, 0));
+	if (ObjectPtrPtr == nullptr)
+	{
+		UE_LOG(
+			LogDlgJsonParser,
+			Error,
+			TEXT("PropertyName = `%s` Is a FObjectProperty but can't get non null ContainerPtrToValuePtr from it's StructObject"),
+			*ObjectProperty->GetNameCPP()
+		);
+		SkipJsonValue(EJsonNotation::ObjectStart);
+		return false;
+	}
+
+	// NOTE: We must check one level up to check if it is a nullptr or not
+	// Reset first, if non nullptr
+	const UObject* ContainerObjectPtr = ObjectProperty->GetObjectPropertyValue_InContainer(ContainerPtr);
+	if (ContainerObjectPtr != nullptr)
+	{
+		*ObjectPtrPtr = nullptr;
+	}
+
+	// FDlgJsonWriter writes the type first, otherwise read the whole object
+	const FString SpecialKeyType = TEXT("__type__");
+	EJsonNotation Notation;
+	if (!ReadNextJsonNotation(Notation))
+	{
+		return false;
+	}
+	if (Notation != EJsonNotation::String || !JsonReader->GetIdentifier().Equals(SpecialKeyType, ESearchCase::IgnoreCase))
+	{
+		const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+		if (Notation != EJsonNotation::ObjectEnd)
+		{
+			const FString Identifier = JsonReader->GetIdentifier();
+			const TSharedPtr<FJsonValue> FirstValue = ReadJsonValue(Notation);
+			if (!FirstValue.IsValid())
+			{
+				return false;
+			}
+			JsonObject->Values.Add(Identifier, FirstValue);
+			if (!ReadJsonObjectAttributes(JsonObject->Values))
+			{
+				return false;
+			}
+		}
+
+		return ConvertScalarJsonValueToProperty(MakeShared<FJsonValueObject>(JsonObject), ObjectProperty, ContainerPtr, ValuePtr);
+	}
+
+	//  Create the new Object
+	const FString JsonObjectType = JsonReader->GetValueAsString();
+	const UClass* ObjectClass = ObjectProperty->PropertyClass;
+	const UClass* ChildClass = GetChildClassFromName(ObjectClass, JsonObjectType);
+	if (ChildClass == nullptr)
+	{
+		UE_LOG(
+			LogDlgJsonParser,
+			Error,
+			TEXT("ConvertJsonReaderToObjectProperty - Trying to load by string reference. Could not find class `%s` for FObjectProperty = `%s`. Ignored."),
+			*JsonObjectType, *ObjectProperty->GetNameCPP()
+		);
+		SkipJsonValue(EJsonNotation::ObjectStart);
+		return false;
+	}
+	*ObjectPtrPtr = CreateNewUObject(ChildClass, DefaultObjectOuter);
+
+	// Something is wrong
+	if (*ObjectPtrPtr == nullptr || !(*ObjectPtrPtr)->IsValidLowLevelFast())
+	{
+		UE_LOG(
+			LogDlgJsonParser,
+			Error,
+			TEXT("ConvertJsonReaderToObjectProperty - PropertyName = `%s` Is a FObjectProperty but could not build any valid UObject"),
+			*ObjectProperty->GetNameCPP()
+		);
+		SkipJsonValue(EJsonNotation::ObjectStart);
+		return false;
+	}
+
+	// Read the rest of the json object
+	if (!JsonReaderToUStruct(ObjectClass, *ObjectPtrPtr))
+	{
+		UE_LOG(
+			LogDlgJsonParser,
+			Error,
+			TEXT("ConvertJsonReaderToObjectProperty - JsonReaderToUStruct failed for property %s"),
+			*ObjectProperty->GetNameCPP()
+		);
+		return false;
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonParser::JsonReaderToProperty(EJsonNotation Notation, FProperty* Property, void* ContainerPtr, void* ValuePtr)
+{
+	check(Property);
+	if (bLogVerbose)
+	{
+		UE_LOG(LogDlgJsonParser, Verbose, TEXT("JsonReaderToProperty, Property = `%s`"), *Property->GetPathName());
+	}
+
+	const bool bArrayProperty = Property->IsA<FArrayProperty>();
+	const bool bSetProperty = Property->IsA<FSetProperty>();
+	const bool bJsonArray = Notation == EJsonNotation::ArrayStart;
+
+	// Scalar only one property
+	if (!bJsonArray)
+	{
+		if (bArrayProperty)
+		{
+			UE_LOG(
+				LogDlgJsonParser,
+				Error,
+				TEXT("JsonReaderToProperty - Attempted to import TArray from non-array JSON type = `%s`"),
+				*GetStringForJsonType(GetJsonTypeForNotation(Notation))
+			);
+			SkipJsonValue(Notation);
+			return false;
+		}
+		if (bSetProperty)
+		{
+			UE_LOG(
+				LogDlgJsonParser,
+				Error,
+				TEXT("JsonReaderToProperty - Attempted to import TSet from non-array JSON type = `%s`"),
+				*GetStringForJsonType(GetJsonTypeForNotation(Notation))
+			);
+			SkipJsonValue(Notation);
+			return false;
+		}
+
+		if (Property->ArrayDim != 1)
+		{
+			UE_LOG(LogDlgJsonParser, Warning, TEXT("[Property->ArrayDim != 1] Ignoring excess properties when deserializing %s"), *Property->GetNameCPP());
+		}
+
+		return ConvertScalarJsonReaderToProperty(Notation, Property, ContainerPtr, ValuePtr);
+	}
+
+	// In practice, the ArrayDim == 1 check ought to be redundant, since nested arrays of UPropertys are not supported
+	if ((bArrayProperty || bSetProperty) && Property->ArrayDim == 1)
+	{
+		// Read into TArray/TSet
+		return ConvertScalarJsonReaderToProperty(Notation, Property, ContainerPtr, ValuePtr);
+	}
+
+	// Array
+	// We're deserializing a JSON array into a static array
+	auto* ValueIntPtr = static_cast<uint8*>(ValuePtr);
+	bool bReturnStatus = true;
+	int32 Index = 0;
+	EJsonNotation ItemNotation;
+	while (ReadNextJsonNotation(ItemNotation) && ItemNotation != EJsonNotation::ArrayEnd)
+	{
+		if (Index < Property->ArrayDim)
+		{
+			// ValuePtr + Index * Property->ElementSize is literally FScriptArrayHelper::GetRawPtr
+			bReturnStatus &= ConvertScalarJsonReaderToProperty(ItemNotation, Property, ContainerPtr, ValueIntPtr + Index * Property->ElementSize);
+		}
+		else
+		{
+			bReturnStatus &= SkipJsonValue(ItemNotation);
+		}
+		Index++;
+	}
+	if (Property->ArrayDim < Index)
+	{
+		UE_LOG(LogDlgJsonParser, Warning, TEXT("[Property->ArrayDim < ArrayValue.Num()] Ignoring excess properties when deserializing %s"), *Property->GetNameCPP());
+	}
+
+	return bReturnStatus && !bJsonReaderFailed;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonParser::JsonReaderToUStruct(const UStruct* StructDefinition, void* ContainerPtr)
+{
+	check(StructDefinition);
+	check(ContainerPtr);
+	if (bLogVerbose)
+	{
+		UE_LOG(LogDlgJsonParser, Verbose, TEXT("JsonReaderToUStruct, StructDefinition = `%s`"), *StructDefinition->GetPathName());
+	}
+
+	// Json Wrapper, read the Object
+	if (StructDefinition == FJsonObjectWrapper::StaticStruct())
+	{
+		FJsonObjectWrapper* ProxyObject = (FJsonObjectWrapper *)ContainerPtr;
+		ProxyObject->JsonObject = MakeShared<FJsonObject>();
+		return ReadJsonObjectAttributes(ProxyObject->JsonObject->Values);
+	}
+
+	// Handle UObject inheritance (children of class)
+	if (StructDefinition->IsA<UClass>())
+	{
+		// Structure points to the child
+		const UObject* UnrealObject = static_cast<const UObject*>(ContainerPtr);
+		if (!UnrealObject->IsValidLowLevelFast())
+		{
+			UE_LOG(
+				LogDlgJsonParser,
+				Error,
+				TEXT("JsonReaderToUStruct: StructDefinition = `%s` is a UClass and expected ContainerPtr to be an UObject. Memory corruption?"),
+				*StructDefinition->GetPathName()
+			);
+			SkipJsonValue(EJsonNotation::ObjectStart);
+			return false;
+		}
+		StructDefinition = UnrealObject->GetClass();
+	}
+	if (!StructDefinition->IsValidLowLevelFast())
+	{
+		UE_LOG(
+			LogDlgJsonParser,
+			Error,
+			TEXT("JsonReaderToUStruct: StructDefinition = `%s` is a UClass and expected ContainerPtr.Class to be valid. Memory corruption?"),
+			*StructDefinition->GetPathName()
+		);
+		SkipJsonValue(EJsonNotation::ObjectStart);
+		return false;
+	}
+
+	// iterate over the json attributes
+	const TSharedRef<const FPropertyTable, ESPMode::ThreadSafe> PropertyTable = GetPropertyTable(StructDefinition);
+	EJsonNotation Notation;
+	while (ReadNextJsonNotation(Notation))
+	{
+		if (Notation == EJsonNotation::ObjectEnd)
+		{
+			return true;
+		}
+
+		// we allow values to not be found since this mirrors the typical UObject mantra that all the fields are optional when deserializing
+		FProperty* Property = PropertyTable->FindRef(JsonReader->GetIdentifier());
+		if (Property == nullptr)
+		{
+			if (!SkipJsonValue(Notation))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		void* ValuePtr = nullptr;
+		if (Property->IsA<FObjectProperty>())
+		{
+			// Handle pointers, only allowed to be UObjects (are already pointers to the Value)
+			ValuePtr = ContainerPtr;
+		}
+		else
+		{
+			// Normal non pointer property
+			ValuePtr = Property->ContainerPtrToValuePtr<void>(ContainerPtr, 0);
+		}
+
+		// Convert the value to the Property
+		if (!JsonReaderToProperty(Notation, Property, ContainerPtr, ValuePtr))
+		{
+			if (bJsonReaderFailed)
+			{
+				return false;
+			}
+
+			UE_LOG(
+				LogDlgJsonParser,
+				Error,
+				TEXT("JsonReaderToUStruct - Unable to parse %s.%s from JSON"),
+				*StructDefinition->GetName(), *Property->GetName()
+			);
+		}
+	}
+
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonParser::JsonStringToUStructStreaming(const UStruct* StructDefinition, void* ContainerPtr)
+{
+	JsonReader = TJsonReaderFactory<>::Create(JsonString);
+	bJsonReaderFailed = false;
+	if (!ScalarString.IsValid())
+	{
+		ScalarString = MakeShared<FDlgJsonScalarString>();
+		ScalarNumber = MakeShared<FDlgJsonScalarNumber>();
+		ScalarBoolean = MakeShared<FDlgJsonScalarBoolean>();
+		ScalarNull = MakeShared<FJsonValueNull>();
+	}
+
+	EJsonNotation Notation;
+	bool bSuccess = ReadNextJsonNotation(Notation) && Notation == EJsonNotation::ObjectStart;
+	bSuccess = bSuccess && JsonReaderToUStruct(StructDefinition, ContainerPtr);
+	if (!bSuccess)
+	{
+		UE_LOG(
+			LogDlgJsonParser,
+			Error,
+			TEXT("JsonStringToUStructStreaming - Unable to parse json of file = `%s`. Error = `%s`"),
+			*FileName, *JsonReader->GetErrorMessage()
+		);
+	}
+
+	JsonReader.Reset();
+	return bSuccess;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+FProperty* FDlgJsonParser::FindPropertyForJsonAttribute(const UStruct* StructDefinition, const FString& AttributeName)
+{
+	return GetPropertyTable(StructDefinition)->FindRef(AttributeName);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TSharedRef<const FDlgJsonParser::FPropertyTable, ESPMode::ThreadSafe> FDlgJsonParser::GetPropertyTable(const UStruct* StructDefinition)
+{
+	check(StructDefinition);
+	const int32 Generation = FNYReflectionHelper::GetPropertyCacheGeneration();
+	{
+		FRWScopeLock ReadLock(DlgJsonParser::PropertyTablesLock, SLT_ReadOnly);
+		if (Generation == DlgJsonParser::PropertyTablesGeneration)
+		{
+			if (const auto* TablePtr = DlgJsonParser::PropertyTables.Find(StructDefinition))
+			{
+				return *TablePtr;
+			}
+		}
+	}
+
+	TSharedRef<FPropertyTable, ESPMode::ThreadSafe> PropertyTable = MakeShared<FPropertyTable, ESPMode::ThreadSafe>();
+	for (TFieldIterator<FProperty> PropIt(StructDefinition); PropIt; ++PropIt)
+	{
+		FProperty* Property = *PropIt;
+		if (!ensure(Property))
+			continue;
+
+		// Check to see if we should ignore this property
+		if (CheckFlags != 0 && !Property->HasAnyPropertyFlags(CheckFlags))
+		{
+			continue;
+		}
+
+		// Same as the linear search, the first property with the name wins
+		const FString PropertyName = Property->GetName();
+		if (!PropertyTable->Contains(PropertyName))
+		{
+			PropertyTable->Add(PropertyName, Property);
+		}
+	}
+
+	FRWScopeLock WriteLock(DlgJsonParser::PropertyTablesLock, SLT_Write);
+	if (Generation != DlgJsonParser::PropertyTablesGeneration)
+	{
+		// The properties of the structs might have changed, rebuild all the tables
+		DlgJsonParser::PropertyTables.Empty();
+		DlgJsonParser::PropertyTablesGeneration = Generation;
+	}
+	DlgJsonParser::PropertyTables.Add(StructDefinition, PropertyTable);
+	return PropertyTable;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonParser::ReadNextJsonNotation(EJsonNotation& OutNotation)
+{
+	if (bJsonReaderFailed)
+	{
+		return false;
+	}
+	if (!JsonReader->ReadNext(OutNotation) || OutNotation == EJsonNotation::Error)
+	{
+		bJsonReaderFailed = true;
+		return false;
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonParser::SkipJsonValue(EJsonNotation Notation)
+{
+	bool bSuccess = true;
+	if (Notation == EJsonNotation::ObjectStart)
+	{
+		bSuccess = JsonReader->SkipObject();
+	}
+	else if (Notation == EJsonNotation::ArrayStart)
+	{
+		bSuccess = JsonReader->SkipArray();
+	}
+
+	bJsonReaderFailed |= !bSuccess;
+	return bSuccess;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TSharedPtr<FJsonValue> FDlgJsonParser::ReadJsonValue(EJsonNotation Notation)
+{
+	switch (Notation)
+	{
+		case EJsonNotation::String:
+			return MakeShared<FJsonValueString>(JsonReader->GetValueAsString());
+
+		case EJsonNotation::Number:
+			return MakeShared<FJsonValueNumber>(JsonReader->GetValueAsNumber());
+
+		case EJsonNotation::Boolean:
+			return MakeShared<FJsonValueBoolean>(JsonReader->GetValueAsBoolean());
+
+		case EJsonNotation::Null:
+			return MakeShared<FJsonValueNull>();
+
+		case EJsonNotation::ObjectStart:
+		{
+			const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+			if (!ReadJsonObjectAttributes(JsonObject->Values))
+			{
+				return nullptr;
+			}
+
+			return MakeShared<FJsonValueObject>(JsonObject);
+		}
+
+		case EJsonNotation::ArrayStart:
+		{
+			TArray<TSharedPtr<FJsonValue>> ArrayValue;
+			EJsonNotation ItemNotation;
+			while (ReadNextJsonNotation(ItemNotation) && ItemNotation != EJsonNotation::ArrayEnd)
+			{
+				const TSharedPtr<FJsonValue> ItemValue = ReadJsonValue(ItemNotation);
+				if (!ItemValue.IsValid())
+				{
+					return nullptr;
+				}
+				ArrayValue.Add(ItemValue);
+			}
+			if (bJsonReaderFailed)
+			{
+				return nullptr;
+			}
+
+			return MakeShared<FJsonValueArray>(ArrayValue);
+		}
+
+		default:
+			bJsonReaderFailed = true;
+			return nullptr;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonParser::ReadJsonObjectAttributes(TMap<FString, TSharedPtr<FJsonValue>>& OutJsonAttributes)
+{
+	EJsonNotation Notation;
+	while (ReadNextJsonNotation(Notation))
+	{
+		if (Notation == EJsonNotation::ObjectEnd)
+		{
+			return true;
+		}
+
+		// Reading the value changes the identifier
+		const FString Identifier = JsonReader->GetIdentifier();
+		const TSharedPtr<FJsonValue> Value = ReadJsonValue(Notation);
+		if (!Value.IsValid())
+		{
+			return false;
+		}
+		OutJsonAttributes.Add(Identifier, Value);
+	}
+
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const TSharedPtr<FJsonValue>& FDlgJsonParser::GetScalarJsonValue(EJsonNotation Notation)
+{
+	switch (Notation)
+	{
+		case EJsonNotation::String:
+			return GetScalarJsonValue(JsonReader->GetValueAsString());
+
+		case EJsonNotation::Number:
+			static_cast<FDlgJsonScalarNumber&>(*ScalarNumber).Set(JsonReader->GetValueAsNumber());
+			return ScalarNumber;
+
+		case EJsonNotation::Boolean:
+			static_cast<FDlgJsonScalarBoolean&>(*ScalarBoolean).Set(JsonReader->GetValueAsBoolean());
+			return ScalarBoolean;
+
+		case EJsonNotation::Null:
+			return ScalarNull;
+
+		default:
+			checkNoEntry();
+			return ScalarNull;
+	}
+}
+
+const TSharedPtr<FJsonValue>& FDlgJsonParser::GetScalarJsonValue(const FString& String)
+{
+	static_cast<FDlgJsonScalarString&>(*ScalarString).Set(String);
+	return ScalarString;
+}
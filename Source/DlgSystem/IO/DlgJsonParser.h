@@ -4,6 +4,7 @@
 #include "Logging/LogMacros.h"
 #include "Dom/JsonValue.h"
 #include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
 
 #include "IDlgParser.h"
 #include "DlgSystem/NYEngineVersionHelpers.h"
@@ -28,6 +29,16 @@ class DLGSYSTEM_API FDlgJsonParser : public IDlgParser
 	 *							- ConvertScalarJsonValueToProperty
 	 *								- JsonValueToProperty
 	 *								- JsonObjectToUStruct
+	 *
+	 *  - DlgJsonParser (streaming, see SetUseStreamingReader)
+	 *		- InitializeParser
+	 *			- JsonStringToUStructStreaming
+	 *				- JsonReaderToUStruct
+	 *					- JsonReaderToProperty
+	 *						- ConvertScalarJsonReaderToProperty
+	 *							- ConvertScalarJsonValueToProperty (scalars and the values read into a DOM)
+	 *							- JsonReaderToProperty
+	 *							- JsonReaderToUStruct
 	 */
 
 public:
@@ -44,6 +55,13 @@ public:
 	bool IsValidFile() const override { return bIsValidFile; }
 	void ReadAllProperty(const UStruct* ReferenceClass, void* TargetObject, UObject* DefaultObjectOuter = nullptr) override;
 
+	// bUseStreamingReader:
+	bool IsUsingStreamingReader() const { return bUseStreamingReader; }
+	void SetUseStreamingReader(bool bValue) { bUseStreamingReader = bValue; }
+
+	// Finds the property the JSON attribute is read into (the name is case insensitive), nullptr if there is none
+	static FProperty* FindPropertyForJsonAttribute(const UStruct* StructDefinition, const FString& AttributeName);
+
 
 private: // JSON -> UStruct
 
@@ -100,11 +118,68 @@ private: // JSON -> UStruct
 	 */
 	bool JsonObjectStringToUStruct(const UStruct* StructDefinition, void* ContainerPtr);
 
+private:
+	// Properties of a struct that are read from JSON keyed by their name.
+	// The FString keys of a TMap are case insensitive, use case insensitive search since FName may change case strangely on us.
+	using FPropertyTable = TMap<FString, FProperty*>;
+
+	// The table of StructDefinition, built on first use and cached until the properties can change (see FNYReflectionHelper::ClearPropertyCache)
+	static TSharedRef<const FPropertyTable, ESPMode::ThreadSafe> GetPropertyTable(const UStruct* StructDefinition);
+
+private: // JSON tokens -> UStruct, same results as above without building the DOM of the whole JSON string
+
+	/**
+	 * Same as ConvertScalarJsonValueToProperty for the value that starts at the current token (of type Notation).
+	 * The scalars, and the rare values that need all their attributes at once, are converted with ConvertScalarJsonValueToProperty.
+	 */
+	bool ConvertScalarJsonReaderToProperty(EJsonNotation Notation, FProperty* Property, void* ContainerPtr, void* ValuePtr);
+
+	// Same as ConvertScalarJsonValueToProperty for UObjects, the __type__ is expected to be the first attribute (as FDlgJsonWriter writes it)
+	bool ConvertJsonReaderToObjectProperty(FObjectProperty* ObjectProperty, void* ContainerPtr, void* ValuePtr);
+
+	// Same as JsonValueToProperty for the value that starts at the current token (of type Notation)
+	bool JsonReaderToProperty(EJsonNotation Notation, FProperty* Property, void* ContainerPtr, void* ValuePtr);
+
+	/**
+	 * Same as JsonAttributesToUStruct for the attributes of the object that starts at the current token.
+	 * Reads everything up to and including the end of the object.
+	 */
+	bool JsonReaderToUStruct(const UStruct* StructDefinition, void* ContainerPtr);
+
+	// Same as JsonObjectStringToUStruct
+	bool JsonStringToUStructStreaming(const UStruct* StructDefinition, void* ContainerPtr);
+
+	// Reads the next token, return false on error (see bJsonReaderFailed)
+	bool ReadNextJsonNotation(EJsonNotation& OutNotation);
+
+	// Skips the value that starts at the current token
+	bool SkipJsonValue(EJsonNotation Notation);
+
+	// Builds the DOM of the value that starts at the current token, nullptr on error
+	TSharedPtr<FJsonValue> ReadJsonValue(EJsonNotation Notation);
+	bool ReadJsonObjectAttributes(TMap<FString, TSharedPtr<FJsonValue>>& OutJsonAttributes);
+
+	// The scalar value of the current token, reused for all the tokens so converting it does not allocate a FJsonValue
+	const TSharedPtr<FJsonValue>& GetScalarJsonValue(EJsonNotation Notation);
+	const TSharedPtr<FJsonValue>& GetScalarJsonValue(const FString& String);
+
 private:
 	FString JsonString;
 	FString FileName;
 	bool bIsValidFile = false;
 
+	// Fill the properties from the tokens of the JSON string instead of building the FJsonObject DOM first.
+	// Both give the same result, the DOM takes several times the memory of the string.
+	bool bUseStreamingReader = true;
+
+	// Used only while streaming
+	TSharedPtr<TJsonReader<TCHAR>> JsonReader;
+	bool bJsonReaderFailed = false;
+	TSharedPtr<FJsonValue> ScalarString;
+	TSharedPtr<FJsonValue> ScalarNumber;
+	TSharedPtr<FJsonValue> ScalarBoolean;
+	TSharedPtr<FJsonValue> ScalarNull;
+
 	/** The default object outer used when creating new objects when using NewObject.  */
 	UObject* DefaultObjectOuter = nullptr;
 
@@ -1,9 +1,12 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #include "DlgJsonWriter.h"
 
-#include "JsonObjectConverter.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
 #include "JsonObjectWrapper.h"
 #include "Policies/CondensedJsonPrintPolicy.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
 #include "UObject/UnrealType.h"
 #include "UObject/EnumProperty.h"
 #include "UObject/TextProperty.h"
@@ -14,6 +17,113 @@
 
 DEFINE_LOG_CATEGORY(LogDlgJsonWriter);
 
+namespace DlgJsonWriter
+{
+	// The values inside JSON objects have an Identifier, the ones inside JSON arrays (and the root) do not.
+	// Numbers are always written as doubles, the same as FJsonSerializer does for FJsonValueNumber.
+	template <class WriterType>
+	static void WriteObjectStart(WriterType& Writer, const FString* Identifier)
+	{
+		if (Identifier != nullptr)
+		{
+			Writer.WriteObjectStart(*Identifier);
+		}
+		else
+		{
+			Writer.WriteObjectStart();
+		}
+	}
+
+	template <class WriterType>
+	static void WriteArrayStart(WriterType& Writer, const FString* Identifier)
+	{
+		if (Identifier != nullptr)
+		{
+			Writer.WriteArrayStart(*Identifier);
+		}
+		else
+		{
+			Writer.WriteArrayStart();
+		}
+	}
+
+	template <class WriterType, typename ValueType>
+	static void WriteValue(WriterType& Writer, const FString* Identifier, const ValueType& Value)
+	{
+		if (Identifier != nullptr)
+		{
+			Writer.WriteValue(*Identifier, Value);
+		}
+		else
+		{
+			Writer.WriteValue(Value);
+		}
+	}
+
+	template <class WriterType>
+	static void WriteNull(WriterType& Writer, const FString* Identifier)
+	{
+		if (Identifier != nullptr)
+		{
+			Writer.WriteNull(*Identifier);
+		}
+		else
+		{
+			Writer.WriteNull();
+		}
+	}
+
+	// Writes a value of an FJsonObject, same as FJsonSerializer
+	template <class WriterType>
+	static void WriteJsonValue(WriterType& Writer, const FString* Identifier, const TSharedPtr<FJsonValue>& Value)
+	{
+		if (!Value.IsValid())
+		{
+			return;
+		}
+
+		switch (Value->Type)
+		{
+			case EJson::Null:
+				WriteNull(Writer, Identifier);
+				break;
+
+			case EJson::String:
+				WriteValue(Writer, Identifier, Value->AsString());
+				break;
+
+			case EJson::Number:
+				WriteValue(Writer, Identifier, Value->AsNumber());
+				break;
+
+			case EJson::Boolean:
+				WriteValue(Writer, Identifier, Value->AsBool());
+				break;
+
+			case EJson::Array:
+				WriteArrayStart(Writer, Identifier);
+				for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+				{
+					WriteJsonValue(Writer, nullptr, Element);
+				}
+				Writer.WriteArrayEnd();
+				break;
+
+			case EJson::Object:
+				WriteObjectStart(Writer, Identifier);
+				for (const auto& Pair : Value->AsObject()->Values)
+				{
+					WriteJsonValue(Writer, &Pair.Key, Pair.Value);
+				}
+				Writer.WriteObjectEnd();
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void FDlgJsonWriter::Write(const UStruct* StructDefinition, const void* ContainerPtr)
 {
@@ -24,17 +134,19 @@ void FDlgJsonWriter::Write(const UStruct* StructDefinition, const void* Containe
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-TSharedPtr<FJsonValue> FDlgJsonWriter::ConvertScalarPropertyToJsonValue(const FProperty* Property, const void* const ContainerPtr, const void* const ValuePtr)
+template <class WriterType>
+void FDlgJsonWriter::WriteScalarPropertyValue(WriterType& Writer, const FString* Identifier, const FProperty* Property, const void* const ContainerPtr, const void* const ValuePtr)
 {
 	check(Property);
 	if (bLogVerbose)
 	{
-		UE_LOG(LogDlgJsonWriter, Verbose, TEXT("ConvertScalarPropertyToJsonValue, Property = `%s`"), *Property->GetPathName());
+		UE_LOG(LogDlgJsonWriter, Verbose, TEXT("WriteScalarPropertyValue, Property = `%s`"), *Property->GetPathName());
 	}
 	if (ValuePtr == nullptr)
 	{
 		// Invalid
-		return MakeShared<FJsonValueNull>();
+		DlgJsonWriter::WriteNull(Writer, Identifier);
+		return;
 	}
 
 	//
@@ -44,26 +156,18 @@ TSharedPtr<FJsonValue> FDlgJsonWriter::ConvertScalarPropertyToJsonValue(const FP
 	// This is only a problem if the target class is different from default (like it happens in tests).
 	//
 
-	// Get Json String for Enum definition
-	auto GetJsonStringForEnum = [&ValuePtr](const UEnum* EnumDefinition, const FNumericProperty* NumericProperty) -> TSharedPtr<FJsonValue>
+	// Write Json String for Enum definition
+	auto WriteEnumString = [&Writer, Identifier, &ValuePtr](const UEnum* EnumDefinition, const FNumericProperty* NumericProperty)
 	{
 		const FString StringValue = EnumDefinition->GetNameByIndex(NumericProperty->GetSignedIntPropertyValue(ValuePtr)).ToString();
-		return MakeShared<FJsonValueString>(StringValue);
-	};
-
-	// Add Index Metadata to JsonObject
-	auto AddIndexMetadata = [this, Property](TSharedRef<FJsonObject> JsonObject)
-	{
-		if (IndexInArray != INDEX_NONE && CanWriteIndex(Property))
-		{
-			JsonObject->SetField(TEXT("__index__"), MakeShared<FJsonValueNumber>(IndexInArray));
-		}
+		DlgJsonWriter::WriteValue(Writer, Identifier, StringValue);
 	};
 
 	// Enum, export enums as strings
 	if (const auto* EnumProperty = FNYReflectionHelper::CastProperty<FEnumProperty>(Property))
 	{
-		return GetJsonStringForEnum(EnumProperty->GetEnum(), EnumProperty->GetUnderlyingProperty());
+		WriteEnumString(EnumProperty->GetEnum(), EnumProperty->GetUnderlyingProperty());
+		return;
 	}
 
 	// Numeric, int, float, possible enum
@@ -72,94 +176,82 @@ TSharedPtr<FJsonValue> FDlgJsonWriter::ConvertScalarPropertyToJsonValue(const FP
 		// See if it's an enum Numeric property
 		if (UEnum* EnumDef = NumericProperty->GetIntPropertyEnum())
 		{
-			return GetJsonStringForEnum(EnumDef, NumericProperty);
+			WriteEnumString(EnumDef, NumericProperty);
+			return;
 		}
 
 		// We want to export numbers as numbers
 		if (NumericProperty->IsInteger())
 		{
-			if (bIsPropertyMapKey)
-			{
-				// NOTE, because JSON only supports floats we do not use the FJsonValueNumber for map keys because integers
-				// are displayed as floats. For example '42' is displayed as '42.0'
-				// Instead we use it as a string, this should be similar as the parser can parse an int from string
-				return MakeShared<FJsonValueString>(FString::Printf(TEXT("%lld"), NumericProperty->GetSignedIntPropertyValue(ValuePtr)));
-			}
-
-			return MakeShared<FJsonValueNumber>(NumericProperty->GetSignedIntPropertyValue(ValuePtr));
+			DlgJsonWriter::WriteValue(Writer, Identifier, static_cast<double>(NumericProperty->GetSignedIntPropertyValue(ValuePtr)));
+			return;
 		}
 		if (NumericProperty->IsFloatingPoint())
 		{
-			return MakeShared<FJsonValueNumber>(NumericProperty->GetFloatingPointPropertyValue(ValuePtr));
+			DlgJsonWriter::WriteValue(Writer, Identifier, static_cast<double>(NumericProperty->GetFloatingPointPropertyValue(ValuePtr)));
+			return;
 		}
 
 		// Invalid
-		return MakeShared<FJsonValueNull>();
+		DlgJsonWriter::WriteNull(Writer, Identifier);
+		return;
 	}
 
 	// Bool, Export bools as JSON bools
 	if (const auto* BoolProperty = FNYReflectionHelper::CastProperty<FBoolProperty>(Property))
 	{
-		return MakeShared<FJsonValueBoolean>(BoolProperty->GetOptionalPropertyValue(ValuePtr));
+		DlgJsonWriter::WriteValue(Writer, Identifier, BoolProperty->GetOptionalPropertyValue(ValuePtr));
+		return;
 	}
 
 	// FString
 	if (const auto* StringProperty = FNYReflectionHelper::CastProperty<FStrProperty>(Property))
 	{
-		return MakeShared<FJsonValueString>(StringProperty->GetOptionalPropertyValue(ValuePtr));
+		DlgJsonWriter::WriteValue(Writer, Identifier, StringProperty->GetOptionalPropertyValue(ValuePtr));
+		return;
 	}
 
 	// FName
 	if (const auto* NameProperty = FNYReflectionHelper::CastProperty<FNameProperty>(Property))
 	{
 		auto* NamePtr = static_cast<const FName*>(ValuePtr);
-		if (NamePtr == nullptr)
-		{
-			UE_LOG(LogDlgJsonWriter,
-				   Error,
-				   TEXT("Got Property = `%s` of type FNameProperty but the Value it not an FName"),
-				   *NameProperty->GetName())
-			return MakeShared<FJsonValueNull>();
-		}
 		if (!NamePtr->IsValidIndexFast() || !NamePtr->IsValid())
 		{
 			UE_LOG(LogDlgJsonWriter, Error, TEXT("Got Property = `%s` of type FName but it is not valid :("), *NameProperty->GetNameCPP())
-			return MakeShared<FJsonValueNull>();
+			DlgJsonWriter::WriteNull(Writer, Identifier);
+			return;
 		}
-		//check(NamePtr == NameProperty->GetPropertyValuePtr(Value));
-		return MakeShared<FJsonValueString>(NamePtr->ToString());
+		DlgJsonWriter::WriteValue(Writer, Identifier, NamePtr->ToString());
+		return;
 	}
 
 	// FText
 	if (const auto* TextProperty = FNYReflectionHelper::CastProperty<FTextProperty>(Property))
 	{
-		return MakeShared<FJsonValueString>(TextProperty->GetOptionalPropertyValue(ValuePtr).ToString());
+		DlgJsonWriter::WriteValue(Writer, Identifier, TextProperty->GetOptionalPropertyValue(ValuePtr).ToString());
+		return;
 	}
 
 	// TArray
 	if (const auto* ArrayProperty = FNYReflectionHelper::CastProperty<FArrayProperty>(Property))
 	{
-		TArray<TSharedPtr<FJsonValue>> Array;
+		DlgJsonWriter::WriteArrayStart(Writer, Identifier);
 		const FDlgConstScriptArrayHelper Helper(ArrayProperty, ValuePtr);
 		for (int32 Index = 0, Num = Helper.Num(); Index < Num; Index++)
 		{
 			IndexInArray = Index;
-			TSharedPtr<FJsonValue> Elem = PropertyToJsonValue(ArrayProperty->Inner, ContainerPtr, Helper.GetConstRawPtr(Index));
-			if (Elem.IsValid())
-			{
-				// add to the array
-				Array.Push(Elem);
-			}
+			WritePropertyValue(Writer, nullptr, ArrayProperty->Inner, ContainerPtr, Helper.GetConstRawPtr(Index));
 		}
+		Writer.WriteArrayEnd();
 
 		ResetState();
-		return MakeShared<FJsonValueArray>(Array);
+		return;
 	}
 
 	// TSet
 	if (const auto* SetProperty = FNYReflectionHelper::CastProperty<FSetProperty>(Property))
 	{
-		TArray<TSharedPtr<FJsonValue>> Array;
+		DlgJsonWriter::WriteArrayStart(Writer, Identifier);
 		const FScriptSetHelper Helper(SetProperty, ValuePtr);
 
 		// GetMaxIndex() instead of Num() - the container is not contiguous
@@ -172,24 +264,25 @@ TSharedPtr<FJsonValue> FDlgJsonWriter::ConvertScalarPropertyToJsonValue(const FP
 			}
 
 			IndexInArray = Index;
-			TSharedPtr<FJsonValue> Elem = PropertyToJsonValue(SetProperty->ElementProp, ContainerPtr, Helper.GetElementPtr(Index));
-			if (Elem.IsValid())
-			{
-				// add to the array
-				Array.Push(Elem);
-			}
+			WritePropertyValue(Writer, nullptr, SetProperty->ElementProp, ContainerPtr, Helper.GetElementPtr(Index));
 		}
+		Writer.WriteArrayEnd();
 
 		ResetState();
-		return MakeShared<FJsonValueArray>(Array);
+		return;
 	}
 
 	// TMap
 	if (const auto* MapProperty = FNYReflectionHelper::CastProperty<FMapProperty>(Property))
 	{
-		const TSharedRef<FJsonObject> OutObject = MakeShared<FJsonObject>();
 		const FDlgConstScriptMapHelper Helper(MapProperty, ValuePtr);
 
+		// The keys are the attribute names, the JSON object attributes are case insensitive so keys that only differ in case
+		// are written once, at the position of the first one but with the name and the value of the last one.
+		TArray<TPair<FString, int32>> Attributes;
+		TMap<FString, int32> AttributesIndices;
+		Attributes.Reserve(Helper.Num());
+
 		// GetMaxIndex() instead of Num() - the container is not contiguous
 		// elements are in [0, GetMaxIndex[, some of them are invalid (Num() returns with the valid element num)
 		for (int32 Index = 0; Index < Helper.GetMaxIndex(); Index++)
@@ -198,59 +291,29 @@ TSharedPtr<FJsonValue> FDlgJsonWriter::ConvertScalarPropertyToJsonValue(const FP
 			{
 				continue;
 			}
-			IndexInArray = Index;
-
-			bIsPropertyMapKey = true;
-			const uint8* MapKeyPtr = Helper.GetConstKeyPtr(Index);
-			const TSharedPtr<FJsonValue> KeyElement = PropertyToJsonValue(Helper.GetKeyProperty(), ContainerPtr, MapKeyPtr);
-
-			bIsPropertyMapKey = false;
-			const uint8* MapValuePtr = Helper.GetConstValuePtr(Index);
-			const TSharedPtr<FJsonValue> ValueElement = PropertyToJsonValue(Helper.GetValueProperty(), ContainerPtr, MapValuePtr);
 
-			if (KeyElement.IsValid() && ValueElement.IsValid())
+			FString KeyString = GetMapKeyString(MapProperty, ContainerPtr, Helper.GetConstKeyPtr(Index), Index);
+			if (const int32* AttributeIndex = AttributesIndices.Find(KeyString))
 			{
-				check(MapKeyPtr);
-
-				FString KeyString;
-				if (auto* KeyStructProperty = FNYReflectionHelper::CastProperty<FStructProperty>(MapProperty->KeyProp))
-				{
-					// Key is a struct
-#if NY_ENGINE_VERSION >= 501
-					MapProperty->KeyProp->ExportTextItem_Direct(KeyString, MapKeyPtr, MapKeyPtr, nullptr, PPF_None);
-#else
-					MapProperty->KeyProp->ExportTextItem(KeyString, MapKeyPtr, MapKeyPtr, nullptr, PPF_None);
-#endif
-				}
-				else
-				{
-					// Default to key string
-					KeyString = KeyElement->AsString();
-				}
-
-				// Fallback for anything else, what could this be :O
-				if (KeyString.IsEmpty())
-				{
-
-#if NY_ENGINE_VERSION >= 501
-					MapProperty->KeyProp->ExportTextItem_Direct(KeyString, MapKeyPtr, MapKeyPtr, nullptr, PPF_None);
-#else
-					MapProperty->KeyProp->ExportTextItem(KeyString, MapKeyPtr, MapKeyPtr, nullptr, PPF_None);
-#endif
-
-					if (KeyString.IsEmpty())
-					{
-						UE_LOG(LogDlgJsonWriter, Error, TEXT("Unable to convert key to string for property `%s`."), *MapProperty->GetNameCPP())
-						KeyString = FString::Printf(TEXT("Unparsed Key %d"), Index);
-					}
-				}
-
-				OutObject->SetField(KeyString, ValueElement);
+				Attributes[*AttributeIndex] = TPair<FString, int32>(MoveTemp(KeyString), Index);
 			}
+			else
+			{
+				AttributesIndices.Add(KeyString, Attributes.Num());
+				Attributes.Emplace(MoveTemp(KeyString), Index);
+			}
+		}
+
+		DlgJsonWriter::WriteObjectStart(Writer, Identifier);
+		for (const TPair<FString, int32>& Attribute : Attributes)
+		{
+			IndexInArray = Attribute.Value;
+			WritePropertyValue(Writer, &Attribute.Key, Helper.GetValueProperty(), ContainerPtr, Helper.GetConstValuePtr(Attribute.Value));
 		}
+		Writer.WriteObjectEnd();
 
 		ResetState();
-		return MakeShared<FJsonValueObject>(OutObject);
+		return;
 	}
 
 	// UStruct
@@ -263,33 +326,32 @@ TSharedPtr<FJsonValue> FDlgJsonWriter::ConvertScalarPropertyToJsonValue(const FP
 			// Export to native text
 			FString OutValueStr;
 			TheCppStructOps->ExportTextItem(OutValueStr, ValuePtr, ValuePtr, nullptr, PPF_None, nullptr);
-			return MakeShared<FJsonValueString>(OutValueStr);
+			DlgJsonWriter::WriteValue(Writer, Identifier, OutValueStr);
+			return;
 		}
 
 		// Handle Struct
-		TSharedRef<FJsonObject> OutObject = MakeShared<FJsonObject>();
-		AddIndexMetadata(OutObject);
-		if (UStructToJsonObject(StructProperty->Struct, ValuePtr, OutObject))
+		if (!WriteUStruct(Writer, Identifier, Property, StructProperty->Struct, ValuePtr))
 		{
-			return MakeShared<FJsonValueObject>(OutObject);
+			// Invalid
+			DlgJsonWriter::WriteNull(Writer, Identifier);
 		}
-
-		// Invalid
-		return MakeShared<FJsonValueNull>();
+		return;
 	}
 
 	// UObject
 	if (const auto* ObjectProperty = FNYReflectionHelper::CastProperty<FObjectProperty>(Property))
 	{
-		auto returnNullptr = [this, &ObjectProperty]() -> TSharedPtr<FJsonValue>
+		auto WriteNullptr = [this, &Writer, Identifier, &ObjectProperty]()
 		{
 			// Save reference as empty string
 			if (CanSaveAsReference(ObjectProperty, nullptr))
 			{
-				return MakeShared<FJsonValueString>(TEXT(""));
+				DlgJsonWriter::WriteValue(Writer, Identifier, FString());
+				return;
 			}
 
-			return MakeShared<FJsonValueNull>();
+			DlgJsonWriter::WriteNull(Writer, Identifier);
 		};
 
 		// NOTE: The ValuePtr here should be a pointer to a pointer
@@ -310,7 +372,8 @@ TSharedPtr<FJsonValue> FDlgJsonWriter::ConvertScalarPropertyToJsonValue(const FP
 					*Property->GetPathName()
 				);
 			}
-			return returnNullptr();
+			WriteNullptr();
+			return;
 		}
 		if (!ObjectPtr->IsValidLowLevelFast())
 		{
@@ -321,28 +384,25 @@ TSharedPtr<FJsonValue> FDlgJsonWriter::ConvertScalarPropertyToJsonValue(const FP
 				TEXT("ObjectPtr.IsValidLowLevelFast is false for Property = `%s`. Memory corruption for UObjects?"),
 				*Property->GetPathName()
 			);
-			return returnNullptr();
+			WriteNullptr();
+			return;
 		}
 
 		// Special case were we want just to save a reference to the object location
-		if (ObjectPtr != nullptr && CanSaveAsReference(ObjectProperty, ObjectPtr))
+		if (CanSaveAsReference(ObjectProperty, ObjectPtr))
 		{
-			return MakeShared<FJsonValueString>(ObjectPtr->GetPathName());
+			DlgJsonWriter::WriteValue(Writer, Identifier, ObjectPtr->GetPathName());
+			return;
 		}
 
-		// Save as normal JSON Object
-		TSharedRef<FJsonObject> OutObject = MakeShared<FJsonObject>();
-		AddIndexMetadata(OutObject);
-
-		// Set the uproperties of the object
+		// Save as normal JSON Object, with the uproperties of the object
 		const UClass* ObjectClass = ObjectProperty->PropertyClass;
-		if (UStructToJsonObject(ObjectClass, ObjectPtr, OutObject))
+		if (!WriteUStruct(Writer, Identifier, Property, ObjectClass, ObjectPtr))
 		{
-			return MakeShared<FJsonValueObject>(OutObject);
+			// Invalid
+			DlgJsonWriter::WriteNull(Writer, Identifier);
 		}
-
-		// Invalid
-		return MakeShared<FJsonValueNull>();
+		return;
 	}
 
 	// Default, convert to string
@@ -353,16 +413,17 @@ TSharedPtr<FJsonValue> FDlgJsonWriter::ConvertScalarPropertyToJsonValue(const FP
 	Property->ExportTextItem(ValueString, ValuePtr, ValuePtr, nullptr, PPF_None);
 #endif
 
-	return MakeShared<FJsonValueString>(ValueString);
+	DlgJsonWriter::WriteValue(Writer, Identifier, ValueString);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-TSharedPtr<FJsonValue> FDlgJsonWriter::PropertyToJsonValue(const FProperty* Property, const void* const ContainerPtr, const void* const ValuePtr)
+template <class WriterType>
+void FDlgJsonWriter::WritePropertyValue(WriterType& Writer, const FString* Identifier, const FProperty* Property, const void* const ContainerPtr, const void* const ValuePtr)
 {
 	check(Property);
 	if (bLogVerbose)
 	{
-		UE_LOG(LogDlgJsonWriter, Verbose, TEXT("PropertyToJsonValue, Property = `%s`"), *Property->GetPathName());
+		UE_LOG(LogDlgJsonWriter, Verbose, TEXT("WritePropertyValue, Property = `%s`"), *Property->GetPathName());
 	}
 
 	if (ContainerPtr == nullptr || ValuePtr == nullptr)
@@ -376,7 +437,7 @@ TSharedPtr<FJsonValue> FDlgJsonWriter::PropertyToJsonValue(const FProperty* Prop
 				UE_LOG(
 					LogDlgJsonWriter,
 					Verbose,
-					TEXT("UStructToJsonObject - Unhandled property type Class = '%s', Name = `%s`. (NOTE: UObjects can be nullptrs)"),
+					TEXT("WritePropertyValue - Unhandled property type Class = '%s', Name = `%s`. (NOTE: UObjects can be nullptrs)"),
 					*PropertyClass->GetName(), *Property->GetPathName()
 				);
 			}
@@ -386,95 +447,96 @@ TSharedPtr<FJsonValue> FDlgJsonWriter::PropertyToJsonValue(const FProperty* Prop
 			UE_LOG(
 				LogDlgJsonWriter,
 				Error,
-				TEXT("UStructToJsonObject - Unhandled property type Class = '%s', Name = `%s`"),
+				TEXT("WritePropertyValue - Unhandled property type Class = '%s', Name = `%s`"),
 				*PropertyClass->GetName(), *Property->GetNameCPP()
 			);
 		}
 
-		return MakeShared<FJsonValueNull>();
+		DlgJsonWriter::WriteNull(Writer, Identifier);
+		return;
 	}
 
 	// Scalar Only one property
 	if (Property->ArrayDim == 1)
 	{
-		return ConvertScalarPropertyToJsonValue(Property, ContainerPtr, ValuePtr);
+		WriteScalarPropertyValue(Writer, Identifier, Property, ContainerPtr, ValuePtr);
+		return;
 	}
 
 	// Array
 	// NOTE: we can't use here ArrayHelper, because then we might also need to use SetHelper, more code, meh
-	TArray<TSharedPtr<FJsonValue>> Array;
+	DlgJsonWriter::WriteArrayStart(Writer, Identifier);
 	auto* ValueIntPtr = static_cast<const uint8*>(ValuePtr);
 	for (int Index = 0; Index < Property->ArrayDim; Index++)
 	{
 		IndexInArray = Index;
 
 		// ValuePtr + Index * Property->ElementSize is literally FScriptArrayHelper::GetRawPtr
-		const TSharedPtr<FJsonValue> JsonValue = ConvertScalarPropertyToJsonValue(Property, ContainerPtr, ValueIntPtr + Index * Property->ElementSize);
-		if (JsonValue.IsValid())
-		{
-			Array.Add(JsonValue);
-		}
+		WriteScalarPropertyValue(Writer, nullptr, Property, ContainerPtr, ValueIntPtr + Index * Property->ElementSize);
 	}
+	Writer.WriteArrayEnd();
 
 	ResetState();
-	return MakeShared<FJsonValueArray>(Array);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-bool FDlgJsonWriter::UStructToJsonAttributes(const UStruct* StructDefinition, const void* const ContainerPtr, TMap<FString, TSharedPtr<FJsonValue>>& OutJsonAttributes)
+template <class WriterType>
+bool FDlgJsonWriter::WriteUStruct(WriterType& Writer, const FString* Identifier, const FProperty* Property, const UStruct* StructDefinition, const void* const ContainerPtr)
 {
-	if (StructDefinition == nullptr || ContainerPtr == nullptr)
+	// Checked before anything is written so that the caller can still write something else instead
+	const UStruct* ChildStructDefinition = nullptr;
+	if (!CheckUStruct(StructDefinition, ContainerPtr, ChildStructDefinition))
 	{
 		return false;
 	}
-	if (bLogVerbose)
-	{
-		UE_LOG(LogDlgJsonWriter, Verbose, TEXT("UStructToJsonAttributes, StructDefinition = `%s`"), *StructDefinition->GetPathName());
-	}
+
+	DlgJsonWriter::WriteObjectStart(Writer, Identifier);
+	const bool bWriteIndex = Property != nullptr && IndexInArray != INDEX_NONE && CanWriteIndex(Property);
 
 	// Json Wrapper, already have an Object
 	if (StructDefinition == FJsonObjectWrapper::StaticStruct())
 	{
-		// Just copy it into the object
+		// Just copy it into the object, it replaces the index
 		const FJsonObjectWrapper* ProxyObject = static_cast<const FJsonObjectWrapper*>(ContainerPtr);
 		if (ProxyObject->JsonObject.IsValid())
 		{
-			OutJsonAttributes = ProxyObject->JsonObject->Values;
+			for (const auto& Pair : ProxyObject->JsonObject->Values)
+			{
+				DlgJsonWriter::WriteJsonValue(Writer, &Pair.Key, Pair.Value);
+			}
+		}
+		else if (bWriteIndex)
+		{
+			Writer.WriteValue(TEXT("__index__"), static_cast<double>(IndexInArray));
 		}
-
-		return true;
 	}
-
-	// Handle UObject inheritance (children of class)
-	if (StructDefinition->IsA<UClass>())
+	else
 	{
-		const UObject* UnrealObject = static_cast<const UObject*>(ContainerPtr);
-		if (!UnrealObject->IsValidLowLevelFast())
+		if (bWriteIndex)
 		{
-			UE_LOG(
-				LogDlgJsonWriter,
-				Error,
-				TEXT("UStructToJsonObject: StructDefinition = `%s` is a UClass and expected ContainerPtr to be an UObject. Memory corruption?"),
-				*StructDefinition->GetPathName()
-			);
-			return false;
+			Writer.WriteValue(TEXT("__index__"), static_cast<double>(IndexInArray));
 		}
 
 		// Write type, Objects because they can have inheritance
-		OutJsonAttributes.Add(TEXT("__type__"), MakeShared<FJsonValueString>(UnrealObject->GetClass()->GetName()));
+		if (StructDefinition->IsA<UClass>())
+		{
+			Writer.WriteValue(TEXT("__type__"), ChildStructDefinition->GetName());
+		}
 
-		// Structure points to the child
-		StructDefinition = UnrealObject->GetClass();
+		WriteUStructAttributes(Writer, ChildStructDefinition, ContainerPtr);
 	}
-	if (!StructDefinition->IsValidLowLevelFast())
+
+	Writer.WriteObjectEnd();
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <class WriterType>
+void FDlgJsonWriter::WriteUStructAttributes(WriterType& Writer, const UStruct* StructDefinition, const void* const ContainerPtr)
+{
+	if (bLogVerbose)
 	{
-		UE_LOG(
-			LogDlgJsonWriter,
-			Error,
-			TEXT("UStructToJsonObject: StructDefinition = `%s` is a UClass and expected ContainerPtr.Class to be valid. Memory corruption?"),
-			*StructDefinition->GetPathName()
-		);
-		return false;
+		UE_LOG(LogDlgJsonWriter, Verbose, TEXT("WriteUStructAttributes, StructDefinition = `%s`"), *StructDefinition->GetPathName());
 	}
 
 	// Iterate over all the properties of the struct
@@ -517,72 +579,164 @@ bool FDlgJsonWriter::UStructToJsonAttributes(const UStruct* StructDefinition, co
 			ValuePtr = Property->ContainerPtrToValuePtr<void>(ContainerPtr, 0);
 		}
 
-		// convert the property to a FJsonValue
-		const TSharedPtr<FJsonValue> JsonValue = PropertyToJsonValue(Property, ContainerPtr, ValuePtr);
-		if (!JsonValue.IsValid())
-		{
-			const auto* PropertyClass = Property->GetClass();
-			if (Property->IsA<FObjectProperty>())
-			{
-				// Object property, can be nullptr
-				if (bLogVerbose)
-				{
-					UE_LOG(
-						LogDlgJsonWriter,
-						Verbose,
-						TEXT("UStructToJsonObject - Unhandled property, Class = `%s`, Name =`%s`, inside Struct = `%s`. (NOTE: UObjects can be nullptrs)"),
-						*PropertyClass->GetName(), *Property->GetPathName(), *StructDefinition->GetPathName()
-					);
-				}
-			}
-			else
-			{
-				UE_LOG(
-					LogDlgJsonWriter,
-					Warning,
-					TEXT("UStructToJsonObject - Unhandled property, Class = `%s`, Name =`%s`, inside Struct = `%s`"),
-					*PropertyClass->GetName(), *Property->GetPathName(), *StructDefinition->GetPathName()
-				);
-			}
+		// write the property as the value of the output object
+		// NOTE default JSON writer makes the first letter to be lowercase, we do not want that ;) FJsonObjectConverter::StandardizeCase
+		const FString VariableName = Property->GetName();
+		WritePropertyValue(Writer, &VariableName, Property, ContainerPtr, ValuePtr);
+	}
+}
 
-			continue;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonWriter::CheckUStruct(const UStruct* StructDefinition, const void* const ContainerPtr, const UStruct*& OutStructDefinition)
+{
+	OutStructDefinition = StructDefinition;
+	if (StructDefinition == nullptr || ContainerPtr == nullptr)
+	{
+		return false;
+	}
+
+	// Json Wrapper, already have an Object
+	if (StructDefinition == FJsonObjectWrapper::StaticStruct())
+	{
+		return true;
+	}
+
+	// Handle UObject inheritance (children of class)
+	if (StructDefinition->IsA<UClass>())
+	{
+		const UObject* UnrealObject = static_cast<const UObject*>(ContainerPtr);
+		if (!UnrealObject->IsValidLowLevelFast())
+		{
+			UE_LOG(
+				LogDlgJsonWriter,
+				Error,
+				TEXT("WriteUStruct: StructDefinition = `%s` is a UClass and expected ContainerPtr to be an UObject. Memory corruption?"),
+				*StructDefinition->GetPathName()
+			);
+			return false;
 		}
 
-		// set the value on the output object
-		// NOTE default JSON writer makes the first letter to be lowercase, we do not want that ;) FJsonObjectConverter::StandardizeCase
-		const FString VariableName = Property->GetName();
-		OutJsonAttributes.Add(VariableName, JsonValue);
+		// Structure points to the child
+		OutStructDefinition = UnrealObject->GetClass();
+	}
+	if (!OutStructDefinition->IsValidLowLevelFast())
+	{
+		UE_LOG(
+			LogDlgJsonWriter,
+			Error,
+			TEXT("WriteUStruct: StructDefinition = `%s` is a UClass and expected ContainerPtr.Class to be valid. Memory corruption?"),
+			*StructDefinition->GetPathName()
+		);
+		return false;
 	}
 
 	return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-template<class CharType, class PrintPolicy>
-bool UStructToJsonStringInternal(const TSharedRef<FJsonObject>& JsonObject, const int32 InitialIndent, FString& OutJsonString)
+FString FDlgJsonWriter::GetMapKeyString(const FMapProperty* MapProperty, const void* const ContainerPtr, const void* const KeyPtr, int32 Index)
+{
+	check(KeyPtr);
+	const FProperty* KeyProperty = MapProperty->KeyProp;
+
+	// The string of the key as a JSON value (see FJsonValue::AsString), empty if it is not a JSON string, number or bool
+	FString KeyString;
+	if (const auto* EnumProperty = FNYReflectionHelper::CastProperty<FEnumProperty>(KeyProperty))
+	{
+		KeyString = EnumProperty->GetEnum()->GetNameByIndex(EnumProperty->GetUnderlyingProperty()->GetSignedIntPropertyValue(KeyPtr)).ToString();
+	}
+	else if (const auto* NumericProperty = FNYReflectionHelper::CastProperty<FNumericProperty>(KeyProperty))
+	{
+		if (UEnum* EnumDef = NumericProperty->GetIntPropertyEnum())
+		{
+			KeyString = EnumDef->GetNameByIndex(NumericProperty->GetSignedIntPropertyValue(KeyPtr)).ToString();
+		}
+		else if (NumericProperty->IsInteger())
+		{
+			// NOTE, because JSON only supports floats we do not use the number string for integer keys because integers
+			// are displayed as floats. For example '42' is displayed as '42.0'
+			// Instead we use it as a string, this should be similar as the parser can parse an int from string
+			KeyString = FString::Printf(TEXT("%lld"), NumericProperty->GetSignedIntPropertyValue(KeyPtr));
+		}
+		else if (NumericProperty->IsFloatingPoint())
+		{
+			KeyString = FJsonValueNumber(NumericProperty->GetFloatingPointPropertyValue(KeyPtr)).AsString();
+		}
+	}
+	else if (const auto* BoolProperty = FNYReflectionHelper::CastProperty<FBoolProperty>(KeyProperty))
+	{
+		KeyString = FJsonValueBoolean(BoolProperty->GetOptionalPropertyValue(KeyPtr)).AsString();
+	}
+	else if (const auto* StringProperty = FNYReflectionHelper::CastProperty<FStrProperty>(KeyProperty))
+	{
+		KeyString = StringProperty->GetOptionalPropertyValue(KeyPtr);
+	}
+	else if (FNYReflectionHelper::CastProperty<FNameProperty>(KeyProperty))
+	{
+		const FName* NamePtr = static_cast<const FName*>(KeyPtr);
+		if (NamePtr->IsValidIndexFast() && NamePtr->IsValid())
+		{
+			KeyString = NamePtr->ToString();
+		}
+	}
+	else if (const auto* TextProperty = FNYReflectionHelper::CastProperty<FTextProperty>(KeyProperty))
+	{
+		KeyString = TextProperty->GetOptionalPropertyValue(KeyPtr).ToString();
+	}
+	else if (const auto* ObjectProperty = FNYReflectionHelper::CastProperty<FObjectProperty>(KeyProperty))
+	{
+		// Only the references are strings, see WriteScalarPropertyValue
+		const UObject* ObjectPtr = ObjectProperty->GetObjectPropertyValue_InContainer(KeyPtr);
+		const UObject* ContainerObjectPtr = ObjectProperty->GetObjectPropertyValue_InContainer(ContainerPtr);
+		if (ObjectPtr != nullptr && ContainerObjectPtr != nullptr && ObjectPtr->IsValidLowLevelFast() && CanSaveAsReference(ObjectProperty, ObjectPtr))
+		{
+			KeyString = ObjectPtr->GetPathName();
+		}
+	}
+
+	// Key is a struct or the fallback for anything else, what could this be :O
+	if (KeyString.IsEmpty())
+	{
+#if NY_ENGINE_VERSION >= 501
+		KeyProperty->ExportTextItem_Direct(KeyString, KeyPtr, KeyPtr, nullptr, PPF_None);
+#else
+		KeyProperty->ExportTextItem(KeyString, KeyPtr, KeyPtr, nullptr, PPF_None);
+#endif
+
+		if (KeyString.IsEmpty())
+		{
+			UE_LOG(LogDlgJsonWriter, Error, TEXT("Unable to convert key to string for property `%s`."), *MapProperty->GetNameCPP())
+			KeyString = FString::Printf(TEXT("Unparsed Key %d"), Index);
+		}
+	}
+
+	return KeyString;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <class PrintPolicy>
+bool FDlgJsonWriter::UStructToJsonStringInternal(const UStruct* StructDefinition, const void* const ContainerPtr, const int32 InitialIndent, FString& OutJsonString)
 {
-	TSharedRef<TJsonWriter<CharType, PrintPolicy>> JsonWriter =
-			TJsonWriterFactory<CharType, PrintPolicy>::Create(&OutJsonString, InitialIndent);
-	const bool bSuccess = FJsonSerializer::Serialize(JsonObject, JsonWriter);
-	JsonWriter->Close();
-	return bSuccess;
+	TSharedRef<TJsonWriter<TCHAR, PrintPolicy>> JsonWriter = TJsonWriterFactory<TCHAR, PrintPolicy>::Create(&OutJsonString, InitialIndent);
+	const bool bSuccess = WriteUStruct(*JsonWriter, nullptr, nullptr, StructDefinition, ContainerPtr);
+	return JsonWriter->Close() && bSuccess;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool FDlgJsonWriter::UStructToJsonString(const UStruct* StructDefinition, const void* const ContainerPtr,
 	 const DlgJsonWriterOptions& Options, FString& OutJsonString)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
-	if (UStructToJsonObject(StructDefinition, ContainerPtr, JsonObject))
+	const UStruct* ChildStructDefinition = nullptr;
+	if (CheckUStruct(StructDefinition, ContainerPtr, ChildStructDefinition))
 	{
 		bool bSuccess;
 		if (Options.bPrettyPrint)
 		{
-			bSuccess = UStructToJsonStringInternal<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>(JsonObject, Options.InitialIndent, OutJsonString);
+			bSuccess = UStructToJsonStringInternal<TPrettyJsonPrintPolicy<TCHAR>>(StructDefinition, ContainerPtr, Options.InitialIndent, OutJsonString);
 		}
 		else
 		{
-			bSuccess = UStructToJsonStringInternal<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>(JsonObject, Options.InitialIndent, OutJsonString);
+			bSuccess = UStructToJsonStringInternal<TCondensedJsonPrintPolicy<TCHAR>>(StructDefinition, ContainerPtr, Options.InitialIndent, OutJsonString);
 		}
 
 		if (bSuccess)
@@ -4,8 +4,6 @@
 #include "Logging/LogMacros.h"
 #include "UObject/UnrealType.h"
 #include "Misc/FileHelper.h"
-#include "Dom/JsonValue.h"
-#include "Dom/JsonObject.h"
 
 #include "IDlgWriter.h"
 
@@ -28,12 +26,14 @@ class DLGSYSTEM_API FDlgJsonWriter : public IDlgWriter
 	 * Call Order and possible calls:
 	 *  - DlgJsonWriter
 	 *		- UStructToJsonString
-	 *			- UStructToJsonObject
-	 *				- UStructToJsonAttributes
-	 *					- PropertyToJsonValue
-	 *						- ConvertScalarPropertyToJsonValue
-	 *							- PropertyToJsonValue
-	 *							- UStructToJsonObject
+	 *			- WriteUStruct
+	 *				- WriteUStructAttributes
+	 *					- WritePropertyValue
+	 *						- WriteScalarPropertyValue
+	 *							- WritePropertyValue
+	 *							- WriteUStruct
+	 *
+	 * Everything is written directly with a TJsonWriter, there is no FJsonObject in between.
 	 */
 public:
 
@@ -59,46 +59,56 @@ public:
 
 private: // UStruct -> JSON
 	/**
-	 * Convert property to JSON, assuming either the property is not an array or the value is an individual array element
-	 * Used by PropertyToJsonValue
+	 * Write property as JSON, assuming either the property is not an array or the value is an individual array element
+	 * Used by WritePropertyValue
 	 */
-	TSharedPtr<FJsonValue> ConvertScalarPropertyToJsonValue(const FProperty* Property, const void* const ContainerPtr, const void* const ValuePtr);
+	template <class WriterType>
+	void WriteScalarPropertyValue(WriterType& Writer, const FString* Identifier, const FProperty* Property, const void* const ContainerPtr, const void* const ValuePtr);
 
 	/**
-	 * Converts from a Property to a Json Value using exportText
+	 * Writes a Property as a JSON value
 	 *
+	 * @param Writer			The JSON writer
+	 * @param Identifier		Name of the value inside the current JSON object, nullptr inside JSON arrays
 	 * @param Property			The property to export
 	 * @param ValuePtr			Pointer to the value of the property
-	 *
-	 * @return					The constructed JsonValue from the property
 	 */
-	TSharedPtr<FJsonValue> PropertyToJsonValue(const FProperty* Property, const void* const ContainerPtr, const void* const ValuePtr);
+	template <class WriterType>
+	void WritePropertyValue(WriterType& Writer, const FString* Identifier, const FProperty* Property, const void* const ContainerPtr, const void* const ValuePtr);
 
 	/**
-	 * Converts from a UStruct to a set of json attributes (possibly from within a JsonObject)
+	 * Writes a UStruct as a JSON object
 	 *
-	 * @param StructDefinition UStruct definition that is looked over for properties
-	 * @param ContainerPtr	   The object the UStruct represents.
-	 * @param JsonAttributes   Map of attributes to copy in to
+	 * @param Writer			The JSON writer
+	 * @param Identifier		Name of the object inside the current JSON object, nullptr inside JSON arrays and for the root
+	 * @param Property			The property of the UStruct, nullptr for the root
+	 * @param StructDefinition	UStruct definition that is looked over for properties
+	 * @param ContainerPtr		The object the UStruct represents.
 	 *
-	 * @return False if any properties failed to write
+	 * @return False if the UStruct is not valid, nothing is written in that case
 	 */
-	bool UStructToJsonAttributes(const UStruct* StructDefinition, const void* const ContainerPtr,
-								 TMap<FString, TSharedPtr<FJsonValue>>& OutJsonAttributes);
+	template <class WriterType>
+	bool WriteUStruct(WriterType& Writer, const FString* Identifier, const FProperty* Property, const UStruct* StructDefinition, const void* const ContainerPtr);
 
 	/**
-	 * Converts from a UStruct to a JSON Object
+	 * Writes the properties of the UStruct as attributes of the current JSON object
 	 *
-	 * @param StructDefinition UStruct definition that is looked over for properties
+	 * @param StructDefinition UStruct definition that is looked over for properties, the class of the object for UObjects
 	 * @param ContainerPtr	   The object the UStruct represents.
-	 * @param OutJsonObject	Json Object to be filled in with data from the ustruct
+	 */
+	template <class WriterType>
+	void WriteUStructAttributes(WriterType& Writer, const UStruct* StructDefinition, const void* const ContainerPtr);
+
+	/**
+	 * Checks if the UStruct can be written
 	 *
-	 * @return False if faile to fill properties
+	 * @param OutStructDefinition	The StructDefinition or the class of the object for UObjects
+	 * @return False if the ContainerPtr or the StructDefinition is not valid
 	 */
-	bool UStructToJsonObject(const UStruct* StructDefinition, const void* const ContainerPtr, TSharedRef<FJsonObject>& OutJsonObject)
-	{
-		return UStructToJsonAttributes(StructDefinition, ContainerPtr, OutJsonObject->Values);
-	}
+	bool CheckUStruct(const UStruct* StructDefinition, const void* const ContainerPtr, const UStruct*& OutStructDefinition);
+
+	/** Gets the name of the JSON attribute of a map key */
+	FString GetMapKeyString(const FMapProperty* MapProperty, const void* const ContainerPtr, const void* const KeyPtr, int32 Index);
 
 	/**
 	 * Converts from a UStruct to a JSON string containing an object, using exportText
@@ -112,10 +122,13 @@ private: // UStruct -> JSON
 	bool UStructToJsonString(const UStruct* StructDefinition, const void* const ContainerPtr, const DlgJsonWriterOptions& Options,
 							 FString& OutJsonString);
 
+	template <class PrintPolicy>
+	bool UStructToJsonStringInternal(const UStruct* StructDefinition, const void* const ContainerPtr, const int32 InitialIndent,
+									 FString& OutJsonString);
+
 	void ResetState()
 	{
 		IndexInArray = INDEX_NONE;
-		bIsPropertyMapKey = false;
 	}
 
 private:
@@ -129,7 +142,4 @@ private:
 
 	// If it is in an array this is != INDEX_NONE
 	int32 IndexInArray = INDEX_NONE;
-
-	// Is the current property used as a map key?
-	bool bIsPropertyMapKey = false;
 };
@@ -0,0 +1,102 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "IDlgParser.h"
+
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectHash.h"
+
+namespace DlgParser
+{
+	// The not abstract children of a parent class by their name, see IDlgParser::GetChildClassFromName.
+	struct FChildClasses
+	{
+		// The classes are kept as weak pointers so that an entry can never match a new class allocated at the address of a garbage collected one.
+		// The names that are not a child class are kept as explicitly null entries.
+		TMap<FName, TWeakObjectPtr<const UClass>> ByName;
+
+		// GetRegisteredClassesVersionNumber when the null entries were added, they are only valid while no class is added or removed
+		uint64 RegisteredClassesVersion = 0;
+	};
+	static TMap<TWeakObjectPtr<const UClass>, FChildClasses> ChildClassesByParent;
+
+	// The parsers can run outside the game thread, guard the cache
+	static FCriticalSection ChildClassesByNameLock;
+
+	static bool IsChildClassOf(const UClass* Class, const UClass* ParentClass)
+	{
+		return Class->IsChildOf(ParentClass) && !Class->HasAnyClassFlags(CLASS_Abstract);
+	}
+}
+
+const UClass* IDlgParser::GetChildClassFromName(const UClass* ParentClass, const FString& Name)
+{
+	// If the name was never used there is no class with it
+	const FName ClassName(*Name, FNAME_Find);
+	if (ClassName.IsNone())
+	{
+		return nullptr;
+	}
+
+	FScopeLock Lock(&DlgParser::ChildClassesByNameLock);
+	const uint64 RegisteredClassesVersion = GetRegisteredClassesVersionNumber();
+	DlgParser::FChildClasses* ChildClassesPtr = DlgParser::ChildClassesByParent.Find(ParentClass);
+	if (ChildClassesPtr == nullptr)
+	{
+		// First time this parent is used, iterate over all the classes once
+		ChildClassesPtr = &DlgParser::ChildClassesByParent.Add(ParentClass);
+		ChildClassesPtr->RegisteredClassesVersion = RegisteredClassesVersion;
+		for (TObjectIterator<UClass> It; It; ++It)
+		{
+			if (DlgParser::IsChildClassOf(*It, ParentClass) && !ChildClassesPtr->ByName.Contains(It->GetFName()))
+			{
+				ChildClassesPtr->ByName.Add(It->GetFName(), *It);
+			}
+		}
+	}
+
+	if (const TWeakObjectPtr<const UClass>* ClassPtr = ChildClassesPtr->ByName.Find(ClassName))
+	{
+		if (const UClass* Class = ClassPtr->Get())
+		{
+			return Class;
+		}
+
+		// Already searched for and no class was added since
+		if (ClassPtr->IsExplicitlyNull() && ChildClassesPtr->RegisteredClassesVersion == RegisteredClassesVersion)
+		{
+			return nullptr;
+		}
+	}
+
+	// The classes changed, the names that were not found could be classes now
+	if (ChildClassesPtr->RegisteredClassesVersion != RegisteredClassesVersion)
+	{
+		for (auto It = ChildClassesPtr->ByName.CreateIterator(); It; ++It)
+		{
+			if (It->Value.IsExplicitlyNull())
+			{
+				It.RemoveCurrent();
+			}
+		}
+		ChildClassesPtr->RegisteredClassesVersion = RegisteredClassesVersion;
+	}
+
+	// Not found (or garbage collected), the class could have been loaded after the map was built (e.g. blueprint classes)
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (DlgParser::IsChildClassOf(*It, ParentClass) && It->GetFName() == ClassName)
+		{
+			ChildClassesPtr->ByName.Add(ClassName, *It);
+			return *It;
+		}
+	}
+
+	// Remember the miss, the next lookup of this name does not iterate over all the classes again
+	ChildClassesPtr->ByName.Add(ClassName, nullptr);
+	return nullptr;
+}
+
+void IDlgParser::ClearClassCache()
+{
+	FScopeLock Lock(&DlgParser::ChildClassesByNameLock);
+	DlgParser::ChildClassesByParent.Empty();
+}
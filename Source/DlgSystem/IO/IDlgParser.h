@@ -28,6 +28,12 @@ public:
 	 */
 	virtual void ReadAllProperty(const UStruct* ReferenceClass, void* TargetObject, UObject* DefaultObjectOuter = nullptr) = 0;
 
+	/**
+	 * Forgets the classes found by GetChildClassFromName.
+	 * Must be called every time classes can be added or renamed (module load, hot reload, blueprint compile).
+	 */
+	static void ClearClassCache();
+
 	// bLogVerbose:
 	bool IsLogVerbose() const { return bLogVerbose; }
 	void SetLogVerbose(bool bValue) { bLogVerbose = bValue; }
@@ -41,27 +47,7 @@ protected:
 	 *
 	 * @return the class, or nullptr if it does not exist
 	 */
-	const UClass* GetChildClassFromName(const UClass* ParentClass, const FString& Name)
-	{
-		for (UClass* Class : StructCache)
-		{
-			if (Class->IsChildOf(ParentClass) && Class->GetName() == Name)
-			{
-				return Class;
-			}
-		}
-
-		for (TObjectIterator<UClass> It; It; ++It)
-		{
-			if (It->IsChildOf(ParentClass) && !It->HasAnyClassFlags(CLASS_Abstract) && (*It)->GetName() == Name)
-			{
-				StructCache.Add(*It);
-				return *It;
-			}
-		}
-
-		return nullptr;
-	}
+	static const UClass* GetChildClassFromName(const UClass* ParentClass, const FString& Name);
 
 	/**
 	 * Default way to create new objects
@@ -73,9 +59,6 @@ protected:
 	}
 
 protected:
-	/** each time a class is read it also cached here, so next time when it has to be found based on name it can be found faster */
-	TArray<UClass*> StructCache;
-
 	// Should this class verbose log?
 	bool bLogVerbose = false;
 };
@@ -8,6 +8,8 @@
 #include "CoreMinimal.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "UObject/WeakObjectPtrTemplates.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/ScopeRWLock.h"
 #include "NYEngineVersionHelpers.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogDlgSystemReflectionHelper, All, All)
@@ -87,6 +89,73 @@ public:
 	}
 #endif // NY_ENGINE_VERSION >= 425
 
+	// Finds the property VariableName of type PropertyType by walking the PropertyLink of Class.
+	// Prefer FindProperty, this is linear in the number of properties of the class.
+	template <typename PropertyType>
+	static const PropertyType* FindPropertyLinear(const UClass* Class, FName VariableName)
+	{
+		if (!Class)
+		{
+			return nullptr;
+		}
+
+		for (auto* Property = Class->PropertyLink; Property != nullptr; Property = Property->PropertyLinkNext)
+		{
+			const PropertyType* CastedProperty = CastProperty<PropertyType>(Property);
+			if (CastedProperty != nullptr && CastedProperty->GetFName() == VariableName)
+			{
+				return CastedProperty;
+			}
+		}
+
+		return nullptr;
+	}
+
+	// Same as FindPropertyLinear but the result (even if not found) is cached per (Class, VariableName, PropertyType).
+	// The cache is cleared on blueprint compile and on hot reload, see ClearPropertyCache.
+	template <typename PropertyType>
+	static const PropertyType* FindProperty(const UClass* Class, FName VariableName)
+	{
+		if (!Class)
+		{
+			return nullptr;
+		}
+
+		const FFieldClass* PropertyClass = PropertyType::StaticClass();
+		const FProperty* Property = nullptr;
+		if (!FindCachedProperty(Class, VariableName, PropertyClass, Property))
+		{
+			Property = FindPropertyLinear<PropertyType>(Class, VariableName);
+			AddCachedProperty(Class, VariableName, PropertyClass, Property);
+		}
+
+		return static_cast<const PropertyType*>(Property);
+	}
+
+	// Removes all the properties from the cache used by FindProperty.
+	// Must be called every time the properties of a class can change (blueprint compile, hot reload, live coding).
+	static void ClearPropertyCache()
+	{
+		FPropertyCache& Cache = GetPropertyCache();
+		FRWScopeLock WriteLock(Cache.Lock, SLT_Write);
+		Cache.Properties.Empty();
+		Cache.Generation.Increment();
+	}
+
+	// Number of entries in the cache used by FindProperty
+	static int32 GetPropertyCacheNum()
+	{
+		FPropertyCache& Cache = GetPropertyCache();
+		FRWScopeLock ReadLock(Cache.Lock, SLT_ReadOnly);
+		return Cache.Properties.Num();
+	}
+
+	// Incremented every time the cache is cleared, whoever keeps properties around must resolve them again if this changed
+	static int32 GetPropertyCacheGeneration()
+	{
+		return GetPropertyCache().Generation.GetValue();
+	}
+
 	// Attempts to get the property VariableName from Object
 	template <typename PropertyType, typename VariableType>
 	static VariableType GetVariable(const UObject* Object, FName VariableName)
@@ -102,13 +171,9 @@ public:
 			return VariableType{};
 		}
 
-		for (auto* Property = Object->GetClass()->PropertyLink; Property != nullptr; Property = Property->PropertyLinkNext)
+		if (const PropertyType* Property = FindProperty<PropertyType>(Object->GetClass(), VariableName))
 		{
-			const PropertyType* CastedProperty = CastProperty<PropertyType>(Property);
-			if (CastedProperty != nullptr && CastedProperty->GetFName() == VariableName)
-			{
-				return CastedProperty->GetPropertyValue_InContainer(Object, 0);
-			}
+			return Property->GetPropertyValue_InContainer(Object, 0);
 		}
 
 		UE_LOG(
@@ -143,15 +208,11 @@ public:
 		}
 
 		// Modify the current variable
-		for (auto* Property = Object->GetClass()->PropertyLink; Property != nullptr; Property = Property->PropertyLinkNext)
+		if (const PropertyType* Property = FindProperty<PropertyType>(Object->GetClass(), VariableName))
 		{
-			const PropertyType* CastedProperty = CastProperty<PropertyType>(Property);
-			if (CastedProperty != nullptr && CastedProperty->GetFName() == VariableName)
-			{
-				const VariableType OldValue = CastedProperty->GetPropertyValue_InContainer(Object, 0);
-				CastedProperty->SetPropertyValue_InContainer(Object, OldValue + Value);
-				return;
-			}
+			const VariableType OldValue = Property->GetPropertyValue_InContainer(Object, 0);
+			Property->SetPropertyValue_InContainer(Object, OldValue + Value);
+			return;
 		}
 
 		UE_LOG(
@@ -178,14 +239,10 @@ public:
 			return;
 		}
 
-		for (auto* Property = Object->GetClass()->PropertyLink; Property != nullptr; Property = Property->PropertyLinkNext)
+		if (const PropertyType* Property = FindProperty<PropertyType>(Object->GetClass(), VariableName))
 		{
-			const PropertyType* CastedProperty = CastProperty<PropertyType>(Property);
-			if (CastedProperty != nullptr && CastedProperty->GetFName() == VariableName)
-			{
-				CastedProperty->SetPropertyValue_InContainer(Object, NewValue);
-				return;
-			}
+			Property->SetPropertyValue_InContainer(Object, NewValue);
+			return;
 		}
 
 		UE_LOG(
@@ -241,5 +298,65 @@ public:
 			Property = Property->PropertyLinkNext;
 		}
 	}
+
+private:
+	// Key of the property cache. The class is kept as a weak pointer so that an entry
+	// can never match a new class that was allocated at the address of a garbage collected one.
+	struct FPropertyCacheKey
+	{
+		FPropertyCacheKey(const UClass* InClass, FName InVariableName, const FFieldClass* InPropertyClass)
+			: Class(InClass), VariableName(InVariableName), PropertyClass(InPropertyClass) {}
+
+		bool operator==(const FPropertyCacheKey& Other) const
+		{
+			return VariableName == Other.VariableName && PropertyClass == Other.PropertyClass && Class == Other.Class;
+		}
+
+		friend uint32 GetTypeHash(const FPropertyCacheKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.Class), GetTypeHash(Key.VariableName)), PointerHash(Key.PropertyClass));
+		}
+
+		TWeakObjectPtr<const UClass> Class;
+		FName VariableName;
+		const FFieldClass* PropertyClass;
+	};
+
+	struct FPropertyCache
+	{
+		// Conditions can be evaluated outside the game thread, guard the cache
+		FRWLock Lock;
+		TMap<FPropertyCacheKey, const FProperty*> Properties;
+		FThreadSafeCounter Generation;
+	};
+
+	// Function local static so this helper stays header only (see the include guard above).
+	// The class is exported from DlgSystem so every module that includes this shares the same cache.
+	static FPropertyCache& GetPropertyCache()
+	{
+		static FPropertyCache Cache;
+		return Cache;
+	}
+
+	// Helpers for FindProperty, return true if the (Class, VariableName, PropertyClass) is in the cache
+	static bool FindCachedProperty(const UClass* Class, FName VariableName, const FFieldClass* PropertyClass, const FProperty*& OutProperty)
+	{
+		FPropertyCache& Cache = GetPropertyCache();
+		FRWScopeLock ReadLock(Cache.Lock, SLT_ReadOnly);
+		if (const FProperty* const* PropertyPtr = Cache.Properties.Find(FPropertyCacheKey(Class, VariableName, PropertyClass)))
+		{
+			OutProperty = *PropertyPtr;
+			return true;
+		}
+
+		return false;
+	}
+
+	static void AddCachedProperty(const UClass* Class, FName VariableName, const FFieldClass* PropertyClass, const FProperty* Property)
+	{
+		FPropertyCache& Cache = GetPropertyCache();
+		FRWScopeLock WriteLock(Cache.Lock, SLT_Write);
+		Cache.Properties.Add(FPropertyCacheKey(Class, VariableName, PropertyClass), Property);
+	}
 };
 #endif // NY_REFLECTION_HELPER
@@ -6,6 +6,7 @@
 #include "Sound/SoundWave.h"
 
 #include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
 #include "DlgSystem/Logging/DlgLogger.h"
 #include "DlgSystem/DlgLocalizationHelper.h"
 
@@ -57,6 +58,7 @@ void UDlgNode::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collec
 void UDlgNode::PostLoad()
 {
 	Super::PostLoad();
+	CompileTextFormats(true);
 
 	// NOTE: We don't this here but instead we do it in the compile phase
 	// Create thew new GUID
@@ -108,6 +110,13 @@ void UDlgNode::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEven
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 
+	// The baked data (descriptors, edges, conditions) of the Dialogue must follow the edit.
+	// Also called for the chain edits, Super::PostEditChangeChainProperty calls this.
+	if (UDlgDialogue* Dialogue = Cast<UDlgDialogue>(GetOuter()))
+	{
+		Dialogue->RebuildBakedDialogue();
+	}
+
 	// Signal to the listeners
 	OnDialogueNodePropertyChanged.Broadcast(PropertyChangedEvent, BroadcastPropertyEdgeIndexChanged);
 	BroadcastPropertyEdgeIndexChanged = INDEX_NONE;
@@ -130,17 +139,13 @@ void UDlgNode::PostEditChangeChainProperty(struct FPropertyChangedChainEvent& Pr
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Begin own function
-bool UDlgNode::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep)
+bool UDlgNode::HandleNodeEnter(UDlgContext& Context, FDlgTraversalState& NodesEnteredWithThisStep)
 {
 	// Fire all the node enter events
 	FireNodeEnterEvents(Context);
 
-	for (FDlgEdge& Edge : Children)
-	{
-		Edge.RebuildConstructedText(Context, OwnerName);
-	}
-
-	return ReevaluateChildren(Context, {});
+	FDlgTraversalState AlreadyEvaluated;
+	return ReevaluateChildren(Context, AlreadyEvaluated);
 }
 
 void UDlgNode::FireNodeEnterEvents(UDlgContext& Context)
@@ -158,29 +163,38 @@ void UDlgNode::FireNodeEnterEvents(UDlgContext& Context)
 	}
 }
 
-bool UDlgNode::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated)
+bool UDlgNode::ReevaluateChildren(UDlgContext& Context, FDlgTraversalState& AlreadyEvaluated)
 {
-	TArray<FDlgEdge>& AvailableOptions = Context.GetMutableOptionsArray();
-	TArray<FDlgEdgeData>& AllOptions = Context.GetAllMutableOptionsArray();
-	AvailableOptions.Empty();
-	AllOptions.Empty();
+	Context.ResetOptions();
 
-	for (const FDlgEdge& Edge : Children)
+	const int32 NodeIndex = Context.GetNodeIndexForGUID(NodeGUID);
+	const bool bRecordIncrementalOptions = Context.IsIncrementalReevaluationEnabled();
+	if (bRecordIncrementalOptions)
 	{
-		const bool bSatisfied = Edge.Evaluate(Context, { this });
+		Context.ResetIncrementalOptions(NodeIndex);
+	}
 
-		if (bSatisfied || Edge.bIncludeInAllOptionListIfUnsatisfied)
-		{
-			AllOptions.Add(FDlgEdgeData{ bSatisfied, Edge });
-		}
-		if (bSatisfied)
+	// Big nodes evaluate the conditions that only read values on worker threads first
+	const bool bThreadSafeConditionsEvaluated = Context.EvaluateThreadSafeConditions(NodeIndex, Children);
+
+	FDlgTraversalState AlreadyVisitedNodes(NodeIndex);
+	for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); EdgeIndex++)
+	{
+		const FDlgEdge& Edge = Children[EdgeIndex];
+		const bool bSatisfied = Context.IsEdgeSatisfied(NodeIndex, EdgeIndex, Edge, AlreadyVisitedNodes);
+		if (bRecordIncrementalOptions)
 		{
-			AvailableOptions.Add(Edge);
+			Context.AddIncrementalOption(Edge, bSatisfied);
 		}
+		Context.AddOption(NodeIndex, EdgeIndex, Edge, bSatisfied);
+	}
+	if (bThreadSafeConditionsEvaluated)
+	{
+		Context.ClearThreadSafeConditionResults();
 	}
 
 	// no child, but no end node?
-	if (AvailableOptions.Num() == 0)
+	if (Context.GetOptionsNum() == 0)
 	{
 		switch (GetDefault<UDlgSystemSettings>()->NoSatisfiedChildBehavior)
 		{
@@ -203,15 +217,17 @@ bool UDlgNode::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> Al
 	return true;
 }
 
-bool UDlgNode::CheckNodeEnterConditions(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const
+bool UDlgNode::CheckNodeEnterConditions(const UDlgContext& Context, FDlgTraversalState& AlreadyVisitedNodes) const
 {
-	if (AlreadyVisitedNodes.Contains(this))
+	const int32 NodeIndex = Context.GetNodeIndexForGUID(NodeGUID);
+	if (AlreadyVisitedNodes.Contains(NodeIndex))
 	{
 		return true;
 	}
 
-	AlreadyVisitedNodes.Add(this);
-	if (!FDlgCondition::EvaluateArray(Context, EnterConditions, OwnerName))
+	// Only visited on this path, the sibling edges must not see it
+	const FDlgTraversalState::FScopedVisit ScopedVisit(AlreadyVisitedNodes, NodeIndex);
+	if (!FDlgCondition::EvaluateArray(Context, EnterConditions, GetEnterConditionsParticipantName()))
 	{
 		return false;
 	}
@@ -222,14 +238,14 @@ bool UDlgNode::CheckNodeEnterConditions(const UDlgContext& Context, TSet<const U
 			break;
 
 		case EDlgEntryRestriction::OncePerContext:
-			if (Context.IsNodeVisited(Context.GetNodeIndexForGUID(NodeGUID), NodeGUID, true))
+			if (Context.IsNodeVisited(NodeIndex, NodeGUID, true))
 			{
 				return false;
 			}
 			break;
 
 		case EDlgEntryRestriction::Once:
-			if (Context.IsNodeVisited(Context.GetNodeIndexForGUID(NodeGUID), NodeGUID, false))
+			if (Context.IsNodeVisited(NodeIndex, NodeGUID, false))
 			{
 				return false;
 			}
@@ -248,7 +264,7 @@ bool UDlgNode::CheckNodeEnterConditions(const UDlgContext& Context, TSet<const U
 	return HasAnySatisfiedChild(Context, AlreadyVisitedNodes);
 }
 
-bool UDlgNode::HasAnySatisfiedChild(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const
+bool UDlgNode::HasAnySatisfiedChild(const UDlgContext& Context, FDlgTraversalState& AlreadyVisitedNodes) const
 {
 	for (const FDlgEdge& Edge : Children)
 	{
@@ -266,30 +282,28 @@ bool UDlgNode::OptionSelected(int32 OptionIndex, bool bFromAll, UDlgContext& Con
 {
 	if (bFromAll)
 	{
-		const TArray<FDlgEdgeData>& AllOptions = Context.GetAllOptionsArray();
-		if (AllOptions.IsValidIndex(OptionIndex))
+		if (const FDlgOptionRecord* Record = Context.FindOptionRecordFromAll(OptionIndex))
 		{
-			check(AllOptions[OptionIndex].IsValid());
-			return Context.EnterNode(AllOptions[OptionIndex].GetEdge().TargetIndex, {});
+			check(Record->TargetIndex > INDEX_NONE);
+			return Context.EnterNode(Record->TargetIndex);
 		}
 
 		FDlgLogger::Get().Errorf(
 			TEXT("OptionSelected - Failed to choose OptionIndex = %d from AllOptions - it only has %d valid options.\nContext:\n\t%s"),
-			OptionIndex, AllOptions.Num(), *Context.GetContextString()
+			OptionIndex, Context.GetAllOptionsNum(), *Context.GetContextString()
 		);
 	}
 	else
 	{
-		const TArray<FDlgEdge>& AvailableOptions = Context.GetOptionsArray();
-		if (AvailableOptions.IsValidIndex(OptionIndex))
+		if (const FDlgOptionRecord* Record = Context.FindOptionRecord(OptionIndex))
 		{
-			check(AvailableOptions[OptionIndex].IsValid());
-			return Context.EnterNode(AvailableOptions[OptionIndex].TargetIndex, {});
+			check(Record->TargetIndex > INDEX_NONE);
+			return Context.EnterNode(Record->TargetIndex);
 		}
 
 		FDlgLogger::Get().Errorf(
 			TEXT("OptionSelected - Failed to choose OptionIndex = %d from AvailableOptions - it only has %d valid options.\nContext:\n\t%s"),
-			OptionIndex, AvailableOptions.Num(), *Context.GetContextString()
+			OptionIndex, Context.GetOptionsNum(), *Context.GetContextString()
 		);
 	}
 	return false;
@@ -393,6 +407,17 @@ void UDlgNode::RebuildTextArguments(bool bEdges, bool bUpdateGraphNode)
 	}
 }
 
+void UDlgNode::CompileTextFormats(bool bEdges)
+{
+	if (bEdges)
+	{
+		for (FDlgEdge& Edge : Children)
+		{
+			Edge.CompileTextFormat();
+		}
+	}
+}
+
 void UDlgNode::UpdateGraphNode()
 {
 #if WITH_EDITOR
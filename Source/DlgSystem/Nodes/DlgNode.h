@@ -13,6 +13,7 @@
 #include "DlgSystem/DlgCondition.h"
 #include "DlgSystem/DlgEvent.h"
 #include "DlgSystem/DlgNodeData.h"
+#include "DlgSystem/DlgTraversalState.h"
 #include "DlgNode.generated.h"
 
 
@@ -99,11 +100,12 @@ public:
 	DECLARE_EVENT_TwoParams(UDlgNode, FDialogueNodePropertyChanged, const FPropertyChangedEvent& /* PropertyChangedEvent */, int32 /* EdgeIndexChanged */);
 	FDialogueNodePropertyChanged OnDialogueNodePropertyChanged;
 
-	virtual bool HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep);
-	virtual bool ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated);
+	// The traversal state is shared by the whole step (passed by reference), it is not copied between the recursive calls.
+	virtual bool HandleNodeEnter(UDlgContext& Context, FDlgTraversalState& NodesEnteredWithThisStep);
+	virtual bool ReevaluateChildren(UDlgContext& Context, FDlgTraversalState& AlreadyEvaluated);
 
-	virtual bool CheckNodeEnterConditions(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const;
-	bool HasAnySatisfiedChild(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const;
+	virtual bool CheckNodeEnterConditions(const UDlgContext& Context, FDlgTraversalState& AlreadyVisitedNodes) const;
+	bool HasAnySatisfiedChild(const UDlgContext& Context, FDlgTraversalState& AlreadyVisitedNodes) const;
 
 	// if bFromAll = true it uses all the options (even unsatisfied)
 	// if bFromAll = false it only uses the satisfied options.
@@ -132,12 +134,17 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
 	virtual FName GetNodeParticipantName() const { return OwnerName; }
 
+	// The participant the EnterConditions without a participant name are checked on
+	FName GetEnterConditionsParticipantName() const { return OwnerName; }
+
 	virtual void SetNodeParticipantName(FName InName) { OwnerName = InName; }
 
 	//
 	// For the EnterConditions
 	//
 
+	EDlgEntryRestriction GetEnterRestriction() const { return EnterRestriction; }
+
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
 	virtual bool HasAnyEnterConditions() const { return GetNodeEnterConditions().Num() > 0 || EnterRestriction != EDlgEntryRestriction::None; }
 
@@ -224,13 +231,21 @@ public:
 	// Updates the namespace and key of all the texts depending on the settings
 	virtual void UpdateTextsNamespacesAndKeys(const UDlgSystemSettings& Settings, bool bEdges, bool bUpdateGraphNode = true);
 
-	// Rebuilds ConstructedText
+	// Rebuilds the text arguments
 	virtual void RebuildTextArguments(bool bEdges, bool bUpdateGraphNode = true);
 	virtual void RebuildTextArgumentsFromPreview(const FText& Preview) {}
 
+	// Compiles the texts with text arguments for formatting, only the changed ones are compiled again
+	virtual void CompileTextFormats(bool bEdges);
+
 	// Constructs the ConstructedText.
+	UE_DEPRECATED(5.4, "The nodes of the Dialogue are not formatted on node enter anymore, use UDlgContext::GetActiveNodeText or FormatNodeText")
 	virtual void RebuildConstructedText(const UDlgContext& Context) {}
 
+	// Formats the node text with the text arguments for the Context, without changing the ConstructedText
+	// NOTE: the contexts format the active node on demand and cache the result, see UDlgContext::GetActiveNodeText
+	virtual FText FormatNodeText(const UDlgContext& Context) const { return GetNodeText(); }
+
 	// Gets the text arguments for this Node (if any). Used for FText::Format
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
 	virtual const TArray<FDlgTextArgument>& GetTextArguments() const
@@ -239,7 +254,8 @@ public:
 		return EmptyArray;
 	};
 
-	// Gets the Text of this Node. This can be the final formatted string.
+	// Gets the Text of this Node.
+	// NOTE: not formatted with the text arguments anymore (the Dialogue is shared by the contexts), use UDlgContext::GetActiveNodeText
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
 	virtual const FText& GetNodeText() const { return FText::GetEmpty(); }
 
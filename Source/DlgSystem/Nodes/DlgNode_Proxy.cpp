@@ -4,11 +4,12 @@
 #include "DlgSystem/DlgContext.h"
 #include "DlgSystem/Logging/DlgLogger.h"
 
-bool UDlgNode_Proxy::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep)
+bool UDlgNode_Proxy::HandleNodeEnter(UDlgContext& Context, FDlgTraversalState& NodesEnteredWithThisStep)
 {
 	FireNodeEnterEvents(Context);
 
-	if (NodesEnteredWithThisStep.Contains(this))
+	const int32 ThisNodeIndex = Context.GetNodeIndexForGUID(NodeGUID);
+	if (NodesEnteredWithThisStep.Contains(ThisNodeIndex))
 	{
 		FDlgLogger::Get().Errorf(
 			TEXT("ProxyNode::HandleNodeEnter - Failed to enter proxy node, it was entered multiple times in a single step."
@@ -19,12 +20,12 @@ bool UDlgNode_Proxy::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*>
 
 		return false;
 	}
-	NodesEnteredWithThisStep.Add(this);
+	NodesEnteredWithThisStep.Add(ThisNodeIndex);
 
 	return Context.EnterNode(NodeIndex, NodesEnteredWithThisStep);
 }
 
-bool UDlgNode_Proxy::CheckNodeEnterConditions(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const
+bool UDlgNode_Proxy::CheckNodeEnterConditions(const UDlgContext& Context, FDlgTraversalState& AlreadyVisitedNodes) const
 {
 	if (!Super::CheckNodeEnterConditions(Context, AlreadyVisitedNodes))
 	{
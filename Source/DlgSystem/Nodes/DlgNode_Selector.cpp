@@ -38,11 +38,12 @@ const FText& UDlgNode_Selector::GetNodeText() const
 	}
 }
 
-bool UDlgNode_Selector::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep)
+bool UDlgNode_Selector::HandleNodeEnter(UDlgContext& Context, FDlgTraversalState& NodesEnteredWithThisStep)
 {
 	FireNodeEnterEvents(Context);
 
-	if (NodesEnteredWithThisStep.Contains(this))
+	const int32 NodeIndex = Context.GetNodeIndexForGUID(NodeGUID);
+	if (NodesEnteredWithThisStep.Contains(NodeIndex))
 	{
 		FDlgLogger::Get().Errorf(
 			TEXT("SelectorNode::HandleNodeEnter - Failed to enter selector node, it was entered multiple times in a single step."
@@ -53,16 +54,17 @@ bool UDlgNode_Selector::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNod
 
 		return false;
 	}
-	NodesEnteredWithThisStep.Add(this);
+	NodesEnteredWithThisStep.Add(NodeIndex);
 
 	switch (SelectorType)
 	{
 		case EDlgNodeSelectorType::First:
 		{
 			// Find first child with satisfies conditions
+			FDlgTraversalState AlreadyVisitedNodes(NodeIndex);
 			for (const FDlgEdge& Edge : Children)
 			{
-				if (Edge.Evaluate(Context, { this }))
+				if (Edge.Evaluate(Context, AlreadyVisitedNodes))
 				{
 					return Context.EnterNode(Edge.TargetIndex, NodesEnteredWithThisStep);
 				}
@@ -101,9 +103,10 @@ int32 UDlgNode_Selector::GetRandomChildNodeIndex(UDlgContext& Context)
 	// List of possible candidates if we want to avoid repetition based on the booleans
 	TArray<int32> CandidatesLimited;
 
+	FDlgTraversalState AlreadyVisitedNodes(Context.GetNodeIndexForGUID(NodeGUID));
 	for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); ++EdgeIndex)
 	{
-		if (Children[EdgeIndex].Evaluate(Context, { this }))
+		if (Children[EdgeIndex].Evaluate(Context, AlreadyVisitedNodes))
 		{
 			Candidates.Add(EdgeIndex);
 
@@ -54,20 +54,26 @@ void UDlgNode_Speech::RebuildConstructedText(const UDlgContext& Context)
 		return;
 	}
 
-	FFormatNamedArguments OrderedArguments;
-	for (const FDlgTextArgument& DlgArgument : TextArguments)
+	ConstructedText = FormatNodeText(Context);
+}
+
+FText UDlgNode_Speech::FormatNodeText(const UDlgContext& Context) const
+{
+	if (TextArguments.Num() <= 0)
 	{
-		OrderedArguments.Add(DlgArgument.DisplayString, DlgArgument.ConstructFormatArgumentValue(Context, OwnerName));
+		return Text;
 	}
-	ConstructedText = FText::AsCultureInvariant(FText::Format(Text, OrderedArguments));
+
+	return FDlgTextArgument::FormatText(FDlgTextArgument::GetTextFormat(Text, TextFormat), TextArguments, Context, OwnerName);
 }
 
-bool UDlgNode_Speech::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep)
+bool UDlgNode_Speech::HandleNodeEnter(UDlgContext& Context, FDlgTraversalState& NodesEnteredWithThisStep)
 {
-	RebuildConstructedText(Context);
 	const bool bResult = Super::HandleNodeEnter(Context, NodesEnteredWithThisStep);
 
 	// Handle virtual parent enter events for direct children
+	const int32 VirtualParentFirstSatisfiedDirectChildIndex =
+		Context.GetNodeState(Context.GetNodeIndexForGUID(NodeGUID)).VirtualParentFirstSatisfiedDirectChildIndex;
 	if (bResult && bIsVirtualParent && Context.IsValidNodeIndex(VirtualParentFirstSatisfiedDirectChildIndex))
 	{
 		// Add to history
@@ -89,16 +95,21 @@ bool UDlgNode_Speech::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*
 	return bResult;
 }
 
-bool UDlgNode_Speech::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated)
+bool UDlgNode_Speech::ReevaluateChildren(UDlgContext& Context, FDlgTraversalState& AlreadyEvaluated)
 {
 	if (bIsVirtualParent)
 	{
-		VirtualParentFirstSatisfiedDirectChildIndex = INDEX_NONE;
-		Context.GetMutableOptionsArray().Empty();
-		Context.GetAllMutableOptionsArray().Empty();
+		Context.ResetOptions();
+
+		const int32 NodeIndex = Context.GetNodeIndexForGUID(NodeGUID);
+		if (!Context.IsValidNodeIndex(NodeIndex))
+		{
+			return false;
+		}
+		Context.GetMutableNodeState(NodeIndex).VirtualParentFirstSatisfiedDirectChildIndex = INDEX_NONE;
 
 		// stop endless loop
-		if (AlreadyEvaluated.Contains(this))
+		if (AlreadyEvaluated.Contains(NodeIndex))
 		{
 			FDlgLogger::Get().Errorf(
 				TEXT("ReevaluateChildren - Endless loop detected, a virtual parent became his own parent! "
@@ -108,12 +119,13 @@ bool UDlgNode_Speech::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNo
 			return false;
 		}
 
-		AlreadyEvaluated.Add(this);
+		const FDlgTraversalState::FScopedVisit ScopedVisit(AlreadyEvaluated, NodeIndex);
 
+		FDlgTraversalState AlreadyVisitedNodes(NodeIndex);
 		for (const FDlgEdge& Edge : Children)
 		{
 			// Find first satisfied child
-			if (Edge.Evaluate(Context, { this }))
+			if (Edge.Evaluate(Context, AlreadyVisitedNodes))
 			{
 				if (UDlgNode* Node = Context.GetMutableNodeFromIndex(Edge.TargetIndex))
 				{
@@ -121,7 +133,7 @@ bool UDlgNode_Speech::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNo
 					const bool bResult = Node->ReevaluateChildren(Context, AlreadyEvaluated);
 					if (bResult)
 					{
-						VirtualParentFirstSatisfiedDirectChildIndex = Edge.TargetIndex;
+						Context.GetMutableNodeState(NodeIndex).VirtualParentFirstSatisfiedDirectChildIndex = Edge.TargetIndex;
 					}
 					return bResult;
 				}
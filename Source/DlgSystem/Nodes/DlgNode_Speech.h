@@ -46,22 +46,31 @@ public:
 	// Begin UDlgNode Interface.
 	//
 
-	bool HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep) override;
-	bool ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated) override;
+	bool HandleNodeEnter(UDlgContext& Context, FDlgTraversalState& NodesEnteredWithThisStep) override;
+	bool ReevaluateChildren(UDlgContext& Context, FDlgTraversalState& AlreadyEvaluated) override;
 	void GetAssociatedParticipants(TArray<FName>& OutArray) const override;
 
 	void UpdateTextsValuesFromDefaultsAndRemappings(const UDlgSystemSettings& Settings, bool bEdges, bool bUpdateGraphNode = true) override;
 	void UpdateTextsNamespacesAndKeys(const UDlgSystemSettings& Settings, bool bEdges, bool bUpdateGraphNode = true) override;
+	UE_DEPRECATED(5.4, "The nodes of the Dialogue are not formatted on node enter anymore, use UDlgContext::GetActiveNodeText or FormatNodeText")
 	void RebuildConstructedText(const UDlgContext& Context) override;
+	FText FormatNodeText(const UDlgContext& Context) const override;
 	void RebuildTextArguments(bool bEdges, bool bUpdateGraphNode = true) override
 	{
 		Super::RebuildTextArguments(bEdges, bUpdateGraphNode);
 		FDlgTextArgument::UpdateTextArgumentArray(Text, TextArguments);
+		FDlgTextArgument::CompileTextFormat(Text, TextFormat);
+	}
+	void CompileTextFormats(bool bEdges) override
+	{
+		Super::CompileTextFormats(bEdges);
+		FDlgTextArgument::CompileTextFormat(Text, TextFormat);
 	}
 	void RebuildTextArgumentsFromPreview(const FText& Preview) override { FDlgTextArgument::UpdateTextArgumentArray(Preview, TextArguments); }
 	const TArray<FDlgTextArgument>& GetTextArguments() const override { return TextArguments; };
 
 	// Getters:
+	// NOTE: only formatted if the deprecated RebuildConstructedText was called, see UDlgNode::GetNodeText
 	const FText& GetNodeText() const override
 	{
 		if (TextArguments.Num() > 0 && !ConstructedText.IsEmpty())
@@ -171,5 +180,6 @@ protected:
 	// Constructed at runtime from the original text and the arguments if there is any.
 	FText ConstructedText;
 
-	int32 VirtualParentFirstSatisfiedDirectChildIndex = INDEX_NONE;
+	// Text compiled as a format pattern, see CompileTextFormats
+	FTextFormat TextFormat;
 };
@@ -78,28 +78,27 @@ void UDlgNode_SpeechSequence::UpdateTextsNamespacesAndKeys(const UDlgSystemSetti
 	Super::UpdateTextsNamespacesAndKeys(Settings, bEdges, bUpdateGraphNode);
 }
 
-bool UDlgNode_SpeechSequence::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep)
+bool UDlgNode_SpeechSequence::HandleNodeEnter(UDlgContext& Context, FDlgTraversalState& NodesEnteredWithThisStep)
 {
-	ActualIndex = 0;
+	SetSpeechSequenceIndex(Context, 0);
 	return Super::HandleNodeEnter(Context, NodesEnteredWithThisStep);
 }
 
-bool UDlgNode_SpeechSequence::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated)
+bool UDlgNode_SpeechSequence::ReevaluateChildren(UDlgContext& Context, FDlgTraversalState& AlreadyEvaluated)
 {
-	TArray<FDlgEdge>& Options = Context.GetMutableOptionsArray();
-	TArray<FDlgEdgeData>& AllOptions = Context.GetAllMutableOptionsArray();
-	Options.Empty();
-	AllOptions.Empty();
+	Context.ResetOptions();
 
 	// If the last entry is active the real edges are used
-	if (ActualIndex == SpeechSequence.Num() - 1)
+	const int32 SpeechSequenceIndex = GetSpeechSequenceIndex(Context);
+	if (SpeechSequenceIndex == SpeechSequence.Num() - 1)
 		return Super::ReevaluateChildren(Context, AlreadyEvaluated);
 
 	// give the context the fake inner edge
-	if (InnerEdges.IsValidIndex(ActualIndex))
+	// NOTE: the options recorded for the real edges are not valid for it, the incremental reevaluation must not rebuild them
+	Context.ResetIncrementalOptions(INDEX_NONE);
+	if (InnerEdges.IsValidIndex(SpeechSequenceIndex))
 	{
-		Options.Add(InnerEdges[ActualIndex]);
-		AllOptions.Add(FDlgEdgeData{ true, InnerEdges[ActualIndex] });
+		Context.AddOption(Context.GetNodeIndexForGUID(NodeGUID), SpeechSequenceIndex, InnerEdges[SpeechSequenceIndex], true, true);
 		return true;
 	}
 
@@ -108,93 +107,108 @@ bool UDlgNode_SpeechSequence::ReevaluateChildren(UDlgContext& Context, TSet<cons
 
 bool UDlgNode_SpeechSequence::OptionSelected(int32 OptionIndex, bool bFromAll, UDlgContext& Context)
 {
+	FDlgTraversalState AlreadyEvaluated(Context.GetNodeIndexForGUID(NodeGUID));
+
 	// Actual index is valid, and not the last node in the speech sequence, increment
-	if (ActualIndex >= 0 && ActualIndex < SpeechSequence.Num() - 1)
+	const int32 SpeechSequenceIndex = GetSpeechSequenceIndex(Context);
+	if (SpeechSequenceIndex >= 0 && SpeechSequenceIndex < SpeechSequence.Num() - 1)
 	{
-		ActualIndex += 1;
-		return ReevaluateChildren(Context, {this});
+		SetSpeechSequenceIndex(Context, SpeechSequenceIndex + 1);
+		return ReevaluateChildren(Context, AlreadyEvaluated);
 	}
 
 	// node finished -> generate true children
-	ActualIndex = 0;
-	Super::ReevaluateChildren(Context, { this });
+	SetSpeechSequenceIndex(Context, 0);
+	Super::ReevaluateChildren(Context, AlreadyEvaluated);
 	return Super::OptionSelected(OptionIndex, bFromAll, Context);
 }
 
 bool UDlgNode_SpeechSequence::OptionSelectedFromReplicated(int32 OptionIndex, bool bFromAll, UDlgContext& Context)
 {
+	FDlgTraversalState AlreadyEvaluated(Context.GetNodeIndexForGUID(NodeGUID));
+
 	// Is the new option index valid? set that for the actual index
 	if (SpeechSequence.IsValidIndex(OptionIndex))
 	{
-		ActualIndex = OptionIndex;
-		return ReevaluateChildren(Context, { this });
+		SetSpeechSequenceIndex(Context, OptionIndex);
+		return ReevaluateChildren(Context, AlreadyEvaluated);
 	}
 
 	// node finished -> generate true children
-	ActualIndex = 0;
-	Super::ReevaluateChildren(Context, { this });
+	SetSpeechSequenceIndex(Context, 0);
+	Super::ReevaluateChildren(Context, AlreadyEvaluated);
 	return Super::OptionSelected(OptionIndex, bFromAll, Context);
 }
 
-const FText& UDlgNode_SpeechSequence::GetNodeText() const
+int32 UDlgNode_SpeechSequence::GetSpeechSequenceIndex(const UDlgContext& Context) const
+{
+	return Context.GetNodeState(Context.GetNodeIndexForGUID(NodeGUID)).SpeechSequenceIndex;
+}
+
+void UDlgNode_SpeechSequence::SetSpeechSequenceIndex(UDlgContext& Context, int32 Index) const
 {
-	if (SpeechSequence.IsValidIndex(ActualIndex))
+	const int32 NodeIndex = Context.GetNodeIndexForGUID(NodeGUID);
+	if (Context.IsValidNodeIndex(NodeIndex))
 	{
-		return SpeechSequence[ActualIndex].Text;
+		int32& SpeechSequenceIndex = Context.GetMutableNodeState(NodeIndex).SpeechSequenceIndex;
+		if (SpeechSequenceIndex != Index)
+		{
+			// Other options are active now, the recorded ones are outdated
+			SpeechSequenceIndex = Index;
+			Context.ResetIncrementalOptions(INDEX_NONE);
+		}
 	}
+}
+
+const FDlgSpeechSequenceEntry* UDlgNode_SpeechSequence::GetActiveSpeechSequenceEntry(const UDlgContext& Context) const
+{
+	const int32 SpeechSequenceIndex = GetSpeechSequenceIndex(Context);
+	return SpeechSequence.IsValidIndex(SpeechSequenceIndex) ? &SpeechSequence[SpeechSequenceIndex] : nullptr;
+}
 
-	return FText::GetEmpty();
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+const FText& UDlgNode_SpeechSequence::GetNodeText() const
+{
+	const FDlgSpeechSequenceEntry* Entry = GetFirstSpeechSequenceEntry();
+	return Entry ? Entry->Text : FText::GetEmpty();
 }
 
 UDlgNodeData* UDlgNode_SpeechSequence::GetNodeData() const
 {
-	if (SpeechSequence.IsValidIndex(ActualIndex))
-	{
-		return SpeechSequence[ActualIndex].NodeData;
-	}
-
-	return nullptr;
+	const FDlgSpeechSequenceEntry* Entry = GetFirstSpeechSequenceEntry();
+	return Entry ? Entry->NodeData : nullptr;
 }
 
 USoundBase* UDlgNode_SpeechSequence::GetNodeVoiceSoundBase() const
 {
-	if (SpeechSequence.IsValidIndex(ActualIndex))
-	{
-		return SpeechSequence[ActualIndex].VoiceSoundWave;
-	}
-
-	return nullptr;
+	const FDlgSpeechSequenceEntry* Entry = GetFirstSpeechSequenceEntry();
+	return Entry ? Entry->VoiceSoundWave : nullptr;
 }
 
 UDialogueWave* UDlgNode_SpeechSequence::GetNodeVoiceDialogueWave() const
 {
-	if (SpeechSequence.IsValidIndex(ActualIndex))
-	{
-		return SpeechSequence[ActualIndex].VoiceDialogueWave;
-	}
+	const FDlgSpeechSequenceEntry* Entry = GetFirstSpeechSequenceEntry();
+	return Entry ? Entry->VoiceDialogueWave : nullptr;
+}
 
-	return nullptr;
+FName UDlgNode_SpeechSequence::GetSpeakerState() const
+{
+	const FDlgSpeechSequenceEntry* Entry = GetFirstSpeechSequenceEntry();
+	return Entry ? Entry->SpeakerState : NAME_None;
 }
 
 UObject* UDlgNode_SpeechSequence::GetNodeGenericData() const
 {
-	if (SpeechSequence.IsValidIndex(ActualIndex))
-	{
-		return SpeechSequence[ActualIndex].GenericData;
-	}
-
-	return nullptr;
+	const FDlgSpeechSequenceEntry* Entry = GetFirstSpeechSequenceEntry();
+	return Entry ? Entry->GenericData : nullptr;
 }
 
-FName UDlgNode_SpeechSequence::GetSpeakerState() const
+FName UDlgNode_SpeechSequence::GetNodeParticipantName() const
 {
-	if (SpeechSequence.IsValidIndex(ActualIndex))
-	{
-		return SpeechSequence[ActualIndex].SpeakerState;
-	}
-
-	return NAME_None;
+	const FDlgSpeechSequenceEntry* Entry = GetFirstSpeechSequenceEntry();
+	return Entry ? Entry->Speaker : OwnerName;
 }
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
 
 void UDlgNode_SpeechSequence::AddAllSpeakerStatesIntoSet(TSet<FName>& OutStates) const
 {
@@ -204,16 +218,6 @@ void UDlgNode_SpeechSequence::AddAllSpeakerStatesIntoSet(TSet<FName>& OutStates)
 	}
 }
 
-FName UDlgNode_SpeechSequence::GetNodeParticipantName() const
-{
-	if (SpeechSequence.IsValidIndex(ActualIndex))
-	{
-		return SpeechSequence[ActualIndex].Speaker;
-	}
-
-	return OwnerName;
-}
-
 void UDlgNode_SpeechSequence::GetAssociatedParticipants(TArray<FName>& OutArray) const
 {
 	Super::GetAssociatedParticipants(OutArray);
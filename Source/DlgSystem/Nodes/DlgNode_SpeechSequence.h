@@ -76,20 +76,30 @@ public:
 	// Begin UDlgNode interface
 	void UpdateTextsValuesFromDefaultsAndRemappings(const UDlgSystemSettings& Settings, bool bEdges, bool bUpdateGraphNode = true) override;
 	void UpdateTextsNamespacesAndKeys(const UDlgSystemSettings& Settings, bool bEdges, bool bUpdateGraphNode = true) override;
-	bool HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep) override;
-	bool ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated) override;
+	bool HandleNodeEnter(UDlgContext& Context, FDlgTraversalState& NodesEnteredWithThisStep) override;
+	bool ReevaluateChildren(UDlgContext& Context, FDlgTraversalState& AlreadyEvaluated) override;
 	bool OptionSelected(int32 OptionIndex, bool bFromAll, UDlgContext& Context) override;
 
 	// Getters
+	// NOTE: the active entry depends on the context, use the UDlgContext::GetActiveNode* getters or GetActiveSpeechSequenceEntry
+	void AddAllSpeakerStatesIntoSet(TSet<FName>& OutStates) const override;
+	void GetAssociatedParticipants(TArray<FName>& OutArray) const override;
+
+	// Deprecated context free getters, the node does not know the active entry (it is stored in the Context), they always read the first entry
+	UE_DEPRECATED(5.4, "GetNodeText of a speech sequence has been deprecated in favour of GetActiveSpeechSequenceEntry(Context) or UDlgContext::GetActiveNodeText, it only reads the first entry")
 	const FText& GetNodeText() const override;
+	UE_DEPRECATED(5.4, "GetNodeData of a speech sequence has been deprecated in favour of GetActiveSpeechSequenceEntry(Context) or UDlgContext::GetActiveNodeData, it only reads the first entry")
 	UDlgNodeData* GetNodeData() const override;
+	UE_DEPRECATED(5.4, "GetNodeVoiceSoundBase of a speech sequence has been deprecated in favour of GetActiveSpeechSequenceEntry(Context) or UDlgContext::GetActiveNodeVoiceSoundBase, it only reads the first entry")
 	USoundBase* GetNodeVoiceSoundBase() const override;
+	UE_DEPRECATED(5.4, "GetNodeVoiceDialogueWave of a speech sequence has been deprecated in favour of GetActiveSpeechSequenceEntry(Context) or UDlgContext::GetActiveNodeVoiceDialogueWave, it only reads the first entry")
 	UDialogueWave* GetNodeVoiceDialogueWave() const override;
+	UE_DEPRECATED(5.4, "GetSpeakerState of a speech sequence has been deprecated in favour of GetActiveSpeechSequenceEntry(Context) or UDlgContext::GetActiveNodeSpeakerState, it only reads the first entry")
 	FName GetSpeakerState() const override;
-	void AddAllSpeakerStatesIntoSet(TSet<FName>& OutStates) const override;
+	UE_DEPRECATED(5.4, "GetNodeGenericData of a speech sequence has been deprecated in favour of GetActiveSpeechSequenceEntry(Context) or UDlgContext::GetActiveNodeGenericData, it only reads the first entry")
 	UObject* GetNodeGenericData() const override;
+	UE_DEPRECATED(5.4, "GetNodeParticipantName of a speech sequence has been deprecated in favour of GetActiveSpeechSequenceEntry(Context) or UDlgContext::GetActiveNodeParticipantName, it only reads the first entry")
 	FName GetNodeParticipantName() const override;
-	void GetAssociatedParticipants(TArray<FName>& OutArray) const override;
 
 #if WITH_EDITOR
 	FString GetNodeTypeString() const override { return TEXT("Speech Sequence"); }
@@ -102,11 +112,18 @@ public:
 	//
 
 	// Useful for multiplayer when you replicate the GetSpeechSequenceIndex
-	// This is different from OptionSelected  because this just sets the ActualIndex = OptionIndex instead of incremeting
-	// the Actual Index
-	// TODO: Proper replicate ActualIndex instead of this hack and all the subnodes
+	// This is different from OptionSelected  because this just sets the speech sequence index = OptionIndex instead of incremeting
+	// the speech sequence index
+	// TODO: Proper replicate the speech sequence index instead of this hack and all the subnodes
 	bool OptionSelectedFromReplicated(int32 OptionIndex, bool bFromAll, UDlgContext& Context);
-	int32 GetSpeechSequenceIndex() const { return ActualIndex; }
+
+	// The active index in the SpeechSequence array, stored in the Context (see FDlgNodeState)
+	int32 GetSpeechSequenceIndex(const UDlgContext& Context) const;
+
+	UE_DEPRECATED(5.4, "GetSpeechSequenceIndex() has been deprecated in favour of GetSpeechSequenceIndex(Context), the index is stored in the Context")
+	int32 GetSpeechSequenceIndex() const { return 0; }
+
+	const FDlgSpeechSequenceEntry* GetActiveSpeechSequenceEntry(const UDlgContext& Context) const;
 
 	// Fills the inner edges from the corresponding  input data (SpeechSequence)
 	void AutoGenerateInnerEdges();
@@ -118,6 +135,9 @@ public:
 	// Gets the SpeechSequence as a mutable array
 	TArray<FDlgSpeechSequenceEntry>* GetMutableNodeSpeechSequence() { return &SpeechSequence; }
 
+	// Gets the inner edges, one for each entry of the SpeechSequence
+	const TArray<FDlgEdge>& GetInnerEdges() const { return InnerEdges; }
+
 	// Tells us if the speech sequence has any speeches (aka not empty)
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
 	bool HasSpeechSequences() const { return SpeechSequence.Num() > 0; }
@@ -125,6 +145,15 @@ public:
 	// Helper functions to get the names of some properties. Used by the DlgSystemEditor module.
 	static FName GetMemberNameSpeechSequence() { return GET_MEMBER_NAME_CHECKED(UDlgNode_SpeechSequence, SpeechSequence); }
 
+protected:
+	void SetSpeechSequenceIndex(UDlgContext& Context, int32 Index) const;
+
+	// Only for the deprecated context free getters
+	const FDlgSpeechSequenceEntry* GetFirstSpeechSequenceEntry() const
+	{
+		return SpeechSequence.Num() > 0 ? &SpeechSequence[0] : nullptr;
+	}
+
 protected:
 	// Array of important stuff to say
 	UPROPERTY(EditAnywhere, Category = "Dialogue|Node")
@@ -133,7 +162,4 @@ protected:
 	// Inner edge, filled automatically based on SpeechSequence
 	UPROPERTY()
 	TArray<FDlgEdge> InnerEdges;
-
-	// The current active index in the SpeechSequence array
-	int32 ActualIndex = INDEX_NONE;
 };
@@ -3,7 +3,10 @@
 #include "CoreTypes.h"
 #include "DlgIOTesterTypes.h"
 #include "Containers/UnrealString.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/AutomationTest.h"
+#include "Serialization/JsonSerializer.h"
 
 #include "DlgSystem/IO/DlgConfigWriter.h"
 #include "DlgSystem/IO/DlgConfigParser.h"
@@ -15,6 +18,20 @@ DEFINE_LOG_CATEGORY(LogDlgIOTester);
 
 #if WITH_DEV_AUTOMATION_TESTS
 
+// Same as FDlgJsonParser but reads through the FJsonObject DOM, the streaming reader must give the same results
+class FDlgJsonDomParser : public FDlgJsonParser
+{
+public:
+	FDlgJsonDomParser() { SetUseStreamingReader(false); }
+};
+
+// Physical memory used by the process, see FPlatformMemory::GetStats
+// NOTE: process wide and it depends on the caches of the allocator, only an estimate of the memory used by a single operation
+static int64 GetUsedPhysicalBytes()
+{
+	return static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+}
+
 class FDlgIOTester
 {
 public:
@@ -130,6 +147,7 @@ bool FDlgIOTester::TestAllParsers(FAutomationTestBase& Test)
 	Options.bSupportsDatePrimitive = false;
 	Options.bSupportsUObjectValueInMap = false;
 	bAllSucceeded &= TestParser<FDlgJsonWriter, FDlgJsonParser>(Test, Options, TEXT("FDlgJsonWriter"), TEXT("FDlgJsonParser"));
+	bAllSucceeded &= TestParser<FDlgJsonWriter, FDlgJsonDomParser>(Test, Options, TEXT("FDlgJsonWriter"), TEXT("FDlgJsonDomParser"));
 
 	Options = {};
 	Options.bSupportsPureEnumContainer = false;
@@ -162,4 +180,378 @@ bool FDlgIOAutomationTest::RunTest(const FString& Parameters)
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgJsonParserBenchmark,
+	"DlgSystem.IO.JsonParserBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgJsonParserBenchmark::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumStructs = 2000;
+	static constexpr int32 NumIterations = 5;
+
+	FDlgIOTesterOptions Options;
+	Options.bSupportsDatePrimitive = false;
+	Options.bSupportsUObjectValueInMap = false;
+	FDlgTestArrayComplex ExportedStruct;
+	ExportedStruct.GenerateRandomData(Options);
+	for (int32 Index = 0; Index < NumStructs; Index++)
+	{
+		ExportedStruct.StructArrayPrimitives.AddDefaulted_GetRef().GenerateRandomData(Options);
+	}
+
+	FDlgJsonWriter Writer;
+	Writer.Write(FDlgTestArrayComplex::StaticStruct(), &ExportedStruct);
+	const FString& JsonString = Writer.GetAsString();
+	const double JsonMegaBytes = static_cast<double>(JsonString.Len() * sizeof(TCHAR)) / (1024.0 * 1024.0);
+
+	auto Benchmark = [&](bool bStreaming, int64& OutUsedBytes)
+	{
+		// Memory used by a single read, measured while the parser (and the DOM of the non streaming reader) is still alive
+		{
+			FDlgTestArrayComplex ImportedStruct;
+			ImportedStruct.GenerateRandomData(Options);
+			FDlgJsonParser Parser;
+			Parser.SetUseStreamingReader(bStreaming);
+
+			const int64 UsedBytesBefore = GetUsedPhysicalBytes();
+			Parser.InitializeParserFromString(JsonString);
+			Parser.ReadAllProperty(FDlgTestArrayComplex::StaticStruct(), &ImportedStruct);
+			OutUsedBytes = FMath::Max<int64>(GetUsedPhysicalBytes() - UsedBytesBefore, 0);
+		}
+
+		double Seconds = 0.0;
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			FDlgTestArrayComplex ImportedStruct;
+			ImportedStruct.GenerateRandomData(Options);
+			FDlgJsonParser Parser;
+			Parser.SetUseStreamingReader(bStreaming);
+			Parser.InitializeParserFromString(JsonString);
+
+			const double StartTime = FPlatformTime::Seconds();
+			Parser.ReadAllProperty(FDlgTestArrayComplex::StaticStruct(), &ImportedStruct);
+			Seconds += FPlatformTime::Seconds() - StartTime;
+
+			FString ErrorMessage;
+			TestTrue(FString::Printf(TEXT("Same struct (streaming = %d)"), bStreaming), ExportedStruct.IsEqual(ImportedStruct, ErrorMessage));
+		}
+
+		UE_LOG(
+			LogDlgIOTester, Display, TEXT("FDlgJsonParser (streaming = %d): %.2f MB/s, used memory = %.2f MB for %.2f MB of JSON"),
+			bStreaming, JsonMegaBytes * NumIterations / FMath::Max(Seconds, SMALL_NUMBER), OutUsedBytes / (1024.0 * 1024.0), JsonMegaBytes
+		);
+	};
+
+	// Only logged, the process wide memory stats are too noisy to compare in a test
+	int64 DomUsedBytes = 0;
+	int64 StreamingUsedBytes = 0;
+	Benchmark(false, DomUsedBytes);
+	Benchmark(true, StreamingUsedBytes);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgJsonParserPropertyLookupTest,
+	"DlgSystem.IO.JsonParserPropertyLookup",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgJsonParserPropertyLookupTest::RunTest(const FString& Parameters)
+{
+	// The cached lookup finds the same properties as searching all of them
+	const TArray<const UStruct*> Structs = {
+		FDlgTestStructPrimitives::StaticStruct(),
+		FDlgTestStructComplex::StaticStruct(),
+		FDlgTestArrayPrimitive::StaticStruct(),
+		FDlgTestArrayComplex::StaticStruct(),
+		FDlgTestSetPrimitive::StaticStruct(),
+		FDlgTestSetComplex::StaticStruct(),
+		FDlgTestMapPrimitive::StaticStruct(),
+		FDlgTestMapComplex::StaticStruct(),
+		UDlgTestObjectPrimitivesBase::StaticClass(),
+		UDlgTestObjectPrimitives_ChildA::StaticClass(),
+		UDlgTestObjectPrimitives_GrandChildA_Of_ChildA::StaticClass()
+	};
+	for (const UStruct* Struct : Structs)
+	{
+		for (TFieldIterator<FProperty> PropIt(Struct); PropIt; ++PropIt)
+		{
+			const FString PropertyName = PropIt->GetName();
+			for (const FString& AttributeName : { PropertyName, PropertyName.ToUpper(), PropertyName.ToLower() })
+			{
+				FProperty* LinearProperty = nullptr;
+				for (TFieldIterator<FProperty> OtherPropIt(Struct); OtherPropIt; ++OtherPropIt)
+				{
+					if (OtherPropIt->GetName().Equals(AttributeName, ESearchCase::IgnoreCase))
+					{
+						LinearProperty = *OtherPropIt;
+						break;
+					}
+				}
+
+				TestTrue(
+					FString::Printf(TEXT("%s.%s"), *Struct->GetName(), *AttributeName),
+					FDlgJsonParser::FindPropertyForJsonAttribute(Struct, AttributeName) == LinearProperty
+				);
+			}
+		}
+		TestNull(TEXT("Unknown attribute"), FDlgJsonParser::FindPropertyForJsonAttribute(Struct, TEXT("__type__")));
+	}
+
+	// Same struct read from the attributes in any case, by both readers
+	FDlgIOTesterOptions Options;
+	Options.bSupportsDatePrimitive = false;
+	Options.bSupportsUObjectValueInMap = false;
+	FDlgTestStructPrimitives ExportedStruct;
+	ExportedStruct.GenerateRandomData(Options);
+
+	FDlgJsonWriter Writer;
+	Writer.Write(FDlgTestStructPrimitives::StaticStruct(), &ExportedStruct);
+	TSharedPtr<FJsonObject> JsonObject;
+	if (!TestTrue(TEXT("Deserialize"), FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Writer.GetAsString()), JsonObject) && JsonObject.IsValid()))
+	{
+		return false;
+	}
+
+	TSharedRef<FJsonObject> LowerCaseJsonObject = MakeShared<FJsonObject>();
+	for (const auto& Elem : JsonObject->Values)
+	{
+		LowerCaseJsonObject->SetField(Elem.Key.ToLower(), Elem.Value);
+	}
+	FString LowerCaseJsonString;
+	FJsonSerializer::Serialize(LowerCaseJsonObject, TJsonWriterFactory<>::Create(&LowerCaseJsonString));
+
+	for (const bool bStreaming : { false, true })
+	{
+		FDlgTestStructPrimitives ImportedStruct;
+		ImportedStruct.GenerateRandomData(Options);
+		FDlgJsonParser Parser;
+		Parser.SetUseStreamingReader(bStreaming);
+		Parser.InitializeParserFromString(LowerCaseJsonString);
+		Parser.ReadAllProperty(FDlgTestStructPrimitives::StaticStruct(), &ImportedStruct);
+
+		FString ErrorMessage;
+		const bool bEqual = ExportedStruct.IsEqual(ImportedStruct, ErrorMessage);
+		TestTrue(FString::Printf(TEXT("Same struct (streaming = %d): %s"), bStreaming, *ErrorMessage), bEqual);
+	}
+
+	return true;
+}
+
+// Exposes the class lookup of the parsers
+class FDlgClassNameTestParser : public FDlgJsonParser
+{
+public:
+	using FDlgJsonParser::GetChildClassFromName;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgParserChildClassFromNameTest,
+	"DlgSystem.IO.ChildClassFromName",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgParserChildClassFromNameTest::RunTest(const FString& Parameters)
+{
+	const UClass* BaseClass = UDlgTestObjectPrimitivesBase::StaticClass();
+	const UClass* ChildAClass = UDlgTestObjectPrimitives_ChildA::StaticClass();
+	const UClass* ChildBClass = UDlgTestObjectPrimitives_ChildB::StaticClass();
+	const UClass* GrandChildClass = UDlgTestObjectPrimitives_GrandChildA_Of_ChildA::StaticClass();
+
+	// Twice, the second time from the cache
+	for (int32 Iteration = 0; Iteration < 2; Iteration++)
+	{
+		TestTrue(TEXT("ChildA of Base"), FDlgClassNameTestParser::GetChildClassFromName(BaseClass, ChildAClass->GetName()) == ChildAClass);
+		TestTrue(TEXT("ChildB of Base"), FDlgClassNameTestParser::GetChildClassFromName(BaseClass, ChildBClass->GetName()) == ChildBClass);
+		TestTrue(TEXT("GrandChild of Base"), FDlgClassNameTestParser::GetChildClassFromName(BaseClass, GrandChildClass->GetName()) == GrandChildClass);
+		TestTrue(TEXT("GrandChild of ChildA"), FDlgClassNameTestParser::GetChildClassFromName(ChildAClass, GrandChildClass->GetName()) == GrandChildClass);
+		TestTrue(TEXT("Case insensitive"), FDlgClassNameTestParser::GetChildClassFromName(BaseClass, ChildAClass->GetName().ToUpper()) == ChildAClass);
+
+		TestNull(TEXT("ChildB is not a child of ChildA"), FDlgClassNameTestParser::GetChildClassFromName(ChildAClass, ChildBClass->GetName()));
+		TestNull(TEXT("Base is not a child of ChildA"), FDlgClassNameTestParser::GetChildClassFromName(ChildAClass, BaseClass->GetName()));
+		TestNull(TEXT("Unknown class"), FDlgClassNameTestParser::GetChildClassFromName(BaseClass, TEXT("DlgTestObjectPrimitives_ThisClassDoesNotExist")));
+		TestNull(TEXT("Empty name"), FDlgClassNameTestParser::GetChildClassFromName(BaseClass, TEXT("")));
+	}
+
+	IDlgParser::ClearClassCache();
+	TestTrue(TEXT("ChildA of Base after ClearClassCache"), FDlgClassNameTestParser::GetChildClassFromName(BaseClass, ChildAClass->GetName()) == ChildAClass);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgConfigParserBenchmark,
+	"DlgSystem.IO.ConfigParserBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgConfigParserBenchmark::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumStructs = 2000;
+	static constexpr int32 NumIterations = 5;
+
+	// Same options as FDlgIOTester::TestAllParsers uses for the config parser
+	FDlgIOTesterOptions Options;
+	Options.bSupportsPureEnumContainer = false;
+	Options.bSupportsNonPrimitiveInSet = false;
+	Options.bSupportsColorPrimitives = false;
+	Options.bSupportsDatePrimitive = false;
+	Options.bSupportsUObjectValueInMap = false;
+	FDlgTestArrayComplex ExportedStruct;
+	ExportedStruct.GenerateRandomData(Options);
+	for (int32 Index = 0; Index < NumStructs; Index++)
+	{
+		ExportedStruct.StructArrayPrimitives.AddDefaulted_GetRef().GenerateRandomData(Options);
+	}
+
+	FDlgConfigWriter Writer;
+	Writer.Write(FDlgTestArrayComplex::StaticStruct(), &ExportedStruct);
+	const FString& ConfigString = Writer.GetAsString();
+	const double ConfigMegaBytes = static_cast<double>(ConfigString.Len() * sizeof(TCHAR)) / (1024.0 * 1024.0);
+
+	double Seconds = 0.0;
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		FDlgTestArrayComplex ImportedStruct;
+		ImportedStruct.GenerateRandomData(Options);
+		FDlgConfigParser Parser;
+		Parser.InitializeParserFromString(ConfigString);
+
+		const double StartTime = FPlatformTime::Seconds();
+		Parser.ReadAllProperty(FDlgTestArrayComplex::StaticStruct(), &ImportedStruct);
+		Seconds += FPlatformTime::Seconds() - StartTime;
+
+		FString ErrorMessage;
+		const bool bEqual = ExportedStruct.IsEqual(ImportedStruct, ErrorMessage);
+		TestTrue(FString::Printf(TEXT("Same struct: %s"), *ErrorMessage), bEqual);
+	}
+
+	UE_LOG(
+		LogDlgIOTester, Display, TEXT("FDlgConfigParser: %.2f MB/s for %.2f MB of config"),
+		ConfigMegaBytes * NumIterations / FMath::Max(Seconds, SMALL_NUMBER), ConfigMegaBytes
+	);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgJsonWriterSameAsSerializerTest,
+	"DlgSystem.IO.JsonWriterSameAsSerializer",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgJsonWriterSameAsSerializerTest::RunTest(const FString& Parameters)
+{
+	// The writer does not build an FJsonObject, the output must be the same as serializing one
+	FDlgIOTesterOptions Options;
+	Options.bSupportsDatePrimitive = false;
+	Options.bSupportsUObjectValueInMap = false;
+	for (int32 Iteration = 0; Iteration < 10; Iteration++)
+	{
+		FDlgTestArrayComplex ExportedStruct;
+		ExportedStruct.GenerateRandomData(Options);
+
+		FDlgJsonWriter Writer;
+		Writer.Write(FDlgTestArrayComplex::StaticStruct(), &ExportedStruct);
+		TSharedPtr<FJsonObject> JsonObject;
+		if (!TestTrue(TEXT("Deserialize"), FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Writer.GetAsString()), JsonObject) && JsonObject.IsValid()))
+		{
+			return false;
+		}
+
+		FString SerializedJsonString;
+		FJsonSerializer::Serialize(JsonObject.ToSharedRef(), TJsonWriterFactory<>::Create(&SerializedJsonString));
+		TestEqual(TEXT("Same JSON string"), Writer.GetAsString(), SerializedJsonString);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgWriterGoldenTest,
+	"DlgSystem.IO.WriterGolden",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgWriterGoldenTest::RunTest(const FString& Parameters)
+{
+	// Fixed data, the golden texts below were written by the writers that built an FJsonObject DOM and concatenated FStrings
+	FDlgTestGolden Golden;
+	Golden.Integer32 = -42;
+	Golden.Integer64 = 1234567890123;
+	Golden.bBoolean = true;
+	Golden.Enum = EDlgTestEnum::Second;
+	Golden.Name = TEXT("Speaker");
+	Golden.String = TEXT("C:\\Dialogues");
+	Golden.Text = FText::FromString(TEXT("Hello World"));
+	Golden.StringArray = { TEXT("First"), TEXT("Second") };
+	Golden.StringMap.Add(TEXT("KeyA"), TEXT("ValueA"));
+	Golden.StringMap.Add(TEXT("KeyB"), TEXT("ValueB"));
+	Golden.Inner.Integer32 = 7;
+	Golden.Inner.Name = TEXT("Inner");
+
+	// JSON, the pretty print policy ends the lines with LINE_TERMINATOR
+	const FString GoldenJson = FString::Join(TArray<FString>{
+		TEXT("{"),
+		TEXT("\t\"Integer32\": -42,"),
+		TEXT("\t\"Integer64\": 1234567890123,"),
+		TEXT("\t\"bBoolean\": true,"),
+		TEXT("\t\"Enum\": \"EDlgTestEnum::Second\","),
+		TEXT("\t\"Name\": \"Speaker\","),
+		TEXT("\t\"String\": \"C:\\\\Dialogues\","),
+		TEXT("\t\"Text\": \"Hello World\","),
+		TEXT("\t\"StringArray\": ["),
+		TEXT("\t\t\"First\","),
+		TEXT("\t\t\"Second\""),
+		TEXT("\t],"),
+		TEXT("\t\"StringMap\":"),
+		TEXT("\t{"),
+		TEXT("\t\t\"KeyA\": \"ValueA\","),
+		TEXT("\t\t\"KeyB\": \"ValueB\""),
+		TEXT("\t},"),
+		TEXT("\t\"Inner\":"),
+		TEXT("\t{"),
+		TEXT("\t\t\"Integer32\": 7,"),
+		TEXT("\t\t\"Name\": \"Inner\""),
+		TEXT("\t}"),
+		TEXT("}")
+	}, LINE_TERMINATOR);
+
+	FDlgJsonWriter JsonWriter;
+	JsonWriter.Write(FDlgTestGolden::StaticStruct(), &Golden);
+	const bool bSameJson = JsonWriter.GetAsString().Equals(GoldenJson, ESearchCase::CaseSensitive);
+	if (!TestTrue(TEXT("Same JSON as the golden text"), bSameJson))
+	{
+		UE_LOG(LogDlgIOTester, Warning, TEXT("Golden JSON = |%s|\n"), *GoldenJson);
+		UE_LOG(LogDlgIOTester, Warning, TEXT("Written JSON = |%s|\n"), *JsonWriter.GetAsString());
+	}
+
+	// Config, primitives first then the primitive containers and the complex elements, always ends the lines with LF
+	const FString GoldenConfig =
+		TEXT("Integer32 -42\n")
+		TEXT("Integer64 1234567890123\n")
+		TEXT("bBoolean True\n")
+		TEXT("Enum \"EDlgTestEnum::Second\"\n")
+		TEXT("Name \"Speaker\"\n")
+		TEXT("String \"C:\\Dialogues\"\n")
+		TEXT("Text \"Hello World\"\n")
+		TEXT("StringArray { \"First\" \"Second\" }\n")
+		TEXT("StringMap { \"KeyA\" \"ValueA\" \"KeyB\" \"ValueB\" }\n")
+		TEXT("Inner {  Integer32 7 Name \"Inner\" }\n");
+
+	FDlgConfigWriter ConfigWriter;
+	ConfigWriter.Write(FDlgTestGolden::StaticStruct(), &Golden);
+	const bool bSameConfig = ConfigWriter.GetAsString().Equals(GoldenConfig, ESearchCase::CaseSensitive);
+	if (!TestTrue(TEXT("Same config as the golden text"), bSameConfig))
+	{
+		UE_LOG(LogDlgIOTester, Warning, TEXT("Golden config = |%s|\n"), *GoldenConfig);
+		UE_LOG(LogDlgIOTester, Warning, TEXT("Written config = |%s|\n"), *ConfigWriter.GetAsString());
+	}
+
+	return true;
+}
+
 #endif //WITH_DEV_AUTOMATION_TESTS
@@ -659,3 +659,55 @@ public:
 	UPROPERTY()
 	TMap<FName, FDlgTestSetComplex> NameToStructOfSetComplex;
 };
+
+// Struct inside FDlgTestGolden
+USTRUCT()
+struct DLGSYSTEM_API FDlgTestGoldenInner
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	UPROPERTY()
+	int32 Integer32 = 0;
+
+	UPROPERTY()
+	FName Name;
+};
+
+// Fixed data, the writers must produce the same text as the golden text
+USTRUCT()
+struct DLGSYSTEM_API FDlgTestGolden
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	UPROPERTY()
+	int32 Integer32 = 0;
+
+	UPROPERTY()
+	int64 Integer64 = 0;
+
+	UPROPERTY()
+	bool bBoolean = false;
+
+	UPROPERTY()
+	EDlgTestEnum Enum = EDlgTestEnum::First;
+
+	UPROPERTY()
+	FName Name;
+
+	UPROPERTY()
+	FString String;
+
+	UPROPERTY()
+	FText Text;
+
+	UPROPERTY()
+	TArray<FString> StringArray;
+
+	UPROPERTY()
+	TMap<FString, FString> StringMap;
+
+	UPROPERTY()
+	FDlgTestGoldenInner Inner;
+};
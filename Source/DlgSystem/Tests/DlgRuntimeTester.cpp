@@ -0,0 +1,1746 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "DlgRuntimeTesterTypes.h"
+#include "GameFramework/Character.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "AssetRegistry/AssetData.h"
+#include "UObject/Package.h"
+
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgDialogueIndex.h"
+#include "DlgSystem/DlgManager.h"
+#include "DlgSystem/DlgParticipantRegistry.h"
+#include "DlgSystem/DlgNativeDialogueParticipant.h"
+#include "DlgSystem/DlgSystemSettings.h"
+#include "DlgSystem/DlgMemory.h"
+#include "DlgSystem/IO/DlgHistoryCodec.h"
+#include "DlgSystem/Nodes/DlgNode_End.h"
+#include "DlgSystem/Nodes/DlgNode_Start.h"
+#include "DlgSystem/Nodes/DlgNode_Speech.h"
+#include "DlgSystem/Nodes/DlgNode_Selector.h"
+#include "DlgSystem/Nodes/DlgNode_SpeechSequence.h"
+#include "DlgSystem/NYReflectionHelper.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDlgRuntimeTester, All, All);
+DEFINE_LOG_CATEGORY(LogDlgRuntimeTester);
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Counts the allocations made by the thread that installed it, forwards everything to the original GMalloc.
+class FDlgAllocationCounter : public FMalloc
+{
+public:
+	FDlgAllocationCounter()
+		: InnerMalloc(GMalloc), OwnerThreadId(FPlatformTLS::GetCurrentThreadId())
+	{
+		GMalloc = this;
+	}
+	~FDlgAllocationCounter()
+	{
+		GMalloc = InnerMalloc;
+	}
+
+	int32 GetNumAllocations() const { return NumAllocations.GetValue(); }
+	void ResetNumAllocations() { NumAllocations.Reset(); }
+
+	//
+	// FMalloc Interface
+	//
+
+	void* Malloc(SIZE_T Count, uint32 Alignment) override
+	{
+		CountAllocation();
+		return InnerMalloc->Malloc(Count, Alignment);
+	}
+	void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		if (Count > 0)
+		{
+			CountAllocation();
+		}
+		return InnerMalloc->Realloc(Original, Count, Alignment);
+	}
+	void Free(void* Original) override { InnerMalloc->Free(Original); }
+	bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return InnerMalloc->GetAllocationSize(Original, SizeOut); }
+	SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return InnerMalloc->QuantizeSize(Count, Alignment); }
+	bool IsInternallyThreadSafe() const override { return InnerMalloc->IsInternallyThreadSafe(); }
+	const TCHAR* GetDescriptiveName() override { return TEXT("DlgAllocationCounter"); }
+
+protected:
+	void CountAllocation()
+	{
+		if (FPlatformTLS::GetCurrentThreadId() == OwnerThreadId)
+		{
+			NumAllocations.Increment();
+		}
+	}
+
+protected:
+	FMalloc* InnerMalloc = nullptr;
+	uint32 OwnerThreadId = 0;
+	FThreadSafeCounter NumAllocations;
+};
+
+
+class FDlgRuntimeTester
+{
+public:
+	// Creates a Dialogue with NumNodes nodes, every node has a few conditional edges to other nodes and every fifth node is a selector
+	// The Hub node (index 0) has an edge for every node up to NumHubEdges. The conditions read UDlgTestParticipant::Integer and bBool.
+	static UDlgDialogue* CreateLargeDialogue(FName ParticipantName, int32 NumNodes, int32 NumHubEdges);
+
+	// Creates a Dialogue where the Hub node (index 0) has NumHubEdges edges:
+	// - half of them go to virtual parents that point back to the hub
+	// - the other half go to a chain of selectors (they check their children on evaluation) that ends back at the hub
+	static UDlgDialogue* CreateHubDialogue(FName ParticipantName, int32 NumHubEdges);
+
+	// Saves and restores the global memory, so that the tests do not leave anything behind
+	struct FScopedMemoryRestore
+	{
+		FScopedMemoryRestore() : HistoryMap(FDlgMemory::Get().GetHistoryMaps()) {}
+		~FScopedMemoryRestore() { FDlgMemory::Get().SetHistoryMap(HistoryMap); }
+
+		TMap<FGuid, FDlgHistory> HistoryMap;
+	};
+
+	static FDlgCondition CreateCondition(FName ParticipantName, EDlgConditionType ConditionType, FName CallbackName)
+	{
+		FDlgCondition Condition;
+		Condition.ParticipantName = ParticipantName;
+		Condition.ConditionType = ConditionType;
+		Condition.CallbackName = CallbackName;
+		return Condition;
+	}
+
+	template <typename NodeType>
+	static NodeType* CreateNode(UDlgDialogue* Dialogue, FName ParticipantName)
+	{
+		NodeType* Node = NewObject<NodeType>(Dialogue);
+		Node->RegenerateGUID();
+		Node->SetNodeParticipantName(ParticipantName);
+		return Node;
+	}
+};
+
+UDlgDialogue* FDlgRuntimeTester::CreateHubDialogue(FName ParticipantName, int32 NumHubEdges)
+{
+	UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+	if (!Dialogue->HasGUID())
+	{
+		Dialogue->RegenerateGUID();
+	}
+
+	TArray<UDlgNode*> Nodes;
+	UDlgNode_Speech* Hub = CreateNode<UDlgNode_Speech>(Dialogue, ParticipantName);
+	Nodes.Add(Hub);
+
+	const int32 NumVirtualParents = NumHubEdges / 2;
+	const int32 NumSelectors = NumHubEdges - NumVirtualParents;
+
+	// Node after the selectors chain
+	UDlgNode_Speech* ChainEnd = CreateNode<UDlgNode_Speech>(Dialogue, ParticipantName);
+	ChainEnd->AddNodeChild(FDlgEdge(0));
+	const int32 ChainEndIndex = Nodes.Add(ChainEnd);
+
+	for (int32 Index = 0; Index < NumVirtualParents; Index++)
+	{
+		UDlgNode_Speech* VirtualParent = CreateNode<UDlgNode_Speech>(Dialogue, ParticipantName);
+		VirtualParent->SetIsVirtualParent(true);
+		VirtualParent->AddNodeChild(FDlgEdge(0));
+		Hub->AddNodeChild(FDlgEdge(Nodes.Add(VirtualParent)));
+	}
+
+	int32 NextChainIndex = ChainEndIndex;
+	for (int32 Index = 0; Index < NumSelectors; Index++)
+	{
+		UDlgNode_Selector* Selector = CreateNode<UDlgNode_Selector>(Dialogue, ParticipantName);
+		Selector->AddNodeChild(FDlgEdge(NextChainIndex));
+		NextChainIndex = Nodes.Add(Selector);
+		Hub->AddNodeChild(FDlgEdge(NextChainIndex));
+	}
+
+	UDlgNode_Start* StartNode = CreateNode<UDlgNode_Start>(Dialogue, ParticipantName);
+	StartNode->AddNodeChild(FDlgEdge(0));
+
+	Dialogue->SetStartNodes({ StartNode });
+	Dialogue->SetNodes(Nodes);
+	Dialogue->UpdateAndRefreshData();
+	return Dialogue;
+}
+
+UDlgDialogue* FDlgRuntimeTester::CreateLargeDialogue(FName ParticipantName, int32 NumNodes, int32 NumHubEdges)
+{
+	UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+	if (!Dialogue->HasGUID())
+	{
+		Dialogue->RegenerateGUID();
+	}
+
+	auto CreateIntCondition = [ParticipantName](int32 Value)
+	{
+		FDlgCondition Condition = CreateCondition(ParticipantName, EDlgConditionType::ClassIntVariable, GET_MEMBER_NAME_CHECKED(UDlgTestParticipant, Integer));
+		Condition.Operation = EDlgOperation::GreaterOrEqual;
+		Condition.IntValue = Value;
+		return Condition;
+	};
+
+	TArray<UDlgNode*> Nodes;
+	UDlgNode_Speech* Hub = CreateNode<UDlgNode_Speech>(Dialogue, ParticipantName);
+	Nodes.Add(Hub);
+	for (int32 NodeIndex = 1; NodeIndex < NumNodes; NodeIndex++)
+	{
+		UDlgNode* Node = nullptr;
+		if (NodeIndex % 5 == 0)
+		{
+			Node = CreateNode<UDlgNode_Selector>(Dialogue, ParticipantName);
+		}
+		else
+		{
+			Node = CreateNode<UDlgNode_Speech>(Dialogue, ParticipantName);
+		}
+
+		if (NodeIndex % 3 == 0)
+		{
+			Node->SetNodeEnterConditions({ CreateCondition(ParticipantName, EDlgConditionType::ClassBoolVariable, GET_MEMBER_NAME_CHECKED(UDlgTestParticipant, bBool)) });
+		}
+		for (const int32 TargetIndex : { (NodeIndex * 7 + 1) % NumNodes, (NodeIndex + 1) % NumNodes, (NodeIndex + 13) % NumNodes })
+		{
+			FDlgEdge Edge(TargetIndex);
+			Edge.Conditions.Add(CreateIntCondition(TargetIndex % 4));
+			Node->AddNodeChild(Edge);
+		}
+		Nodes.Add(Node);
+	}
+
+	for (int32 NodeIndex = 1; NodeIndex <= NumHubEdges && NodeIndex < NumNodes; NodeIndex++)
+	{
+		FDlgEdge Edge(NodeIndex);
+		Edge.Conditions.Add(CreateIntCondition(NodeIndex % 3));
+		Hub->AddNodeChild(Edge);
+	}
+	// Always at least one option
+	Hub->AddNodeChild(FDlgEdge(0));
+
+	UDlgNode_Start* StartNode = CreateNode<UDlgNode_Start>(Dialogue, ParticipantName);
+	StartNode->AddNodeChild(FDlgEdge(0));
+
+	Dialogue->SetStartNodes({ StartNode });
+	Dialogue->SetNodes(Nodes);
+	Dialogue->UpdateAndRefreshData();
+	return Dialogue;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgTraversalAllocationsTest,
+	"DlgSystem.Runtime.TraversalAllocations",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgTraversalAllocationsTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumHubEdges = 10;
+	static constexpr int32 NumSteps = 20;
+	const FDlgRuntimeTester::FScopedMemoryRestore MemoryRestore;
+
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateHubDialogue(Participant->ParticipantName, NumHubEdges);
+
+	TMap<FName, UObject*> Participants;
+	Participants.Add(Participant->ParticipantName, Participant);
+
+	UDlgContext* Context = NewObject<UDlgContext>(Participant);
+	if (!TestTrue(TEXT("Context started"), Context->Start(Dialogue, Participants)))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Hub options num"), Context->GetOptionsNum(), NumHubEdges);
+
+	// One step is: Hub -> virtual parent (options are the Hub children) -> selectors chain -> chain end -> Hub
+	auto DoStep = [Context]() -> bool
+	{
+		return Context->ChooseOption(0)
+			&& Context->ChooseOption(NumHubEdges - 1)
+			&& Context->ChooseOption(0);
+	};
+
+	// Warm up: visit every node once so that the history and the options arrays have their final size
+	TestTrue(TEXT("Warm up ReevaluateOptions"), Context->ReevaluateOptions());
+	TestTrue(TEXT("Warm up step"), DoStep());
+	TestTrue(TEXT("Warm up step"), DoStep());
+
+	int32 NumReevaluateAllocations = 0;
+	int32 NumChooseAllocations = 0;
+	{
+		FDlgAllocationCounter AllocationCounter;
+		for (int32 Step = 0; Step < NumSteps; Step++)
+		{
+			Context->ReevaluateOptions();
+		}
+		NumReevaluateAllocations = AllocationCounter.GetNumAllocations();
+
+		AllocationCounter.ResetNumAllocations();
+		for (int32 Step = 0; Step < NumSteps; Step++)
+		{
+			DoStep();
+		}
+		NumChooseAllocations = AllocationCounter.GetNumAllocations();
+	}
+
+	UE_LOG(LogDlgRuntimeTester, Display, TEXT("ReevaluateOptions allocations = %d, ChooseOption allocations = %d (for %d steps)"),
+		NumReevaluateAllocations, NumChooseAllocations, NumSteps);
+
+	TestEqual(TEXT("Active node is the Hub"), Context->GetActiveNodeIndex(), 0);
+	TestEqual(TEXT("ReevaluateOptions heap allocations"), NumReevaluateAllocations, 0);
+	TestEqual(TEXT("ChooseOption heap allocations"), NumChooseAllocations, 0);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgPropertyCacheBenchmark,
+	"DlgSystem.Runtime.PropertyCacheBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgPropertyCacheBenchmark::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumIterations = 1000;
+
+	// Class with a lot of (inherited) properties, like the participants of a real game
+	const UClass* Class = ACharacter::StaticClass();
+	const UObject* Object = Class->GetDefaultObject();
+
+	int32 NumProperties = 0;
+	for (auto* Property = Class->PropertyLink; Property != nullptr; Property = Property->PropertyLinkNext)
+	{
+		NumProperties++;
+	}
+
+	TArray<FName> FloatNames;
+	FNYReflectionHelper::GetVariableNames(Class, FFloatProperty::StaticClass(), FloatNames, {});
+	if (!TestTrue(TEXT("Class has float properties"), FloatNames.Num() > 0))
+	{
+		return false;
+	}
+
+	// The cache must find the same properties
+	for (const FName& Name : FloatNames)
+	{
+		TestTrue(
+			FString::Printf(TEXT("FindProperty(%s) == FindPropertyLinear(%s)"), *Name.ToString(), *Name.ToString()),
+			FNYReflectionHelper::FindProperty<FFloatProperty>(Class, Name) == FNYReflectionHelper::FindPropertyLinear<FFloatProperty>(Class, Name)
+		);
+	}
+
+	// What GetVariable used to do
+	double LinearSum = 0.0;
+	const double LinearStartSeconds = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		for (const FName& Name : FloatNames)
+		{
+			LinearSum += FNYReflectionHelper::FindPropertyLinear<FFloatProperty>(Class, Name)->GetPropertyValue_InContainer(Object);
+		}
+	}
+	const double LinearSeconds = FPlatformTime::Seconds() - LinearStartSeconds;
+
+	double CachedSum = 0.0;
+	const double CachedStartSeconds = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		for (const FName& Name : FloatNames)
+		{
+			CachedSum += FNYReflectionHelper::GetVariable<FFloatProperty, float>(Object, Name);
+		}
+	}
+	const double CachedSeconds = FPlatformTime::Seconds() - CachedStartSeconds;
+
+	UE_LOG(LogDlgRuntimeTester, Display, TEXT("Property lookup of %d float variables from a class with %d properties, %d iterations: linear = %.3f ms, cached = %.3f ms"),
+		FloatNames.Num(), NumProperties, NumIterations, LinearSeconds * 1000.0, CachedSeconds * 1000.0);
+	TestEqual(TEXT("Linear and cached values"), CachedSum, LinearSum);
+
+	// Invalidation
+	FNYReflectionHelper::ClearPropertyCache();
+	TestEqual(TEXT("Property cache is empty after ClearPropertyCache"), FNYReflectionHelper::GetPropertyCacheNum(), 0);
+	TestTrue(TEXT("FindProperty after ClearPropertyCache"), FNYReflectionHelper::FindProperty<FFloatProperty>(Class, FloatNames[0]) != nullptr);
+	TestEqual(TEXT("Property cache num"), FNYReflectionHelper::GetPropertyCacheNum(), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgBoundConditionsTest,
+	"DlgSystem.Runtime.BoundConditions",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgBoundConditionsTest::RunTest(const FString& Parameters)
+{
+	const FDlgRuntimeTester::FScopedMemoryRestore MemoryRestore;
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	const FName ParticipantName = Participant->ParticipantName;
+
+	UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+	if (!Dialogue->HasGUID())
+	{
+		Dialogue->RegenerateGUID();
+	}
+
+	// Hub with an edge for each condition type, every edge leads back to the hub
+	UDlgNode_Speech* Hub = FDlgRuntimeTester::CreateNode<UDlgNode_Speech>(Dialogue, ParticipantName);
+	{
+		FDlgEdge Edge(0);
+		FDlgCondition Condition = FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::ClassIntVariable, GET_MEMBER_NAME_CHECKED(UDlgTestParticipant, Integer));
+		Condition.Operation = EDlgOperation::GreaterOrEqual;
+		Condition.IntValue = 5;
+		Edge.Conditions.Add(Condition);
+		Hub->AddNodeChild(Edge);
+	}
+	{
+		FDlgEdge Edge(0);
+		FDlgCondition Condition = FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::ClassNameVariable, GET_MEMBER_NAME_CHECKED(UDlgTestParticipant, Name));
+		Condition.NameValue = TEXT("Expected");
+		Edge.Conditions.Add(Condition);
+		Hub->AddNodeChild(Edge);
+	}
+	{
+		FDlgEdge Edge(0);
+		Edge.Conditions.Add(FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::BoolCall, TEXT("Bool")));
+		Hub->AddNodeChild(Edge);
+	}
+
+	UDlgNode_Start* StartNode = FDlgRuntimeTester::CreateNode<UDlgNode_Start>(Dialogue, ParticipantName);
+	StartNode->AddNodeChild(FDlgEdge(0));
+	Dialogue->SetStartNodes({ StartNode });
+	Dialogue->SetNodes({ Hub });
+	Dialogue->UpdateAndRefreshData();
+
+	// At least one option must be satisfied, otherwise the dialogue ends
+	Participant->Integer = 5;
+
+	TMap<FName, UObject*> Participants;
+	Participants.Add(ParticipantName, Participant);
+	UDlgContext* Context = NewObject<UDlgContext>(Participant);
+	if (!TestTrue(TEXT("Context started"), Context->Start(Dialogue, Participants)))
+	{
+		return false;
+	}
+
+	TestTrue(TEXT("Conditions are bound"), Context->AreConditionsBound());
+	for (const FDlgEdge& Edge : Hub->GetNodeChildren())
+	{
+		TArrayView<const FDlgBoundCondition> BoundConditions;
+		TestTrue(TEXT("Edge conditions are bound"), Context->GetBoundConditions(Edge.Conditions, NAME_None, BoundConditions));
+		TestEqual(TEXT("Bound conditions num"), BoundConditions.Num(), Edge.Conditions.Num());
+	}
+	TestEqual(TEXT("Int condition is satisfied"), Context->GetOptionsNum(), 1);
+
+	// The bound conditions read the current values
+	Participant->Name = TEXT("Expected");
+	Participant->bBool = true;
+	TestTrue(TEXT("ReevaluateOptions"), Context->ReevaluateOptions());
+	TestEqual(TEXT("All conditions are satisfied"), Context->GetOptionsNum(), 3);
+
+	// Properties can change on blueprint compile/hot reload, must bind again
+	FNYReflectionHelper::ClearPropertyCache();
+	TestFalse(TEXT("Conditions are outdated after ClearPropertyCache"), Context->AreConditionsBound());
+	Participant->Integer = 4;
+	TestTrue(TEXT("ReevaluateOptions"), Context->ReevaluateOptions());
+	TestTrue(TEXT("Conditions are bound again by ReevaluateOptions"), Context->AreConditionsBound());
+	TestEqual(TEXT("Int condition is not satisfied"), Context->GetOptionsNum(), 2);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgIncrementalReevaluationTest,
+	"DlgSystem.Runtime.IncrementalReevaluation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgIncrementalReevaluationTest::RunTest(const FString& Parameters)
+{
+	const FDlgRuntimeTester::FScopedMemoryRestore MemoryRestore;
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	const FName ParticipantName = Participant->ParticipantName;
+	const FName BoolName = TEXT("Bool");
+
+	UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+	if (!Dialogue->HasGUID())
+	{
+		Dialogue->RegenerateGUID();
+	}
+
+	// Hub with two edges leading back to the hub, one always satisfied and one reading the Bool value
+	UDlgNode_Speech* Hub = FDlgRuntimeTester::CreateNode<UDlgNode_Speech>(Dialogue, ParticipantName);
+	Hub->AddNodeChild(FDlgEdge(0));
+	{
+		FDlgEdge Edge(0);
+		Edge.Conditions.Add(FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::BoolCall, BoolName));
+		Hub->AddNodeChild(Edge);
+	}
+
+	UDlgNode_Start* StartNode = FDlgRuntimeTester::CreateNode<UDlgNode_Start>(Dialogue, ParticipantName);
+	StartNode->AddNodeChild(FDlgEdge(0));
+	Dialogue->SetStartNodes({ StartNode });
+	Dialogue->SetNodes({ Hub });
+	Dialogue->UpdateAndRefreshData();
+
+	TMap<FName, UObject*> Participants;
+	Participants.Add(ParticipantName, Participant);
+	UDlgContext* Context = NewObject<UDlgContext>(Participant);
+	Context->SetIncrementalReevaluation(true);
+	if (!TestTrue(TEXT("Context started"), Context->Start(Dialogue, Participants)))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Bool condition is not satisfied"), Context->GetOptionsNum(), 1);
+
+	// Not notified, the option is not reevaluated
+	Participant->bBool = true;
+	TestTrue(TEXT("ReevaluateOptions"), Context->ReevaluateOptions());
+	TestEqual(TEXT("Unchanged option is skipped"), Context->GetOptionsNum(), 1);
+
+	// Not read by any condition, filtered out
+	UDlgManager::NotifyParticipantVariableChanged(Participant, TEXT("Unused"));
+	TestTrue(TEXT("ReevaluateOptions"), Context->ReevaluateOptions());
+	TestEqual(TEXT("Unrelated variable does not reevaluate the option"), Context->GetOptionsNum(), 1);
+
+	UDlgManager::NotifyParticipantVariableChanged(Participant, BoolName);
+	TestTrue(TEXT("ReevaluateOptions"), Context->ReevaluateOptions());
+	TestEqual(TEXT("Dirty option is reevaluated"), Context->GetOptionsNum(), 2);
+	TestEqual(TEXT("All options num"), Context->GetAllOptionsNum(), 2);
+
+	Participant->bBool = false;
+	Context->MarkAllOptionsDirty();
+	TestTrue(TEXT("ReevaluateOptions"), Context->ReevaluateOptions());
+	TestEqual(TEXT("All options are reevaluated"), Context->GetOptionsNum(), 1);
+
+	// Disabled, everything is reevaluated every time
+	Context->SetIncrementalReevaluation(false);
+	Participant->bBool = true;
+	TestTrue(TEXT("ReevaluateOptions"), Context->ReevaluateOptions());
+	TestEqual(TEXT("Full reevaluation"), Context->GetOptionsNum(), 2);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgIncrementalSpeechSequenceTest,
+	"DlgSystem.Runtime.IncrementalSpeechSequence",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgIncrementalSpeechSequenceTest::RunTest(const FString& Parameters)
+{
+	const FDlgRuntimeTester::FScopedMemoryRestore MemoryRestore;
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	const FName ParticipantName = Participant->ParticipantName;
+	const FName BoolName = TEXT("Bool");
+
+	UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+	if (!Dialogue->HasGUID())
+	{
+		Dialogue->RegenerateGUID();
+	}
+
+	// Speech sequence of 3 entries, the real edges lead back to it, one always satisfied and one reading the Bool value
+	UDlgNode_SpeechSequence* Sequence = FDlgRuntimeTester::CreateNode<UDlgNode_SpeechSequence>(Dialogue, ParticipantName);
+	for (int32 Index = 0; Index < 3; Index++)
+	{
+		FDlgSpeechSequenceEntry Entry;
+		Entry.Speaker = ParticipantName;
+		Entry.Text = FText::AsNumber(Index);
+		Sequence->GetMutableNodeSpeechSequence()->Add(Entry);
+	}
+	Sequence->AutoGenerateInnerEdges();
+	Sequence->AddNodeChild(FDlgEdge(0));
+	{
+		FDlgEdge Edge(0);
+		Edge.Conditions.Add(FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::BoolCall, BoolName));
+		Sequence->AddNodeChild(Edge);
+	}
+
+	UDlgNode_Start* StartNode = FDlgRuntimeTester::CreateNode<UDlgNode_Start>(Dialogue, ParticipantName);
+	StartNode->AddNodeChild(FDlgEdge(0));
+	Dialogue->SetStartNodes({ StartNode });
+	Dialogue->SetNodes({ Sequence });
+	Dialogue->UpdateAndRefreshData();
+
+	TMap<FName, UObject*> Participants;
+	Participants.Add(ParticipantName, Participant);
+	UDlgContext* Context = NewObject<UDlgContext>(Participant);
+	Context->SetIncrementalReevaluation(true);
+	if (!TestTrue(TEXT("Context started"), Context->Start(Dialogue, Participants)))
+	{
+		return false;
+	}
+
+	// Step through the sequence, every entry only has the inner edge until the last one
+	for (int32 Index = 0; Index < 2; Index++)
+	{
+		TestEqual(TEXT("Speech sequence index"), Sequence->GetSpeechSequenceIndex(*Context), Index);
+		TestTrue(TEXT("ReevaluateOptions"), Context->ReevaluateOptions());
+		TestEqual(TEXT("Only the inner edge"), Context->GetOptionsNum(), 1);
+		TestTrue(TEXT("Active text"), Context->GetActiveNodeText().EqualTo(FText::AsNumber(Index)));
+		TestTrue(TEXT("ChooseOption"), Context->ChooseOption(0));
+	}
+	TestEqual(TEXT("Last entry"), Sequence->GetSpeechSequenceIndex(*Context), 2);
+	TestTrue(TEXT("ReevaluateOptions"), Context->ReevaluateOptions());
+	TestEqual(TEXT("Bool edge is not satisfied"), Context->GetOptionsNum(), 1);
+
+	// Back to the first entry, the options recorded for the real edges must not be rebuilt
+	TestTrue(TEXT("OptionSelectedFromReplicated"), Sequence->OptionSelectedFromReplicated(0, false, *Context));
+	TestEqual(TEXT("First entry"), Sequence->GetSpeechSequenceIndex(*Context), 0);
+	Participant->bBool = true;
+	UDlgManager::NotifyParticipantVariableChanged(Participant, BoolName);
+	TestTrue(TEXT("ReevaluateOptions"), Context->ReevaluateOptions());
+	TestEqual(TEXT("Still only the inner edge"), Context->GetOptionsNum(), 1);
+	TestTrue(TEXT("Active text"), Context->GetActiveNodeText().EqualTo(FText::AsNumber(0)));
+
+	// The real edges are recorded again for the last entry
+	TestTrue(TEXT("ChooseOption"), Context->ChooseOption(0));
+	TestTrue(TEXT("ChooseOption"), Context->ChooseOption(0));
+	TestEqual(TEXT("Both real edges"), Context->GetOptionsNum(), 2);
+	Participant->bBool = false;
+	UDlgManager::NotifyParticipantVariableChanged(Participant, BoolName);
+	TestTrue(TEXT("ReevaluateOptions"), Context->ReevaluateOptions());
+	TestEqual(TEXT("Bool edge is reevaluated"), Context->GetOptionsNum(), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgSharedDialogueTest,
+	"DlgSystem.Runtime.SharedDialogue",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgSharedDialogueTest::RunTest(const FString& Parameters)
+{
+	const FDlgRuntimeTester::FScopedMemoryRestore MemoryRestore;
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	const FName ParticipantName = Participant->ParticipantName;
+
+	UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+	if (!Dialogue->HasGUID())
+	{
+		Dialogue->RegenerateGUID();
+	}
+
+	// Speech sequence of 3 entries that loops back to itself
+	UDlgNode_SpeechSequence* Sequence = FDlgRuntimeTester::CreateNode<UDlgNode_SpeechSequence>(Dialogue, ParticipantName);
+	for (int32 Index = 0; Index < 3; Index++)
+	{
+		FDlgSpeechSequenceEntry Entry;
+		Entry.Speaker = ParticipantName;
+		Entry.Text = FText::AsNumber(Index);
+		Sequence->GetMutableNodeSpeechSequence()->Add(Entry);
+	}
+	Sequence->AutoGenerateInnerEdges();
+	Sequence->AddNodeChild(FDlgEdge(0));
+
+	UDlgNode_Start* StartNode = FDlgRuntimeTester::CreateNode<UDlgNode_Start>(Dialogue, ParticipantName);
+	StartNode->AddNodeChild(FDlgEdge(0));
+	Dialogue->SetStartNodes({ StartNode });
+	Dialogue->SetNodes({ Sequence });
+	Dialogue->UpdateAndRefreshData();
+
+	TMap<FName, UObject*> Participants;
+	Participants.Add(ParticipantName, Participant);
+	UDlgContext* FirstContext = NewObject<UDlgContext>(Participant);
+	UDlgContext* SecondContext = NewObject<UDlgContext>(Participant);
+	if (!TestTrue(TEXT("First context started"), FirstContext->Start(Dialogue, Participants))
+		|| !TestTrue(TEXT("Second context started"), SecondContext->Start(Dialogue, Participants)))
+	{
+		return false;
+	}
+
+	// Advancing one context must not move the other one
+	TestTrue(TEXT("ChooseOption"), FirstContext->ChooseOption(0));
+	TestTrue(TEXT("ChooseOption"), FirstContext->ChooseOption(0));
+	TestEqual(TEXT("First context speech sequence index"), Sequence->GetSpeechSequenceIndex(*FirstContext), 2);
+	TestEqual(TEXT("Second context speech sequence index"), Sequence->GetSpeechSequenceIndex(*SecondContext), 0);
+	TestTrue(TEXT("First context active text"), FirstContext->GetActiveNodeText().EqualTo(FText::AsNumber(2)));
+	TestTrue(TEXT("Second context active text"), SecondContext->GetActiveNodeText().EqualTo(FText::AsNumber(0)));
+
+	TestTrue(TEXT("ChooseOption"), SecondContext->ChooseOption(0));
+	TestEqual(TEXT("First context speech sequence index"), Sequence->GetSpeechSequenceIndex(*FirstContext), 2);
+	TestEqual(TEXT("Second context speech sequence index"), Sequence->GetSpeechSequenceIndex(*SecondContext), 1);
+
+	// The last entry goes through the real edge, back to the start of the sequence
+	TestTrue(TEXT("ChooseOption"), FirstContext->ChooseOption(0));
+	TestEqual(TEXT("First context speech sequence index"), Sequence->GetSpeechSequenceIndex(*FirstContext), 0);
+	TestEqual(TEXT("Second context speech sequence index"), Sequence->GetSpeechSequenceIndex(*SecondContext), 1);
+
+	// The deprecated context free getters do not follow any context
+	PRAGMA_DISABLE_DEPRECATION_WARNINGS
+	TestEqual(TEXT("Context free speech sequence index"), Sequence->GetSpeechSequenceIndex(), 0);
+	TestTrue(TEXT("Context free text"), Sequence->GetNodeText().EqualTo(FText::AsNumber(0)));
+	PRAGMA_ENABLE_DEPRECATION_WARNINGS
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgScopedMemoryTest,
+	"DlgSystem.Runtime.ScopedMemory",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgScopedMemoryTest::RunTest(const FString& Parameters)
+{
+	const FDlgRuntimeTester::FScopedMemoryRestore MemoryRestore;
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateHubDialogue(Participant->ParticipantName, 2);
+	const FGuid DialogueGUID = Dialogue->GetGUID();
+	const TArray<UObject*> Participants = { Participant };
+
+	// Each player has its own memory
+	const TSharedRef<FDlgMemory> FirstMemory = MakeShared<FDlgMemory>();
+	const TSharedRef<FDlgMemory> SecondMemory = MakeShared<FDlgMemory>();
+	UDlgContext* Context = UDlgManager::StartDialogueWithContext(TEXT("ScopedMemoryTest"), Dialogue, Participants, FirstMemory);
+	if (!TestNotNull(TEXT("Context started"), Context))
+	{
+		return false;
+	}
+
+	TestTrue(TEXT("Hub is visited in the memory of the context"), FirstMemory->IsNodeIndexVisited(DialogueGUID, 0));
+	TestTrue(TEXT("Context reads its own memory"), Context->IsNodeVisited(0, Dialogue->GetNodes()[0]->GetGUID(), false));
+	TestFalse(TEXT("Other memory is untouched"), SecondMemory->IsNodeIndexVisited(DialogueGUID, 0));
+	TestFalse(TEXT("Global memory is untouched"), FDlgMemory::Get().IsNodeIndexVisited(DialogueGUID, 0));
+
+	// Copies are in the same memory
+	UDlgContext* Copy = Context->CreateCopy();
+	TestTrue(TEXT("Copy uses the same memory"), Copy && &Copy->GetMemory() == &FirstMemory.Get());
+
+	// Without a memory the global one is used
+	UDlgContext* GlobalContext = UDlgManager::StartDialogue(Dialogue, Participants);
+	TestTrue(TEXT("Context uses the global memory"), GlobalContext && &GlobalContext->GetMemory() == &FDlgMemory::Get());
+	TestTrue(TEXT("Hub is visited in the global memory"), FDlgMemory::Get().IsNodeIndexVisited(DialogueGUID, 0));
+	TestFalse(TEXT("Other memory is untouched"), SecondMemory->IsNodeIndexVisited(DialogueGUID, 0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgVisitedNodesCacheTest,
+	"DlgSystem.Runtime.VisitedNodesCache",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgVisitedNodesCacheTest::RunTest(const FString& Parameters)
+{
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateHubDialogue(TEXT("Participant"), 8);
+	const TArray<UDlgNode*>& Nodes = Dialogue->GetNodes();
+
+	FDlgHistory History;
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex += 2)
+	{
+		History.Add(NodeIndex, Nodes[NodeIndex]->GetGUID());
+	}
+	// Saved by an older version of the Dialogue
+	History.VisitedNodeIndices.Add(Nodes.Num() + 3);
+	History.VisitedNodeGUIDs.Add(FGuid::NewGuid());
+
+	// Same results before (no cache) and after the cache is built by SetNodeVisited
+	FDlgMemory Memory;
+	Memory.SetEntry(Dialogue->GetGUID(), History);
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		TestEqual(TEXT("IsNodeVisited"), Memory.IsNodeVisited(*Dialogue, NodeIndex, Nodes[NodeIndex]->GetGUID()), History.Contains(NodeIndex, Nodes[NodeIndex]->GetGUID()));
+	}
+	Memory.SetNodeVisited(*Dialogue, 1, Nodes[1]->GetGUID());
+	History.Add(1, Nodes[1]->GetGUID());
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		TestEqual(TEXT("IsNodeVisited cached"), Memory.IsNodeVisited(*Dialogue, NodeIndex, Nodes[NodeIndex]->GetGUID()), History.Contains(NodeIndex, Nodes[NodeIndex]->GetGUID()));
+	}
+	TestTrue(TEXT("Unknown node index"), Memory.IsNodeVisited(*Dialogue, Nodes.Num() + 3, FGuid()));
+
+	// The history itself is still the saved data
+	TestTrue(TEXT("History is unchanged"), *Memory.GetHistoryMaps().Find(Dialogue->GetGUID()) == History);
+	Memory.SetEntry(Dialogue->GetGUID(), FDlgHistory{});
+	TestFalse(TEXT("IsNodeVisited after SetEntry"), Memory.IsNodeVisited(*Dialogue, 0, Nodes[0]->GetGUID()));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgHistoryCodecBenchmark,
+	"DlgSystem.Runtime.HistoryCodecBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgHistoryCodecBenchmark::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumDialogues = 200;
+	static constexpr int32 NumNodes = 128;
+	static constexpr int32 NumIterations = 20;
+
+	// History of a long game, every other node visited
+	FDlgMemory Memory;
+	TArray<FGuid> DialogueGUIDs;
+	for (int32 DialogueIndex = 0; DialogueIndex < NumDialogues; DialogueIndex++)
+	{
+		const FGuid DialogueGUID = DialogueGUIDs.Add_GetRef(FGuid::NewGuid());
+		TArray<FGuid> NodeGUIDs;
+		for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+		{
+			NodeGUIDs.Add(FGuid::NewGuid());
+		}
+		for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex += 2)
+		{
+			Memory.SetNodeVisited(DialogueGUID, NodeIndex, NodeGUIDs[NodeIndex]);
+		}
+		Memory.GetNodeData(DialogueGUID, NodeGUIDs[1]).GUIDList.Append({ NodeGUIDs[2], NodeGUIDs[4] });
+	}
+	// Saved by an older version
+	Memory.FindOrAddEntry(DialogueGUIDs[0]).VisitedNodeIndices.Add(-1);
+
+	auto AreMemoriesEqual = [](const FDlgMemory& A, const FDlgMemory& B)
+	{
+		if (A.GetHistoryMaps().Num() != B.GetHistoryMaps().Num())
+		{
+			return false;
+		}
+		for (const auto& Pair : A.GetHistoryMaps())
+		{
+			const FDlgHistory* Other = B.FindEntry(Pair.Key);
+			if (!Other || !(*Other == Pair.Value) || !Other->NodeData.OrderIndependentCompareEqual(Pair.Value.NodeData))
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	// UPROPERTY path, what a save game does
+	TArray<uint8> PropertyBytes;
+	FDlgMemory PropertyLoaded;
+	const double PropertyStartSeconds = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		PropertyBytes.Reset();
+		FMemoryWriter Writer(PropertyBytes, true);
+		FObjectAndNameAsStringProxyArchive WriterProxy(Writer, true);
+		FDlgMemory::StaticStruct()->SerializeItem(WriterProxy, &Memory, nullptr);
+
+		FMemoryReader Reader(PropertyBytes, true);
+		FObjectAndNameAsStringProxyArchive ReaderProxy(Reader, true);
+		FDlgMemory::StaticStruct()->SerializeItem(ReaderProxy, &PropertyLoaded, nullptr);
+	}
+	const double PropertySeconds = FPlatformTime::Seconds() - PropertyStartSeconds;
+
+	TArray<uint8> CodecBytes;
+	FDlgMemory CodecLoaded;
+	const double CodecStartSeconds = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		CodecBytes = FDlgHistoryCodec::SaveMemoryToBytes(Memory);
+		FDlgHistoryCodec::LoadMemoryFromBytes(CodecBytes, CodecLoaded);
+	}
+	const double CodecSeconds = FPlatformTime::Seconds() - CodecStartSeconds;
+
+	UE_LOG(LogDlgRuntimeTester, Display, TEXT("History of %d dialogues with %d visited nodes each, %d save/load iterations: UPROPERTY = %.3f ms (%d bytes), codec = %.3f ms (%d bytes)"),
+		NumDialogues, NumNodes / 2, NumIterations, PropertySeconds * 1000.0, PropertyBytes.Num(), CodecSeconds * 1000.0, CodecBytes.Num());
+	TestTrue(TEXT("UPROPERTY round trip"), AreMemoriesEqual(PropertyLoaded, Memory));
+	TestTrue(TEXT("Codec round trip"), AreMemoriesEqual(CodecLoaded, Memory));
+	TestTrue(TEXT("Codec is smaller"), CodecBytes.Num() < PropertyBytes.Num());
+
+	// Delta, only the changed dialogues
+	Memory.ClearDirtyEntries();
+	const FGuid NewNodeGUID = FGuid::NewGuid();
+	Memory.SetNodeVisited(DialogueGUIDs[3], NumNodes + 1, NewNodeGUID);
+	Memory.GetNodeData(DialogueGUIDs[5], NewNodeGUID).GUIDList.Add(NewNodeGUID);
+	const FGuid NewDialogueGUID = FGuid::NewGuid();
+	Memory.SetNodeVisited(NewDialogueGUID, 0, NewNodeGUID);
+	Memory.GetEntry(FGuid::NewGuid());
+	TestEqual(TEXT("Number of changed dialogues"), Memory.GetDirtyEntries().Num(), 4);
+
+	const TArray<uint8> DeltaBytes = FDlgHistoryCodec::SaveMemoryDeltaToBytes(Memory);
+	TestTrue(TEXT("Delta is at a checkpoint"), Memory.GetDirtyEntries().Num() == 0 && !Memory.AreAllEntriesDirty());
+	TestTrue(TEXT("Delta is smaller than a full save"), DeltaBytes.Num() * 10 < CodecBytes.Num());
+	TestTrue(TEXT("Load delta"), FDlgHistoryCodec::LoadMemoryFromBytes(DeltaBytes, CodecLoaded));
+	TestTrue(TEXT("Delta round trip"), AreMemoriesEqual(CodecLoaded, Memory));
+
+	// Emptied memory, the delta must be a full save
+	FDlgMemory Emptied = Memory;
+	Emptied.Empty();
+	Emptied.SetNodeVisited(NewDialogueGUID, 1, NewNodeGUID);
+	TestTrue(TEXT("Load full save from delta"), FDlgHistoryCodec::LoadMemoryFromBytes(FDlgHistoryCodec::SaveMemoryDeltaToBytes(Emptied), CodecLoaded));
+	TestTrue(TEXT("Full save from delta round trip"), AreMemoriesEqual(CodecLoaded, Emptied));
+
+	// Invalid data
+	TArray<uint8> Truncated = CodecBytes;
+	Truncated.SetNum(Truncated.Num() / 2);
+	FDlgMemory Invalid;
+	AddExpectedError(TEXT("FDlgHistoryCodec::LoadMemory"), EAutomationExpectedErrorFlags::Contains, 2);
+	TestFalse(TEXT("Load truncated data"), FDlgHistoryCodec::LoadMemoryFromBytes(Truncated, Invalid));
+	TestFalse(TEXT("Load UPROPERTY data"), FDlgHistoryCodec::LoadMemoryFromBytes(PropertyBytes, Invalid));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgNodeDescriptorsTest,
+	"DlgSystem.Runtime.NodeDescriptors",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgNodeDescriptorsTest::RunTest(const FString& Parameters)
+{
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateHubDialogue(TEXT("Participant"), 6);
+
+	// Nodes added without a rebuild fall back to the nodes
+	UDlgNode_End* End = FDlgRuntimeTester::CreateNode<UDlgNode_End>(Dialogue, TEXT("Participant"));
+	const int32 EndIndex = Dialogue->AddNode(End);
+	TestTrue(TEXT("Descriptors are out of date after AddNode"), Dialogue->GetNodeDescriptor(EndIndex) == nullptr);
+	TestTrue(TEXT("IsEndNode without descriptors"), Dialogue->IsEndNode(EndIndex));
+
+	Dialogue->RebuildBakedDialogue();
+	const TArray<UDlgNode*>& Nodes = Dialogue->GetNodes();
+	const TArray<FDlgBakedEdge>& Edges = Dialogue->GetBakedDialogue().Edges;
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		const UDlgNode* Node = Nodes[NodeIndex];
+		const FDlgNodeDescriptor* Descriptor = Dialogue->GetNodeDescriptor(NodeIndex);
+		if (!TestNotNull(TEXT("Descriptor"), Descriptor))
+		{
+			return false;
+		}
+
+		TestEqual(TEXT("IsEndNode"), Dialogue->IsEndNode(NodeIndex), Node->IsA<UDlgNode_End>());
+		TestEqual(TEXT("bHasEnterConditions"), static_cast<bool>(Descriptor->bHasEnterConditions), Node->HasAnyEnterConditions());
+		if (TestEqual(TEXT("NumEdges"), Descriptor->NumEdges, Node->GetNodeChildren().Num()))
+		{
+			for (int32 EdgeIndex = 0; EdgeIndex < Descriptor->NumEdges; EdgeIndex++)
+			{
+				TestEqual(TEXT("Edge target"), Edges[Descriptor->FirstEdgeIndex + EdgeIndex].TargetIndex, Node->GetNodeChildAt(EdgeIndex).TargetIndex);
+			}
+		}
+	}
+	TestTrue(TEXT("End node kind"), Dialogue->GetNodeDescriptor(EndIndex)->Kind == EDlgNodeKind::End);
+	TestTrue(TEXT("Virtual parent descriptor"), Dialogue->GetNodeDescriptor(2)->bIsVirtualParent);
+	TestFalse(TEXT("IsEndNode of invalid index"), Dialogue->IsEndNode(Nodes.Num()));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgBakedDialogueBenchmark,
+	"DlgSystem.Runtime.BakedDialogueBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgBakedDialogueBenchmark::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumNodes = 1000;
+	static constexpr int32 NumIterations = 200;
+
+	const FDlgRuntimeTester::FScopedMemoryRestore MemoryRestore;
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	Participant->Integer = 2;
+	Participant->bBool = true;
+	const FName ParticipantName = Participant->ParticipantName;
+
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateLargeDialogue(ParticipantName, NumNodes, 64);
+
+	// What is done once after loading
+	const double BakeStartSeconds = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		Dialogue->RebuildBakedDialogue();
+	}
+	const double BakeSeconds = (FPlatformTime::Seconds() - BakeStartSeconds) / NumIterations;
+	const FDlgBakedDialogue& Baked = Dialogue->GetBakedDialogue();
+	TestTrue(TEXT("Baked dialogue is valid"), Dialogue->HasValidBakedDialogue());
+	TestEqual(TEXT("Baked nodes"), Baked.GetNumNodes(), NumNodes);
+
+	TMap<FName, UObject*> Participants;
+	Participants.Add(ParticipantName, Participant);
+	UDlgContext* Context = NewObject<UDlgContext>(Participant);
+	if (!TestTrue(TEXT("Context started"), Context->Start(Dialogue, Participants)))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Context uses the baked dialogue"), Context->CanUseBakedDialogue());
+
+	auto MeasureStep = [Context](TArray<bool>& OutEnterable, int32& OutNumOptions)
+	{
+		const double StartSeconds = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			Context->ReevaluateOptions();
+		}
+		const double Seconds = (FPlatformTime::Seconds() - StartSeconds) / NumIterations;
+
+		OutNumOptions = Context->GetOptionsNum();
+		OutEnterable.Reset();
+		for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+		{
+			OutEnterable.Add(Context->IsNodeEnterable(NodeIndex));
+		}
+		return Seconds;
+	};
+
+	TArray<bool> BakedEnterable;
+	int32 BakedNumOptions = 0;
+	const double BakedStepSeconds = MeasureStep(BakedEnterable, BakedNumOptions);
+
+	// Same context, evaluated from the UDlgNode objects
+	Dialogue->EmptyBakedDialogue();
+	TestFalse(TEXT("Conditions are outdated after EmptyBakedDialogue"), Context->AreConditionsBound());
+	Context->BindConditions();
+	TestFalse(TEXT("Context does not use the baked dialogue"), Context->CanUseBakedDialogue());
+
+	TArray<bool> NodesEnterable;
+	int32 NodesNumOptions = 0;
+	const double NodesStepSeconds = MeasureStep(NodesEnterable, NodesNumOptions);
+
+	UE_LOG(LogDlgRuntimeTester, Display, TEXT("Dialogue with %d nodes: bake = %.3f ms (%llu bytes), ReevaluateOptions: nodes = %.3f ms, baked = %.3f ms"),
+		NumNodes, BakeSeconds * 1000.0, static_cast<uint64>(Baked.GetAllocatedSize()), NodesStepSeconds * 1000.0, BakedStepSeconds * 1000.0);
+	TestEqual(TEXT("Same number of options"), BakedNumOptions, NodesNumOptions);
+	TestTrue(TEXT("Same enterable nodes"), BakedEnterable == NodesEnterable);
+
+	// The conditions bound from the nodes follow the edits as well
+	Dialogue->RebuildBakedDialogue();
+	TestFalse(TEXT("Conditions bound from the nodes are outdated after RebuildBakedDialogue"), Context->AreConditionsBound());
+
+	// Nodes edited without a rebuild fall back to the nodes, the conditions are compared by the first bind of each bake
+	Dialogue->RebuildBakedDialogue();
+	Dialogue->GetNodes()[1]->GetMutableNodeChildAt(0)->Conditions[0].IntValue += 10;
+	Context->BindConditions();
+	TestFalse(TEXT("Context does not use the baked dialogue with edited conditions"), Context->CanUseBakedDialogue());
+	Dialogue->RebuildBakedDialogue();
+	Context->BindConditions();
+	TestTrue(TEXT("Context uses the rebuilt baked dialogue"), Context->CanUseBakedDialogue());
+	Dialogue->GetNodes()[1]->AddNodeChild(FDlgEdge(0));
+	TestFalse(TEXT("Baked dialogue is out of date with an added edge"), Dialogue->HasValidBakedDialogue());
+	TestTrue(TEXT("Descriptor is out of date with an added edge"), Dialogue->GetNodeDescriptor(1) == nullptr);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgDialogueIndexTest,
+	"DlgSystem.Runtime.DialogueIndex",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgDialogueIndexTest::RunTest(const FString& Parameters)
+{
+	const FName ParticipantName(TEXT("DlgIndexTestParticipant"));
+	const FName IntName(TEXT("DlgIndexTestInt"));
+	const FName FloatName(TEXT("DlgIndexTestFloat"));
+	const FName ConditionName(TEXT("DlgIndexTestCondition"));
+
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateLargeDialogue(ParticipantName, 10, 2);
+	UDlgNode* Node = Dialogue->GetMutableNodeFromIndex(1);
+	Node->SetNodeEnterConditions({
+		FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::IntCall, IntName),
+		FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::EventCall, ConditionName)
+	});
+	Dialogue->UpdateAndRefreshData();
+
+	// Same tags as the ones saved in the asset registry
+	const FAssetData AssetData(Dialogue);
+	FDlgDialogueIndexEntry Entry;
+	if (!TestTrue(TEXT("Entry read from the asset registry tags"), Entry.SetFromAssetData(AssetData)))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Tags GUID"), Entry.GUID, Dialogue->GetGUID());
+	TestEqual(TEXT("Tags speaker states"), Entry.SpeakerStates.Num(), Dialogue->GetSpeakerStates().Num());
+	const FDlgParticipantData* Data = Entry.ParticipantsData.Find(ParticipantName);
+	if (!TestNotNull(TEXT("Tags participant"), Data))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Tags int names"), Data->IntVariableNames.Contains(IntName));
+	TestTrue(TEXT("Tags condition names"), Data->Conditions.Contains(ConditionName));
+
+	// The loaded (transient) Dialogue is part of the index
+	const double QueryStartSeconds = FPlatformTime::Seconds();
+	const TArray<FName> IntNames = UDlgManager::GetDialoguesParticipantIntNames(ParticipantName);
+	const double QuerySeconds = FPlatformTime::Seconds() - QueryStartSeconds;
+	TestTrue(TEXT("Manager int names"), IntNames.Contains(IntName));
+	TestTrue(TEXT("Manager condition names"), UDlgManager::GetDialoguesParticipantConditionNames(ParticipantName).Contains(ConditionName));
+	TestTrue(TEXT("Manager participant names"), UDlgManager::GetDialoguesParticipantNames().Contains(ParticipantName));
+	TestTrue(TEXT("Manager dialogues for participant"), UDlgManager::GetAllDialoguesForParticipantName(ParticipantName).Contains(Dialogue));
+	const FSoftObjectPath* Path = UDlgManager::GetAllDialoguesGUIDsPathsMap().Find(Dialogue->GetGUID());
+	TestTrue(TEXT("Manager GUID path"), Path && *Path == FSoftObjectPath(Dialogue));
+
+	// Changes of loaded Dialogues are visible without rebuilding the index
+	Node->SetNodeEnterConditions({ FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::FloatCall, FloatName) });
+	Dialogue->UpdateAndRefreshData();
+	TestTrue(TEXT("Manager float names after change"), UDlgManager::GetDialoguesParticipantFloatNames(ParticipantName).Contains(FloatName));
+	TestFalse(TEXT("Manager int names after change"), UDlgManager::GetDialoguesParticipantIntNames(ParticipantName).Contains(IntName));
+
+	UE_LOG(LogDlgRuntimeTester, Display, TEXT("Dialogue index with %d Dialogues: int names query = %.3f ms"),
+		FDlgDialogueIndex::Get().Num(), QuerySeconds * 1000.0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgDialogueIndexNamesTest,
+	"DlgSystem.Runtime.DialogueIndexNames",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgDialogueIndexNamesTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumQueries = 1000;
+	const FName ParticipantName(TEXT("DlgIndexNamesTestParticipant"));
+	const FName SharedName(TEXT("DlgIndexNamesTestB"));
+	const FName FirstName(TEXT("DlgIndexNamesTestA"));
+	const FName LastName(TEXT("DlgIndexNamesTestC"));
+
+	auto SetIntConditions = [ParticipantName](UDlgDialogue* Dialogue, const TArray<FName>& Names)
+	{
+		TArray<FDlgCondition> Conditions;
+		for (const FName Name : Names)
+		{
+			Conditions.Add(FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::IntCall, Name));
+		}
+		Dialogue->GetMutableNodeFromIndex(1)->SetNodeEnterConditions(Conditions);
+		Dialogue->UpdateAndRefreshData();
+	};
+
+	// Both use SharedName
+	UDlgDialogue* FirstDialogue = FDlgRuntimeTester::CreateLargeDialogue(ParticipantName, 10, 2);
+	UDlgDialogue* SecondDialogue = FDlgRuntimeTester::CreateLargeDialogue(ParticipantName, 10, 2);
+	SetIntConditions(FirstDialogue, { LastName, SharedName });
+	SetIntConditions(SecondDialogue, { SharedName, FirstName });
+
+	const TArray<FName> ExpectedNames = { FirstName, SharedName, LastName };
+	TestTrue(TEXT("Sorted names of both Dialogues"), UDlgManager::GetDialoguesParticipantIntNames(ParticipantName) == ExpectedNames);
+
+	// SharedName is still used by the second Dialogue
+	SetIntConditions(FirstDialogue, {});
+	const TArray<FName> ExpectedSecondNames = { FirstName, SharedName };
+	TestTrue(TEXT("Names after the first Dialogue changed"), UDlgManager::GetDialoguesParticipantIntNames(ParticipantName) == ExpectedSecondNames);
+
+	SetIntConditions(SecondDialogue, {});
+	TestEqual(TEXT("Names after both Dialogues changed"), UDlgManager::GetDialoguesParticipantIntNames(ParticipantName).Num(), 0);
+
+	// Picker lookups do not depend on the number of Dialogues
+	SetIntConditions(FirstDialogue, ExpectedNames);
+	int32 NumNames = 0;
+	const double StartSeconds = FPlatformTime::Seconds();
+	for (int32 Query = 0; Query < NumQueries; Query++)
+	{
+		NumNames += UDlgManager::GetDialoguesParticipantIntNames(ParticipantName).Num();
+	}
+	const double QuerySeconds = (FPlatformTime::Seconds() - StartSeconds) / NumQueries;
+	TestEqual(TEXT("Names of the queries"), NumNames, NumQueries * ExpectedNames.Num());
+
+	UE_LOG(LogDlgRuntimeTester, Display, TEXT("Dialogue index with %d Dialogues: int names query = %.4f ms"),
+		FDlgDialogueIndex::Get().Num(), QuerySeconds * 1000.0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgBatchTest,
+	"DlgSystem.Runtime.Batch",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgBatchTest::RunTest(const FString& Parameters)
+{
+	const FDlgRuntimeTester::FScopedMemoryRestore MemoryRestore;
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	UDlgDialogue* FirstDialogue = FDlgRuntimeTester::CreateHubDialogue(Participant->ParticipantName, 2);
+	UDlgDialogue* SecondDialogue = FDlgRuntimeTester::CreateHubDialogue(Participant->ParticipantName, 3);
+
+	TArray<FDlgStartDialogueRequest> Requests;
+	auto AddRequest = [&Requests](UDlgDialogue* Dialogue, const TArray<UObject*>& Participants)
+	{
+		FDlgStartDialogueRequest& Request = Requests.AddDefaulted_GetRef();
+		Request.Dialogue = Dialogue;
+		Request.Participants = Participants;
+	};
+	AddRequest(FirstDialogue, { Participant });
+	AddRequest(nullptr, { Participant });
+	AddRequest(SecondDialogue, { Participant });
+	AddRequest(FirstDialogue, {});
+	AddRequest(FirstDialogue, { Participant });
+
+	AddExpectedError(TEXT("StartDialoguesBatch"), EAutomationExpectedErrorFlags::Contains, 0);
+	AddExpectedError(TEXT("ChooseOptionsBatch"), EAutomationExpectedErrorFlags::Contains, 1);
+	const TArray<UDlgContext*> Contexts = UDlgManager::StartDialoguesBatch(Requests);
+	if (!TestEqual(TEXT("One context for each request"), Contexts.Num(), Requests.Num()))
+	{
+		return false;
+	}
+
+	const TArray<bool> ExpectedResults = { true, false, true, false, true };
+	for (int32 Index = 0; Index < Requests.Num(); Index++)
+	{
+		TestEqual(FString::Printf(TEXT("Request at Index = %d started"), Index), Contexts[Index] != nullptr, ExpectedResults[Index]);
+		if (Contexts[Index])
+		{
+			TestTrue(TEXT("Context has the Dialogue of the request"), Contexts[Index]->GetDialogue() == Requests[Index].Dialogue);
+		}
+	}
+
+	// Same results as the single versions, nullptr contexts are skipped
+	TestTrue(TEXT("ReevaluateOptionsBatch"), UDlgManager::ReevaluateOptionsBatch(Contexts) == ExpectedResults);
+	TestTrue(TEXT("ChooseOptionsBatch"), UDlgManager::ChooseOptionsBatch(Contexts, { 0, 0, 0, 0, 0 }) == ExpectedResults);
+
+	// Every index needs an option
+	const TArray<bool> MismatchResults = UDlgManager::ChooseOptionsBatch(Contexts, { 0 });
+	TestTrue(TEXT("ChooseOptionsBatch with missing options"), MismatchResults == TArray<bool>{ false, false, false, false, false });
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgContextStateTest,
+	"DlgSystem.Runtime.ContextState",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgContextStateTest::RunTest(const FString& Parameters)
+{
+	const FDlgRuntimeTester::FScopedMemoryRestore MemoryRestore;
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateHubDialogue(Participant->ParticipantName, 4);
+	const TArray<UObject*> Participants = { Participant };
+
+	UDlgContext* Reference = UDlgManager::StartDialogue(Dialogue, Participants);
+	UDlgContext* Context = UDlgManager::StartDialogue(Dialogue, Participants);
+	if (!TestNotNull(TEXT("Reference started"), Reference) || !TestNotNull(TEXT("Context started"), Context))
+	{
+		return false;
+	}
+
+	// The state leaves the context
+	FDlgContextState State;
+	Context->MoveStateTo(State);
+	TestTrue(TEXT("State has the Dialogue"), State.GetDialogue() == Dialogue);
+	TestEqual(TEXT("State active node"), State.GetActiveNodeIndex(), Reference->GetActiveNodeIndex());
+	TestEqual(TEXT("Context has no options"), Context->GetOptionsNum(), 0);
+	TestTrue(TEXT("Context keeps the Dialogue"), Context->GetDialogue() == Dialogue);
+	TestTrue(TEXT("Context keeps the bound conditions"), Context->AreConditionsBound());
+	TestEqual(TEXT("Context remembers the moved state"), Context->GetMovedStateRevision(), State.Revision);
+
+	// The same bindings are kept when the state comes back
+	if (!TestTrue(TEXT("MoveStateFrom the same context"), Context->MoveStateFrom(State)))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Conditions still bound"), Context->AreConditionsBound());
+	TestEqual(TEXT("Same options after moving back"), Context->GetOptionsNum(), Reference->GetOptionsNum());
+	TestEqual(TEXT("Context is in use"), Context->GetMovedStateRevision(), static_cast<uint64>(0));
+	Context->MoveStateTo(State);
+
+	// Any context can continue the state, same as the reference
+	for (int32 Step = 0; Step < 4; Step++)
+	{
+		UDlgContext* Borrowed = NewObject<UDlgContext>(GetTransientPackage());
+		if (!TestTrue(TEXT("MoveStateFrom"), Borrowed->MoveStateFrom(State)))
+		{
+			return false;
+		}
+		TestEqual(TEXT("Same options as the reference"), Borrowed->GetOptionsNum(), Reference->GetOptionsNum());
+
+		const int32 OptionIndex = Step % Reference->GetOptionsNum();
+		TestEqual(TEXT("ChooseOption"), Borrowed->ChooseOption(OptionIndex), Reference->ChooseOption(OptionIndex));
+		TestEqual(TEXT("Same active node as the reference"), Borrowed->GetActiveNodeIndex(), Reference->GetActiveNodeIndex());
+		Borrowed->MoveStateTo(State);
+	}
+
+	// A reset context starts as a new one
+	Context->ResetForReuse();
+	TMap<FName, UObject*> ParticipantsMap;
+	ParticipantsMap.Add(Participant->ParticipantName, Participant);
+	TestTrue(TEXT("Reset context starts again"), Context->Start(Dialogue, ParticipantsMap));
+	TestFalse(TEXT("Reset context has not ended"), Context->HasDialogueEnded());
+
+	// Destroyed participants end the state
+	FDlgContextState OrphanState;
+	OrphanState.Dialogue = Dialogue;
+	OrphanState.Participants.Add(Participant->ParticipantName, nullptr);
+	TestFalse(TEXT("MoveStateFrom with a destroyed participant"), Context->MoveStateFrom(OrphanState));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgOptionRecordsTest,
+	"DlgSystem.Runtime.OptionRecords",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgOptionRecordsTest::RunTest(const FString& Parameters)
+{
+	const FDlgRuntimeTester::FScopedMemoryRestore MemoryRestore;
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateHubDialogue(Participant->ParticipantName, 4);
+	const TArray<UObject*> Participants = { Participant };
+	UDlgContext* Context = UDlgManager::StartDialogue(Dialogue, Participants);
+	if (!TestNotNull(TEXT("Context started"), Context))
+	{
+		return false;
+	}
+
+	for (int32 Step = 0; Step < 3; Step++)
+	{
+		// The copies of the edges are the same as the records
+		const TArray<FDlgEdge>& Options = Context->GetOptionsArray();
+		const TArray<FDlgEdgeData>& AllOptions = Context->GetAllOptionsArray();
+		TestEqual(TEXT("Options num"), Options.Num(), Context->GetOptionsNum());
+		TestEqual(TEXT("All options num"), AllOptions.Num(), Context->GetAllOptionsNum());
+		for (int32 OptionIndex = 0; OptionIndex < Options.Num(); OptionIndex++)
+		{
+			const FDlgOptionRecord* Record = Context->FindOptionRecord(OptionIndex);
+			if (!TestNotNull(TEXT("Record"), Record))
+			{
+				return false;
+			}
+			TestEqual(TEXT("Same target"), Options[OptionIndex].TargetIndex, Record->TargetIndex);
+			TestTrue(TEXT("GetOption is the edge of the Dialogue"), &Context->GetOption(OptionIndex) == &Context->GetOptionRecordEdge(*Record));
+			PRAGMA_DISABLE_DEPRECATION_WARNINGS
+			TestTrue(TEXT("Same text"), Options[OptionIndex].GetText().EqualTo(Context->GetOptionText(OptionIndex)));
+			PRAGMA_ENABLE_DEPRECATION_WARNINGS
+		}
+		for (int32 Index = 0; Index < AllOptions.Num(); Index++)
+		{
+			TestEqual(TEXT("Same satisfied"), AllOptions[Index].IsSatisfied(), Context->IsOptionSatisfied(Index));
+			TestEqual(TEXT("Same target from all"), AllOptions[Index].GetEdge().TargetIndex, Context->GetAllOptionRecords()[Index].TargetIndex);
+		}
+
+		if (Context->GetOptionsNum() == 0 || !Context->ChooseOption(0))
+		{
+			break;
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgFormattedTextsTest,
+	"DlgSystem.Runtime.FormattedTexts",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgFormattedTextsTest::RunTest(const FString& Parameters)
+{
+	const FDlgRuntimeTester::FScopedMemoryRestore MemoryRestore;
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+	if (!Dialogue->HasGUID())
+	{
+		Dialogue->RegenerateGUID();
+	}
+
+	UDlgNode_Speech* Node = FDlgRuntimeTester::CreateNode<UDlgNode_Speech>(Dialogue, Participant->ParticipantName);
+	Node->SetNodeText(FText::FromString(TEXT("Hello {Name}!")));
+	FDlgEdge Edge(0);
+	Edge.SetText(FText::FromString(TEXT("Again {Name}?")));
+	Node->AddNodeChild(Edge);
+
+	UDlgNode_Start* StartNode = FDlgRuntimeTester::CreateNode<UDlgNode_Start>(Dialogue, Participant->ParticipantName);
+	StartNode->AddNodeChild(FDlgEdge(0));
+	Dialogue->SetStartNodes({ StartNode });
+	Dialogue->SetNodes({ Node });
+	Dialogue->UpdateAndRefreshData();
+
+	const TArray<UObject*> Participants = { Participant };
+	UDlgContext* Context = UDlgManager::StartDialogue(Dialogue, Participants);
+	if (!TestNotNull(TEXT("Context started"), Context) || !TestEqual(TEXT("One option"), Context->GetOptionsNum(), 1))
+	{
+		return false;
+	}
+
+	// Formatted for the context, the Dialogue is left untouched
+	const FText& NodeText = Context->GetActiveNodeText();
+	const FText OptionText = Context->GetOptionText(0);
+	TestFalse(TEXT("Node text is formatted"), NodeText.ToString().Contains(TEXT("{Name}")));
+	TestFalse(TEXT("Option text is formatted"), OptionText.ToString().Contains(TEXT("{Name}")));
+	TestTrue(TEXT("Dialogue node text is not formatted"), Node->GetNodeText().ToString().Contains(TEXT("{Name}")));
+	PRAGMA_DISABLE_DEPRECATION_WARNINGS
+	TestTrue(TEXT("Dialogue edge text is not formatted"), Node->GetNodeChildren()[0].GetText().ToString().Contains(TEXT("{Name}")));
+
+	// Cached, and the same as the copies of the edges
+	TestTrue(TEXT("Node text is cached"), &NodeText == &Context->GetActiveNodeText());
+	TestTrue(TEXT("Option text is cached"), OptionText.IdenticalTo(Context->GetOptionText(0)));
+	TestTrue(TEXT("Same text in the options array"), Context->GetOptionsArray()[0].GetText().EqualTo(OptionText));
+	TestTrue(TEXT("GetOption is formatted"), Context->GetOption(0).GetText().EqualTo(OptionText));
+	TestTrue(TEXT("GetOptionFromAll is formatted"), Context->GetOptionFromAll(0).GetEdge().GetText().EqualTo(OptionText));
+	PRAGMA_ENABLE_DEPRECATION_WARNINGS
+
+	// Still valid after the options are reevaluated
+	Context->ReevaluateOptions();
+	TestTrue(TEXT("Option text after reevaluation"), OptionText.EqualTo(Context->GetOptionText(0)));
+
+	// Still formatted after a step
+	TestTrue(TEXT("ChooseOption"), Context->ChooseOption(0));
+	TestTrue(TEXT("Same node text after a step"), Context->GetActiveNodeText().EqualTo(NodeText));
+	TestTrue(TEXT("Same option text after a step"), Context->GetOptionText(0).EqualTo(OptionText));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgParallelConditionsBenchmark,
+	"DlgSystem.Runtime.ParallelConditionsBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgParallelConditionsBenchmark::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumEdges = 200;
+	static constexpr int32 NumTargets = 20;
+	static constexpr int32 NumIterations = 200;
+
+	const FDlgRuntimeTester::FScopedMemoryRestore MemoryRestore;
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	Participant->Integer = 5;
+	const FName ParticipantName = Participant->ParticipantName;
+
+	// A hub with NumEdges edges, each with a few class variable conditions and a named condition for some of them
+	UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+	if (!Dialogue->HasGUID())
+	{
+		Dialogue->RegenerateGUID();
+	}
+
+	TArray<UDlgNode*> Nodes;
+	UDlgNode_Speech* Hub = FDlgRuntimeTester::CreateNode<UDlgNode_Speech>(Dialogue, ParticipantName);
+	Nodes.Add(Hub);
+	for (int32 TargetIndex = 0; TargetIndex < NumTargets; TargetIndex++)
+	{
+		UDlgNode_Speech* Target = FDlgRuntimeTester::CreateNode<UDlgNode_Speech>(Dialogue, ParticipantName);
+		FDlgCondition EnterCondition = FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::ClassIntVariable, GET_MEMBER_NAME_CHECKED(UDlgTestParticipant, Integer));
+		EnterCondition.Operation = EDlgOperation::GreaterOrEqual;
+		EnterCondition.IntValue = TargetIndex % 8;
+		Target->SetNodeEnterConditions({ EnterCondition });
+		Target->AddNodeChild(FDlgEdge(0));
+		Nodes.Add(Target);
+	}
+	for (int32 EdgeIndex = 0; EdgeIndex < NumEdges; EdgeIndex++)
+	{
+		FDlgEdge Edge(1 + EdgeIndex % NumTargets);
+		FDlgCondition IntCondition = FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::ClassIntVariable, GET_MEMBER_NAME_CHECKED(UDlgTestParticipant, Integer));
+		IntCondition.Operation = EDlgOperation::Less;
+		IntCondition.IntValue = EdgeIndex % 10;
+		Edge.Conditions.Add(IntCondition);
+		Edge.Conditions.Add(FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::ClassBoolVariable, GET_MEMBER_NAME_CHECKED(UDlgTestParticipant, bCondition)));
+		if (EdgeIndex % 4 == 0)
+		{
+			// Only evaluated on the game thread
+			Edge.Conditions.Add(FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::EventCall, TEXT("Condition")));
+		}
+		Hub->AddNodeChild(Edge);
+	}
+	UDlgNode_Start* StartNode = FDlgRuntimeTester::CreateNode<UDlgNode_Start>(Dialogue, ParticipantName);
+	StartNode->AddNodeChild(FDlgEdge(0));
+	Dialogue->SetStartNodes({ StartNode });
+	Dialogue->SetNodes(Nodes);
+	Dialogue->UpdateAndRefreshData();
+
+	const TArray<UObject*> Participants = { Participant };
+	UDlgContext* Context = UDlgManager::StartDialogue(Dialogue, Participants);
+	if (!TestNotNull(TEXT("Context started"), Context))
+	{
+		return false;
+	}
+
+	UDlgSystemSettings* Settings = GetMutableDefault<UDlgSystemSettings>();
+	const bool bOldParallelConditionsEvaluation = Settings->bParallelConditionsEvaluation;
+	const int32 OldParallelConditionsMinEdges = Settings->ParallelConditionsMinEdges;
+
+	auto Measure = [&](bool bParallel, TArray<int32>& OutTargets)
+	{
+		Settings->bParallelConditionsEvaluation = bParallel;
+		Settings->ParallelConditionsMinEdges = 1;
+
+		const double StartSeconds = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			Context->ReevaluateOptions();
+		}
+		const double Seconds = FPlatformTime::Seconds() - StartSeconds;
+
+		OutTargets.Reset();
+		for (const FDlgOptionRecord& Record : Context->GetAllOptionRecords())
+		{
+			OutTargets.Add(Record.bSatisfied ? Record.TargetIndex : -Record.TargetIndex);
+		}
+		return Seconds;
+	};
+
+	TArray<int32> SerialTargets;
+	TArray<int32> ParallelTargets;
+	const double SerialSeconds = Measure(false, SerialTargets);
+	const double ParallelSeconds = Measure(true, ParallelTargets);
+
+	Settings->bParallelConditionsEvaluation = bOldParallelConditionsEvaluation;
+	Settings->ParallelConditionsMinEdges = OldParallelConditionsMinEdges;
+
+	UE_LOG(LogDlgRuntimeTester, Display, TEXT("ReevaluateOptions of a node with %d edges, %d iterations: serial = %.3f ms, parallel = %.3f ms"),
+		NumEdges, NumIterations, SerialSeconds * 1000.0, ParallelSeconds * 1000.0);
+	TestTrue(TEXT("Some options are satisfied"), Context->GetOptionsNum() > 0);
+	TestTrue(TEXT("Serial and parallel options"), SerialTargets == ParallelTargets);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgNativeParticipantTest,
+	"DlgSystem.Runtime.NativeParticipant",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgNativeParticipantTest::RunTest(const FString& Parameters)
+{
+	const FDlgRuntimeTester::FScopedMemoryRestore MemoryRestore;
+	UDlgTestNativeParticipant* NativeParticipant = NewObject<UDlgTestNativeParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	UDlgTestParticipant* BlueprintParticipant = NewObject<UDlgTestParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	const FName ParticipantName = NativeParticipant->ParticipantName;
+	TestNotNull(TEXT("Native participant is detected"), FDlgParticipantCalls::GetNative(NativeParticipant));
+	TestNull(TEXT("Blueprint participant is not native"), FDlgParticipantCalls::GetNative(BlueprintParticipant));
+
+	UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+	if (!Dialogue->HasGUID())
+	{
+		Dialogue->RegenerateGUID();
+	}
+
+	// Entering the hub increments the int, only implemented by the native participant
+	UDlgNode_Speech* Hub = FDlgRuntimeTester::CreateNode<UDlgNode_Speech>(Dialogue, ParticipantName);
+	FDlgEvent Event;
+	Event.ParticipantName = ParticipantName;
+	Event.EventType = EDlgEventType::ModifyInt;
+	Event.EventName = TEXT("Int");
+	Event.IntValue = 1;
+	Event.bDelta = true;
+	Hub->SetNodeEnterEvents({ Event });
+	{
+		// Values fetched at once
+		FDlgEdge Edge(0);
+		FDlgCondition IntCondition = FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::IntCall, TEXT("Int"));
+		IntCondition.Operation = EDlgOperation::GreaterOrEqual;
+		IntCondition.IntValue = 1;
+		FDlgCondition BoolCondition = FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::BoolCall, TEXT("Bool"));
+		BoolCondition.bBoolValue = false;
+		Edge.Conditions = { IntCondition, BoolCondition, FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::FloatCall, TEXT("Float")) };
+		Hub->AddNodeChild(Edge);
+	}
+	{
+		FDlgEdge Edge(0);
+		FDlgCondition IntCondition = FDlgRuntimeTester::CreateCondition(ParticipantName, EDlgConditionType::IntCall, TEXT("Int"));
+		IntCondition.Operation = EDlgOperation::GreaterOrEqual;
+		IntCondition.IntValue = 5;
+		Edge.Conditions.Add(IntCondition);
+		Hub->AddNodeChild(Edge);
+	}
+
+	UDlgNode_Start* StartNode = FDlgRuntimeTester::CreateNode<UDlgNode_Start>(Dialogue, ParticipantName);
+	StartNode->AddNodeChild(FDlgEdge(0));
+	Dialogue->SetStartNodes({ StartNode });
+	Dialogue->SetNodes({ Hub });
+	Dialogue->UpdateAndRefreshData();
+
+	const TArray<UObject*> NativeParticipants = { NativeParticipant };
+	UDlgContext* NativeContext = UDlgManager::StartDialogue(Dialogue, NativeParticipants);
+	if (!TestNotNull(TEXT("Native context started"), NativeContext))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Event called natively"), NativeParticipant->Integer, 1);
+	TestTrue(TEXT("Values fetched at once"), NativeParticipant->NumGetValuesCalls > 0);
+
+	// Same result through the Blueprint events
+	BlueprintParticipant->Integer = 1;
+	const TArray<UObject*> BlueprintParticipants = { BlueprintParticipant };
+	UDlgContext* BlueprintContext = UDlgManager::StartDialogue(Dialogue, BlueprintParticipants);
+	if (!TestNotNull(TEXT("Blueprint context started"), BlueprintContext))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Same options num"), NativeContext->GetOptionsNum(), BlueprintContext->GetOptionsNum());
+	TestEqual(TEXT("Only the fetched at once edge is satisfied"), NativeContext->GetOptionsNum(), 1);
+
+	// The values are fetched again on every evaluation
+	const int32 NumGetValuesCalls = NativeParticipant->NumGetValuesCalls;
+	NativeParticipant->Integer = 5;
+	TestTrue(TEXT("ReevaluateOptions"), NativeContext->ReevaluateOptions());
+	TestTrue(TEXT("Values fetched again"), NativeParticipant->NumGetValuesCalls > NumGetValuesCalls);
+	TestEqual(TEXT("Both edges are satisfied"), NativeContext->GetOptionsNum(), 2);
+
+	return true;
+}
+
+// Game world with a participant registered manually and an actor participant that is not registered
+struct FDlgRegistryTestWorld
+{
+	FDlgRegistryTestWorld()
+		: bTrackParticipantsAutomatically(GetDefault<UDlgSystemSettings>()->bTrackParticipantsAutomatically),
+		bUseOnlyRegisteredParticipants(GetDefault<UDlgSystemSettings>()->bUseOnlyRegisteredParticipants)
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+		Registry = UDlgParticipantRegistry::Get(World);
+
+		RegisteredParticipant = NewObject<UDlgTestParticipant>(World, NAME_None, RF_Transient);
+		RegisteredParticipant->ParticipantName = TEXT("RegisteredParticipant");
+		ActorParticipant = World->SpawnActor<ADlgTestParticipantActor>();
+	}
+	~FDlgRegistryTestWorld()
+	{
+		UDlgSystemSettings* Settings = GetMutableDefault<UDlgSystemSettings>();
+		Settings->bTrackParticipantsAutomatically = bTrackParticipantsAutomatically;
+		Settings->bUseOnlyRegisteredParticipants = bUseOnlyRegisteredParticipants;
+		World->DestroyWorld(false);
+	}
+
+	UWorld* World = nullptr;
+	UDlgParticipantRegistry* Registry = nullptr;
+	UDlgTestParticipant* RegisteredParticipant = nullptr;
+	ADlgTestParticipantActor* ActorParticipant = nullptr;
+	bool bTrackParticipantsAutomatically;
+	bool bUseOnlyRegisteredParticipants;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgParticipantRegistryManualTest,
+	"DlgSystem.Runtime.ParticipantRegistryManual",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgParticipantRegistryManualTest::RunTest(const FString& Parameters)
+{
+	GetMutableDefault<UDlgSystemSettings>()->bTrackParticipantsAutomatically = false;
+	FDlgRegistryTestWorld TestWorld;
+	UDlgParticipantRegistry* Registry = TestWorld.Registry;
+	UDlgTestParticipant* Participant = TestWorld.RegisteredParticipant;
+	if (!TestNotNull(TEXT("Registry"), Registry) || !TestNotNull(TEXT("Actor"), TestWorld.ActorParticipant))
+	{
+		return false;
+	}
+
+	TestFalse(TEXT("Not registered"), Registry->IsParticipantRegistered(Participant));
+	AddExpectedError(TEXT("does not implement the IDlgDialogueParticipant interface"), EAutomationExpectedErrorFlags::Contains, 0);
+	TestFalse(TEXT("Object without the interface"), Registry->RegisterParticipant(TestWorld.World));
+	TestTrue(TEXT("RegisterParticipant"), Registry->RegisterParticipant(Participant));
+	TestTrue(TEXT("Registered"), Registry->IsParticipantRegistered(Participant));
+	TestFalse(TEXT("Only some participants are registered"), Registry->IsAuthoritative());
+	TestTrue(TEXT("Found by name"), Registry->GetParticipants(Participant->ParticipantName) == TArray<UObject*>{ Participant });
+
+	// Renamed, found under the new name
+	Participant->ParticipantName = TEXT("RenamedParticipant");
+	TestEqual(TEXT("Not found under the old name"), Registry->GetParticipants(TEXT("RegisteredParticipant")).Num(), 0);
+	TestTrue(TEXT("Found under the new name"), Registry->GetParticipants(Participant->ParticipantName) == TArray<UObject*>{ Participant });
+
+	Registry->UnregisterParticipant(Participant);
+	TestFalse(TEXT("Unregistered"), Registry->IsParticipantRegistered(Participant));
+	TestEqual(TEXT("Not found after UnregisterParticipant"), Registry->GetParticipants(Participant->ParticipantName).Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgParticipantRegistryMixedTest,
+	"DlgSystem.Runtime.ParticipantRegistryMixed",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgParticipantRegistryMixedTest::RunTest(const FString& Parameters)
+{
+	const FDlgRuntimeTester::FScopedMemoryRestore MemoryRestore;
+	GetMutableDefault<UDlgSystemSettings>()->bTrackParticipantsAutomatically = false;
+	GetMutableDefault<UDlgSystemSettings>()->bUseOnlyRegisteredParticipants = false;
+	FDlgRegistryTestWorld TestWorld;
+	UDlgTestParticipant* Participant = TestWorld.RegisteredParticipant;
+	ADlgTestParticipantActor* Actor = TestWorld.ActorParticipant;
+	if (!TestNotNull(TEXT("Registry"), TestWorld.Registry) || !TestNotNull(TEXT("Actor"), Actor))
+	{
+		return false;
+	}
+	TestTrue(TEXT("RegisterParticipant"), TestWorld.Registry->RegisterParticipant(Participant));
+
+	// Both participants speak
+	UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+	if (!Dialogue->HasGUID())
+	{
+		Dialogue->RegenerateGUID();
+	}
+	UDlgNode_Speech* First = FDlgRuntimeTester::CreateNode<UDlgNode_Speech>(Dialogue, Participant->ParticipantName);
+	UDlgNode_Speech* Second = FDlgRuntimeTester::CreateNode<UDlgNode_Speech>(Dialogue, Actor->ParticipantName);
+	First->AddNodeChild(FDlgEdge(1));
+	UDlgNode_Start* StartNode = FDlgRuntimeTester::CreateNode<UDlgNode_Start>(Dialogue, Participant->ParticipantName);
+	StartNode->AddNodeChild(FDlgEdge(0));
+	Dialogue->SetStartNodes({ StartNode });
+	Dialogue->SetNodes({ First, Second });
+	Dialogue->UpdateAndRefreshData();
+
+	// The registered participant from the registry, the other one from the world
+	const TArray<UObject*> Objects = UDlgManager::GetObjectsWithDialogueParticipantInterface(TestWorld.World);
+	TestTrue(TEXT("Registered participant"), Objects.Contains(Participant));
+	TestTrue(TEXT("Not registered participant"), Objects.Contains(Actor));
+	const TMap<FName, FDlgObjectsArray> ObjectsMap = UDlgManager::GetObjectsMapWithDialogueParticipantInterface(TestWorld.World);
+	TestTrue(TEXT("Registered participant name"), ObjectsMap.Contains(Participant->ParticipantName));
+	TestTrue(TEXT("Not registered participant name"), ObjectsMap.Contains(Actor->ParticipantName));
+	TestNotNull(TEXT("Started with both participants"), UDlgManager::StartDialogueWithDefaultParticipants(TestWorld.World, Dialogue));
+
+	// Explicitly only the registered ones
+	GetMutableDefault<UDlgSystemSettings>()->bUseOnlyRegisteredParticipants = true;
+	TestTrue(TEXT("Only the registered participants"), TestWorld.Registry->IsAuthoritative());
+	TestFalse(TEXT("Not registered participant is ignored"), UDlgManager::GetObjectsWithDialogueParticipantInterface(TestWorld.World).Contains(Actor));
+	AddExpectedError(TEXT("the system FAILED to find the following Participant(s)"), EAutomationExpectedErrorFlags::Contains, 0);
+	TestNull(TEXT("Not started without the other participant"), UDlgManager::StartDialogueWithDefaultParticipants(TestWorld.World, Dialogue));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgParticipantRegistryLevelRemovedTest,
+	"DlgSystem.Runtime.ParticipantRegistryLevelRemoved",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgParticipantRegistryLevelRemovedTest::RunTest(const FString& Parameters)
+{
+	GetMutableDefault<UDlgSystemSettings>()->bTrackParticipantsAutomatically = true;
+	FDlgRegistryTestWorld TestWorld;
+	UDlgParticipantRegistry* Registry = TestWorld.Registry;
+	UDlgTestParticipant* Participant = TestWorld.RegisteredParticipant;
+	ADlgTestParticipantActor* Actor = TestWorld.ActorParticipant;
+	if (!TestNotNull(TEXT("Registry"), Registry) || !TestNotNull(TEXT("Actor"), Actor))
+	{
+		return false;
+	}
+
+	// The world is searched once, the actor is tracked
+	TestTrue(TEXT("RegisterParticipant"), Registry->RegisterParticipant(Participant));
+	TestTrue(TEXT("World is tracked"), Registry->IsAuthoritative());
+	TestTrue(TEXT("Actor is tracked"), Registry->IsParticipantRegistered(Actor));
+
+	// Level of the actor removed, the registered participant stays
+	FWorldDelegates::LevelRemovedFromWorld.Broadcast(Actor->GetLevel(), TestWorld.World);
+	TestFalse(TEXT("Actor of the removed level"), Registry->IsParticipantRegistered(Actor));
+	TestTrue(TEXT("Registered participant after the level is removed"), Registry->IsParticipantRegistered(Participant));
+
+	// All the levels
+	FWorldDelegates::LevelRemovedFromWorld.Broadcast(nullptr, TestWorld.World);
+	TestTrue(TEXT("Registered participant after all the levels are removed"), Registry->IsParticipantRegistered(Participant));
+	TestTrue(TEXT("Still found by name"), Registry->GetParticipants(Participant->ParticipantName) == TArray<UObject*>{ Participant });
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,103 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "GameFramework/Actor.h"
+
+#include "DlgSystem/DlgDialogueParticipant.h"
+#include "DlgSystem/DlgNativeDialogueParticipant.h"
+
+#include "DlgRuntimeTesterTypes.generated.h"
+
+
+// Participant used by the runtime tests
+UCLASS()
+class UDlgTestParticipant : public UObject, public IDlgDialogueParticipant
+{
+	GENERATED_BODY()
+
+public:
+	//
+	// IDlgDialogueParticipant Interface
+	//
+
+	FName GetParticipantName_Implementation() const override { return ParticipantName; }
+	bool CheckCondition_Implementation(const UDlgContext* Context, FName ConditionName) const override { return bCondition; }
+	int32 GetIntValue_Implementation(FName ValueName) const override { return Integer; }
+	float GetFloatValue_Implementation(FName ValueName) const override { return Float; }
+	bool GetBoolValue_Implementation(FName ValueName) const override { return bBool; }
+	FName GetNameValue_Implementation(FName ValueName) const override { return Name; }
+
+public:
+	UPROPERTY()
+	FName ParticipantName = TEXT("Participant");
+
+	UPROPERTY()
+	bool bCondition = true;
+
+	UPROPERTY()
+	int32 Integer = 0;
+
+	UPROPERTY()
+	float Float = 0.f;
+
+	UPROPERTY()
+	bool bBool = false;
+
+	UPROPERTY()
+	FName Name;
+};
+
+
+// Same values as UDlgTestParticipant, called through IDlgNativeDialogueParticipant. Counts the GetValuesNative calls.
+UCLASS()
+class UDlgTestNativeParticipant : public UDlgTestParticipant, public IDlgNativeDialogueParticipant
+{
+	GENERATED_BODY()
+
+public:
+	//
+	// IDlgNativeDialogueParticipant Interface
+	//
+
+	bool CheckConditionNative(const UDlgContext* Context, FName ConditionName) const override { return bCondition; }
+	float GetFloatValueNative(FName ValueName) const override { return Float; }
+	int32 GetIntValueNative(FName ValueName) const override { return Integer; }
+	bool GetBoolValueNative(FName ValueName) const override { return bBool; }
+	FName GetNameValueNative(FName ValueName) const override { return Name; }
+
+	void GetValuesNative(TArrayView<FDlgParticipantValueRequest> Requests) const override
+	{
+		NumGetValuesCalls++;
+		IDlgNativeDialogueParticipant::GetValuesNative(Requests);
+	}
+
+	bool ModifyIntValueNative(FName ValueName, bool bDelta, int32 Value) override
+	{
+		Integer = bDelta ? Integer + Value : Value;
+		return true;
+	}
+
+public:
+	mutable int32 NumGetValuesCalls = 0;
+};
+
+
+// Actor participant, found by searching the world
+UCLASS()
+class ADlgTestParticipantActor : public AActor, public IDlgDialogueParticipant
+{
+	GENERATED_BODY()
+
+public:
+	//
+	// IDlgDialogueParticipant Interface
+	//
+
+	FName GetParticipantName_Implementation() const override { return ParticipantName; }
+
+public:
+	UPROPERTY()
+	FName ParticipantName = TEXT("ActorParticipant");
+};
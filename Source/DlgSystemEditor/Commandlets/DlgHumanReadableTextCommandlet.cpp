@@ -266,7 +266,8 @@ bool UDlgHumanReadableTextCommandlet::ExportDialogueToHumanReadableFormat(const
 
 			FDlgNodeSpeechSequence_FormatHumanReadable ExportNode;
 			ExportNode.NodeIndex = NodeIndex;
-			ExportNode.Speaker = NodeSpeechSequence->GetNodeParticipantName();
+			// The owner of the node, not the speaker of an entry
+			ExportNode.Speaker = NodeSpeechSequence->UDlgNode::GetNodeParticipantName();
 
 			// Fill sequence
 			for (const FDlgSpeechSequenceEntry& Entry : NodeSpeechSequence->GetNodeSpeechSequence())
@@ -444,7 +445,7 @@ bool UDlgHumanReadableTextCommandlet::ImportHumanReadableFormatIntoDialogue(cons
 		}
 
 		// Node speaker changed
-		if (!NodeSpeechSequence->GetNodeParticipantName().IsEqual(HumanSpeechSequence.Speaker, ENameCase::CaseSensitive))
+		if (!NodeSpeechSequence->UDlgNode::GetNodeParticipantName().IsEqual(HumanSpeechSequence.Speaker, ENameCase::CaseSensitive))
 		{
 			NodeSpeechSequence->SetNodeParticipantName(HumanSpeechSequence.Speaker);
 			bModified = true;
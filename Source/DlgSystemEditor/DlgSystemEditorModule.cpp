@@ -38,8 +38,10 @@
 #include "DlgSystem/DlgManager.h"
 #include "DlgSystem/IDlgSystemModule.h"
 #include "DlgSystem/DlgParticipantName.h"
+#include "DlgSystem/NYReflectionHelper.h"
 
 #include "DlgSystem/IO/DlgConfigWriter.h"
+#include "DlgSystem/IO/IDlgParser.h"
 #include "DlgSystem/Logging/DlgLogger.h"
 
 #define LOCTEXT_NAMESPACE "DlgSystemEditor"
@@ -284,6 +286,10 @@ void FDlgSystemEditorModule::ShutdownModule()
 	{
 		FCoreDelegates::OnPostEngineInit.Remove(OnPostEngineInitHandle);
 	}
+	if (OnBlueprintCompiledHandle.IsValid() && GEditor)
+	{
+		GEditor->OnBlueprintCompiled().Remove(OnBlueprintCompiledHandle);
+	}
 
 	UE_LOG(LogDlgSystemEditor, Log, TEXT("DlgSystemEditorModule: ShutdownModule"));
 }
@@ -331,6 +337,16 @@ void FDlgSystemEditorModule::HandleOnDeleteAllDialoguesTextFiles()
 void FDlgSystemEditorModule::HandleOnPostEngineInit()
 {
 	bIsEngineInitialized = true;
+
+	// The compiled blueprint classes can have different properties (and names), the cached ones are no longer valid
+	if (GEditor)
+	{
+		OnBlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddLambda([]()
+		{
+			FNYReflectionHelper::ClearPropertyCache();
+			IDlgParser::ClearClassCache();
+		});
+	}
 	UE_LOG(LogDlgSystemEditor, Log, TEXT("DlgSystemEditorModule::HandleOnPostEngineInit"));
 }
 
@@ -105,6 +105,7 @@ private:
 	FDelegateHandle OnBeginPIEHandle;
 	FDelegateHandle OnPostPIEStartedHandle; // after BeginPlay() has been called
 	FDelegateHandle OnEndPIEHandle;
+	FDelegateHandle OnBlueprintCompiledHandle;
 
 	// Flags
 	bool bIsEngineInitialized = false;
@@ -276,7 +276,7 @@ FText SDlgGraphNode_Edge::GetEdgeText() const
 {
 	if (DialogueGraphNode_Edge != nullptr)
 	{
-		const FText EdgeText = DialogueGraphNode_Edge->GetDialogueEdge().GetText();
+		const FText EdgeText = DialogueGraphNode_Edge->GetDialogueEdge().GetUnformattedText();
 		if (Settings->GraphEdgeTextCharLimit <= 0)
 		{
 			return EdgeText;